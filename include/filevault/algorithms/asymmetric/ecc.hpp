@@ -204,6 +204,32 @@ class ECCHybrid : public core::ICryptoAlgorithm {
         const core::EncryptionConfig& config
     ) override;
     
+    /**
+     * @brief Encrypt incrementally to a recipient's public key
+     *
+     * The first output carries the ephemeral public key and nonce, so the
+     * outputs followed by the tag are laid out exactly like encrypt().
+     * @param key Recipient's public key
+     * @param nonce AES-GCM nonce (12 bytes), or empty to generate one
+     */
+    core::Result<std::unique_ptr<core::ICipherSession>> begin_encryption(
+        std::span<const uint8_t> key,
+        std::span<const uint8_t> nonce,
+        std::span<const uint8_t> associated_data = {}
+    ) override;
+    
+    /**
+     * @brief Decrypt incrementally with own private key
+     *
+     * The ephemeral public key and nonce are read from the first input
+     * bytes; the trailing 16-byte tag goes to finish(). @p nonce is unused.
+     */
+    core::Result<std::unique_ptr<core::ICipherSession>> begin_decryption(
+        std::span<const uint8_t> key,
+        std::span<const uint8_t> nonce,
+        std::span<const uint8_t> associated_data = {}
+    ) override;
+    
     /**
      * @brief Generate a new ECC key pair for this hybrid scheme
      */
@@ -0,0 +1,93 @@
+#ifndef FILEVAULT_ALGORITHMS_SYMMETRIC_AEAD_CONTEXT_HPP
+#define FILEVAULT_ALGORITHMS_SYMMETRIC_AEAD_CONTEXT_HPP
+
+#include "filevault/core/crypto_algorithm.hpp"
+#include <botan/aead.h>
+#include <memory>
+#include <string>
+
+namespace filevault {
+namespace algorithms {
+namespace symmetric {
+
+/**
+ * @brief Keyed context for Botan AEAD modes (GCM family, ChaCha20-Poly1305, AEGIS)
+ *
+ * Each direction's AEAD_Mode is created and keyed on first use and then
+ * only restarted with a new nonce per message; the working buffer is kept
+ * between messages too. Output matches the algorithm's one-shot
+ * encrypt()/decrypt(): ciphertext and 16-byte tag are returned separately,
+ * and a missing nonce is generated at random.
+ */
+class AeadContext : public core::ICipherContext {
+public:
+    /**
+     * @param botan_name Botan mode name (e.g. "AES-256/GCM")
+     * @param type Algorithm reported in results
+     * @param key Key to bind; a wrong size fails every call with "Invalid key size"
+     * @param key_size Expected key size in bytes
+     * @param bind_associated_data Authenticate config.associated_data (Serpent
+     *        and Twofish never did, and keep their output unchanged)
+     * @param nonce_size Nonce size in bytes (AEGIS takes 16 or 32)
+     */
+    AeadContext(std::string botan_name,
+                core::AlgorithmType type,
+                std::span<const uint8_t> key,
+                size_t key_size,
+                bool bind_associated_data = true,
+                size_t nonce_size = NONCE_SIZE);
+
+    core::CryptoResult encrypt(
+        std::span<const uint8_t> plaintext,
+        const core::EncryptionConfig& config
+    ) override;
+
+    core::CryptoResult decrypt(
+        std::span<const uint8_t> ciphertext,
+        const core::EncryptionConfig& config
+    ) override;
+
+    /**
+     * @brief Encrypt in place over @p out; only a sub-granularity tail is buffered
+     */
+    core::Result<size_t> encrypt_into(
+        std::span<const uint8_t> plaintext,
+        std::span<uint8_t> out,
+        std::span<uint8_t> tag_out,
+        const core::EncryptionConfig& config
+    ) override;
+
+    /**
+     * @brief Decrypt in place over @p out; wiped again if the tag does not verify
+     */
+    core::Result<size_t> decrypt_into(
+        std::span<const uint8_t> ciphertext,
+        std::span<uint8_t> out,
+        const core::EncryptionConfig& config
+    ) override;
+
+    size_t tag_size() const override { return TAG_SIZE; }
+
+    static constexpr size_t NONCE_SIZE = 12;
+    static constexpr size_t TAG_SIZE = 16;
+
+private:
+    Botan::AEAD_Mode& mode(Botan::Cipher_Dir direction);
+    void set_associated_data(Botan::AEAD_Mode& cipher, const core::EncryptionConfig& config);
+
+    std::string botan_name_;
+    core::AlgorithmType type_;
+    Botan::secure_vector<uint8_t> key_;
+    bool key_valid_;
+    bool bind_associated_data_;
+    size_t nonce_size_;
+    std::unique_ptr<Botan::AEAD_Mode> encryptor_;
+    std::unique_ptr<Botan::AEAD_Mode> decryptor_;
+    Botan::secure_vector<uint8_t> buffer_;
+};
+
+} // namespace symmetric
+} // namespace algorithms
+} // namespace filevault
+
+#endif // FILEVAULT_ALGORITHMS_SYMMETRIC_AEAD_CONTEXT_HPP
@@ -38,6 +38,20 @@ class AES_GCM : public core::ICryptoAlgorithm {
     
     bool is_suitable_for(core::SecurityLevel level) const override;
 
+    core::Result<std::unique_ptr<core::ICipherSession>> begin_encryption(
+        std::span<const uint8_t> key,
+        std::span<const uint8_t> nonce,
+        std::span<const uint8_t> associated_data = {}
+    ) override;
+    
+    core::Result<std::unique_ptr<core::ICipherSession>> begin_decryption(
+        std::span<const uint8_t> key,
+        std::span<const uint8_t> nonce,
+        std::span<const uint8_t> associated_data = {}
+    ) override;
+    
+    std::unique_ptr<core::ICipherContext> make_context(std::span<const uint8_t> key) override;
+
 private:
     size_t key_bits_;
     core::AlgorithmType type_;
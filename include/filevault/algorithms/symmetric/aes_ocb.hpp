@@ -0,0 +1,82 @@
+/**
+ * @file aes_ocb.hpp
+ * @brief AES-OCB3 AEAD encryption algorithms
+ *
+ * OCB3 (RFC 7253) encrypts and authenticates in a single pass: every block
+ * is one AES call masked by an offset, and the tag is the encrypted XOR
+ * checksum of the plaintext. Blocks are independent, so AES-NI pipelines
+ * stay full and no GF(2^128) multiply (GHASH) is needed.
+ */
+
+#ifndef FILEVAULT_ALGORITHMS_SYMMETRIC_AES_OCB_HPP
+#define FILEVAULT_ALGORITHMS_SYMMETRIC_AES_OCB_HPP
+
+#include "filevault/core/crypto_algorithm.hpp"
+#include <botan/aead.h>
+#include <memory>
+
+namespace filevault {
+namespace algorithms {
+namespace symmetric {
+
+/**
+ * @brief AES-OCB AEAD encryption
+ *
+ * Same key sizes, 96-bit nonce and 128-bit tag as AES_GCM, so it drops
+ * into every path that handles GCM.
+ */
+class AES_OCB : public core::ICryptoAlgorithm {
+public:
+    /**
+     * @brief Construct AES-OCB with specified key size
+     * @param key_bits 128, 192 or 256
+     */
+    explicit AES_OCB(size_t key_bits = 256);
+    virtual ~AES_OCB() = default;
+
+    std::string name() const override;
+    core::AlgorithmType type() const override;
+
+    core::CryptoResult encrypt(
+        std::span<const uint8_t> plaintext,
+        std::span<const uint8_t> key,
+        const core::EncryptionConfig& config
+    ) override;
+
+    core::CryptoResult decrypt(
+        std::span<const uint8_t> ciphertext,
+        std::span<const uint8_t> key,
+        const core::EncryptionConfig& config
+    ) override;
+
+    size_t key_size() const override { return key_bits_ / 8; }
+    size_t nonce_size() const { return 12; } // RFC 7253 recommended
+    size_t tag_size() const { return 16; }   // 128-bit tag
+
+    bool is_suitable_for(core::SecurityLevel level) const override;
+
+    core::Result<std::unique_ptr<core::ICipherSession>> begin_encryption(
+        std::span<const uint8_t> key,
+        std::span<const uint8_t> nonce,
+        std::span<const uint8_t> associated_data = {}
+    ) override;
+
+    core::Result<std::unique_ptr<core::ICipherSession>> begin_decryption(
+        std::span<const uint8_t> key,
+        std::span<const uint8_t> nonce,
+        std::span<const uint8_t> associated_data = {}
+    ) override;
+
+    std::unique_ptr<core::ICipherContext> make_context(std::span<const uint8_t> key) override;
+
+private:
+    size_t key_bits_;
+    core::AlgorithmType type_;
+    std::string botan_name_;
+};
+
+} // namespace symmetric
+} // namespace algorithms
+} // namespace filevault
+
+#endif // FILEVAULT_ALGORITHMS_SYMMETRIC_AES_OCB_HPP
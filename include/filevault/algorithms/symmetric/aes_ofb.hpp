@@ -57,6 +57,18 @@ class AES_OFB : public core::ICryptoAlgorithm {
     bool requires_padding() const { return false; }
     bool is_authenticated() const { return false; }
     bool is_suitable_for(core::SecurityLevel level) const override;
+
+    core::Result<std::unique_ptr<core::ICipherSession>> begin_encryption(
+        std::span<const uint8_t> key,
+        std::span<const uint8_t> nonce,
+        std::span<const uint8_t> associated_data = {}
+    ) override;
+    
+    core::Result<std::unique_ptr<core::ICipherSession>> begin_decryption(
+        std::span<const uint8_t> key,
+        std::span<const uint8_t> nonce,
+        std::span<const uint8_t> associated_data = {}
+    ) override;
     
 private:
     size_t key_bits_;
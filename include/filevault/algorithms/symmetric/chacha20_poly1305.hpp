@@ -53,6 +53,20 @@ class ChaCha20Poly1305 : public core::ICryptoAlgorithm {
     size_t tag_size() const { return 16; }           // 128 bits
     
     bool is_suitable_for(core::SecurityLevel level) const override;
+
+    core::Result<std::unique_ptr<core::ICipherSession>> begin_encryption(
+        std::span<const uint8_t> key,
+        std::span<const uint8_t> nonce,
+        std::span<const uint8_t> associated_data = {}
+    ) override;
+    
+    core::Result<std::unique_ptr<core::ICipherSession>> begin_decryption(
+        std::span<const uint8_t> key,
+        std::span<const uint8_t> nonce,
+        std::span<const uint8_t> associated_data = {}
+    ) override;
+    
+    std::unique_ptr<core::ICipherContext> make_context(std::span<const uint8_t> key) override;
 };
 
 } // namespace symmetric
@@ -0,0 +1,70 @@
+#ifndef FILEVAULT_ALGORITHMS_SYMMETRIC_CIPHER_SESSION_HPP
+#define FILEVAULT_ALGORITHMS_SYMMETRIC_CIPHER_SESSION_HPP
+
+#include "filevault/core/crypto_algorithm.hpp"
+#include <botan/cipher_mode.h>
+#include <memory>
+#include <string>
+
+namespace filevault {
+namespace algorithms {
+namespace symmetric {
+
+/**
+ * @brief Incremental session over any Botan Cipher_Mode (GCM, ChaCha20-Poly1305,
+ *        CTR, CBC, CFB, OFB, XTS)
+ *
+ * update() runs whole update granules through Cipher_Mode::process and keeps
+ * the rest, plus the mode's minimum final size (the last block of padded CBC
+ * or XTS ciphertext stealing), for finish(). For AEAD modes the tag is
+ * passed separately, so only sub-granule remainders are held back.
+ */
+class CipherModeSession : public core::ICipherSession {
+public:
+    /**
+     * @brief Create, key and start the mode
+     *
+     * @param botan_name Botan mode name (e.g. "AES-256/CBC/PKCS7")
+     * @param direction Encryption or decryption
+     * @param key Key, checked against @p key_size
+     * @param key_size Expected key size in bytes
+     * @param nonce Nonce/IV of @p nonce_size bytes, or empty to generate one
+     * @param nonce_size Nonce/IV size in bytes
+     * @param associated_data Bound for AEAD modes; rejected for others
+     */
+    static core::Result<std::unique_ptr<core::ICipherSession>> begin(
+        const std::string& botan_name,
+        Botan::Cipher_Dir direction,
+        std::span<const uint8_t> key,
+        size_t key_size,
+        std::span<const uint8_t> nonce,
+        size_t nonce_size,
+        std::span<const uint8_t> associated_data = {});
+
+    const std::vector<uint8_t>& nonce() const override { return nonce_; }
+    size_t tag_size() const override { return tag_size_; }
+    size_t output_bound(size_t input) const override;
+
+    core::Result<size_t> update(std::span<const uint8_t> in, std::span<uint8_t> out) override;
+    core::Result<size_t> finish(std::span<uint8_t> out, std::span<uint8_t> tag) override;
+
+private:
+    CipherModeSession(std::unique_ptr<Botan::Cipher_Mode> mode,
+                      Botan::Cipher_Dir direction,
+                      std::vector<uint8_t> nonce);
+
+    std::unique_ptr<Botan::Cipher_Mode> mode_;
+    Botan::Cipher_Dir direction_;
+    std::vector<uint8_t> nonce_;
+    size_t tag_size_;
+    size_t granularity_;
+    size_t hold_;                           ///< Bytes finish() needs besides the tag
+    Botan::secure_vector<uint8_t> pending_; ///< Input not yet processed
+    bool finished_ = false;
+};
+
+} // namespace symmetric
+} // namespace algorithms
+} // namespace filevault
+
+#endif // FILEVAULT_ALGORITHMS_SYMMETRIC_CIPHER_SESSION_HPP
@@ -50,6 +50,8 @@ class SM4_GCM : public core::ICryptoAlgorithm {
     size_t tag_size() const { return 16; }    // 128-bit tag
     
     bool is_suitable_for(core::SecurityLevel level) const override;
+    
+    std::unique_ptr<core::ICipherContext> make_context(std::span<const uint8_t> key) override;
 };
 
 } // namespace symmetric
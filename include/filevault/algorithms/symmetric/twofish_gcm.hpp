@@ -14,6 +14,7 @@
 
 #include "filevault/core/types.hpp"
 #include "filevault/core/crypto_algorithm.hpp"
+#include <memory>
 #include <vector>
 #include <span>
 
@@ -116,6 +117,11 @@ class Twofish_GCM : public core::ICryptoAlgorithm {
      */
     bool is_suitable_for(core::SecurityLevel level) const override;
 
+    /**
+     * @brief Context keyed once for many messages (streaming chunks)
+     */
+    std::unique_ptr<core::ICipherContext> make_context(std::span<const uint8_t> key) override;
+
 private:
     size_t key_bits_;
     core::AlgorithmType type_;
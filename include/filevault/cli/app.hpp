@@ -39,6 +39,10 @@ class Application {
     // Global options
     bool verbose_ = false;
     std::string log_level_ = "info";
+    std::string io_backend_ = "sync";
+    bool direct_io_ = false;
+    std::string cache_policy_ = "keep";
+    uint64_t max_memory_ = 0;   // Process memory budget (0 = MemoryBudget::default_limit)
 };
 
 } // namespace cli
@@ -60,6 +60,10 @@ class BenchmarkCommand : public ICommand {
     void benchmark_kdf(nlohmann::json& json_results);
     void benchmark_compression(nlohmann::json& json_results);
     void benchmark_hash(nlohmann::json& json_results);
+    void benchmark_io(nlohmann::json& json_results);
+    void benchmark_contexts(nlohmann::json& json_results);
+    void benchmark_rng(nlohmann::json& json_results);
+    void benchmark_startup(nlohmann::json& json_results);
     
     // Algorithm-specific benchmarks
     BenchmarkResult benchmark_algorithm(core::AlgorithmType algo_type);
@@ -86,6 +90,10 @@ class BenchmarkCommand : public ICommand {
     bool hash_only_ = false;
     bool kdf_only_ = false;
     bool compression_only_ = false;
+    bool io_only_ = false;
+    bool contexts_only_ = false;
+    bool rng_only_ = false;
+    bool startup_only_ = false;
 };
 
 } // namespace cli
@@ -18,12 +18,29 @@ class DecryptCommand : public ICommand {
     int execute() override;
 
 private:
+    /**
+     * @brief Decrypt only --range of a streaming (FVST) file
+     */
+    int execute_range();
+    
+    /**
+     * @brief Decrypt an FVST stream from stdin or to stdout ("-")
+     */
+    int execute_stream();
+    
+    /**
+     * @brief Decrypt an FVST file to a file on the chunk pipeline
+     */
+    int execute_streaming_file();
+    
     core::CryptoEngine& engine_;
     std::string input_file_;
     std::string output_file_;
     std::string password_;
+    std::string range_;
     bool verbose_ = false;
     bool no_progress_ = false;
+    size_t threads_ = 0;    // Streaming worker threads (0 = all cores)
 };
 
 } // namespace cli
@@ -3,6 +3,8 @@
 
 #include "filevault/cli/command.hpp"
 #include "filevault/core/crypto_engine.hpp"
+#include "filevault/core/file_format.hpp"
+#include "filevault/core/streaming.hpp"
 
 namespace filevault {
 namespace cli {
@@ -21,6 +23,29 @@ class EncryptCommand : public ICommand {
     int execute() override;
 
 private:
+    /**
+     * @brief Chunked FVST encryption for stdin/stdout pipes ("-"),
+     * checkpointed/resumed/appended runs and files above --stream-threshold
+     */
+    int execute_stream();
+    
+    /**
+     * @brief encrypt_stream between the input/output files or stdin/stdout
+     */
+    core::StreamingResult encrypt_pipe(const core::StreamingConfig& config);
+    
+    /**
+     * @brief Encrypt the input file block by block through @p session into
+     * the .fvlt layout (header | ciphertext | tag); returns the bytes read
+     */
+    core::Result<size_t> encrypt_incremental(core::ICipherSession& session,
+                                             const core::FileHeader& header);
+    
+    /**
+     * @brief Print the output summary after a successful encryption
+     */
+    int report_output(size_t plaintext_size);
+    
     core::CryptoEngine& engine_;
     
     // Command options
@@ -36,6 +61,13 @@ class EncryptCommand : public ICommand {
     bool verbose_ = false;
     bool no_progress_ = false;
     bool force_weak_password_ = false;
+    size_t checkpoint_interval_ = 0;  // Chunks between checkpoint journal updates
+    bool resume_ = false;
+    bool append_ = false;             // Add the input to an existing FVST output
+    bool stream_ = false;             // Force the chunked FVST format
+    size_t stream_threshold_ = 100 * 1024 * 1024;  // Larger inputs are streamed automatically
+    size_t chunk_size_ = 0;           // Streaming chunk size (0 = get_recommended_chunk_size)
+    size_t threads_ = 0;              // Streaming worker threads (0 = all cores)
 };
 
 } // namespace cli
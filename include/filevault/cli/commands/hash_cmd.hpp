@@ -3,6 +3,7 @@
 
 #include "filevault/cli/command.hpp"
 #include "filevault/core/crypto_engine.hpp"
+#include "filevault/core/io_backend.hpp"
 #include <string>
 #include <unordered_map>
 
@@ -43,6 +44,7 @@ class HashCommand : public ICommand {
     std::string output_format_ = "hex";
     std::string verify_hash_;
     std::string hmac_key_;
+    std::string cache_policy_;   // Empty = global --cache setting
     bool uppercase_ = false;
     bool no_filename_ = false;
     bool verbose_ = false;
@@ -52,6 +54,8 @@ class HashCommand : public ICommand {
     std::string get_botan_algorithm_name(const std::string& algo);
     bool is_secure_algorithm(const std::string& algo);
     
+    core::IOOptions io_options() const;
+    
     std::string calculate_file_hash(
         const std::string& filepath,
         const std::string& algorithm
@@ -33,6 +33,7 @@ class InfoCommand : public ICommand {
     core::CryptoEngine& engine_;
     std::string input_file_;
     bool verbose_ = false;
+    bool system_ = false;   // Show detected CPU/memory resources instead of a file
     
     /**
      * @brief Parse encrypted file header
@@ -56,6 +57,11 @@ class InfoCommand : public ICommand {
     
     FileInfo parse_file(const std::string& path);
     void display_info(const FileInfo& info);
+    
+    /**
+     * @brief Show the CPUs and memory streaming sizes itself to (cgroup-aware)
+     */
+    void display_system();
 };
 
 } // namespace cli
@@ -0,0 +1,38 @@
+#ifndef FILEVAULT_CLI_COMMANDS_UPDATE_CMD_HPP
+#define FILEVAULT_CLI_COMMANDS_UPDATE_CMD_HPP
+
+#include "filevault/cli/command.hpp"
+#include "filevault/core/crypto_engine.hpp"
+
+namespace filevault {
+namespace cli {
+
+/**
+ * @brief Update command: re-encrypt only the changed chunks of a streaming (FVST) file
+ */
+class UpdateCommand : public ICommand {
+public:
+    explicit UpdateCommand(core::CryptoEngine& engine);
+    
+    std::string name() const override { return "update"; }
+    std::string description() const override { return "Refresh a streaming encrypted file from a changed input"; }
+    
+    void setup(CLI::App& app) override;
+    int execute() override;
+
+private:
+    core::CryptoEngine& engine_;
+    
+    // Command options
+    std::string input_file_;
+    std::string stream_file_;
+    std::string password_;
+    std::string algorithm_ = "aes-256-gcm";    // Only used when the stream is created
+    std::string compression_type_ = "none";   // Only used when the stream is created
+    bool content_defined_ = false;            // Only used when the stream is created
+};
+
+} // namespace cli
+} // namespace filevault
+
+#endif // FILEVAULT_CLI_COMMANDS_UPDATE_CMD_HPP
@@ -0,0 +1,38 @@
+#ifndef FILEVAULT_CLI_COMMANDS_VERIFY_INTEGRITY_CMD_HPP
+#define FILEVAULT_CLI_COMMANDS_VERIFY_INTEGRITY_CMD_HPP
+
+#include "filevault/cli/command.hpp"
+#include "filevault/core/crypto_engine.hpp"
+
+namespace filevault {
+namespace cli {
+
+/**
+ * @brief Verify-integrity command: authenticate an encrypted file without decrypting it to disk
+ */
+class VerifyIntegrityCommand : public ICommand {
+public:
+    explicit VerifyIntegrityCommand(core::CryptoEngine& engine);
+    
+    std::string name() const override { return "verify-integrity"; }
+    std::string description() const override { return "Check every authentication tag of an encrypted file"; }
+    
+    void setup(CLI::App& app) override;
+    int execute() override;
+
+private:
+    core::CryptoEngine& engine_;
+    
+    // Command options
+    std::string input_file_;
+    std::string password_;
+    size_t threads_ = 0;
+    
+    int verify_streaming();
+    int verify_single();
+};
+
+} // namespace cli
+} // namespace filevault
+
+#endif // FILEVAULT_CLI_COMMANDS_VERIFY_INTEGRITY_CMD_HPP
@@ -6,6 +6,7 @@
 #include <vector>
 #include <span>
 #include <memory>
+#include <mutex>
 
 namespace filevault {
 namespace compression {
@@ -25,6 +26,9 @@ struct CompressionResult {
 
 /**
  * @brief Interface for compression algorithms
+ *
+ * Compressors may keep codec contexts between calls, so one instance must
+ * not be used from several threads at once (see CompressorPool).
  */
 class ICompressor {
 public:
@@ -75,13 +79,91 @@ class CompressionService {
      * @brief Parse algorithm from string
      */
     static core::CompressionType parse_algorithm(const std::string& name);
+    
+    /**
+     * @brief Order-0 entropy (bits per byte) of evenly spaced samples of @p data
+     * 
+     * Reads at most PROBE_SAMPLES windows of PROBE_WINDOW bytes, so the cost is
+     * independent of the input size.
+     */
+    static double estimate_entropy(std::span<const uint8_t> data);
+    
+    /**
+     * @brief Cheap probe for already-compressed/encrypted data (JPEG, archives, ...)
+     * @return true if compressing @p data is unlikely to save anything
+     */
+    static bool is_likely_incompressible(std::span<const uint8_t> data);
+    
+    /**
+     * @brief Codec working memory of one call, excluding input and output buffers
+     * 
+     * Used to reserve from core::MemoryBudget (LZMA level 9 needs ~670 MB to compress).
+     */
+    static uint64_t memory_usage(core::CompressionType type, int level, bool decompress = false);
+    
+    static constexpr size_t PROBE_SAMPLES = 16;
+    static constexpr size_t PROBE_WINDOW = 4096;
+    /// Sampled entropy above which data is treated as incompressible
+    static constexpr double INCOMPRESSIBLE_ENTROPY = 7.8;
+};
+
+/**
+ * @brief Thread-safe pool of reusable compressors of one type
+ * 
+ * Workers lease a compressor per chunk and return it when the lease ends,
+ * so no more compressors than concurrent workers are ever created and codec
+ * contexts are reused across chunks.
+ */
+class CompressorPool {
+public:
+    /**
+     * @brief Exclusive use of one pooled compressor
+     */
+    class Lease {
+    public:
+        Lease(CompressorPool& pool, std::unique_ptr<ICompressor> compressor)
+            : pool_(pool), compressor_(std::move(compressor)) {}
+        ~Lease() { pool_.release(std::move(compressor_)); }
+        
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        
+        ICompressor* operator->() const { return compressor_.get(); }
+        
+    private:
+        CompressorPool& pool_;
+        std::unique_ptr<ICompressor> compressor_;
+    };
+    
+    explicit CompressorPool(core::CompressionType type) : type_(type) {}
+    
+    /**
+     * @brief Take an idle compressor, creating one if none is free
+     */
+    Lease acquire();
+    
+private:
+    void release(std::unique_ptr<ICompressor> compressor);
+    
+    core::CompressionType type_;
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<ICompressor>> idle_;
 };
 
 /**
  * @brief ZLIB compressor (fast, good compression)
+ * 
+ * Keeps its deflate context between calls (deflateReset instead of a new
+ * deflateInit per buffer).
  */
 class ZlibCompressor : public ICompressor {
 public:
+    ZlibCompressor();
+    ~ZlibCompressor() override;
+    
+    ZlibCompressor(const ZlibCompressor&) = delete;
+    ZlibCompressor& operator=(const ZlibCompressor&) = delete;
+    
     std::string name() const override { return "zlib"; }
     
     CompressionResult compress(
@@ -92,6 +174,10 @@ class ZlibCompressor : public ICompressor {
     CompressionResult decompress(
         std::span<const uint8_t> input
     ) override;
+
+private:
+    struct DeflateState;
+    std::unique_ptr<DeflateState> deflate_;
 };
 
 /**
@@ -113,9 +199,18 @@ class Bzip2Compressor : public ICompressor {
 
 /**
  * @brief LZMA compressor (maximum compression, slowest)
+ * 
+ * Re-initialises the same lzma_stream for each buffer, which lets liblzma
+ * reuse the encoder's allocations.
  */
 class LzmaCompressor : public ICompressor {
 public:
+    LzmaCompressor();
+    ~LzmaCompressor() override;
+    
+    LzmaCompressor(const LzmaCompressor&) = delete;
+    LzmaCompressor& operator=(const LzmaCompressor&) = delete;
+    
     std::string name() const override { return "lzma"; }
     
     CompressionResult compress(
@@ -126,6 +221,10 @@ class LzmaCompressor : public ICompressor {
     CompressionResult decompress(
         std::span<const uint8_t> input
     ) override;
+
+private:
+    struct EncoderState;
+    std::unique_ptr<EncoderState> encoder_;
 };
 
 } // namespace compression
@@ -0,0 +1,179 @@
+#ifndef FILEVAULT_CORE_ALGORITHM_REGISTRY_HPP
+#define FILEVAULT_CORE_ALGORITHM_REGISTRY_HPP
+
+#include "filevault/core/file_format.hpp"
+#include "filevault/core/types.hpp"
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <string_view>
+
+namespace filevault {
+namespace core {
+
+/**
+ * @brief Static description of an algorithm: everything known without
+ *        constructing it
+ */
+struct AlgorithmInfo {
+    AlgorithmType type;
+    std::string_view name;                     ///< Display name ("AES-256-GCM")
+    std::array<std::string_view, 5> aliases;   ///< Lower-case names accepted on the command line
+    size_t key_size;                           ///< Key (or derived key) size in bytes
+    bool aead;                                 ///< Authenticated, 16-byte tag after the ciphertext
+    AlgorithmID format_id;                     ///< Header ID in .fvlt files (UNKNOWN = not storable)
+    size_t nonce_size = 12;                    ///< Nonce size in bytes for AEAD entries
+};
+
+/**
+ * @brief One entry per AlgorithmType, in enum order
+ *
+ * CryptoEngine resolves names and key sizes here and only constructs an
+ * implementation when get_algorithm() first asks for it, so starting the
+ * CLI costs no algorithm set-up at all.
+ */
+inline constexpr AlgorithmInfo ALGORITHM_TABLE[] = {
+    {AlgorithmType::AES_128_GCM, "AES-128-GCM", {"aes-128-gcm", "aes128gcm"}, 16, true, AlgorithmID::AES_128_GCM},
+    {AlgorithmType::AES_192_GCM, "AES-192-GCM", {"aes-192-gcm", "aes192gcm"}, 24, true, AlgorithmID::AES_192_GCM},
+    {AlgorithmType::AES_256_GCM, "AES-256-GCM", {"aes-256-gcm", "aes256gcm", "aes", "aes256"}, 32, true, AlgorithmID::AES_256_GCM},
+    {AlgorithmType::CHACHA20_POLY1305, "ChaCha20-Poly1305", {"chacha20-poly1305", "chacha20", "chacha"}, 32, true, AlgorithmID::CHACHA20_POLY1305},
+    {AlgorithmType::SERPENT_256_GCM, "Serpent-256-GCM", {"serpent-256-gcm", "serpent", "serpent256"}, 32, true, AlgorithmID::SERPENT_256_GCM},
+    {AlgorithmType::TWOFISH_128_GCM, "Twofish-128-GCM", {"twofish-128-gcm", "twofish128"}, 16, true, AlgorithmID::TWOFISH_128_GCM},
+    {AlgorithmType::TWOFISH_192_GCM, "Twofish-192-GCM", {"twofish-192-gcm", "twofish192"}, 24, true, AlgorithmID::TWOFISH_192_GCM},
+    {AlgorithmType::TWOFISH_256_GCM, "Twofish-256-GCM", {"twofish-256-gcm", "twofish", "twofish256"}, 32, true, AlgorithmID::TWOFISH_256_GCM},
+    {AlgorithmType::CAMELLIA_128_GCM, "Camellia-128-GCM", {"camellia-128-gcm", "camellia128"}, 16, true, AlgorithmID::CAMELLIA_128_GCM},
+    {AlgorithmType::CAMELLIA_192_GCM, "Camellia-192-GCM", {"camellia-192-gcm", "camellia192"}, 24, true, AlgorithmID::CAMELLIA_192_GCM},
+    {AlgorithmType::CAMELLIA_256_GCM, "Camellia-256-GCM", {"camellia-256-gcm", "camellia", "camellia256"}, 32, true, AlgorithmID::CAMELLIA_256_GCM},
+    {AlgorithmType::ARIA_128_GCM, "ARIA-128-GCM", {"aria-128-gcm", "aria128"}, 16, true, AlgorithmID::ARIA_128_GCM},
+    {AlgorithmType::ARIA_192_GCM, "ARIA-192-GCM", {"aria-192-gcm", "aria192"}, 24, true, AlgorithmID::ARIA_192_GCM},
+    {AlgorithmType::ARIA_256_GCM, "ARIA-256-GCM", {"aria-256-gcm", "aria", "aria256"}, 32, true, AlgorithmID::ARIA_256_GCM},
+    {AlgorithmType::SM4_GCM, "SM4-GCM", {"sm4-gcm", "sm4"}, 16, true, AlgorithmID::SM4_GCM},
+
+    // Non-AEAD modes (not authenticated)
+    {AlgorithmType::AES_128_CBC, "AES-128-CBC", {"aes-128-cbc", "aes128cbc"}, 16, false, AlgorithmID::AES_128_CBC},
+    {AlgorithmType::AES_192_CBC, "AES-192-CBC", {"aes-192-cbc", "aes192cbc"}, 24, false, AlgorithmID::AES_192_CBC},
+    {AlgorithmType::AES_256_CBC, "AES-256-CBC", {"aes-256-cbc", "aes256cbc"}, 32, false, AlgorithmID::AES_256_CBC},
+    {AlgorithmType::AES_128_CTR, "AES-128-CTR", {"aes-128-ctr", "aes128ctr"}, 16, false, AlgorithmID::AES_128_CTR},
+    {AlgorithmType::AES_192_CTR, "AES-192-CTR", {"aes-192-ctr", "aes192ctr"}, 24, false, AlgorithmID::AES_192_CTR},
+    {AlgorithmType::AES_256_CTR, "AES-256-CTR", {"aes-256-ctr", "aes256ctr"}, 32, false, AlgorithmID::AES_256_CTR},
+    {AlgorithmType::AES_128_CFB, "AES-128-CFB", {"aes-128-cfb", "aes128cfb"}, 16, false, AlgorithmID::AES_128_CFB},
+    {AlgorithmType::AES_192_CFB, "AES-192-CFB", {"aes-192-cfb", "aes192cfb"}, 24, false, AlgorithmID::AES_192_CFB},
+    {AlgorithmType::AES_256_CFB, "AES-256-CFB", {"aes-256-cfb", "aes256cfb"}, 32, false, AlgorithmID::AES_256_CFB},
+    {AlgorithmType::AES_128_OFB, "AES-128-OFB", {"aes-128-ofb", "aes128ofb"}, 16, false, AlgorithmID::AES_128_OFB},
+    {AlgorithmType::AES_192_OFB, "AES-192-OFB", {"aes-192-ofb", "aes192ofb"}, 24, false, AlgorithmID::AES_192_OFB},
+    {AlgorithmType::AES_256_OFB, "AES-256-OFB", {"aes-256-ofb", "aes256ofb"}, 32, false, AlgorithmID::AES_256_OFB},
+    {AlgorithmType::AES_128_ECB, "AES-128-ECB", {"aes-128-ecb", "aes128ecb"}, 16, false, AlgorithmID::AES_128_ECB},
+    {AlgorithmType::AES_192_ECB, "AES-192-ECB", {"aes-192-ecb", "aes192ecb"}, 24, false, AlgorithmID::AES_192_ECB},
+    {AlgorithmType::AES_256_ECB, "AES-256-ECB", {"aes-256-ecb", "aes256ecb"}, 32, false, AlgorithmID::AES_256_ECB},
+    {AlgorithmType::AES_128_XTS, "AES-128-XTS", {"aes-128-xts", "aes128xts"}, 32, false, AlgorithmID::AES_128_XTS},
+    {AlgorithmType::AES_256_XTS, "AES-256-XTS", {"aes-256-xts", "aes256xts", "xts"}, 64, false, AlgorithmID::AES_256_XTS},
+    {AlgorithmType::TRIPLE_DES_CBC, "3DES-CBC", {"3des", "3des-cbc", "tripledes", "triple-des"}, 24, false, AlgorithmID::TRIPLE_DES_CBC},
+
+    // Asymmetric (key_size is the curve or modulus size)
+    {AlgorithmType::RSA_2048, "RSA-2048", {"rsa-2048", "rsa2048"}, 256, false, AlgorithmID::RSA_2048},
+    {AlgorithmType::RSA_3072, "RSA-3072", {"rsa-3072", "rsa3072"}, 384, false, AlgorithmID::RSA_3072},
+    {AlgorithmType::RSA_4096, "RSA-4096", {"rsa-4096", "rsa4096", "rsa"}, 512, false, AlgorithmID::RSA_4096},
+    {AlgorithmType::ECC_P256, "ECC-P256", {"ecc-p256", "eccp256", "p256", "secp256r1"}, 32, false, AlgorithmID::ECC_P256},
+    {AlgorithmType::ECC_P384, "ECC-P384", {"ecc-p384", "eccp384", "p384", "secp384r1"}, 48, false, AlgorithmID::ECC_P384},
+    {AlgorithmType::ECC_P521, "ECC-P521", {"ecc-p521", "eccp521", "p521", "secp521r1", "ecc"}, 66, false, AlgorithmID::ECC_P521},
+
+    // Classical (educational)
+    {AlgorithmType::CAESAR, "Caesar", {"caesar"}, 4, false, AlgorithmID::CAESAR},
+    {AlgorithmType::VIGENERE, "Vigenère", {"vigenere", "vigenère"}, 32, false, AlgorithmID::VIGENERE},
+    {AlgorithmType::PLAYFAIR, "Playfair", {"playfair"}, 32, false, AlgorithmID::PLAYFAIR},
+    {AlgorithmType::SUBSTITUTION, "Substitution", {"substitution", "sub"}, 26, false, AlgorithmID::SUBSTITUTION},
+    {AlgorithmType::HILL, "Hill", {"hill"}, 4, false, AlgorithmID::HILL},
+
+    // Post-quantum (no .fvlt header ID; KEMs and signatures are not file ciphers)
+    {AlgorithmType::KYBER_512, "Kyber-512", {"kyber-512", "kyber512"}, 32, false, AlgorithmID::UNKNOWN},
+    {AlgorithmType::KYBER_768, "Kyber-768", {"kyber-768", "kyber768"}, 32, false, AlgorithmID::UNKNOWN},
+    {AlgorithmType::KYBER_1024, "Kyber-1024", {"kyber-1024", "kyber1024", "kyber"}, 32, false, AlgorithmID::UNKNOWN},
+    {AlgorithmType::DILITHIUM_2, "Dilithium-2", {"dilithium-2", "dilithium2"}, 0, false, AlgorithmID::UNKNOWN},
+    {AlgorithmType::DILITHIUM_3, "Dilithium-3", {"dilithium-3", "dilithium3"}, 0, false, AlgorithmID::UNKNOWN},
+    {AlgorithmType::DILITHIUM_5, "Dilithium-5", {"dilithium-5", "dilithium5", "dilithium"}, 0, false, AlgorithmID::UNKNOWN},
+    {AlgorithmType::KYBER_512_HYBRID, "Kyber-512-Hybrid", {"kyber-512-hybrid", "kyber512hybrid"}, 32, false, AlgorithmID::UNKNOWN},
+    {AlgorithmType::KYBER_768_HYBRID, "Kyber-768-Hybrid", {"kyber-768-hybrid", "kyber768hybrid"}, 32, false, AlgorithmID::UNKNOWN},
+    {AlgorithmType::KYBER_1024_HYBRID, "Kyber-1024-Hybrid", {"kyber-1024-hybrid", "kyber1024hybrid", "kyber-hybrid"}, 32, false, AlgorithmID::UNKNOWN},
+
+    // High-throughput AEAD (appended: AlgorithmType values are stored in headers)
+    {AlgorithmType::AEGIS_128L, "AEGIS-128L", {"aegis-128l", "aegis128l"}, 16, true, AlgorithmID::AEGIS_128L, 16},
+    {AlgorithmType::AEGIS_256, "AEGIS-256", {"aegis-256", "aegis256", "aegis"}, 32, true, AlgorithmID::AEGIS_256, 32},
+    {AlgorithmType::AES_128_OCB, "AES-128-OCB", {"aes-128-ocb", "aes128ocb"}, 16, true, AlgorithmID::AES_128_OCB},
+    {AlgorithmType::AES_192_OCB, "AES-192-OCB", {"aes-192-ocb", "aes192ocb"}, 24, true, AlgorithmID::AES_192_OCB},
+    {AlgorithmType::AES_256_OCB, "AES-256-OCB", {"aes-256-ocb", "aes256ocb", "ocb"}, 32, true, AlgorithmID::AES_256_OCB},
+};
+
+namespace detail {
+
+constexpr bool table_in_enum_order() {
+    for (size_t i = 0; i < std::size(ALGORITHM_TABLE); ++i) {
+        if (static_cast<size_t>(ALGORITHM_TABLE[i].type) != i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+constexpr bool equals_ignore_case(std::string_view input, std::string_view lower) {
+    if (input.size() != lower.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < input.size(); ++i) {
+        char c = input[i];
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+        if (c != lower[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace detail
+
+static_assert(std::size(ALGORITHM_TABLE) == static_cast<size_t>(AlgorithmType::AES_256_OCB) + 1,
+              "every AlgorithmType needs an ALGORITHM_TABLE entry");
+static_assert(detail::table_in_enum_order(), "ALGORITHM_TABLE must follow AlgorithmType order");
+
+/**
+ * @brief Table entry for @p type (nullptr for an out-of-range value)
+ */
+constexpr const AlgorithmInfo* find_algorithm(AlgorithmType type) {
+    const auto index = static_cast<size_t>(type);
+    return index < std::size(ALGORITHM_TABLE) ? &ALGORITHM_TABLE[index] : nullptr;
+}
+
+/**
+ * @brief Table entry with an alias matching @p name, ignoring ASCII case
+ */
+constexpr const AlgorithmInfo* find_algorithm(std::string_view name) {
+    for (const auto& info : ALGORITHM_TABLE) {
+        for (const auto& alias : info.aliases) {
+            if (!alias.empty() && detail::equals_ignore_case(name, alias)) {
+                return &info;
+            }
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Table entry stored under header ID @p id
+ */
+constexpr const AlgorithmInfo* find_algorithm(AlgorithmID id) {
+    if (id == AlgorithmID::UNKNOWN) {
+        return nullptr;
+    }
+    for (const auto& info : ALGORITHM_TABLE) {
+        if (info.format_id == id) {
+            return &info;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace core
+} // namespace filevault
+
+#endif // FILEVAULT_CORE_ALGORITHM_REGISTRY_HPP
@@ -0,0 +1,202 @@
+#ifndef FILEVAULT_CORE_CHUNK_POOL_HPP
+#define FILEVAULT_CORE_CHUNK_POOL_HPP
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <functional>
+#include <optional>
+#include <map>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include "result.hpp"
+
+namespace filevault {
+namespace core {
+
+/**
+ * @brief A single chunk travelling through the streaming pipeline
+ */
+struct ChunkJob {
+    size_t index = 0;               // Chunk index (defines output order)
+    size_t plain_size = 0;          // Plaintext bytes covered by this chunk
+    std::vector<uint8_t> data;      // Input on submit, transformed output on return
+    std::vector<uint8_t> tag;       // Authentication tag (AEAD only)
+    bool last = false;              // Final chunk of the stream
+    bool compressed = false;        // Payload is compressed (per-chunk record flag)
+    std::vector<uint8_t> segment_id; // Segment the record's nonce is derived from (FVST)
+    uint64_t nonce_index = 0;       // Chunk index in that nonce (a moved record keeps its own)
+    std::array<uint8_t, 16> digest{}; // Keyed plaintext digest (FLAG_CHUNK_DIGESTS)
+    bool unchanged = false;         // Copied from the previous version (delta update)
+    size_t source_index = 0;        // Chunk of the previous version it is copied from
+    uint64_t offset = 0;            // Stream offset of the chunk's record (verification)
+    bool success = true;
+    std::string error_message;
+};
+
+/**
+ * @brief Worker pool that transforms chunks in parallel and returns them in order
+ *
+ * A producer submits chunks with increasing indices and a consumer collects
+ * results with next(), which always yields the lowest outstanding index.
+ * Producer and consumer may be the same thread or two different threads.
+ *
+ * With zero threads no workers are started and submit() runs the transform
+ * inline on the producer thread.
+ */
+class ChunkWorkerPool {
+public:
+    using Transform = std::function<void(ChunkJob&)>;
+
+    /**
+     * @param threads Number of worker threads (0 runs inline)
+     * @param transform Function applied to each chunk; may throw
+     */
+    ChunkWorkerPool(size_t threads, Transform transform);
+    ~ChunkWorkerPool();
+
+    ChunkWorkerPool(const ChunkWorkerPool&) = delete;
+    ChunkWorkerPool& operator=(const ChunkWorkerPool&) = delete;
+
+    /**
+     * @brief Queue a chunk for transformation
+     */
+    void submit(ChunkJob job);
+
+    /**
+     * @brief Signal that no more chunks will be submitted
+     */
+    void close();
+
+    /**
+     * @brief Wait for and return the next chunk in submission order
+     * @return The chunk, or std::nullopt once closed and fully drained
+     */
+    std::optional<ChunkJob> next();
+
+    /**
+     * @brief Chunks submitted but not yet returned by next()
+     */
+    size_t outstanding() const;
+
+    /**
+     * @brief Number of worker threads (0 when running inline)
+     */
+    size_t thread_count() const { return workers_.size(); }
+
+private:
+    void worker_loop();
+    void run(ChunkJob& job);
+
+    Transform transform_;
+    std::vector<std::thread> workers_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable done_cv_;
+    std::deque<ChunkJob> pending_;
+    std::map<size_t, ChunkJob> completed_;
+    bool stopping_ = false;
+    bool closed_ = false;
+    size_t submitted_ = 0;
+    size_t returned_ = 0;
+    size_t next_index_ = 0;
+};
+
+/**
+ * @brief Fixed set of reusable chunk buffers
+ *
+ * Each acquire() takes one of `slots` slots and blocks while none are free,
+ * which provides backpressure: the reader can never run more than `slots`
+ * chunks ahead of the writer. Released buffers keep their capacity and are
+ * handed out again, so steady-state streaming does not allocate read buffers.
+ */
+class ChunkBufferRing {
+public:
+    explicit ChunkBufferRing(size_t slots);
+
+    /**
+     * @brief Take a free slot (blocking)
+     * @return A recycled (or new, empty) buffer, or std::nullopt if cancelled
+     */
+    std::optional<std::vector<uint8_t>> acquire();
+
+    /**
+     * @brief Return a slot together with a buffer for reuse
+     */
+    void release(std::vector<uint8_t> buffer);
+
+    /**
+     * @brief Wake all waiters and make further acquire() calls fail
+     */
+    void cancel();
+
+    size_t slots() const { return slots_; }
+
+private:
+    size_t slots_;
+    size_t available_;
+    bool cancelled_ = false;
+    std::vector<std::vector<uint8_t>> free_buffers_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+};
+
+/**
+ * @brief Bounded read -> transform -> write pipeline
+ *
+ * Reading runs on the calling thread, transforms on a ChunkWorkerPool and
+ * writing on a dedicated writer thread, so reading chunk i+1 and writing
+ * chunk i-1 overlap with transforming chunk i. The number of chunks in
+ * flight (and therefore memory) is bounded by the buffer ring size,
+ * independent of the input length.
+ */
+class ChunkPipeline {
+public:
+    /**
+     * @brief Fill a job from the input
+     *
+     * The job arrives with a recycled buffer in `data`. Return false at end of
+     * input; throw on read errors.
+     */
+    using Reader = std::function<bool(ChunkJob& job)>;
+
+    /**
+     * @brief Write a transformed job; throw to abort the pipeline
+     */
+    using Writer = std::function<void(ChunkJob& job)>;
+
+    /**
+     * @param threads Transform worker threads (0 transforms on the reader thread)
+     * @param slots Maximum number of chunks in flight (at least 1)
+     * @param transform Per-chunk transform
+     */
+    ChunkPipeline(size_t threads, size_t slots, ChunkWorkerPool::Transform transform);
+
+    /**
+     * @brief Run the pipeline to completion
+     * @return Error describing the first failed stage, if any
+     */
+    Result<void> run(const Reader& reader, const Writer& writer);
+
+    /**
+     * @brief Number of buffer slots for a byte budget
+     * @param chunk_size Size of one chunk
+     * @param max_in_flight_bytes Byte budget (0 = no byte limit)
+     * @param threads Transform worker threads
+     */
+    static size_t slots_for_budget(size_t chunk_size, size_t max_in_flight_bytes, size_t threads);
+
+private:
+    size_t threads_;
+    size_t slots_;
+    ChunkWorkerPool::Transform transform_;
+};
+
+} // namespace core
+} // namespace filevault
+
+#endif // FILEVAULT_CORE_CHUNK_POOL_HPP
@@ -0,0 +1,69 @@
+#ifndef FILEVAULT_CORE_CONTENT_CHUNKER_HPP
+#define FILEVAULT_CORE_CONTENT_CHUNKER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace filevault {
+namespace core {
+
+/**
+ * @brief Content-defined chunk boundaries (FastCDC-style Gear rolling hash)
+ *
+ * A cut is placed where the rolling hash h = (h << 1) + gear[byte] has all
+ * masked bits clear, so boundaries follow the content: inserting bytes only
+ * moves the boundaries next to the edit. Normalized chunking uses a stricter
+ * mask before the average size and a looser one after it, which keeps chunk
+ * sizes close to the average. No cut is searched for in the first min_size
+ * bytes and every chunk ends at max_size at the latest.
+ *
+ * The gear table is derived from a key, so boundary positions reveal nothing
+ * about the content to someone without the key.
+ */
+class ContentChunker {
+public:
+    /**
+     * @param key Secret the gear table is derived from
+     * @param min_size Smallest chunk (except the final one)
+     * @param avg_size Target average (rounded down to a power of two)
+     * @param max_size Largest chunk
+     */
+    ContentChunker(const std::vector<uint8_t>& key, size_t min_size, size_t avg_size, size_t max_size);
+
+    /**
+     * @brief Chunker for FVST content-defined streams, whose header only records the maximum
+     *
+     * Chunks are chunk_size / 16 to chunk_size bytes, chunk_size / 4 on average.
+     */
+    static ContentChunker for_stream(const std::vector<uint8_t>& key, size_t chunk_size);
+
+    /**
+     * @brief Most chunks for_stream() can cut @p size bytes into (all but the last at the minimum)
+     */
+    static uint64_t max_stream_chunks(uint64_t size, size_t chunk_size);
+
+    /**
+     * @brief Length of the chunk that starts at @p data
+     * @param size Bytes available; pass at least max_size() unless they run to the end of the input
+     */
+    size_t cut_point(const uint8_t* data, size_t size) const;
+
+    size_t min_size() const { return min_size_; }
+    size_t avg_size() const { return avg_size_; }
+    size_t max_size() const { return max_size_; }
+
+private:
+    std::array<uint64_t, 256> gear_{};
+    uint64_t mask_small_ = 0;   // More bits: harder to cut before the average
+    uint64_t mask_large_ = 0;   // Fewer bits: easier to cut after it
+    size_t min_size_;
+    size_t avg_size_;
+    size_t max_size_;
+};
+
+} // namespace core
+} // namespace filevault
+
+#endif // FILEVAULT_CORE_CONTENT_CHUNKER_HPP
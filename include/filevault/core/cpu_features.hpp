@@ -0,0 +1,106 @@
+#ifndef FILEVAULT_CORE_CPU_FEATURES_HPP
+#define FILEVAULT_CORE_CPU_FEATURES_HPP
+
+#include "filevault/core/types.hpp"
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace filevault {
+namespace core {
+
+/**
+ * @brief Crypto-relevant instruction set extensions of the running CPU
+ *
+ * x86 flags come from CPUID (AVX and AVX-512 also need the OS to save the
+ * wider registers, checked with XGETBV); ARMv8 flags from the kernel's
+ * HWCAP bits on Linux, and are always set on Apple silicon.
+ */
+struct CpuFeatures {
+    std::string architecture = "unknown";   // "x86_64", "aarch64", ...
+    std::string model;                      // CPU brand string, if the CPU reports one
+
+    // x86
+    bool aes_ni = false;
+    bool vaes = false;                      // AES on 256/512-bit vectors
+    bool pclmulqdq = false;                 // Carry-less multiply (GHASH)
+    bool avx2 = false;
+    bool avx512 = false;                    // AVX-512F
+    bool sha_ni = false;
+
+    // ARMv8 crypto extensions
+    bool arm_aes = false;
+    bool arm_pmull = false;                 // Polynomial multiply (GHASH)
+    bool arm_sha2 = false;
+
+    /**
+     * @brief AES rounds and GHASH both run in hardware, so AES-GCM is fast
+     */
+    bool hardware_aes() const;
+
+    /**
+     * @brief Names of the extensions present, for display
+     */
+    std::vector<std::string> names() const;
+
+    /**
+     * @brief Architecture, model and extensions; identifies the machine
+     *        that produced cached benchmark figures
+     */
+    std::string signature() const;
+
+    /**
+     * @brief Features of this machine, probed once and cached
+     */
+    static const CpuFeatures& current();
+
+    /**
+     * @brief Probe the CPU now
+     */
+    static CpuFeatures probe();
+};
+
+/**
+ * @brief Measured encryption throughput of one AEAD
+ */
+struct AeadThroughput {
+    AlgorithmType algorithm;
+    double encrypt_mbps = 0;
+};
+
+/**
+ * @brief The `auto` algorithm choice: the fastest 256-bit AEAD here
+ *
+ * Benchmark figures measured on this machine win when available
+ * (`filevault benchmark --symmetric` saves them). Otherwise the choice
+ * follows the probe: AES-256-GCM with AES and carry-less multiply
+ * instructions, ChaCha20-Poly1305 without them, where table-based AES is
+ * several times slower.
+ */
+class AutoAlgorithm {
+public:
+    /**
+     * @brief Pick from @p measured if it has a usable entry, else from @p cpu
+     */
+    static AlgorithmType choose(const CpuFeatures& cpu,
+                                const std::vector<AeadThroughput>& measured = {});
+
+    /**
+     * @brief Figures saved by save_measurements() for this CPU (empty if the
+     *        file is missing, unreadable or from another machine)
+     */
+    static std::vector<AeadThroughput> load_measurements(const std::filesystem::path& file,
+                                                         const CpuFeatures& cpu);
+
+    /**
+     * @brief Store @p measured for later choose() calls
+     */
+    static bool save_measurements(const std::filesystem::path& file,
+                                  const CpuFeatures& cpu,
+                                  const std::vector<AeadThroughput>& measured);
+};
+
+} // namespace core
+} // namespace filevault
+
+#endif // FILEVAULT_CORE_CPU_FEATURES_HPP
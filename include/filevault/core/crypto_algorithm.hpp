@@ -1,14 +1,188 @@
 #ifndef FILEVAULT_CORE_CRYPTO_ALGORITHM_HPP
 #define FILEVAULT_CORE_CRYPTO_ALGORITHM_HPP
 
+#include <memory>
+#include <mutex>
 #include <string>
 #include <span>
+#include <vector>
 #include "types.hpp"
 #include "result.hpp"
 
 namespace filevault {
 namespace core {
 
+/**
+ * @brief Where one message of a batch landed in its BatchArena
+ */
+struct BatchItem {
+    uint64_t offset = 0;    ///< Start of the ciphertext; the tag follows it
+    uint32_t length = 0;    ///< Ciphertext length
+};
+
+/**
+ * @brief Contiguous output of encrypt_batch()
+ *
+ * Messages are stored back to back as [ciphertext][tag], with one compact
+ * descriptor per message. Reusing an arena keeps its capacity, so repeated
+ * batches of similar size allocate nothing.
+ */
+class BatchArena {
+public:
+    size_t size() const { return items_.size(); }
+    size_t tag_size() const { return tag_size_; }
+    const std::vector<BatchItem>& items() const { return items_; }
+
+    /**
+     * @brief Every message and tag, in input order
+     */
+    std::span<const uint8_t> bytes() const { return data_; }
+
+    std::span<const uint8_t> ciphertext(size_t index) const {
+        const auto& item = items_.at(index);
+        return std::span<const uint8_t>(data_).subspan(item.offset, item.length);
+    }
+
+    std::span<const uint8_t> tag(size_t index) const {
+        const auto& item = items_.at(index);
+        return std::span<const uint8_t>(data_).subspan(item.offset + item.length, tag_size_);
+    }
+
+    /**
+     * @brief Nonce message @p index was encrypted under
+     *
+     * The index is XORed big-endian into the last four bytes of the base,
+     * so a base must never be reused with the same key.
+     */
+    static std::vector<uint8_t> nonce_for(std::span<const uint8_t> nonce_base, size_t index);
+
+    /**
+     * @brief Drop the contents, keeping the capacity
+     */
+    void clear();
+
+private:
+    friend class ICipherContext;
+    static void write_nonce(std::span<const uint8_t> nonce_base, size_t index, std::vector<uint8_t>& nonce);
+
+    std::vector<uint8_t> data_;
+    std::vector<BatchItem> items_;
+    size_t tag_size_ = 0;
+};
+
+/**
+ * @brief An algorithm bound to one key, for encrypting many messages
+ *
+ * Keeps the cipher object and its key schedule, so each message only sets
+ * a nonce and runs start/finish instead of creating and keying a cipher.
+ * encrypt()/decrypt() take the same config fields (nonce, tag, associated
+ * data) as ICryptoAlgorithm and produce identical output.
+ *
+ * Not thread-safe: each thread uses its own context (see CipherContextPool).
+ */
+class ICipherContext {
+public:
+    virtual ~ICipherContext() = default;
+
+    virtual CryptoResult encrypt(
+        std::span<const uint8_t> plaintext,
+        const EncryptionConfig& config
+    ) = 0;
+
+    virtual CryptoResult decrypt(
+        std::span<const uint8_t> ciphertext,
+        const EncryptionConfig& config
+    ) = 0;
+
+    /**
+     * @brief Encrypt into caller-owned buffers (see ICryptoAlgorithm::encrypt_into)
+     *
+     * The default copies the result of encrypt(); AeadContext encrypts in place.
+     */
+    virtual Result<size_t> encrypt_into(
+        std::span<const uint8_t> plaintext,
+        std::span<uint8_t> out,
+        std::span<uint8_t> tag_out,
+        const EncryptionConfig& config
+    );
+
+    /**
+     * @brief Decrypt into a caller-owned buffer (see ICryptoAlgorithm::decrypt_into)
+     */
+    virtual Result<size_t> decrypt_into(
+        std::span<const uint8_t> ciphertext,
+        std::span<uint8_t> out,
+        const EncryptionConfig& config
+    );
+
+    /**
+     * @brief Encrypt many messages into @p output (see ICryptoAlgorithm::encrypt_batch)
+     */
+    virtual Result<size_t> encrypt_batch(
+        std::span<const std::span<const uint8_t>> inputs,
+        std::span<const uint8_t> nonce_base,
+        BatchArena& output
+    );
+
+    /**
+     * @brief Tag bytes appended to each message (16 for AEAD contexts)
+     */
+    virtual size_t tag_size() const { return 0; }
+};
+
+/**
+ * @brief One message encrypted or decrypted piece by piece
+ *
+ * Created by ICryptoAlgorithm::begin_encryption()/begin_decryption(), fed
+ * with update() and closed with finish(). Only the bytes the cipher cannot
+ * process yet (a partial granule, or the final block of a padded mode) are
+ * held back, so messages of any size take constant memory. update()
+ * outputs, then finish()'s output, then the tag reproduce exactly what
+ * encrypt() writes for the same key and nonce.
+ *
+ * Decrypted bytes returned by update() are not authenticated until
+ * finish() has verified the tag; callers must discard them if it fails.
+ */
+class ICipherSession {
+public:
+    virtual ~ICipherSession() = default;
+
+    /**
+     * @brief Nonce/IV of this message (generated if begin was given none)
+     */
+    virtual const std::vector<uint8_t>& nonce() const = 0;
+
+    /**
+     * @brief Tag bytes finish() writes or verifies (16 for AEAD, 0 otherwise)
+     */
+    virtual size_t tag_size() const = 0;
+
+    /**
+     * @brief Output space update() or finish() may need after @p input more bytes
+     */
+    virtual size_t output_bound(size_t input) const = 0;
+
+    /**
+     * @brief Process @p in, writing every byte that is ready to @p out
+     *
+     * @p out must not overlap @p in and should hold output_bound(in.size())
+     * bytes.
+     *
+     * @return Bytes written to @p out
+     */
+    virtual Result<size_t> update(std::span<const uint8_t> in, std::span<uint8_t> out) = 0;
+
+    /**
+     * @brief Flush the held-back bytes and end the message
+     *
+     * Encryption writes the tag into @p tag; decryption verifies @p tag.
+     * Either way @p tag must be exactly tag_size() bytes.
+     *
+     * @return Bytes written to @p out
+     */
+    virtual Result<size_t> finish(std::span<uint8_t> out, std::span<uint8_t> tag) = 0;
+};
+
 /**
  * @brief Interface for cryptographic algorithms
  */
@@ -61,6 +235,155 @@ class ICryptoAlgorithm {
      * @brief Check if algorithm is suitable for security level
      */
     virtual bool is_suitable_for(SecurityLevel level) const = 0;
+
+    /**
+     * @brief Bind @p key once for repeated encrypt/decrypt calls
+     *
+     * AEAD ciphers override this to key their cipher objects once. The
+     * default keeps a copy of the key and forwards to encrypt()/decrypt(),
+     * so it is no faster but works for every algorithm. The context must
+     * not outlive this algorithm.
+     */
+    virtual std::unique_ptr<ICipherContext> make_context(std::span<const uint8_t> key);
+
+    /**
+     * @brief Encrypt into caller-owned buffers without intermediate copies
+     *
+     * @p out may be exactly @p plaintext's memory (in-place) or a separate
+     * buffer such as a mapped output file. The nonce must be given in
+     * @p config; algorithms that would pick their own IV instead fail.
+     * @p tag_out must be the algorithm's tag size: 16 bytes for AEAD
+     * ciphers, empty otherwise.
+     *
+     * Keyed AEAD ciphers run in place over @p out; other algorithms go
+     * through encrypt() and copy its output.
+     *
+     * @return Bytes written to @p out (the ciphertext length)
+     */
+    virtual Result<size_t> encrypt_into(
+        std::span<const uint8_t> plaintext,
+        std::span<uint8_t> out,
+        std::span<uint8_t> tag_out,
+        std::span<const uint8_t> key,
+        const EncryptionConfig& config
+    );
+
+    /**
+     * @brief Decrypt into a caller-owned buffer without intermediate copies
+     *
+     * Nonce and tag come from @p config, as for decrypt(). @p out may be
+     * exactly @p ciphertext's memory. If authentication fails the bytes
+     * written to @p out are wiped.
+     *
+     * @return Bytes written to @p out (the plaintext length)
+     */
+    virtual Result<size_t> decrypt_into(
+        std::span<const uint8_t> ciphertext,
+        std::span<uint8_t> out,
+        std::span<const uint8_t> key,
+        const EncryptionConfig& config
+    );
+
+    /**
+     * @brief Encrypt many small messages under one keyed context
+     *
+     * The arena is sized once for the whole batch and each message is
+     * encrypted in place into it, so with an AEAD context the loop makes
+     * no per-message heap allocation and returns no CryptoResult. Message
+     * i uses BatchArena::nonce_for(nonce_base, i); no associated data is
+     * bound. The cipher must preserve length (AEAD or stream modes). On
+     * failure the arena is left empty.
+     *
+     * @return Number of messages encrypted
+     */
+    virtual Result<size_t> encrypt_batch(
+        std::span<const std::span<const uint8_t>> inputs,
+        std::span<const uint8_t> key,
+        std::span<const uint8_t> nonce_base,
+        BatchArena& output
+    );
+
+    /**
+     * @brief Start encrypting one message incrementally
+     *
+     * @param nonce Nonce/IV to use, or empty to generate one (see ICipherSession::nonce())
+     * @param associated_data Authenticated but not encrypted; AEAD algorithms only
+     *
+     * Implemented by GCM, ChaCha20-Poly1305, CTR, CBC, CFB, OFB and XTS; the
+     * default reports that the algorithm only works on whole messages.
+     */
+    virtual Result<std::unique_ptr<ICipherSession>> begin_encryption(
+        std::span<const uint8_t> key,
+        std::span<const uint8_t> nonce,
+        std::span<const uint8_t> associated_data = {}
+    );
+
+    /**
+     * @brief Start decrypting one message incrementally (the tag goes to finish())
+     */
+    virtual Result<std::unique_ptr<ICipherSession>> begin_decryption(
+        std::span<const uint8_t> key,
+        std::span<const uint8_t> nonce,
+        std::span<const uint8_t> associated_data = {}
+    );
+};
+
+/**
+ * @brief Pool of keyed contexts shared by pipeline workers
+ *
+ * Workers lease a context per chunk and return it when the lease ends, so
+ * no more contexts than concurrent workers are created and each keeps its
+ * key schedule for the whole run (same scheme as CompressorPool).
+ */
+class CipherContextPool {
+public:
+    /**
+     * @brief Exclusive use of one pooled context
+     */
+    class Lease {
+    public:
+        Lease(CipherContextPool& pool, std::unique_ptr<ICipherContext> context)
+            : pool_(pool), context_(std::move(context)) {}
+        ~Lease() { pool_.release(std::move(context_)); }
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        ICipherContext* operator->() const { return context_.get(); }
+
+    private:
+        CipherContextPool& pool_;
+        std::unique_ptr<ICipherContext> context_;
+    };
+
+    /**
+     * @param algorithm Algorithm creating the contexts; must outlive the pool
+     * @param key Key copied into the pool and scrubbed on destruction
+     */
+    CipherContextPool(ICryptoAlgorithm& algorithm, std::span<const uint8_t> key);
+    ~CipherContextPool();
+
+    CipherContextPool(const CipherContextPool&) = delete;
+    CipherContextPool& operator=(const CipherContextPool&) = delete;
+
+    /**
+     * @brief Take an idle context, creating one if none is free
+     */
+    Lease acquire();
+
+    /**
+     * @brief Contexts created so far (at most the peak number of concurrent leases)
+     */
+    size_t created() const;
+
+private:
+    void release(std::unique_ptr<ICipherContext> context);
+
+    ICryptoAlgorithm& algorithm_;
+    std::vector<uint8_t> key_;
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<ICipherContext>> idle_;
+    size_t created_ = 0;
 };
 
 } // namespace core
@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <map>
+#include <mutex>
 #include <optional>
 #include "crypto_algorithm.hpp"
 #include "types.hpp"
@@ -14,6 +15,9 @@ namespace core {
 /**
  * @brief Main cryptographic engine
  * Manages algorithms and provides key derivation
+ *
+ * Names, aliases and key sizes come from ALGORITHM_TABLE; an algorithm
+ * object is only built the first time get_algorithm() asks for it.
  */
 class CryptoEngine {
 public:
@@ -26,6 +30,8 @@ class CryptoEngine {
     
     /**
      * @brief Initialize engine with default algorithms
+     *
+     * Cheap: the built-in algorithms are created lazily by get_algorithm().
      */
     void initialize();
     
@@ -35,7 +41,8 @@ class CryptoEngine {
     void register_algorithm(std::unique_ptr<ICryptoAlgorithm> algorithm);
     
     /**
-     * @brief Get algorithm by type
+     * @brief Get algorithm by type, constructing it on first use (thread-safe)
+     * @return nullptr if the type has no file-encryption implementation
      */
     ICryptoAlgorithm* get_algorithm(AlgorithmType type);
     
@@ -94,6 +101,7 @@ class CryptoEngine {
     static std::optional<SecurityLevel> parse_security_level(const std::string& name);
 
 private:
+    std::mutex mutex_;  ///< Guards algorithms_
     std::map<AlgorithmType, std::unique_ptr<ICryptoAlgorithm>> algorithms_;
 };
 
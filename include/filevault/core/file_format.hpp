@@ -96,7 +96,13 @@ enum class AlgorithmID : uint8_t {
     // Asymmetric (ECC)
     ECC_P256 = 0x60,
     ECC_P384 = 0x61,
-    ECC_P521 = 0x62
+    ECC_P521 = 0x62,
+    // High-throughput AEAD
+    AEGIS_128L = 0x70,
+    AEGIS_256 = 0x71,
+    AES_128_OCB = 0x72,
+    AES_192_OCB = 0x73,
+    AES_256_OCB = 0x74
 };
 
 /**
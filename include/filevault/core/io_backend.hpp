@@ -0,0 +1,239 @@
+#ifndef FILEVAULT_CORE_IO_BACKEND_HPP
+#define FILEVAULT_CORE_IO_BACKEND_HPP
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include "result.hpp"
+
+namespace filevault {
+namespace core {
+
+/**
+ * @brief File I/O backend implementations
+ */
+enum class IOBackendType : uint8_t {
+    SYNC,   // Blocking reads/writes (POSIX file descriptors on Linux, iostreams elsewhere)
+    URING   // Linux io_uring with a queue of reads/writes in flight
+};
+
+/**
+ * @brief Page-cache policy for data that has been read or written
+ */
+enum class CachePolicy : uint8_t {
+    KEEP,   // Leave cached pages to the kernel
+    DROP    // Use-once data: POSIX_FADV_DONTNEED behind the cursor
+};
+
+/**
+ * @brief Options for opening a sequential reader or writer
+ */
+struct IOOptions {
+    IOBackendType backend = IOBackendType::SYNC;
+    size_t block_size = 1024 * 1024;   // Size of each queued read/write
+    size_t queue_depth = 8;            // Requests kept in flight (io_uring only)
+    bool direct = false;               // O_DIRECT: bypass the page cache (Linux only)
+    CachePolicy cache = CachePolicy::KEEP;
+    // Readers: start reading at this offset (size() still reports the whole file)
+    uint64_t read_offset = 0;
+    // Writers: reopen an existing file, discard everything after this offset
+    // and continue writing there (resume). Unset creates or truncates the file.
+    std::optional<uint64_t> write_offset;
+};
+
+/**
+ * @brief Sequential file reader
+ */
+class ISequentialReader {
+public:
+    virtual ~ISequentialReader() = default;
+
+    /**
+     * @brief Read up to @p length bytes
+     * @return Bytes read; fewer than requested only at end of file
+     * @throws std::runtime_error on I/O errors
+     */
+    virtual size_t read(uint8_t* dst, size_t length) = 0;
+
+    /**
+     * @brief File size at open time
+     */
+    virtual uint64_t size() const = 0;
+};
+
+/**
+ * @brief Sequential file writer
+ */
+class ISequentialWriter {
+public:
+    virtual ~ISequentialWriter() = default;
+
+    /**
+     * @brief Append @p length bytes (may be queued)
+     * @throws std::runtime_error on I/O errors
+     */
+    virtual void write(const uint8_t* src, size_t length) = 0;
+
+    /**
+     * @brief Wait until all queued writes have reached the file
+     * @throws std::runtime_error on I/O errors
+     */
+    virtual void flush() = 0;
+
+    /**
+     * @brief flush() and wait until the data is on stable storage (fdatasync)
+     * @throws std::runtime_error on I/O errors
+     */
+    virtual void sync() = 0;
+};
+
+/**
+ * @brief Factory and process-wide selection of the I/O backend
+ *
+ * The default backend is SYNC; the CLI's global --io option changes it.
+ * Requesting URING when it is not compiled in (no liburing) or not
+ * permitted by the kernel falls back to SYNC with a warning.
+ *
+ * With IOOptions::direct, files are opened with O_DIRECT and all transfers
+ * use DIRECT_IO_ALIGNMENT-aligned buffers, offsets and lengths. The
+ * unaligned tail of a file is written as a zero-padded block and the file
+ * is then truncated to its real length. Filesystems without O_DIRECT
+ * support (tmpfs, non-Linux) fall back to buffered I/O with a warning.
+ */
+class IOBackend {
+public:
+    /// Buffer, offset and length alignment used for O_DIRECT transfers
+    static constexpr size_t DIRECT_IO_ALIGNMENT = 4096;
+
+
+    static Result<std::unique_ptr<ISequentialReader>> open_reader(
+        const std::string& path, const IOOptions& options = {});
+
+    static Result<std::unique_ptr<ISequentialWriter>> open_writer(
+        const std::string& path, const IOOptions& options = {});
+
+    /**
+     * @brief Whether @p type can be used on this build and kernel
+     */
+    static bool is_available(IOBackendType type);
+
+    static IOBackendType default_backend();
+    static void set_default_backend(IOBackendType type);
+
+    /**
+     * @brief Process-wide O_DIRECT default (the CLI's global --direct-io flag)
+     */
+    static bool default_direct();
+    static void set_default_direct(bool direct);
+
+    /**
+     * @brief Whether this platform has O_DIRECT at all
+     */
+    static bool is_direct_supported();
+
+    /**
+     * @brief Process-wide page-cache policy (the CLI's global --cache option)
+     */
+    static CachePolicy default_cache_policy();
+    static void set_default_cache_policy(CachePolicy policy);
+
+    /**
+     * @brief Options with the process-wide backend and cache policy (never O_DIRECT)
+     */
+    static IOOptions default_options();
+
+    static std::string name(IOBackendType type);
+    static std::optional<IOBackendType> parse(const std::string& name);
+
+    static std::string cache_policy_name(CachePolicy policy);
+    static std::optional<CachePolicy> parse_cache_policy(const std::string& name);
+};
+
+/**
+ * @brief std::streambuf reading from an ISequentialReader
+ *
+ * Large reads go straight from the backend into the caller's buffer; the
+ * internal buffer only serves small reads such as peek().
+ */
+class ReaderStreamBuf : public std::streambuf {
+public:
+    explicit ReaderStreamBuf(ISequentialReader& reader, size_t buffer_size = 64 * 1024);
+
+protected:
+    int_type underflow() override;
+    std::streamsize xsgetn(char* s, std::streamsize count) override;
+
+private:
+    ISequentialReader& reader_;
+    std::vector<char> buffer_;
+};
+
+/**
+ * @brief std::streambuf writing to an ISequentialWriter
+ */
+class WriterStreamBuf : public std::streambuf {
+public:
+    explicit WriterStreamBuf(ISequentialWriter& writer, size_t buffer_size = 64 * 1024);
+    ~WriterStreamBuf() override;
+
+protected:
+    int_type overflow(int_type ch) override;
+    std::streamsize xsputn(const char* s, std::streamsize count) override;
+    int sync() override;
+
+private:
+    bool flush_buffer();
+
+    ISequentialWriter& writer_;
+    std::vector<char> buffer_;
+};
+
+namespace detail {
+
+/**
+ * @brief Page-cache hints for one sequentially accessed file descriptor
+ *
+ * Readers get POSIX_FADV_SEQUENTIAL and a WILLNEED hint for the first
+ * window on open. With CachePolicy::DROP, pages are released in
+ * DROP_WINDOW steps behind the cursor: read pages right away, written
+ * pages once writeback of the previous window has finished
+ * (sync_file_range). All calls are no-ops off Linux.
+ */
+class CacheAdvisor {
+public:
+    static constexpr uint64_t DROP_WINDOW = 8 * 1024 * 1024;
+
+    CacheAdvisor() = default;
+    CacheAdvisor(int fd, CachePolicy policy, uint64_t start = 0)
+        : fd_(fd), policy_(policy), dropped_(start), flushed_(start) {}
+
+    void advise_sequential(uint64_t size);
+    void consumed(uint64_t offset);   // Reader: bytes before offset are no longer needed
+    void written(uint64_t offset);    // Writer: bytes before offset have been written
+    void release(bool wrote);         // Drop every cached page (waits for writeback if @p wrote)
+
+private:
+    int fd_ = -1;
+    CachePolicy policy_ = CachePolicy::KEEP;
+    uint64_t dropped_ = 0;    // Pages before this offset were released
+    uint64_t flushed_ = 0;    // Writeback was started for pages before this offset
+};
+
+#ifdef FILEVAULT_HAVE_IO_URING
+// Implemented in io_uring_backend.cpp; return nullptr if io_uring cannot be set up
+std::unique_ptr<ISequentialReader> make_uring_reader(const std::string& path, const IOOptions& options,
+                                                     std::string& error);
+std::unique_ptr<ISequentialWriter> make_uring_writer(const std::string& path, const IOOptions& options,
+                                                     std::string& error);
+bool uring_supported();
+#endif
+
+} // namespace detail
+
+} // namespace core
+} // namespace filevault
+
+#endif // FILEVAULT_CORE_IO_BACKEND_HPP
@@ -0,0 +1,115 @@
+#ifndef FILEVAULT_CORE_MEMORY_BUDGET_HPP
+#define FILEVAULT_CORE_MEMORY_BUDGET_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+namespace filevault {
+namespace core {
+
+/**
+ * @brief Process-wide budget that large allocations reserve from first
+ *
+ * Key derivation (Argon2/scrypt working memory), streaming pipelines (chunk
+ * buffers plus codec state) and other big consumers reserve their peak
+ * before allocating and release it when done. When the budget is exhausted
+ * a reservation waits for others to be released, and reserve_units() hands
+ * out fewer units (pipelines then run fewer chunks in flight), so
+ * concurrent work queues up instead of exceeding the process limit.
+ *
+ * A request larger than the whole limit is granted once nothing else is
+ * reserved, so it is serialised rather than refused. To avoid deadlock a
+ * thread must not wait for a reservation while holding one: work done under
+ * a reservation (e.g. a pipeline's workers) is covered by it.
+ */
+class MemoryBudget {
+public:
+    /**
+     * @brief Reserved bytes, returned to the budget on destruction
+     */
+    class Reservation {
+    public:
+        Reservation() = default;
+        ~Reservation() { release(); }
+
+        Reservation(Reservation&& other) noexcept;
+        Reservation& operator=(Reservation&& other) noexcept;
+        Reservation(const Reservation&) = delete;
+        Reservation& operator=(const Reservation&) = delete;
+
+        uint64_t bytes() const { return bytes_; }
+
+        /**
+         * @brief Return the bytes early
+         */
+        void release();
+
+    private:
+        friend class MemoryBudget;
+        Reservation(MemoryBudget* budget, uint64_t bytes) : budget_(budget), bytes_(bytes) {}
+
+        MemoryBudget* budget_ = nullptr;
+        uint64_t bytes_ = 0;
+    };
+
+    /**
+     * @param limit Budget in bytes (0 = default_limit())
+     */
+    explicit MemoryBudget(uint64_t limit = 0);
+
+    MemoryBudget(const MemoryBudget&) = delete;
+    MemoryBudget& operator=(const MemoryBudget&) = delete;
+
+    /**
+     * @brief The budget shared by the whole process (--max-memory)
+     */
+    static MemoryBudget& global();
+
+    /**
+     * @brief Three quarters of the cgroup memory limit, or of physical memory without one
+     */
+    static uint64_t default_limit();
+
+    /**
+     * @brief Change the limit (0 = default_limit()); waiting reservations are re-evaluated
+     */
+    void set_limit(uint64_t limit);
+
+    uint64_t limit() const;
+    uint64_t reserved() const;
+
+    /**
+     * @brief Reserve @p bytes, waiting until they fit
+     */
+    Reservation reserve(uint64_t bytes);
+
+    /**
+     * @brief Reserve @p bytes only if they fit now
+     */
+    std::optional<Reservation> try_reserve(uint64_t bytes);
+
+    /**
+     * @brief Reserve between @p min_units and @p max_units units of @p unit bytes
+     *
+     * Takes as many units as fit now, waiting only until @p min_units fit.
+     * The number granted is bytes() / unit.
+     */
+    Reservation reserve_units(uint64_t unit, size_t min_units, size_t max_units);
+
+private:
+    bool fits(uint64_t bytes) const;
+    void release(uint64_t bytes);
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    uint64_t limit_;
+    uint64_t reserved_ = 0;
+};
+
+} // namespace core
+} // namespace filevault
+
+#endif // FILEVAULT_CORE_MEMORY_BUDGET_HPP
@@ -2,7 +2,9 @@
 #define FILEVAULT_CORE_MODES_HPP
 
 #include "filevault/core/types.hpp"
+#include "filevault/core/cpu_features.hpp"
 #include <string>
+#include <vector>
 
 namespace filevault {
 namespace core {
@@ -37,8 +39,13 @@ struct ModePreset {
     
     /**
      * @brief Get preset by mode
+     *
+     * The algorithm is the `auto` choice for this CPU: the fastest AEAD in
+     * @p measured (the saved benchmark figures `encrypt -a auto` uses) if
+     * there is one, else AES-256-GCM with AES instructions and
+     * ChaCha20-Poly1305 without.
      */
-    static ModePreset get_preset(UserMode mode);
+    static ModePreset get_preset(UserMode mode, const std::vector<AeadThroughput>& measured = {});
     
     /**
      * @brief Parse mode from string
@@ -46,9 +53,9 @@ struct ModePreset {
     static UserMode parse_mode(const std::string& name);
     
     /**
-     * @brief Get all available presets
+     * @brief Get all available presets (algorithms chosen as in get_preset())
      */
-    static std::vector<ModePreset> get_all_presets();
+    static std::vector<ModePreset> get_all_presets(const std::vector<AeadThroughput>& measured = {});
 };
 
 // Predefined presets
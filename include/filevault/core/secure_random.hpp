@@ -0,0 +1,49 @@
+#ifndef FILEVAULT_CORE_SECURE_RANDOM_HPP
+#define FILEVAULT_CORE_SECURE_RANDOM_HPP
+
+#include <botan/rng.h>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace filevault {
+namespace core {
+
+/**
+ * @brief Per-thread DRBG for salts, nonces, IVs, tweaks and key generation
+ *
+ * Each thread owns an HMAC_DRBG(SHA-512) that is seeded from the system RNG
+ * on first use and reseeded from it every RESEED_INTERVAL requests. A forked
+ * child reseeds before its first request (the DRBG compares the process id
+ * on every call), so parent and child never share an output stream.
+ *
+ * Botan::AutoSeeded_RNG is the same construction, but built and seeded from
+ * the OS on every call; drawing a 12-byte nonce that way costs more than
+ * encrypting a small message.
+ */
+class SecureRandom {
+public:
+    /// Requests served between reseeds from the system RNG
+    static constexpr size_t RESEED_INTERVAL = 1024;
+
+    /**
+     * @brief The calling thread's generator, for APIs taking a RandomNumberGenerator&
+     */
+    static Botan::RandomNumberGenerator& thread_rng();
+
+    /**
+     * @brief Fill @p out with random bytes
+     */
+    static void randomize(std::span<uint8_t> out);
+
+    /**
+     * @brief @p length random bytes
+     */
+    static std::vector<uint8_t> bytes(size_t length);
+};
+
+} // namespace core
+} // namespace filevault
+
+#endif // FILEVAULT_CORE_SECURE_RANDOM_HPP
@@ -1,13 +1,21 @@
 #ifndef FILEVAULT_CORE_STREAMING_HPP
 #define FILEVAULT_CORE_STREAMING_HPP
 
+#include <array>
 #include <cstdint>
 #include <vector>
 #include <string>
 #include <functional>
+#include <initializer_list>
 #include <fstream>
+#include <istream>
+#include <ostream>
+#include <map>
+#include <optional>
+#include <span>
 #include "types.hpp"
 #include "result.hpp"
+#include "io_backend.hpp"
 
 namespace filevault {
 namespace core {
@@ -40,7 +48,77 @@ struct StreamingConfig {
     SecurityLevel level = SecurityLevel::STRONG;
     CompressionType compression = CompressionType::NONE;
     int compression_level = 6;
+    // Store chunks whose sampled entropy says they will not compress (JPEG, archives)
+    bool skip_incompressible = true;
     StreamProgressCallback progress_callback = nullptr;
+    
+    // Worker threads for chunk compression/encryption (0 = one per usable CPU).
+    size_t threads = 1;
+    
+    // Upper bound on chunk buffers held by the pipeline at once (0 = no byte limit).
+    // At least two chunks are always in flight so reads and writes can overlap.
+    size_t max_in_flight_bytes = 512 * 1024 * 1024;
+    
+    // Backend for encrypt_file/decrypt_file file I/O (defaults to the --io selection).
+    IOBackendType io_backend = IOBackend::default_backend();
+    
+    // Open files with O_DIRECT (defaults to --direct-io). Encryption then writes
+    // the aligned record layout (FLAG_ALIGNED) so every record starts on a
+    // RECORD_ALIGNMENT boundary.
+    bool direct_io = IOBackend::default_direct();
+    
+    // Page-cache policy for encrypt_file/decrypt_file (defaults to --cache). DROP
+    // releases input pages once a chunk has been read and output pages once written back.
+    CachePolicy cache_policy = IOBackend::default_cache_policy();
+    
+    // encrypt_file: every N chunks, make the output durable (fdatasync) and record
+    // the progress in a journal next to it (checkpoint_path), so an interrupted
+    // run can continue with resume_encrypt_file (0 = no journal).
+    size_t checkpoint_interval = 0;
+    
+    // Store a keyed digest of every chunk's plaintext in the footer
+    // (FLAG_CHUNK_DIGESTS), so update_file can skip unchanged chunks.
+    bool chunk_digests = false;
+    
+    // Cut chunks where a keyed rolling hash of the content says so
+    // (FLAG_CONTENT_DEFINED) instead of every chunk_size bytes; chunk_size is
+    // then the maximum (see ContentChunker::for_stream). An insertion only
+    // changes the chunks around it, so update_file can still copy the rest.
+    bool content_defined_chunks = false;
+};
+
+/**
+ * @brief Location of one chunk record in an FVST file
+ */
+struct ChunkIndexEntry {
+    uint64_t offset = 0;        // File offset of the record's size field
+    uint32_t plain_size = 0;    // Plaintext bytes in this chunk
+    std::array<uint8_t, 16> digest{};  // Keyed plaintext digest (FLAG_CHUNK_DIGESTS)
+};
+
+/**
+ * @brief Chunks from first_chunk on are encrypted under base_nonce
+ * 
+ * Every append to an FVST stream starts a segment with a fresh base nonce;
+ * chunks before the first listed segment use the header's nonce. From format
+ * version 3 on base_nonce is the segment's id, from which the nonce is derived
+ * with the stream key.
+ */
+struct StreamSegment {
+    uint64_t first_chunk = 0;
+    std::vector<uint8_t> base_nonce;
+    uint64_t first_index = 0;       // Nonce index of first_chunk (records moved by update_file keep theirs)
+    std::array<uint8_t, 16> tag{};  // Version 3: MAC of the segment, chained to the previous tag
+};
+
+/**
+ * @brief Progress recorded in a checkpoint journal
+ */
+struct StreamCheckpoint {
+    uint64_t next_chunk = 0;        // Chunks [0, next_chunk) are on stable storage
+    uint64_t record_offset = 0;     // Output offset just past the last durable record
+    uint64_t input_offset = 0;      // Plaintext bytes consumed by those chunks
+    std::array<uint8_t, 16> kept_digest{};  // FLAG_CHUNK_DIGESTS: chained digest of those chunks
 };
 
 /**
@@ -51,6 +129,9 @@ struct StreamingResult {
     std::string error_message;
     size_t bytes_processed = 0;
     size_t chunks_processed = 0;
+    size_t chunks_unchanged = 0;    // update_file: records copied without re-encryption
+    std::optional<size_t> bad_chunk; // verify_file: first chunk that failed authentication
+    uint64_t bad_offset = 0;        // verify_file: file offset of that chunk's record
     double processing_time_ms = 0.0;
     double throughput_mbps = 0.0;
 };
@@ -66,10 +147,98 @@ struct StreamingResult {
  * [Header][Chunk1][Chunk2]...[ChunkN][Footer]
  * 
  * Each chunk:
- * [4 bytes: chunk_size][12 bytes: nonce][encrypted_data][16 bytes: tag]
+ * [4 bytes: chunk_size | last-chunk bit | compressed bit][encrypted_data][16 bytes: tag]
+ * 
+ * With FLAG_CHUNK_COMPRESSION each record says whether its payload was
+ * compressed (RECORD_COMPRESSED); chunks that would not shrink, or that the
+ * entropy probe rejects, are stored as-is. The bit is bound to the chunk
+ * nonce, so flipping it fails authentication.
+ * 
+ * append_file() adds data without re-encrypting earlier chunks: it decrypts
+ * only the final record and re-encrypts its plaintext, followed by the new
+ * data, in a new segment. The segment starts with a marker record
+ * [4 bytes: RECORD_SEGMENT][segment id][8 bytes: first nonce index][16 bytes: tag]
+ * carrying a fresh random id, so no (nonce, chunk index) pair is ever used for
+ * two different plaintexts; chunk indices continue across segments. Such
+ * streams set FLAG_SEGMENTS.
+ * 
+ * update_file() rewrites a stream from a new version of its plaintext.
+ * With FLAG_CHUNK_DIGESTS the footer holds a keyed digest of each chunk;
+ * chunks whose digest is unchanged are copied as ciphertext, the others are
+ * re-encrypted in segments under an id that is fresh for the update.
+ * 
+ * With FLAG_CONTENT_DEFINED chunk boundaries come from a keyed Gear rolling
+ * hash (ContentChunker) and chunks vary in length up to chunk_size; the
+ * header's chunk count is 0 and the footer records every chunk's length.
+ * Digests of such streams do not bind the chunk index, so update_file finds
+ * chunks that moved and copies their records under a segment whose first
+ * nonce index reproduces the nonce they were encrypted with.
+ * 
+ * Records and segments are bound to their stream (format version 3, see
+ * RecordBinding): segment base nonces are derived from the stream key and the
+ * segment id, every marker carries a MAC chained to the marker before it, and
+ * records carry the header fields, segment id and nonce index as associated
+ * data. Moving, repeating or dropping records or markers, or editing the
+ * header, fails authentication. Version 2 streams remain readable; appends
+ * and checkpoint resumes refuse them, update_file re-encrypts them in full.
+ * 
+ * With FLAG_ALIGNED the header and every record are zero-padded to the
+ * next RECORD_ALIGNMENT boundary, so records (and the footer) start on
+ * 4 KiB boundaries and can be read with O_DIRECT without straddling blocks.
+ * 
+ * The final chunk carries RECORD_LAST_CHUNK in its size field and is
+ * encrypted under a distinct nonce, so truncation is detected even when
+ * the total length was unknown when the header was written (pipes). Its
+ * segment id is derived from the last segment tag, so it also authenticates
+ * the segment table as a whole.
+ * 
+ * Footer (present when the header has the index flag set):
+ * N x [8 bytes: record offset][4 bytes: plaintext size]
+ * (FLAG_CHUNK_DIGESTS only) N x [16 bytes: digest]
+ * (FLAG_SEGMENTS only) M x [4 bytes: first chunk][segment id][8 bytes: first nonce index][16 bytes: tag]
+ * [4 bytes: M] (version 2 entries: [4 bytes: first chunk][base nonce])
+ * [8 bytes: index offset][4 bytes: N]["FVIX"]
+ * The footer lets StreamingReader seek straight to the chunks covering
+ * a byte range instead of walking every record from the start.
+ * 
+ * Chunks flow through a bounded read -> transform -> write pipeline
+ * (see ChunkPipeline): the calling thread reads, a worker pool
+ * (StreamingConfig::threads) compresses/encrypts, and a writer thread
+ * writes finished chunks strictly in index order. Chunk buffers come from
+ * a fixed ring sized by StreamingConfig::max_in_flight_bytes, so memory use
+ * does not grow with the file size. Progress callbacks run on the writer thread.
  */
 class StreamingCrypto {
 public:
+    /// Header flag: the file ends with a chunk index footer
+    static constexpr uint8_t FLAG_CHUNK_INDEX = 0x01;
+    /// Header flag: the final record is marked with RECORD_LAST_CHUNK
+    static constexpr uint8_t FLAG_END_MARKER = 0x02;
+    /// Header flag: total size and chunk count were unknown when written
+    static constexpr uint8_t FLAG_SIZE_UNKNOWN = 0x04;
+    /// Header flag: header and records are padded to RECORD_ALIGNMENT
+    static constexpr uint8_t FLAG_ALIGNED = 0x08;
+    /// Record alignment used by FLAG_ALIGNED (matches O_DIRECT block alignment)
+    static constexpr size_t RECORD_ALIGNMENT = IOBackend::DIRECT_IO_ALIGNMENT;
+    /// Header flag: records carry RECORD_COMPRESSED
+    static constexpr uint8_t FLAG_CHUNK_COMPRESSION = 0x10;
+    /// Header flag: appended segments with their own base nonces follow the first one
+    static constexpr uint8_t FLAG_SEGMENTS = 0x20;
+    /// Header flag: the footer carries a keyed plaintext digest per chunk
+    static constexpr uint8_t FLAG_CHUNK_DIGESTS = 0x40;
+    /// Header flag: chunk boundaries are content-defined, chunk lengths vary
+    static constexpr uint8_t FLAG_CONTENT_DEFINED = 0x80;
+    /// Size field of a segment marker record (never a valid record size)
+    static constexpr uint32_t RECORD_SEGMENT = 0xFFFFFFFFu;
+    /// Record size bit marking the final chunk of the stream
+    static constexpr uint32_t RECORD_LAST_CHUNK = 0x80000000u;
+    /// Record size bit marking a compressed payload (FLAG_CHUNK_COMPRESSION)
+    static constexpr uint32_t RECORD_COMPRESSED = 0x40000000u;
+    /// Largest supported chunk size (record sizes must stay below RECORD_COMPRESSED)
+    static constexpr size_t MAX_CHUNK_SIZE = RECORD_COMPRESSED - 1;
+    /// Most chunks in one stream (the header and footer store 4-byte chunk counts)
+    static constexpr uint64_t MAX_CHUNKS = UINT32_MAX;
+    
     /**
      * @brief Encrypt a large file using streaming
      * @param input_path Path to input file
@@ -85,6 +254,150 @@ class StreamingCrypto {
         const StreamingConfig& config = {}
     );
     
+    /**
+     * @brief Continue an interrupted checkpointed encrypt_file run
+     * 
+     * Reads the journal at checkpoint_path(@p output_path) and the partial
+     * output's header, checks that the input still has the size in the
+     * header and that the last durable chunk authenticates under
+     * @p password, then discards everything after that chunk and encrypts
+     * the rest of the input in a new segment, so a changed input never
+     * reuses a nonce. With chunk digests the kept chunks of the input must
+     * still match the journal. Format parameters come from the output header;
+     * only runtime options are taken from @p options. The journal is removed
+     * once the output is complete.
+     * 
+     * @param input_path Path to the same input file
+     * @param output_path Path to the partial output
+     * @param password Encryption password used for the interrupted run
+     * @param options Runtime options
+     * @return Result of the operation (bytes and chunks of this run only)
+     */
+    static StreamingResult resume_encrypt_file(
+        const std::string& input_path,
+        const std::string& output_path,
+        const std::string& password,
+        const StreamingConfig& options = {}
+    );
+    
+    /**
+     * @brief Checkpoint journal path for an output file
+     */
+    static std::string checkpoint_path(const std::string& output_path);
+    
+    /**
+     * @brief Append a file to an existing FVST stream
+     * 
+     * Re-derives the key from the stored salt and authenticates the final
+     * record; earlier chunks are neither read nor re-encrypted. The final
+     * chunk's plaintext and @p input_path are encrypted as a new segment
+     * continuing the chunk counter, then the index footer is rewritten and
+     * the header's size and chunk count are updated in place. Cost grows
+     * with the new data, not with the size of the stream.
+     * 
+     * The overwritten tail is saved to an undo journal (append_journal_path)
+     * first; an interrupted append is rolled back by the next append_file.
+     * 
+     * @param input_path Data to append
+     * @param stream_path Existing FVST file (written with a chunk index and end markers)
+     * @param password Password of the stream
+     * @param options Runtime options (format parameters come from the stream header)
+     * @return Result of the operation (bytes and chunks written by this call)
+     */
+    static StreamingResult append_file(
+        const std::string& input_path,
+        const std::string& stream_path,
+        const std::string& password,
+        const StreamingConfig& options = {}
+    );
+    
+    /**
+     * @brief Re-encrypt an FVST stream from a changed plaintext
+     * 
+     * Compares every chunk of @p input_path with the keyed digests stored in
+     * the stream's footer. Unchanged chunks are copied as ciphertext; changed
+     * (or added) chunks are compressed and encrypted under a base nonce that
+     * is fresh for this update. The new stream is written next to the old one
+     * and renamed over it once durable. Streams without digests are
+     * re-encrypted in full (and gain digests, so the next update is cheap).
+     * 
+     * @param input_path New version of the plaintext
+     * @param stream_path Existing FVST file
+     * @param password Password of the stream
+     * @param options Runtime options (format parameters come from the stream header)
+     * @return Result; chunks_unchanged counts the copied records
+     */
+    static StreamingResult update_file(
+        const std::string& input_path,
+        const std::string& stream_path,
+        const std::string& password,
+        const StreamingConfig& options = {}
+    );
+    
+    /**
+     * @brief Undo journal path used by append_file
+     */
+    static std::string append_journal_path(const std::string& stream_path);
+    
+    /**
+     * @brief Encrypt a stream of unknown length (e.g. stdin)
+     * 
+     * Memory use is bounded by the pipeline regardless of input length.
+     * The output only needs to support sequential writes.
+     * 
+     * @param input Plaintext source, read until end of stream
+     * @param output Destination for the FVST stream
+     * @param password Encryption password
+     * @param config Streaming configuration
+     * @return Result of the operation
+     */
+    static StreamingResult encrypt_stream(
+        std::istream& input,
+        std::ostream& output,
+        const std::string& password,
+        const StreamingConfig& config = {}
+    );
+    
+    /**
+     * @brief Decrypt an FVST stream to an output stream (e.g. stdout)
+     * 
+     * Reads the input sequentially, so it works on pipes; memory use is
+     * bounded by the pipeline. Only runtime options are taken from @p options.
+     * 
+     * @param input Encrypted FVST source
+     * @param output Destination for plaintext
+     * @param password Decryption password
+     * @param options Runtime options
+     * @return Result of the operation
+     */
+    static StreamingResult decrypt_stream(
+        std::istream& input,
+        std::ostream& output,
+        const std::string& password,
+        const StreamingConfig& options = {}
+    );
+    
+    /**
+     * @brief Authenticate every chunk of an FVST file without producing plaintext
+     * 
+     * Derives the key once and checks all record tags on the worker pool;
+     * payloads are neither decompressed nor written anywhere. On failure
+     * bad_chunk and bad_offset name the first record that did not
+     * authenticate (or could not be read). bytes_processed counts the
+     * ciphertext that was verified. Only runtime options are taken from
+     * @p options.
+     * 
+     * @param input_path Path to encrypted file
+     * @param password Decryption password
+     * @param options Runtime options
+     * @return Result; success means every record authenticated
+     */
+    static StreamingResult verify_file(
+        const std::string& input_path,
+        const std::string& password,
+        const StreamingConfig& options = {}
+    );
+    
     /**
      * @brief Decrypt a large file using streaming
      * @param input_path Path to encrypted file
@@ -100,6 +413,26 @@ class StreamingCrypto {
         StreamProgressCallback progress_callback = nullptr
     );
     
+    /**
+     * @brief Decrypt a large file using streaming with runtime options
+     * 
+     * Format parameters (algorithm, KDF, chunk size, compression) always come
+     * from the stream header; only runtime options such as `threads`,
+     * `max_in_flight_bytes` and `progress_callback` are taken from @p options.
+     * 
+     * @param input_path Path to encrypted file
+     * @param output_path Path to output file
+     * @param password Decryption password
+     * @param options Runtime options
+     * @return Result of the operation
+     */
+    static StreamingResult decrypt_file(
+        const std::string& input_path,
+        const std::string& output_path,
+        const std::string& password,
+        const StreamingConfig& options
+    );
+    
     /**
      * @brief Check if a file should use streaming (based on size)
      * @param file_path Path to file
@@ -113,41 +446,329 @@ class StreamingCrypto {
     
     /**
      * @brief Get recommended chunk size based on available memory
+     * 
+     * Uses the memory and CPUs this process may use (SystemResources, so
+     * cgroup limits apply) and leaves room for a chunk per worker.
+     * 
      * @return Recommended chunk size in bytes
      */
     static size_t get_recommended_chunk_size();
+    
+    /**
+     * @brief Resolve a configured thread count (0 = usable CPUs, see SystemResources)
+     */
+    static size_t resolve_thread_count(size_t requested);
+    
+    /**
+     * @brief Check whether a file starts with the FVST magic bytes
+     */
+    static bool is_streaming_file(const std::string& file_path);
+    
+    /**
+     * @brief Check whether chunks can be sealed with @p algorithm (AEAD with a 16-byte tag)
+     */
+    static bool supports_algorithm(AlgorithmType algorithm);
 
 private:
+    friend class StreamingReader;
+    
+    /**
+     * @brief Partial output that encrypt_impl continues instead of writing a header
+     */
+    struct ResumeState {
+        std::vector<uint8_t> salt;
+        std::vector<uint8_t> base_nonce;        // Header nonce
+        uint8_t flags = 0;
+        StreamCheckpoint checkpoint;
+        std::vector<ChunkIndexEntry> entries;   // Records kept in the output
+        std::vector<StreamSegment> segments;    // Segments of the kept records
+        std::vector<uint8_t> segment_id;        // This run's chunks start a segment with this id
+        
+        // Record before checkpoint.next_chunk, authenticated before anything is written
+        std::vector<uint8_t> last_data;
+        std::vector<uint8_t> last_tag;
+        bool last_final = false;                // Carries RECORD_LAST_CHUNK
+        bool last_compressed = false;
+        // The record is being replaced: encrypt its plaintext ahead of the input (append)
+        bool carry_last = false;
+        // Input from its start, to recompute the digests of kept chunks (FLAG_CHUNK_DIGESTS);
+        // they must match checkpoint.kept_digest
+        std::istream* kept_input = nullptr;
+    };
+    
+    /**
+     * @brief Previous version of a stream that encrypt_impl copies unchanged chunks from
+     */
+    struct UpdateSource {
+        std::istream* previous = nullptr;
+        std::vector<uint8_t> salt;
+        std::vector<uint8_t> base_nonce;        // Header nonce, kept by the new version
+        uint8_t flags = 0;
+        std::vector<ChunkIndexEntry> entries;   // With digests
+        std::vector<StreamSegment> segments;
+        std::vector<uint8_t> update_segment;    // Segment id of re-encrypted chunks
+        std::map<std::array<uint8_t, 16>, size_t> by_digest;  // Content-defined streams: digest -> chunk
+        
+        // Final record, authenticated before anything is written
+        std::vector<uint8_t> last_data;
+        std::vector<uint8_t> last_tag;
+        bool last_compressed = false;
+    };
+    
+    using CheckpointCallback = std::function<void(const StreamCheckpoint&, const std::vector<uint8_t>& base_nonce)>;
+    
+    /**
+     * @brief Shared encryption path; @p known_size is written to the header when present
+     * @param resume Continue this partial output (input and output are positioned after it)
+     * @param update Previous version whose unchanged records are copied (delta update)
+     * @param on_checkpoint Called on the writer thread every checkpoint_interval chunks,
+     *        after the records have been flushed to the output stream
+     */
+    static StreamingResult encrypt_impl(
+        std::istream& input,
+        std::ostream& output,
+        const std::string& password,
+        const StreamingConfig& config,
+        std::optional<uint64_t> known_size,
+        const ResumeState* resume = nullptr,
+        const CheckpointCallback& on_checkpoint = nullptr,
+        const UpdateSource* update = nullptr
+    );
+    
+    /**
+     * @brief Shared decryption path; with no @p output records are only authenticated
+     */
+    static StreamingResult decrypt_impl(
+        std::istream& input,
+        std::ostream* output,
+        const std::string& password,
+        const StreamingConfig& options
+    );
+    
+    /**
+     * @brief Key for chunk digests or chunk boundaries, derived from the stream key
+     */
+    static std::vector<uint8_t> derive_subkey(const std::vector<uint8_t>& key, const std::string& label);
+    
+    /**
+     * @brief Keyed digest of a chunk
+     * @param index Bound into the digest so equal chunks differ (0 for content-defined
+     *        streams, whose chunks move between versions)
+     */
+    static std::array<uint8_t, 16> chunk_digest(
+        const std::vector<uint8_t>& digest_key,
+        uint64_t index,
+        const std::vector<uint8_t>& plaintext
+    );
+    
+    /**
+     * @brief Restore the tail saved by an interrupted append_file
+     */
+    static Result<void> rollback_append(const std::string& stream_path);
+    
+    /**
+     * @brief Binds records and segment markers to their stream (format version 3)
+     * 
+     * Derived from the stream key: a MAC of the header fields records depend
+     * on, the base nonce of each segment id, and the chained segment tags.
+     * The final record is encrypted under an id derived from the last segment
+     * tag. Older versions use the stored base nonces as they are, without
+     * associated data or tags.
+     */
+    class RecordBinding {
+    public:
+        RecordBinding(
+            uint8_t version,
+            const std::vector<uint8_t>& key,
+            const StreamingConfig& config,
+            uint8_t flags,
+            const std::vector<uint8_t>& salt,
+            const std::vector<uint8_t>& base_nonce
+        );
+        
+        /**
+         * @brief Segment of the chunks before the first marker (the header's nonce)
+         */
+        const StreamSegment& first_segment() const { return first_; }
+        
+        /**
+         * @brief Tag @p segment as the successor of @p previous
+         */
+        void seal(StreamSegment& segment, const StreamSegment& previous) const;
+        
+        /**
+         * @brief Whether @p segment carries the tag seal() gives it after @p previous
+         */
+        bool check(const StreamSegment& segment, const StreamSegment& previous) const;
+        
+        /**
+         * @brief Whether a footer's segment table authenticates as written, in order
+         */
+        bool check(const std::vector<StreamSegment>& segments, size_t chunk_count) const;
+        
+        /**
+         * @brief Segment id of the final record when @p last is the stream's last segment
+         */
+        std::vector<uint8_t> final_id(const StreamSegment& last) const;
+        
+        /**
+         * @brief Set the nonce and associated data of a record
+         */
+        void apply(
+            EncryptionConfig& config,
+            const std::vector<uint8_t>& segment_id,
+            uint64_t nonce_index,
+            bool last,
+            bool compressed
+        ) const;
+        
+        /**
+         * @brief Set the nonce and associated data of chunk @p index of a stream with @p segments
+         */
+        void apply(
+            EncryptionConfig& config,
+            const std::vector<StreamSegment>& segments,
+            uint64_t index,
+            bool last,
+            bool compressed
+        ) const;
+        
+    private:
+        static std::vector<uint8_t> mac(
+            const std::vector<uint8_t>& key,
+            char domain,
+            std::initializer_list<std::span<const uint8_t>> parts
+        );
+        
+        uint8_t version_;
+        std::vector<uint8_t> tag_key_;      // Header binding, segment tags, final ids
+        std::vector<uint8_t> nonce_key_;    // Segment base nonces
+        std::vector<uint8_t> header_;       // MAC of the header fields
+        StreamSegment first_;
+    };
+    
+    /**
+     * @brief Segment that chunk @p index belongs to (@p first before any listed segment)
+     */
+    static const StreamSegment& segment_for(
+        const std::vector<StreamSegment>& segments,
+        const StreamSegment& first,
+        uint64_t index
+    );
+    
+    /**
+     * @brief Bytes of a segment marker or table entry after its 4-byte field
+     */
+    static size_t segment_size(uint8_t version, size_t nonce_size);
+    
+    /**
+     * @brief Write a segment's id, first nonce index and tag (current version)
+     */
+    static void write_segment(std::ostream& file, const StreamSegment& segment);
+    
+    /**
+     * @brief Read what write_segment wrote (version 2: the base nonce only)
+     */
+    static void read_segment(std::istream& file, StreamSegment& segment, uint8_t version, size_t nonce_size);
+    
+    /**
+     * @brief Make a checkpointed output durable and drop its journal once complete
+     */
+    static StreamingResult& finish_checkpointed(
+        StreamingResult& result,
+        ISequentialWriter& writer,
+        const std::string& journal_path
+    );
+    
+    /**
+     * @brief Durably replace the checkpoint journal (temporary file, fdatasync, rename)
+     */
+    static bool write_checkpoint(
+        const std::string& path,
+        const StreamCheckpoint& checkpoint,
+        const std::vector<uint8_t>& base_nonce
+    );
+    
+    /**
+     * @brief Load a checkpoint journal written by write_checkpoint
+     */
+    static bool read_checkpoint(
+        const std::string& path,
+        StreamCheckpoint& checkpoint,
+        std::vector<uint8_t>& base_nonce
+    );
+    
     /**
      * @brief Derive chunk-specific nonce from base nonce and chunk index
+     * @param last_chunk Final chunk of a stream with end markers
+     * @param compressed Record has RECORD_COMPRESSED set
      */
     static std::vector<uint8_t> derive_chunk_nonce(
         const std::vector<uint8_t>& base_nonce,
-        size_t chunk_index
+        size_t chunk_index,
+        bool last_chunk = false,
+        bool compressed = false
     );
     
+    /**
+     * @brief Zero bytes that pad @p offset to the next record boundary
+     */
+    static size_t record_padding(uint64_t offset, uint8_t flags);
+    
     /**
      * @brief Write streaming file header
      */
     static bool write_stream_header(
-        std::ofstream& file,
+        std::ostream& file,
         const StreamingConfig& config,
         const std::vector<uint8_t>& salt,
         const std::vector<uint8_t>& base_nonce,
         size_t total_size,
-        size_t chunk_count
+        size_t chunk_count,
+        uint8_t flags
     );
     
     /**
      * @brief Read streaming file header
      */
     static bool read_stream_header(
-        std::ifstream& file,
+        std::istream& file,
         StreamingConfig& config,
         std::vector<uint8_t>& salt,
         std::vector<uint8_t>& base_nonce,
         size_t& original_size,
-        size_t& chunk_count
+        size_t& chunk_count,
+        uint8_t& flags,
+        uint8_t& version
+    );
+    
+    /**
+     * @brief Append the chunk index footer
+     * @param index_offset Stream offset at which the footer starts
+     * @param segments Segment table, written when @p flags has FLAG_SEGMENTS
+     */
+    static bool write_chunk_index(
+        std::ostream& file,
+        const std::vector<ChunkIndexEntry>& entries,
+        uint64_t index_offset,
+        uint8_t flags = 0,
+        const std::vector<StreamSegment>& segments = {}
+    );
+    
+    /**
+     * @brief Load the chunk index footer (seeks within @p file)
+     * @param chunk_count Expected entry count (0 = not known from the header)
+     * @param version Format version, which sets the layout of the segment table
+     * @param nonce_size Base nonce length, for the segment table of FLAG_SEGMENTS streams
+     */
+    static bool read_chunk_index(
+        std::ifstream& file,
+        size_t chunk_count,
+        std::vector<ChunkIndexEntry>& entries,
+        uint8_t flags = 0,
+        uint8_t version = 0,
+        size_t nonce_size = 0,
+        std::vector<StreamSegment>* segments = nullptr
     );
 };
 
@@ -0,0 +1,129 @@
+#ifndef FILEVAULT_CORE_STREAMING_READER_HPP
+#define FILEVAULT_CORE_STREAMING_READER_HPP
+
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <optional>
+#include <fstream>
+#include "streaming.hpp"
+#include "crypto_engine.hpp"
+#include "types.hpp"
+#include "result.hpp"
+
+namespace filevault {
+namespace core {
+
+/**
+ * @brief Random-access reader for FVST streaming files
+ *
+ * Uses the chunk index footer to locate the records covering a byte range
+ * and decrypts only those chunks. Files written without an index (format
+ * version 1) are indexed by walking the record size fields once on open,
+ * which skips over the data without decrypting it.
+ *
+ * Recently decrypted chunks are kept in a small LRU cache so sequential
+ * small reads do not re-authenticate the same chunk. Opening a version 3
+ * file authenticates its final record, which vouches for the segment table.
+ */
+class StreamingReader {
+public:
+    /**
+     * @param cache_chunks Number of decrypted chunks to keep (at least 1)
+     */
+    explicit StreamingReader(size_t cache_chunks = 4);
+    ~StreamingReader();
+
+    StreamingReader(const StreamingReader&) = delete;
+    StreamingReader& operator=(const StreamingReader&) = delete;
+
+    /**
+     * @brief Open an FVST file and derive its key
+     * @param path Path to encrypted file
+     * @param password Decryption password
+     */
+    Result<void> open(const std::string& path, const std::string& password);
+
+    /**
+     * @brief Close the file and wipe key material and cached plaintext
+     */
+    void close();
+
+    bool is_open() const { return file_.is_open(); }
+
+    /**
+     * @brief Plaintext size of the whole stream
+     */
+    uint64_t size() const { return total_size_; }
+
+    size_t chunk_count() const { return index_.size(); }
+
+    /**
+     * @brief Whether the file carried an index footer (false if built by scanning)
+     */
+    bool has_index_footer() const { return has_footer_; }
+
+    /**
+     * @brief Move the read position (may be at most size())
+     */
+    Result<void> seek(uint64_t offset);
+
+    uint64_t tell() const { return position_; }
+
+    /**
+     * @brief Read up to @p length bytes from the current position
+     *
+     * Returns fewer bytes only at end of stream. Advances the position.
+     */
+    Result<std::vector<uint8_t>> read(size_t length);
+
+    /**
+     * @brief Read up to @p length bytes starting at @p offset
+     */
+    Result<std::vector<uint8_t>> read(uint64_t offset, size_t length);
+
+    size_t cache_hits() const { return cache_hits_; }
+    size_t cache_misses() const { return cache_misses_; }
+
+private:
+    using CacheList = std::list<std::pair<size_t, std::vector<uint8_t>>>;
+
+    Result<void> build_index_by_scan(uint64_t data_start);
+    Result<const std::vector<uint8_t>*> load_chunk(size_t index);
+    Result<std::vector<uint8_t>> decrypt_chunk(size_t index);
+    size_t chunk_for_offset(uint64_t offset) const;
+
+    std::ifstream file_;
+    std::unique_ptr<CryptoEngine> engine_;
+    ICryptoAlgorithm* algorithm_ = nullptr;
+    EncryptionConfig enc_config_;
+    std::unique_ptr<ICipherContext> cipher_;   // Holds the derived key
+    std::optional<StreamingCrypto::RecordBinding> binding_;
+    std::vector<uint8_t> base_nonce_;
+    std::vector<StreamSegment> segments_;  // Appended segments (FLAG_SEGMENTS)
+    CompressionType compression_ = CompressionType::NONE;
+    size_t chunk_size_ = 0;
+
+    std::vector<ChunkIndexEntry> index_;
+    std::vector<uint64_t> plain_offsets_;   // Start of each chunk, plus total size
+    bool has_footer_ = false;
+    bool end_marker_ = false;
+    uint8_t flags_ = 0;
+    uint8_t version_ = 0;
+    uint64_t total_size_ = 0;
+    uint64_t position_ = 0;
+
+    size_t cache_capacity_;
+    CacheList cache_;                       // Most recently used first
+    std::unordered_map<size_t, CacheList::iterator> cache_map_;
+    size_t cache_hits_ = 0;
+    size_t cache_misses_ = 0;
+};
+
+} // namespace core
+} // namespace filevault
+
+#endif // FILEVAULT_CORE_STREAMING_READER_HPP
@@ -0,0 +1,50 @@
+#ifndef FILEVAULT_CORE_SYSTEM_RESOURCES_HPP
+#define FILEVAULT_CORE_SYSTEM_RESOURCES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace filevault {
+namespace core {
+
+/**
+ * @brief CPU and memory this process may actually use
+ *
+ * Host-wide figures (sysinfo, hardware_concurrency) overstate what a
+ * container gets. On Linux the probe also reads the process's cgroup
+ * (v2 memory.max / cpu.max, v1 memory.limit_in_bytes / cpu.cfs_quota_us,
+ * taking the tightest limit on the path to the root) and its CPU affinity
+ * mask, and reports the smaller of host and cgroup values.
+ */
+struct SystemResources {
+    size_t online_cpus = 1;                  // Hardware threads of the host
+    size_t affinity_cpus = 1;                // CPUs in the affinity mask
+    std::optional<double> cpu_quota;         // cgroup CPU quota in CPUs (e.g. 1.5)
+    size_t cpu_count = 1;                    // Usable CPUs: affinity, capped by the quota
+
+    uint64_t total_memory = 0;               // Physical memory of the host
+    std::optional<uint64_t> memory_limit;    // cgroup memory limit
+    uint64_t available_memory = 0;           // Allocatable now: host and cgroup headroom
+
+    std::string cgroup = "none";             // "v2", "v1" or "none"
+
+    /**
+     * @brief Resources of this process, probed once and cached
+     */
+    static const SystemResources& current();
+
+    /**
+     * @brief Probe the cgroup files under @p root (tests pass a fake tree)
+     *
+     * Reads @p root/proc/self/cgroup and the hierarchy under
+     * @p root/sys/fs/cgroup; host figures come from the running system.
+     */
+    static SystemResources probe(const std::string& root = "/");
+};
+
+} // namespace core
+} // namespace filevault
+
+#endif // FILEVAULT_CORE_SYSTEM_RESOURCES_HPP
@@ -98,7 +98,17 @@ enum class AlgorithmType {
     // Hybrid Post-Quantum (Classic + PQC for transition period)
     KYBER_512_HYBRID,   // Kyber-512 + X25519
     KYBER_768_HYBRID,   // Kyber-768 + X25519
-    KYBER_1024_HYBRID   // Kyber-1024 + X25519
+    KYBER_1024_HYBRID,  // Kyber-1024 + X25519
+    
+    // High-throughput AEAD (AES round function, no GHASH). Values are
+    // written into file headers, so new algorithms are only ever appended.
+    AEGIS_128L,
+    AEGIS_256,
+    
+    // AES-OCB3 (RFC 7253): one-pass, fully parallel AEAD
+    AES_128_OCB,
+    AES_192_OCB,
+    AES_256_OCB
 };
 
 /**
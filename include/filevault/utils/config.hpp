@@ -32,6 +32,11 @@ class Config {
      */
     static std::filesystem::path get_config_path();
     
+    /**
+     * @brief Get path of the AEAD benchmark results used by `-a auto`
+     */
+    static std::filesystem::path get_benchmark_cache_path();
+    
     /**
      * @brief Get default config
      */
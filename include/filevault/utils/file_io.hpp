@@ -5,6 +5,7 @@
 #include <vector>
 #include <cstdint>
 #include <span>
+#include <cstdio>
 #include "filevault/core/result.hpp"
 
 namespace filevault {
@@ -34,6 +35,13 @@ class FileIO {
      * @brief Get file size
      */
     static size_t file_size(const std::string& path);
+    
+    /**
+     * @brief Switch a standard stream (stdin/stdout) to binary mode
+     * 
+     * No-op on POSIX; required on Windows so piped data is not translated.
+     */
+    static void set_binary_mode(std::FILE* stream);
 };
 
 } // namespace utils
@@ -4,14 +4,17 @@
  */
 
 #include "filevault/algorithms/asymmetric/ecc.hpp"
-#include <botan/auto_rng.h>
+#include "filevault/algorithms/symmetric/aes_gcm.hpp"
+#include "filevault/core/secure_random.hpp"
 #include <botan/pkcs8.h>
 #include <botan/x509_key.h>
 #include <botan/pubkey.h>
 #include <botan/kdf.h>
 #include <botan/cipher_mode.h>
 #include <botan/hex.h>
+#include <botan/mem_ops.h>
 #include <spdlog/spdlog.h>
+#include <algorithm>
 #include <chrono>
 #include <stdexcept>
 
@@ -40,6 +43,17 @@ static size_t get_curve_key_size(ECCurve curve) {
     }
 }
 
+// AES-256 key for the hybrid scheme: HKDF-SHA256 of the ECDH shared secret
+static std::vector<uint8_t> derive_hybrid_key(const std::vector<uint8_t>& shared_secret) {
+    auto kdf = Botan::KDF::create("HKDF(SHA-256)");
+    std::vector<uint8_t> aes_key(32);  // 256-bit AES key
+    kdf->derive_key(aes_key, 
+                   std::span<const uint8_t>(shared_secret), 
+                   std::span<const uint8_t>(),  // salt
+                   std::span<const uint8_t>());  // label
+    return aes_key;
+}
+
 // ============================================================================
 // ECDH Implementation
 // ============================================================================
@@ -67,7 +81,7 @@ ECCKeyPair ECDH::generate_key_pair() {
     result.curve_name = botan_curve_name_;
     
     try {
-        Botan::AutoSeeded_RNG rng;
+        auto& rng = core::SecureRandom::thread_rng();
         
         if (curve_ == ECCurve::X25519) {
             // X25519 uses different key type - use PrivateKey interface
@@ -101,7 +115,7 @@ ECDHResult ECDH::derive_shared_secret(
     result.success = false;
     
     try {
-        Botan::AutoSeeded_RNG rng;
+        auto& rng = core::SecureRandom::thread_rng();
         
         // Load private key
         auto priv_key = Botan::PKCS8::load_key(
@@ -173,7 +187,7 @@ ECCKeyPair ECDSA::generate_key_pair() {
     result.curve_name = botan_curve_name_;
     
     try {
-        Botan::AutoSeeded_RNG rng;
+        auto& rng = core::SecureRandom::thread_rng();
         Botan::EC_Group group = Botan::EC_Group::from_name(botan_curve_name_);
         Botan::ECDSA_PrivateKey private_key(rng, group);
         
@@ -200,7 +214,7 @@ ECDSASignResult ECDSA::sign(
     result.success = false;
     
     try {
-        Botan::AutoSeeded_RNG rng;
+        auto& rng = core::SecureRandom::thread_rng();
         
         // Load private key
         auto priv_key = Botan::PKCS8::load_key(
@@ -306,7 +320,7 @@ core::CryptoResult ECCHybrid::encrypt(
     core::CryptoResult result;
     
     try {
-        Botan::AutoSeeded_RNG rng;
+        auto& rng = core::SecureRandom::thread_rng();
         
         // Generate ephemeral key pair
         auto ephemeral = ecdh_.generate_key_pair();
@@ -320,12 +334,7 @@ core::CryptoResult ECCHybrid::encrypt(
         }
         
         // Derive AES key from shared secret using HKDF
-        auto kdf = Botan::KDF::create("HKDF(SHA-256)");
-        std::vector<uint8_t> aes_key(32);  // 256-bit AES key
-        kdf->derive_key(aes_key, 
-                       std::span<const uint8_t>(dh_result.shared_secret), 
-                       std::span<const uint8_t>(),  // salt
-                       std::span<const uint8_t>());  // label
+        auto aes_key = derive_hybrid_key(dh_result.shared_secret);
         
         // Generate nonce for AES-GCM
         std::vector<uint8_t> nonce(12);
@@ -429,12 +438,7 @@ core::CryptoResult ECCHybrid::decrypt(
         }
         
         // Derive AES key from shared secret
-        auto kdf = Botan::KDF::create("HKDF(SHA-256)");
-        std::vector<uint8_t> aes_key(32);
-        kdf->derive_key(aes_key, 
-                       std::span<const uint8_t>(dh_result.shared_secret), 
-                       std::span<const uint8_t>(),  // salt
-                       std::span<const uint8_t>());  // label
+        auto aes_key = derive_hybrid_key(dh_result.shared_secret);
         
         // Decrypt with AES-256-GCM
         auto cipher = Botan::Cipher_Mode::create("AES-256/GCM", Botan::Cipher_Dir::Decryption);
@@ -468,6 +472,217 @@ core::CryptoResult ECCHybrid::decrypt(
     return result;
 }
 
+// ----------------------------------------------------------------------------
+// ECCHybrid incremental sessions
+// ----------------------------------------------------------------------------
+
+namespace {
+
+using SessionResult = core::Result<std::unique_ptr<core::ICipherSession>>;
+
+constexpr size_t HYBRID_NONCE_SIZE = 12;
+
+// Emits the ephemeral public key and nonce ahead of the AES-GCM output
+class HybridEncryptSession : public core::ICipherSession {
+public:
+    HybridEncryptSession(std::vector<uint8_t> prefix, std::unique_ptr<core::ICipherSession> aes)
+        : prefix_(std::move(prefix)), aes_(std::move(aes)) {}
+
+    const std::vector<uint8_t>& nonce() const override { return aes_->nonce(); }
+    size_t tag_size() const override { return aes_->tag_size(); }
+
+    size_t output_bound(size_t input) const override {
+        return (prefix_sent_ ? 0 : prefix_.size()) + aes_->output_bound(input);
+    }
+
+    core::Result<size_t> update(std::span<const uint8_t> in, std::span<uint8_t> out) override {
+        auto sent = send_prefix(out);
+        if (!sent) {
+            return sent;
+        }
+        auto written = aes_->update(in, out.subspan(sent.value));
+        if (!written) {
+            return written;
+        }
+        return core::Result<size_t>::ok(sent.value + written.value);
+    }
+
+    core::Result<size_t> finish(std::span<uint8_t> out, std::span<uint8_t> tag) override {
+        auto sent = send_prefix(out);  // An empty message still carries the header
+        if (!sent) {
+            return sent;
+        }
+        auto written = aes_->finish(out.subspan(sent.value), tag);
+        if (!written) {
+            return written;
+        }
+        return core::Result<size_t>::ok(sent.value + written.value);
+    }
+
+private:
+    core::Result<size_t> send_prefix(std::span<uint8_t> out) {
+        if (prefix_sent_) {
+            return core::Result<size_t>::ok(0);
+        }
+        if (out.size() < prefix_.size()) {
+            return core::Result<size_t>::error("Output buffer too small (need " +
+                                               std::to_string(prefix_.size()) + " bytes)");
+        }
+        std::copy(prefix_.begin(), prefix_.end(), out.begin());
+        prefix_sent_ = true;
+        return core::Result<size_t>::ok(prefix_.size());
+    }
+
+    std::vector<uint8_t> prefix_;
+    std::unique_ptr<core::ICipherSession> aes_;
+    bool prefix_sent_ = false;
+};
+
+// Collects the ephemeral public key and nonce, then hands the rest to AES-GCM
+class HybridDecryptSession : public core::ICipherSession {
+public:
+    HybridDecryptSession(ECDH& ecdh, std::span<const uint8_t> private_key,
+                         std::span<const uint8_t> associated_data)
+        : ecdh_(ecdh),
+          private_key_(private_key.begin(), private_key.end()),
+          associated_data_(associated_data.begin(), associated_data.end()) {}
+
+    ~HybridDecryptSession() override {
+        Botan::secure_scrub_memory(private_key_.data(), private_key_.size());
+    }
+
+    const std::vector<uint8_t>& nonce() const override { return nonce_; }
+    size_t tag_size() const override { return 16; }
+
+    size_t output_bound(size_t input) const override {
+        return aes_ ? aes_->output_bound(input) : input;
+    }
+
+    core::Result<size_t> update(std::span<const uint8_t> in, std::span<uint8_t> out) override {
+        if (!aes_) {
+            size_t used = read_header(in);
+            if (!aes_) {
+                if (!error_.empty()) {
+                    return core::Result<size_t>::error(error_);
+                }
+                return core::Result<size_t>::ok(0);
+            }
+            in = in.subspan(used);
+        }
+        return aes_->update(in, out);
+    }
+
+    core::Result<size_t> finish(std::span<uint8_t> out, std::span<uint8_t> tag) override {
+        if (!aes_) {
+            return core::Result<size_t>::error(error_.empty() ? "Ciphertext too short" : error_);
+        }
+        return aes_->finish(out, tag);
+    }
+
+private:
+    // Header: [2-byte key length][ephemeral public key][nonce]; returns input bytes consumed
+    size_t read_header(std::span<const uint8_t> in) {
+        size_t used = 0;
+        while (error_.empty() && used < in.size() && header_.size() < header_size()) {
+            size_t take = (std::min)(header_size() - header_.size(), in.size() - used);
+            header_.insert(header_.end(), in.begin() + used, in.begin() + used + take);
+            used += take;
+        }
+        if (error_.empty() && header_.size() >= 2 && header_.size() == header_size()) {
+            start();
+        }
+        return used;
+    }
+
+    size_t header_size() const {
+        if (header_.size() < 2) {
+            return 2;
+        }
+        return 2 + ((static_cast<size_t>(header_[0]) << 8) | header_[1]) + HYBRID_NONCE_SIZE;
+    }
+
+    void start() {
+        std::span<const uint8_t> header(header_);
+        auto ephemeral_pub_key = header.subspan(2, header.size() - 2 - HYBRID_NONCE_SIZE);
+        nonce_.assign(header.end() - HYBRID_NONCE_SIZE, header.end());
+
+        auto dh_result = ecdh_.derive_shared_secret(private_key_, ephemeral_pub_key);
+        if (!dh_result.success) {
+            error_ = "Failed to derive shared secret: " + dh_result.error_message;
+            return;
+        }
+        auto aes_key = derive_hybrid_key(dh_result.shared_secret);
+        Botan::secure_scrub_memory(dh_result.shared_secret.data(), dh_result.shared_secret.size());
+
+        auto session = symmetric::AES_GCM(256).begin_decryption(aes_key, nonce_, associated_data_);
+        Botan::secure_scrub_memory(aes_key.data(), aes_key.size());
+        if (!session) {
+            error_ = session.error_message;
+            return;
+        }
+        aes_ = std::move(session.value);
+    }
+
+    ECDH& ecdh_;
+    std::vector<uint8_t> private_key_;
+    std::vector<uint8_t> associated_data_;
+    std::vector<uint8_t> header_;
+    std::vector<uint8_t> nonce_;
+    std::string error_;
+    std::unique_ptr<core::ICipherSession> aes_;
+};
+
+} // anonymous namespace
+
+core::Result<std::unique_ptr<core::ICipherSession>> ECCHybrid::begin_encryption(
+    std::span<const uint8_t> key,  // Recipient's public key
+    std::span<const uint8_t> nonce,
+    std::span<const uint8_t> associated_data
+) {
+    try {
+        auto ephemeral = ecdh_.generate_key_pair();
+        
+        auto dh_result = ecdh_.derive_shared_secret(ephemeral.private_key, key);
+        if (!dh_result.success) {
+            return SessionResult::error("Failed to derive shared secret: " + dh_result.error_message);
+        }
+        auto aes_key = derive_hybrid_key(dh_result.shared_secret);
+        Botan::secure_scrub_memory(dh_result.shared_secret.data(), dh_result.shared_secret.size());
+        Botan::secure_scrub_memory(ephemeral.private_key.data(), ephemeral.private_key.size());
+        
+        auto session = symmetric::AES_GCM(256).begin_encryption(aes_key, nonce, associated_data);
+        Botan::secure_scrub_memory(aes_key.data(), aes_key.size());
+        if (!session) {
+            return session;
+        }
+        
+        // Same header as encrypt(): key length (2 bytes, big-endian), key, nonce
+        size_t pub_key_len = ephemeral.public_key.size();
+        const auto& aes_nonce = session.value->nonce();
+        std::vector<uint8_t> prefix;
+        prefix.reserve(2 + pub_key_len + aes_nonce.size());
+        prefix.push_back(static_cast<uint8_t>(pub_key_len >> 8));
+        prefix.push_back(static_cast<uint8_t>(pub_key_len & 0xFF));
+        prefix.insert(prefix.end(), ephemeral.public_key.begin(), ephemeral.public_key.end());
+        prefix.insert(prefix.end(), aes_nonce.begin(), aes_nonce.end());
+        
+        return SessionResult::ok(std::make_unique<HybridEncryptSession>(
+            std::move(prefix), std::move(session.value)));
+        
+    } catch (const std::exception& e) {
+        spdlog::error("ECCHybrid begin_encryption failed: {}", e.what());
+        return SessionResult::error(std::string("ECC encryption error: ") + e.what());
+    }
+}
+
+core::Result<std::unique_ptr<core::ICipherSession>> ECCHybrid::begin_decryption(
+    std::span<const uint8_t> key,  // Own private key
+    [[maybe_unused]] std::span<const uint8_t> nonce,
+    std::span<const uint8_t> associated_data
+) {
+    return SessionResult::ok(std::make_unique<HybridDecryptSession>(ecdh_, key, associated_data));
+}
+
 bool ECCHybrid::is_suitable_for(core::SecurityLevel level) const {
     switch (curve_) {
         case ECCurve::SECP256R1:
@@ -4,7 +4,7 @@
  */
 
 #include "filevault/algorithms/asymmetric/rsa.hpp"
-#include <botan/auto_rng.h>
+#include "filevault/core/secure_random.hpp"
 #include <botan/rsa.h>
 #include <botan/pubkey.h>
 #include <botan/pkcs8.h>
@@ -51,7 +51,7 @@ RSAKeyPair RSA::generate_key_pair() {
     key_pair.bits = key_bits_;
     
     try {
-        Botan::AutoSeeded_RNG rng;
+        auto& rng = core::SecureRandom::thread_rng();
         Botan::RSA_PrivateKey private_key(rng, key_bits_);
         
         // Export private key as PKCS#8 PEM
@@ -102,7 +102,7 @@ core::CryptoResult RSA::encrypt(
         }
         
         // Create encryptor with OAEP padding (SHA-256)
-        Botan::AutoSeeded_RNG rng;
+        auto& rng = core::SecureRandom::thread_rng();
         Botan::PK_Encryptor_EME encryptor(*public_key, rng, "EME-OAEP(SHA-256)");
         
         // Encrypt
@@ -149,7 +149,7 @@ core::CryptoResult RSA::decrypt(
         }
         
         // Create decryptor with OAEP padding (SHA-256)
-        Botan::AutoSeeded_RNG rng;
+        auto& rng = core::SecureRandom::thread_rng();
         Botan::PK_Decryptor_EME decryptor(*private_key, rng, "EME-OAEP(SHA-256)");
         
         // Decrypt
@@ -192,7 +192,7 @@ std::vector<uint8_t> RSA::sign(
             throw std::runtime_error("Failed to load private key");
         }
         
-        Botan::AutoSeeded_RNG rng;
+        auto& rng = core::SecureRandom::thread_rng();
         Botan::PK_Signer signer(*priv_key, rng, "EMSA-PSS(SHA-256)");
         
         signer.update(data.data(), data.size());
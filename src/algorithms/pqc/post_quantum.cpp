@@ -7,7 +7,7 @@
 
 #include "filevault/algorithms/pqc/post_quantum.hpp"
 #include "filevault/algorithms/symmetric/aes_gcm.hpp"
-#include <botan/auto_rng.h>
+#include "filevault/core/secure_random.hpp"
 #include <botan/pubkey.h>
 #include <botan/pk_keys.h>
 #include <botan/kyber.h>
@@ -132,7 +132,7 @@ PQKeyPair Kyber::generate_keypair() {
     result.algorithm = name();
     
     try {
-        Botan::AutoSeeded_RNG rng;
+        auto& rng = core::SecureRandom::thread_rng();
         Botan::KyberMode mode = get_kyber_mode(variant_);
         
         Botan::Kyber_PrivateKey private_key(rng, mode);
@@ -162,7 +162,7 @@ core::CryptoResult Kyber::encrypt(
     core::CryptoResult result;
     
     try {
-        Botan::AutoSeeded_RNG rng;
+        auto& rng = core::SecureRandom::thread_rng();
         Botan::KyberMode mode = get_kyber_mode(variant_);
         
         // Load public key
@@ -212,7 +212,7 @@ core::CryptoResult Kyber::decrypt(
     core::CryptoResult result;
     
     try {
-        Botan::AutoSeeded_RNG rng;
+        auto& rng = core::SecureRandom::thread_rng();
         Botan::KyberMode mode = get_kyber_mode(variant_);
         
         // Load private key
@@ -308,7 +308,7 @@ PQKeyPair Dilithium::generate_keypair() {
     result.algorithm = name();
     
     try {
-        Botan::AutoSeeded_RNG rng;
+        auto& rng = core::SecureRandom::thread_rng();
         Botan::DilithiumMode mode = get_dilithium_mode(variant_);
         
         Botan::Dilithium_PrivateKey private_key(rng, mode);
@@ -334,7 +334,7 @@ std::vector<uint8_t> Dilithium::sign(
     std::span<const uint8_t> private_key
 ) {
     try {
-        Botan::AutoSeeded_RNG rng;
+        auto& rng = core::SecureRandom::thread_rng();
         Botan::DilithiumMode mode = get_dilithium_mode(variant_);
         
         // Load private key
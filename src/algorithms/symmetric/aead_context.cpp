@@ -0,0 +1,311 @@
+#include "filevault/algorithms/symmetric/aead_context.hpp"
+#include "filevault/core/secure_random.hpp"
+#include <botan/mem_ops.h>
+#include <spdlog/spdlog.h>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+namespace filevault {
+namespace algorithms {
+namespace symmetric {
+
+AeadContext::AeadContext(std::string botan_name,
+                         core::AlgorithmType type,
+                         std::span<const uint8_t> key,
+                         size_t key_size,
+                         bool bind_associated_data,
+                         size_t nonce_size)
+    : botan_name_(std::move(botan_name)),
+      type_(type),
+      key_(key.begin(), key.end()),
+      key_valid_(key.size() == key_size),
+      bind_associated_data_(bind_associated_data),
+      nonce_size_(nonce_size) {
+}
+
+Botan::AEAD_Mode& AeadContext::mode(Botan::Cipher_Dir direction) {
+    auto& cipher = direction == Botan::Cipher_Dir::Encryption ? encryptor_ : decryptor_;
+    if (!cipher) {
+        auto created = Botan::AEAD_Mode::create(botan_name_, direction);
+        if (!created) {
+            throw std::runtime_error(botan_name_ + " not available");
+        }
+        created->set_key(key_.data(), key_.size());
+        cipher = std::move(created);
+        spdlog::debug("Keyed {} context", botan_name_);
+    }
+    return *cipher;
+}
+
+void AeadContext::set_associated_data(Botan::AEAD_Mode& cipher, const core::EncryptionConfig& config) {
+    if (!bind_associated_data_) {
+        return;
+    }
+    // Always set it: the mode keeps the previous message's data otherwise
+    if (config.associated_data.has_value()) {
+        const auto& ad = config.associated_data.value();
+        cipher.set_associated_data(ad.data(), ad.size());
+    } else {
+        cipher.set_associated_data(nullptr, 0);
+    }
+}
+
+core::CryptoResult AeadContext::encrypt(
+    std::span<const uint8_t> plaintext,
+    const core::EncryptionConfig& config) {
+
+    auto start = std::chrono::high_resolution_clock::now();
+    core::CryptoResult result;
+    result.algorithm_used = type_;
+
+    if (!key_valid_) {
+        result.success = false;
+        result.error_message = "Invalid key size";
+        return result;
+    }
+
+    std::vector<uint8_t> nonce;
+    if (config.nonce.has_value() && !config.nonce.value().empty()) {
+        if (config.nonce.value().size() != nonce_size_) {
+            result.success = false;
+            result.error_message = "Invalid nonce size";
+            return result;
+        }
+        nonce = config.nonce.value();
+    } else {
+        auto& rng = core::SecureRandom::thread_rng();
+        nonce.resize(nonce_size_);
+        rng.randomize(nonce.data(), nonce.size());
+    }
+
+    Botan::AEAD_Mode* cipher = nullptr;
+    try {
+        cipher = &mode(Botan::Cipher_Dir::Encryption);
+        set_associated_data(*cipher, config);
+        cipher->start(nonce.data(), nonce.size());
+
+        buffer_.assign(plaintext.begin(), plaintext.end());
+        cipher->finish(buffer_);
+
+        if (buffer_.size() < TAG_SIZE) {
+            result.success = false;
+            result.error_message = "Invalid ciphertext size";
+            return result;
+        }
+
+        size_t ciphertext_len = buffer_.size() - TAG_SIZE;
+        result.data.assign(buffer_.begin(), buffer_.begin() + ciphertext_len);
+        result.tag = std::vector<uint8_t>(buffer_.begin() + ciphertext_len, buffer_.end());
+        result.nonce = std::move(nonce);
+
+        result.success = true;
+        result.original_size = plaintext.size();
+        result.final_size = result.data.size();
+
+        auto end = std::chrono::high_resolution_clock::now();
+        result.processing_time_ms = std::chrono::duration<double, std::milli>(end - start).count();
+        return result;
+
+    } catch (const std::exception& e) {
+        if (cipher) {
+            cipher->reset();
+        }
+        result.success = false;
+        result.error_message = std::string("Encryption failed: ") + e.what();
+        return result;
+    }
+}
+
+core::CryptoResult AeadContext::decrypt(
+    std::span<const uint8_t> ciphertext,
+    const core::EncryptionConfig& config) {
+
+    auto start = std::chrono::high_resolution_clock::now();
+    core::CryptoResult result;
+    result.algorithm_used = type_;
+
+    if (!key_valid_) {
+        result.success = false;
+        result.error_message = "Invalid key size";
+        return result;
+    }
+
+    if (!config.nonce.has_value() || !config.tag.has_value()) {
+        result.success = false;
+        result.error_message = "Nonce and tag must be provided in config";
+        return result;
+    }
+
+    const auto& nonce = config.nonce.value();
+    const auto& tag = config.tag.value();
+
+    if (nonce.size() != nonce_size_) {
+        result.success = false;
+        result.error_message = "Invalid nonce size";
+        return result;
+    }
+
+    if (tag.size() != TAG_SIZE) {
+        result.success = false;
+        result.error_message = "Invalid tag size";
+        return result;
+    }
+
+    Botan::AEAD_Mode* cipher = nullptr;
+    try {
+        cipher = &mode(Botan::Cipher_Dir::Decryption);
+        set_associated_data(*cipher, config);
+        cipher->start(nonce.data(), nonce.size());
+
+        buffer_.clear();
+        buffer_.reserve(ciphertext.size() + tag.size());
+        buffer_.insert(buffer_.end(), ciphertext.begin(), ciphertext.end());
+        buffer_.insert(buffer_.end(), tag.begin(), tag.end());
+        cipher->finish(buffer_);
+
+        result.data.assign(buffer_.begin(), buffer_.end());
+
+        result.success = true;
+        result.original_size = ciphertext.size();
+        result.final_size = result.data.size();
+
+        auto end = std::chrono::high_resolution_clock::now();
+        result.processing_time_ms = std::chrono::duration<double, std::milli>(end - start).count();
+        return result;
+
+    } catch (const Botan::Invalid_Authentication_Tag&) {
+        cipher->reset();
+        result.success = false;
+        result.error_message = "Authentication failed: Invalid tag (data may be corrupted or tampered)";
+        return result;
+    } catch (const std::exception& e) {
+        if (cipher) {
+            cipher->reset();
+        }
+        result.success = false;
+        result.error_message = std::string("Decryption failed: ") + e.what();
+        return result;
+    }
+}
+
+core::Result<size_t> AeadContext::encrypt_into(
+    std::span<const uint8_t> plaintext,
+    std::span<uint8_t> out,
+    std::span<uint8_t> tag_out,
+    const core::EncryptionConfig& config) {
+
+    if (!key_valid_) {
+        return core::Result<size_t>::error("Invalid key size");
+    }
+    if (!config.nonce.has_value() || config.nonce->size() != nonce_size_) {
+        return core::Result<size_t>::error("Invalid nonce size");
+    }
+    if (tag_out.size() != TAG_SIZE) {
+        return core::Result<size_t>::error("Tag buffer must be 16 bytes");
+    }
+    if (out.size() < plaintext.size()) {
+        return core::Result<size_t>::error("Output buffer too small");
+    }
+
+    const size_t length = plaintext.size();
+    if (length > 0 && out.data() != plaintext.data()) {
+        std::memmove(out.data(), plaintext.data(), length);
+    }
+
+    Botan::AEAD_Mode* cipher = nullptr;
+    try {
+        cipher = &mode(Botan::Cipher_Dir::Encryption);
+        set_associated_data(*cipher, config);
+        cipher->start(config.nonce->data(), config.nonce->size());
+
+        // Whole granules are transformed where they lie; finish() needs a vector,
+        // so only the remainder goes through the work buffer
+        const size_t bulk = length - length % cipher->update_granularity();
+        if (bulk > 0) {
+            cipher->process(out.data(), bulk);
+        }
+        buffer_.assign(out.begin() + bulk, out.begin() + length);
+        cipher->finish(buffer_);
+
+        if (buffer_.size() != length - bulk + TAG_SIZE) {
+            return core::Result<size_t>::error("Invalid ciphertext size");
+        }
+        std::copy(buffer_.begin(), buffer_.end() - TAG_SIZE, out.begin() + bulk);
+        std::copy(buffer_.end() - TAG_SIZE, buffer_.end(), tag_out.begin());
+        return core::Result<size_t>::ok(length);
+
+    } catch (const std::exception& e) {
+        if (cipher) {
+            cipher->reset();
+        }
+        return core::Result<size_t>::error(std::string("Encryption failed: ") + e.what());
+    }
+}
+
+core::Result<size_t> AeadContext::decrypt_into(
+    std::span<const uint8_t> ciphertext,
+    std::span<uint8_t> out,
+    const core::EncryptionConfig& config) {
+
+    if (!key_valid_) {
+        return core::Result<size_t>::error("Invalid key size");
+    }
+    if (!config.nonce.has_value() || !config.tag.has_value()) {
+        return core::Result<size_t>::error("Nonce and tag must be provided in config");
+    }
+    if (config.nonce->size() != nonce_size_) {
+        return core::Result<size_t>::error("Invalid nonce size");
+    }
+    if (config.tag->size() != TAG_SIZE) {
+        return core::Result<size_t>::error("Invalid tag size");
+    }
+    if (out.size() < ciphertext.size()) {
+        return core::Result<size_t>::error("Output buffer too small");
+    }
+
+    const size_t length = ciphertext.size();
+    if (length > 0 && out.data() != ciphertext.data()) {
+        std::memmove(out.data(), ciphertext.data(), length);
+    }
+
+    Botan::AEAD_Mode* cipher = nullptr;
+    try {
+        cipher = &mode(Botan::Cipher_Dir::Decryption);
+        set_associated_data(*cipher, config);
+        cipher->start(config.nonce->data(), config.nonce->size());
+
+        const size_t bulk = length - length % cipher->update_granularity();
+        if (bulk > 0) {
+            cipher->process(out.data(), bulk);
+        }
+        // The tag is checked in finish(), so it travels with the remainder
+        buffer_.assign(out.begin() + bulk, out.begin() + length);
+        buffer_.insert(buffer_.end(), config.tag->begin(), config.tag->end());
+        cipher->finish(buffer_);
+
+        if (buffer_.size() != length - bulk) {
+            Botan::secure_scrub_memory(out.data(), length);
+            return core::Result<size_t>::error("Invalid plaintext size");
+        }
+        std::copy(buffer_.begin(), buffer_.end(), out.begin() + bulk);
+        return core::Result<size_t>::ok(length);
+
+    } catch (const Botan::Invalid_Authentication_Tag&) {
+        // Unauthenticated plaintext must not reach the caller
+        Botan::secure_scrub_memory(out.data(), length);
+        cipher->reset();
+        return core::Result<size_t>::error(
+            "Authentication failed: Invalid tag (data may be corrupted or tampered)");
+    } catch (const std::exception& e) {
+        Botan::secure_scrub_memory(out.data(), length);
+        if (cipher) {
+            cipher->reset();
+        }
+        return core::Result<size_t>::error(std::string("Decryption failed: ") + e.what());
+    }
+}
+
+} // namespace symmetric
+} // namespace algorithms
+} // namespace filevault
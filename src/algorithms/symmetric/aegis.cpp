@@ -0,0 +1,97 @@
+/**
+ * @file aegis.cpp
+ * @brief Implementation of AEGIS-128L / AEGIS-256 AEAD encryption
+ */
+
+#include "filevault/algorithms/symmetric/aegis.hpp"
+#include "filevault/algorithms/symmetric/aead_context.hpp"
+#include "filevault/algorithms/symmetric/cipher_session.hpp"
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+
+namespace filevault {
+namespace algorithms {
+namespace symmetric {
+
+AEGIS::AEGIS(size_t key_bits) : key_bits_(key_bits) {
+    switch (key_bits) {
+        case 128:
+            type_ = core::AlgorithmType::AEGIS_128L;
+            botan_name_ = "AEGIS-128L";
+            break;
+        case 256:
+            type_ = core::AlgorithmType::AEGIS_256;
+            botan_name_ = "AEGIS-256";
+            break;
+        default:
+            throw std::invalid_argument("AEGIS key size must be 128 or 256 bits");
+    }
+
+    spdlog::debug("Created {} algorithm", botan_name_);
+}
+
+std::string AEGIS::name() const {
+    return botan_name_;
+}
+
+core::AlgorithmType AEGIS::type() const {
+    return type_;
+}
+
+// One-shot calls go through a single-use context: same nonce handling,
+// tag layout and error messages as the keyed path
+core::CryptoResult AEGIS::encrypt(
+    std::span<const uint8_t> plaintext,
+    std::span<const uint8_t> key,
+    const core::EncryptionConfig& config) {
+
+    AeadContext context(botan_name_, type_, key, key_size(), true, nonce_size());
+    return context.encrypt(plaintext, config);
+}
+
+core::CryptoResult AEGIS::decrypt(
+    std::span<const uint8_t> ciphertext,
+    std::span<const uint8_t> key,
+    const core::EncryptionConfig& config) {
+
+    AeadContext context(botan_name_, type_, key, key_size(), true, nonce_size());
+    return context.decrypt(ciphertext, config);
+}
+
+bool AEGIS::is_suitable_for(core::SecurityLevel level) const {
+    // Same reasoning as AES: 128-bit keys stop at MEDIUM
+    switch (level) {
+        case core::SecurityLevel::WEAK:
+        case core::SecurityLevel::MEDIUM:
+            return true;
+        case core::SecurityLevel::STRONG:
+        case core::SecurityLevel::PARANOID:
+            return key_bits_ >= 256;
+        default:
+            return true;
+    }
+}
+
+std::unique_ptr<core::ICipherContext> AEGIS::make_context(std::span<const uint8_t> key) {
+    return std::make_unique<AeadContext>(botan_name_, type_, key, key_size(), true, nonce_size());
+}
+
+core::Result<std::unique_ptr<core::ICipherSession>> AEGIS::begin_encryption(
+    std::span<const uint8_t> key,
+    std::span<const uint8_t> nonce,
+    std::span<const uint8_t> associated_data) {
+    return CipherModeSession::begin(botan_name_, Botan::Cipher_Dir::Encryption,
+                                    key, key_size(), nonce, nonce_size(), associated_data);
+}
+
+core::Result<std::unique_ptr<core::ICipherSession>> AEGIS::begin_decryption(
+    std::span<const uint8_t> key,
+    std::span<const uint8_t> nonce,
+    std::span<const uint8_t> associated_data) {
+    return CipherModeSession::begin(botan_name_, Botan::Cipher_Dir::Decryption,
+                                    key, key_size(), nonce, nonce_size(), associated_data);
+}
+
+} // namespace symmetric
+} // namespace algorithms
+} // namespace filevault
@@ -4,7 +4,8 @@
  */
 
 #include "filevault/algorithms/symmetric/aes_cbc.hpp"
-#include <botan/auto_rng.h>
+#include "filevault/algorithms/symmetric/cipher_session.hpp"
+#include "filevault/core/secure_random.hpp"
 #include <botan/hex.h>
 #include <spdlog/spdlog.h>
 #include <chrono>
@@ -69,7 +70,7 @@ core::CryptoResult AES_CBC::encrypt(
             iv = config.nonce.value();
             spdlog::debug("AES-CBC: Using provided IV");
         } else {
-            Botan::AutoSeeded_RNG rng;
+            auto& rng = core::SecureRandom::thread_rng();
             iv.resize(iv_size());
             rng.randomize(iv.data(), iv.size());
             spdlog::debug("AES-CBC: Generated new IV ({} bytes)", iv.size());
@@ -215,6 +216,22 @@ bool AES_CBC::is_suitable_for(core::SecurityLevel level) const {
     }
 }
 
+core::Result<std::unique_ptr<core::ICipherSession>> AES_CBC::begin_encryption(
+    std::span<const uint8_t> key,
+    std::span<const uint8_t> nonce,
+    std::span<const uint8_t> associated_data) {
+    return CipherModeSession::begin(botan_name_, Botan::Cipher_Dir::Encryption,
+                                    key, key_size(), nonce, iv_size(), associated_data);
+}
+
+core::Result<std::unique_ptr<core::ICipherSession>> AES_CBC::begin_decryption(
+    std::span<const uint8_t> key,
+    std::span<const uint8_t> nonce,
+    std::span<const uint8_t> associated_data) {
+    return CipherModeSession::begin(botan_name_, Botan::Cipher_Dir::Decryption,
+                                    key, key_size(), nonce, iv_size(), associated_data);
+}
+
 } // namespace symmetric
 } // namespace algorithms
 } // namespace filevault
@@ -4,7 +4,8 @@
  */
 
 #include "filevault/algorithms/symmetric/aes_ctr.hpp"
-#include <botan/auto_rng.h>
+#include "filevault/algorithms/symmetric/cipher_session.hpp"
+#include "filevault/core/secure_random.hpp"
 #include <botan/hex.h>
 #include <spdlog/spdlog.h>
 #include <chrono>
@@ -69,7 +70,7 @@ core::CryptoResult AES_CTR::encrypt(
             nonce = config.nonce.value();
             spdlog::debug("AES-CTR: Using provided nonce");
         } else {
-            Botan::AutoSeeded_RNG rng;
+            auto& rng = core::SecureRandom::thread_rng();
             nonce.resize(nonce_size());
             rng.randomize(nonce.data(), nonce.size());
             spdlog::debug("AES-CTR: Generated new nonce ({} bytes)", nonce.size());
@@ -203,6 +204,23 @@ bool AES_CTR::is_suitable_for(core::SecurityLevel level) const {
     }
 }
 
+core::Result<std::unique_ptr<core::ICipherSession>> AES_CTR::begin_encryption(
+    std::span<const uint8_t> key,
+    std::span<const uint8_t> nonce,
+    std::span<const uint8_t> associated_data) {
+    return CipherModeSession::begin(botan_name_, Botan::Cipher_Dir::Encryption,
+                                    key, key_size(), nonce, nonce_size(), associated_data);
+}
+
+core::Result<std::unique_ptr<core::ICipherSession>> AES_CTR::begin_decryption(
+    std::span<const uint8_t> key,
+    std::span<const uint8_t> nonce,
+    std::span<const uint8_t> associated_data) {
+    // CTR decrypts by running the keystream again, as decrypt() does
+    return CipherModeSession::begin(botan_name_, Botan::Cipher_Dir::Encryption,
+                                    key, key_size(), nonce, nonce_size(), associated_data);
+}
+
 } // namespace symmetric
 } // namespace algorithms
 } // namespace filevault
@@ -10,7 +10,6 @@
 
 #include "filevault/algorithms/symmetric/aes_ecb.hpp"
 #include <botan/block_cipher.h>
-#include <botan/auto_rng.h>
 #include <botan/hex.h>
 #include <spdlog/spdlog.h>
 #include <chrono>
@@ -1,5 +1,7 @@
 #include "filevault/algorithms/symmetric/aes_gcm.hpp"
-#include <botan/auto_rng.h>
+#include "filevault/algorithms/symmetric/cipher_session.hpp"
+#include "filevault/algorithms/symmetric/aead_context.hpp"
+#include "filevault/core/secure_random.hpp"
 #include <spdlog/spdlog.h>
 #include <chrono>
 
@@ -63,7 +65,7 @@ core::CryptoResult AES_GCM::encrypt(
             spdlog::debug("Using provided nonce (testing mode)");
         } else {
             // CRITICAL: Generate NEW unique nonce for THIS encryption
-            Botan::AutoSeeded_RNG rng;
+            auto& rng = core::SecureRandom::thread_rng();
             nonce.resize(nonce_size());
             rng.randomize(nonce.data(), nonce.size());
             spdlog::debug("Generated new unique nonce ({} bytes)", nonce.size());
@@ -237,6 +239,26 @@ bool AES_GCM::is_suitable_for(core::SecurityLevel level) const {
     return true;
 }
 
+std::unique_ptr<core::ICipherContext> AES_GCM::make_context(std::span<const uint8_t> key) {
+    return std::make_unique<AeadContext>(botan_name_, type_, key, key_size());
+}
+
+core::Result<std::unique_ptr<core::ICipherSession>> AES_GCM::begin_encryption(
+    std::span<const uint8_t> key,
+    std::span<const uint8_t> nonce,
+    std::span<const uint8_t> associated_data) {
+    return CipherModeSession::begin(botan_name_, Botan::Cipher_Dir::Encryption,
+                                    key, key_size(), nonce, nonce_size(), associated_data);
+}
+
+core::Result<std::unique_ptr<core::ICipherSession>> AES_GCM::begin_decryption(
+    std::span<const uint8_t> key,
+    std::span<const uint8_t> nonce,
+    std::span<const uint8_t> associated_data) {
+    return CipherModeSession::begin(botan_name_, Botan::Cipher_Dir::Decryption,
+                                    key, key_size(), nonce, nonce_size(), associated_data);
+}
+
 } // namespace symmetric
 } // namespace algorithms
 } // namespace filevault
@@ -0,0 +1,91 @@
+/**
+ * @file aes_ocb.cpp
+ * @brief Implementation of AES-OCB3 AEAD encryption
+ */
+
+#include "filevault/algorithms/symmetric/aes_ocb.hpp"
+#include "filevault/algorithms/symmetric/aead_context.hpp"
+#include "filevault/algorithms/symmetric/cipher_session.hpp"
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+
+namespace filevault {
+namespace algorithms {
+namespace symmetric {
+
+AES_OCB::AES_OCB(size_t key_bits) : key_bits_(key_bits) {
+    switch (key_bits) {
+        case 128:
+            type_ = core::AlgorithmType::AES_128_OCB;
+            botan_name_ = "AES-128/OCB";
+            break;
+        case 192:
+            type_ = core::AlgorithmType::AES_192_OCB;
+            botan_name_ = "AES-192/OCB";
+            break;
+        case 256:
+            type_ = core::AlgorithmType::AES_256_OCB;
+            botan_name_ = "AES-256/OCB";
+            break;
+        default:
+            throw std::invalid_argument("Invalid AES key size. Must be 128, 192, or 256 bits");
+    }
+
+    spdlog::debug("Created {} cipher", botan_name_);
+}
+
+std::string AES_OCB::name() const {
+    return botan_name_;
+}
+
+core::AlgorithmType AES_OCB::type() const {
+    return type_;
+}
+
+core::CryptoResult AES_OCB::encrypt(
+    std::span<const uint8_t> plaintext,
+    std::span<const uint8_t> key,
+    const core::EncryptionConfig& config) {
+
+    AeadContext context(botan_name_, type_, key, key_size());
+    return context.encrypt(plaintext, config);
+}
+
+core::CryptoResult AES_OCB::decrypt(
+    std::span<const uint8_t> ciphertext,
+    std::span<const uint8_t> key,
+    const core::EncryptionConfig& config) {
+
+    AeadContext context(botan_name_, type_, key, key_size());
+    return context.decrypt(ciphertext, config);
+}
+
+bool AES_OCB::is_suitable_for(core::SecurityLevel level) const {
+    // Like AES-GCM, the security comes from key length and KDF parameters
+    (void)level;
+    return true;
+}
+
+std::unique_ptr<core::ICipherContext> AES_OCB::make_context(std::span<const uint8_t> key) {
+    return std::make_unique<AeadContext>(botan_name_, type_, key, key_size());
+}
+
+core::Result<std::unique_ptr<core::ICipherSession>> AES_OCB::begin_encryption(
+    std::span<const uint8_t> key,
+    std::span<const uint8_t> nonce,
+    std::span<const uint8_t> associated_data) {
+    return CipherModeSession::begin(botan_name_, Botan::Cipher_Dir::Encryption,
+                                    key, key_size(), nonce, nonce_size(), associated_data);
+}
+
+core::Result<std::unique_ptr<core::ICipherSession>> AES_OCB::begin_decryption(
+    std::span<const uint8_t> key,
+    std::span<const uint8_t> nonce,
+    std::span<const uint8_t> associated_data) {
+    return CipherModeSession::begin(botan_name_, Botan::Cipher_Dir::Decryption,
+                                    key, key_size(), nonce, nonce_size(), associated_data);
+}
+
+} // namespace symmetric
+} // namespace algorithms
+} // namespace filevault
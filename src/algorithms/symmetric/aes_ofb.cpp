@@ -4,7 +4,8 @@
  */
 
 #include "filevault/algorithms/symmetric/aes_ofb.hpp"
-#include <botan/auto_rng.h>
+#include "filevault/algorithms/symmetric/cipher_session.hpp"
+#include "filevault/core/secure_random.hpp"
 #include <botan/hex.h>
 #include <spdlog/spdlog.h>
 #include <chrono>
@@ -67,7 +68,7 @@ core::CryptoResult AES_OFB::encrypt(
         if (config.nonce.has_value() && config.nonce.value().size() == iv_size()) {
             iv = config.nonce.value();
         } else {
-            Botan::AutoSeeded_RNG rng;
+            auto& rng = core::SecureRandom::thread_rng();
             iv.resize(iv_size());
             rng.randomize(iv.data(), iv.size());
         }
@@ -171,6 +172,22 @@ bool AES_OFB::is_suitable_for(core::SecurityLevel level) const {
     }
 }
 
+core::Result<std::unique_ptr<core::ICipherSession>> AES_OFB::begin_encryption(
+    std::span<const uint8_t> key,
+    std::span<const uint8_t> nonce,
+    std::span<const uint8_t> associated_data) {
+    return CipherModeSession::begin(botan_name_, Botan::Cipher_Dir::Encryption,
+                                    key, key_size(), nonce, iv_size(), associated_data);
+}
+
+core::Result<std::unique_ptr<core::ICipherSession>> AES_OFB::begin_decryption(
+    std::span<const uint8_t> key,
+    std::span<const uint8_t> nonce,
+    std::span<const uint8_t> associated_data) {
+    return CipherModeSession::begin(botan_name_, Botan::Cipher_Dir::Decryption,
+                                    key, key_size(), nonce, iv_size(), associated_data);
+}
+
 } // namespace symmetric
 } // namespace algorithms
 } // namespace filevault
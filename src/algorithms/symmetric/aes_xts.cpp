@@ -4,7 +4,8 @@
  */
 
 #include "filevault/algorithms/symmetric/aes_xts.hpp"
-#include <botan/auto_rng.h>
+#include "filevault/algorithms/symmetric/cipher_session.hpp"
+#include "filevault/core/secure_random.hpp"
 #include <botan/hex.h>
 #include <spdlog/spdlog.h>
 #include <chrono>
@@ -72,7 +73,7 @@ core::CryptoResult AES_XTS::encrypt(
         if (config.nonce.has_value() && config.nonce.value().size() == tweak_size()) {
             tweak = config.nonce.value();
         } else {
-            Botan::AutoSeeded_RNG rng;
+            auto& rng = core::SecureRandom::thread_rng();
             tweak.resize(tweak_size());
             rng.randomize(tweak.data(), tweak.size());
         }
@@ -183,6 +184,22 @@ bool AES_XTS::is_suitable_for(core::SecurityLevel level) const {
     }
 }
 
+core::Result<std::unique_ptr<core::ICipherSession>> AES_XTS::begin_encryption(
+    std::span<const uint8_t> key,
+    std::span<const uint8_t> nonce,
+    std::span<const uint8_t> associated_data) {
+    return CipherModeSession::begin(botan_name_, Botan::Cipher_Dir::Encryption,
+                                    key, key_size(), nonce, tweak_size(), associated_data);
+}
+
+core::Result<std::unique_ptr<core::ICipherSession>> AES_XTS::begin_decryption(
+    std::span<const uint8_t> key,
+    std::span<const uint8_t> nonce,
+    std::span<const uint8_t> associated_data) {
+    return CipherModeSession::begin(botan_name_, Botan::Cipher_Dir::Decryption,
+                                    key, key_size(), nonce, tweak_size(), associated_data);
+}
+
 } // namespace symmetric
 } // namespace algorithms
 } // namespace filevault
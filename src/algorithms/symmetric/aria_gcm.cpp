@@ -4,7 +4,8 @@
  */
 
 #include "filevault/algorithms/symmetric/aria_gcm.hpp"
-#include <botan/auto_rng.h>
+#include "filevault/algorithms/symmetric/aead_context.hpp"
+#include "filevault/core/secure_random.hpp"
 #include <botan/hex.h>
 #include <spdlog/spdlog.h>
 #include <stdexcept>
@@ -70,7 +71,7 @@ core::CryptoResult ARIA_GCM::encrypt(
         }
         
         // Generate nonce
-        Botan::AutoSeeded_RNG rng;
+        auto& rng = core::SecureRandom::thread_rng();
         std::vector<uint8_t> nonce(nonce_size());
         if (config.nonce && !config.nonce->empty()) {
             nonce = *config.nonce;
@@ -233,6 +234,10 @@ bool ARIA_GCM::is_suitable_for(core::SecurityLevel level) const {
     }
 }
 
+std::unique_ptr<core::ICipherContext> ARIA_GCM::make_context(std::span<const uint8_t> key) {
+    return std::make_unique<AeadContext>(botan_name_, type_, key, key_size());
+}
+
 } // namespace symmetric
 } // namespace algorithms
 } // namespace filevault
@@ -1,5 +1,7 @@
 #include "filevault/algorithms/symmetric/chacha20_poly1305.hpp"
-#include <botan/auto_rng.h>
+#include "filevault/algorithms/symmetric/cipher_session.hpp"
+#include "filevault/algorithms/symmetric/aead_context.hpp"
+#include "filevault/core/secure_random.hpp"
 #include <spdlog/spdlog.h>
 #include <chrono>
 
@@ -43,7 +45,7 @@ core::CryptoResult ChaCha20Poly1305::encrypt(
             spdlog::debug("Using provided nonce (testing mode)");
         } else {
             // CRITICAL: Generate NEW unique nonce for THIS encryption
-            Botan::AutoSeeded_RNG rng;
+            auto& rng = core::SecureRandom::thread_rng();
             nonce.resize(nonce_size());
             rng.randomize(nonce.data(), nonce.size());
             spdlog::debug("Generated new unique nonce ({} bytes)", nonce.size());
@@ -219,6 +221,26 @@ bool ChaCha20Poly1305::is_suitable_for(core::SecurityLevel level) const {
     return true;
 }
 
+std::unique_ptr<core::ICipherContext> ChaCha20Poly1305::make_context(std::span<const uint8_t> key) {
+    return std::make_unique<AeadContext>("ChaCha20Poly1305", type(), key, key_size());
+}
+
+core::Result<std::unique_ptr<core::ICipherSession>> ChaCha20Poly1305::begin_encryption(
+    std::span<const uint8_t> key,
+    std::span<const uint8_t> nonce,
+    std::span<const uint8_t> associated_data) {
+    return CipherModeSession::begin("ChaCha20Poly1305", Botan::Cipher_Dir::Encryption,
+                                    key, key_size(), nonce, nonce_size(), associated_data);
+}
+
+core::Result<std::unique_ptr<core::ICipherSession>> ChaCha20Poly1305::begin_decryption(
+    std::span<const uint8_t> key,
+    std::span<const uint8_t> nonce,
+    std::span<const uint8_t> associated_data) {
+    return CipherModeSession::begin("ChaCha20Poly1305", Botan::Cipher_Dir::Decryption,
+                                    key, key_size(), nonce, nonce_size(), associated_data);
+}
+
 } // namespace symmetric
 } // namespace algorithms
 } // namespace filevault
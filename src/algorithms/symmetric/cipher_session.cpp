@@ -0,0 +1,170 @@
+#include "filevault/algorithms/symmetric/cipher_session.hpp"
+#include "filevault/core/secure_random.hpp"
+#include <botan/aead.h>
+#include <botan/mem_ops.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+
+namespace filevault {
+namespace algorithms {
+namespace symmetric {
+
+using SessionResult = core::Result<std::unique_ptr<core::ICipherSession>>;
+
+SessionResult CipherModeSession::begin(
+    const std::string& botan_name,
+    Botan::Cipher_Dir direction,
+    std::span<const uint8_t> key,
+    size_t key_size,
+    std::span<const uint8_t> nonce,
+    size_t nonce_size,
+    std::span<const uint8_t> associated_data) {
+
+    if (key.size() != key_size) {
+        return SessionResult::error("Invalid key size. Expected " + std::to_string(key_size) +
+                                    " bytes, got " + std::to_string(key.size()));
+    }
+
+    std::vector<uint8_t> iv;
+    if (nonce.empty()) {
+        iv = core::SecureRandom::bytes(nonce_size);
+    } else if (nonce.size() != nonce_size) {
+        return SessionResult::error("Invalid nonce size. Expected " + std::to_string(nonce_size) +
+                                    " bytes, got " + std::to_string(nonce.size()));
+    } else {
+        iv.assign(nonce.begin(), nonce.end());
+    }
+
+    try {
+        auto mode = Botan::Cipher_Mode::create(botan_name, direction);
+        if (!mode) {
+            return SessionResult::error(botan_name + " not available");
+        }
+        mode->set_key(key.data(), key.size());
+
+        if (!associated_data.empty()) {
+            auto* aead = dynamic_cast<Botan::AEAD_Mode*>(mode.get());
+            if (!aead) {
+                return SessionResult::error("Associated data needs an AEAD mode, not " + botan_name);
+            }
+            aead->set_associated_data(associated_data.data(), associated_data.size());
+        }
+        mode->start(iv.data(), iv.size());
+
+        spdlog::debug("Started incremental {} session", botan_name);
+        return SessionResult::ok(std::unique_ptr<core::ICipherSession>(
+            new CipherModeSession(std::move(mode), direction, std::move(iv))));
+
+    } catch (const std::exception& e) {
+        return SessionResult::error("Failed to start " + botan_name + ": " + e.what());
+    }
+}
+
+CipherModeSession::CipherModeSession(std::unique_ptr<Botan::Cipher_Mode> mode,
+                                     Botan::Cipher_Dir direction,
+                                     std::vector<uint8_t> nonce)
+    : mode_(std::move(mode)),
+      direction_(direction),
+      nonce_(std::move(nonce)),
+      tag_size_(mode_->tag_size()),
+      granularity_((std::max)(mode_->update_granularity(), size_t(1))) {
+
+    // A decrypting AEAD mode counts the tag in its minimum; ours arrives in finish()
+    size_t minimum = mode_->minimum_final_size();
+    if (direction_ == Botan::Cipher_Dir::Decryption) {
+        minimum = minimum > tag_size_ ? minimum - tag_size_ : 0;
+    }
+    hold_ = minimum;
+}
+
+size_t CipherModeSession::output_bound(size_t input) const {
+    if (direction_ == Botan::Cipher_Dir::Encryption) {
+        return mode_->output_length(pending_.size() + input);
+    }
+    return pending_.size() + input;
+}
+
+core::Result<size_t> CipherModeSession::update(std::span<const uint8_t> in, std::span<uint8_t> out) {
+    if (finished_) {
+        return core::Result<size_t>::error("Session already finished");
+    }
+
+    const size_t total = pending_.size() + in.size();
+    size_t ready = total > hold_ ? total - hold_ : 0;
+    ready -= ready % granularity_;
+    if (out.size() < ready) {
+        return core::Result<size_t>::error("Output buffer too small (need " + std::to_string(ready) + " bytes)");
+    }
+    if (ready == 0) {
+        pending_.insert(pending_.end(), in.begin(), in.end());
+        return core::Result<size_t>::ok(0);
+    }
+
+    // Held-back bytes first, then the new input, processed in place in the output
+    const size_t from_pending = (std::min)(ready, pending_.size());
+    const size_t from_input = ready - from_pending;
+    std::copy_n(pending_.begin(), from_pending, out.begin());
+    std::copy_n(in.begin(), from_input, out.begin() + from_pending);
+
+    size_t written = 0;
+    try {
+        written = mode_->process(out.data(), ready);
+    } catch (const std::exception& e) {
+        finished_ = true;
+        Botan::secure_scrub_memory(out.data(), ready);
+        return core::Result<size_t>::error(std::string(direction_ == Botan::Cipher_Dir::Encryption
+            ? "Encryption failed: " : "Decryption failed: ") + e.what());
+    }
+
+    pending_.erase(pending_.begin(), pending_.begin() + from_pending);
+    pending_.insert(pending_.end(), in.begin() + from_input, in.end());
+    return core::Result<size_t>::ok(written);
+}
+
+core::Result<size_t> CipherModeSession::finish(std::span<uint8_t> out, std::span<uint8_t> tag) {
+    if (finished_) {
+        return core::Result<size_t>::error("Session already finished");
+    }
+    if (tag.size() != tag_size_) {
+        return core::Result<size_t>::error("Tag buffer must be " + std::to_string(tag_size_) + " bytes");
+    }
+    finished_ = true;
+
+    const bool encrypting = direction_ == Botan::Cipher_Dir::Encryption;
+    try {
+        if (!encrypting) {
+            pending_.insert(pending_.end(), tag.begin(), tag.end());
+        }
+        mode_->finish(pending_);
+    } catch (const Botan::Invalid_Authentication_Tag&) {
+        Botan::secure_scrub_memory(pending_.data(), pending_.size());
+        return core::Result<size_t>::error(
+            "Authentication failed: Invalid tag (data may be corrupted or tampered)");
+    } catch (const std::exception& e) {
+        Botan::secure_scrub_memory(pending_.data(), pending_.size());
+        return core::Result<size_t>::error(std::string(encrypting
+            ? "Encryption failed: " : "Decryption failed: ") + e.what());
+    }
+
+    size_t length = pending_.size();
+    if (encrypting && tag_size_ > 0) {
+        if (length < tag_size_) {
+            return core::Result<size_t>::error("Invalid ciphertext size");
+        }
+        length -= tag_size_;
+        std::copy(pending_.begin() + length, pending_.end(), tag.begin());
+    }
+    if (out.size() < length) {
+        Botan::secure_scrub_memory(pending_.data(), pending_.size());
+        return core::Result<size_t>::error("Output buffer too small (need " + std::to_string(length) + " bytes)");
+    }
+
+    std::copy_n(pending_.begin(), length, out.begin());
+    Botan::secure_scrub_memory(pending_.data(), pending_.size());
+    pending_.clear();
+    return core::Result<size_t>::ok(length);
+}
+
+} // namespace symmetric
+} // namespace algorithms
+} // namespace filevault
@@ -1,7 +1,8 @@
 #include "filevault/algorithms/symmetric/serpent_gcm.hpp"
+#include "filevault/algorithms/symmetric/aead_context.hpp"
+#include "filevault/core/secure_random.hpp"
 #include <botan/cipher_mode.h>
 #include <botan/hex.h>
-#include <botan/auto_rng.h>
 #include <spdlog/spdlog.h>
 #include <stdexcept>
 #include <chrono>
@@ -60,7 +61,7 @@ core::CryptoResult Serpent_GCM::encrypt(
             spdlog::debug("Serpent-GCM: Using provided nonce (testing mode)");
         } else {
             // CRITICAL: Generate NEW unique nonce for THIS encryption
-            Botan::AutoSeeded_RNG rng;
+            auto& rng = core::SecureRandom::thread_rng();
             nonce.resize(12);  // GCM requires 12-byte nonce
             rng.randomize(nonce.data(), nonce.size());
             spdlog::debug("Serpent-GCM: Generated new unique nonce ({} bytes)", nonce.size());
@@ -300,6 +301,11 @@ std::vector<uint8_t> Serpent_GCM::process_gcm(
     return buffer;
 }
 
+std::unique_ptr<core::ICipherContext> Serpent_GCM::make_context(std::span<const uint8_t> key) {
+    // Associated data was never bound by this cipher; keep its output unchanged
+    return std::make_unique<AeadContext>("Serpent/GCM", type(), key, key_size(), false);
+}
+
 } // namespace symmetric
 } // namespace algorithms
 } // namespace filevault
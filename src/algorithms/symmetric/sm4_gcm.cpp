@@ -4,7 +4,8 @@
  */
 
 #include "filevault/algorithms/symmetric/sm4_gcm.hpp"
-#include <botan/auto_rng.h>
+#include "filevault/algorithms/symmetric/aead_context.hpp"
+#include "filevault/core/secure_random.hpp"
 #include <botan/hex.h>
 #include <spdlog/spdlog.h>
 #include <stdexcept>
@@ -50,7 +51,7 @@ core::CryptoResult SM4_GCM::encrypt(
         }
         
         // Generate nonce
-        Botan::AutoSeeded_RNG rng;
+        auto& rng = core::SecureRandom::thread_rng();
         std::vector<uint8_t> nonce(nonce_size());
         if (config.nonce && !config.nonce->empty()) {
             nonce = *config.nonce;
@@ -212,6 +213,10 @@ bool SM4_GCM::is_suitable_for(core::SecurityLevel level) const {
     }
 }
 
+std::unique_ptr<core::ICipherContext> SM4_GCM::make_context(std::span<const uint8_t> key) {
+    return std::make_unique<AeadContext>("SM4/GCM", type(), key, key_size());
+}
+
 } // namespace symmetric
 } // namespace algorithms
 } // namespace filevault
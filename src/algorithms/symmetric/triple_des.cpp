@@ -4,7 +4,7 @@
  */
 
 #include "filevault/algorithms/symmetric/triple_des.hpp"
-#include <botan/auto_rng.h>
+#include "filevault/core/secure_random.hpp"
 #include <botan/hex.h>
 #include <spdlog/spdlog.h>
 #include <chrono>
@@ -41,7 +41,7 @@ core::CryptoResult TripleDES::encrypt(
             iv = config.nonce.value();
             spdlog::debug("3DES: Using provided IV");
         } else {
-            Botan::AutoSeeded_RNG rng;
+            auto& rng = core::SecureRandom::thread_rng();
             iv.resize(iv_size());
             rng.randomize(iv.data(), iv.size());
             spdlog::debug("3DES: Generated new IV ({} bytes)", iv.size());
@@ -9,9 +9,10 @@
  */
 
 #include "filevault/algorithms/symmetric/twofish_gcm.hpp"
+#include "filevault/algorithms/symmetric/aead_context.hpp"
+#include "filevault/core/secure_random.hpp"
 #include <botan/cipher_mode.h>
 #include <botan/hex.h>
-#include <botan/auto_rng.h>
 #include <spdlog/spdlog.h>
 #include <stdexcept>
 #include <chrono>
@@ -103,7 +104,7 @@ core::CryptoResult Twofish_GCM::encrypt(
             spdlog::debug("Twofish-GCM: Using provided nonce (testing mode)");
         } else {
             // Generate NEW unique nonce for THIS encryption
-            Botan::AutoSeeded_RNG rng;
+            auto& rng = core::SecureRandom::thread_rng();
             nonce.resize(nonce_size());
             rng.randomize(nonce.data(), nonce.size());
             spdlog::debug("Twofish-GCM: Generated new unique nonce ({} bytes)", nonce.size());
@@ -331,6 +332,11 @@ std::vector<uint8_t> Twofish_GCM::process_gcm(
     return buffer;
 }
 
+std::unique_ptr<core::ICipherContext> Twofish_GCM::make_context(std::span<const uint8_t> key) {
+    // Associated data was never bound by this cipher; keep its output unchanged
+    return std::make_unique<AeadContext>(botan_name_, type_, key, key_size(), false);
+}
+
 } // namespace symmetric
 } // namespace algorithms
 } // namespace filevault
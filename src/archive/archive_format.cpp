@@ -1,5 +1,5 @@
 #include "filevault/archive/archive_format.hpp"
-#include <fstream>
+#include "filevault/core/io_backend.hpp"
 #include <cstring>
 #include <chrono>
 #include <stdexcept>
@@ -143,17 +143,19 @@ std::vector<uint8_t> ArchiveFormat::create_archive(const std::vector<fs::path>&
         archive.insert(archive.end(), entry_data.begin(), entry_data.end());
     }
     
-    // Write file data
+    // Write file data (read straight into the archive buffer; honours --io/--cache)
+    const auto io_options = core::IOBackend::default_options();
     for (size_t i = 0; i < files.size(); ++i) {
-        std::ifstream file(files[i], std::ios::binary);
+        auto file = core::IOBackend::open_reader(files[i].string(), io_options);
         if (!file) {
             throw std::runtime_error("Failed to open: " + files[i].string());
         }
         
-        std::vector<uint8_t> file_data(entries[i].file_size);
-        file.read(reinterpret_cast<char*>(file_data.data()), entries[i].file_size);
-        
-        archive.insert(archive.end(), file_data.begin(), file_data.end());
+        size_t start = archive.size();
+        archive.resize(start + entries[i].file_size);
+        if (file.value->read(archive.data() + start, entries[i].file_size) != entries[i].file_size) {
+            throw std::runtime_error("Failed to read: " + files[i].string());
+        }
     }
     
     return archive;
@@ -197,21 +199,23 @@ bool ArchiveFormat::extract_archive(
     }
     
     // Extract files
+    const auto io_options = core::IOBackend::default_options();
     for (const auto& entry : entries) {
         fs::path output_path = output_dir / entry.filename;
         
-        std::ofstream out_file(output_path, std::ios::binary);
+        auto out_file = core::IOBackend::open_writer(output_path.string(), io_options);
         if (!out_file) {
             return false;
         }
         
         size_t file_offset = data_section_offset + entry.offset;
-        out_file.write(
-            reinterpret_cast<const char*>(&archive_data[file_offset]),
-            entry.file_size
-        );
-        
-        out_file.close();
+        try {
+            out_file.value->write(&archive_data[file_offset], entry.file_size);
+            out_file.value->flush();
+        } catch (const std::exception&) {
+            return false;
+        }
+        out_file.value.reset();
         
         // Restore modification time
         auto ftime = fs::file_time_type::clock::now() + 
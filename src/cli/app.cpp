@@ -15,6 +15,10 @@
 #include "filevault/cli/commands/sign_cmd.hpp"
 #include "filevault/cli/commands/verify_cmd.hpp"
 #include "filevault/cli/commands/keyinfo_cmd.hpp"
+#include "filevault/cli/commands/update_cmd.hpp"
+#include "filevault/cli/commands/verify_integrity_cmd.hpp"
+#include "filevault/core/io_backend.hpp"
+#include "filevault/core/memory_budget.hpp"
 #include "filevault/utils/console.hpp"
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
@@ -43,6 +47,31 @@ void Application::initialize() {
     app_.add_flag("-v,--verbose", verbose_, "Verbose output");
     app_.add_option("--log-level", log_level_, "Log level (debug, info, warn, error)")
         ->check(CLI::IsMember({"debug", "info", "warn", "error"}));
+    // Applied as soon as the option is parsed, before any subcommand callback runs
+    app_.add_option("--io", io_backend_, "File I/O backend (sync, uring)")
+        ->check(CLI::IsMember({"sync", "uring"}))
+        ->each([](const std::string& value) {
+            if (auto backend = core::IOBackend::parse(value)) {
+                core::IOBackend::set_default_backend(*backend);
+            }
+        });
+    app_.add_flag("--direct-io", direct_io_, "Bypass the page cache with O_DIRECT (Linux, streaming files)")
+        ->each([](const std::string&) {
+            core::IOBackend::set_default_direct(true);
+        });
+    app_.add_option("--cache", cache_policy_, "Page-cache policy for bulk file I/O (keep, drop)")
+        ->check(CLI::IsMember({"keep", "drop"}))
+        ->each([](const std::string& value) {
+            if (auto policy = core::IOBackend::parse_cache_policy(value)) {
+                core::IOBackend::set_default_cache_policy(*policy);
+            }
+        });
+    app_.add_option("--max-memory", max_memory_,
+                    "Memory budget shared by key derivation, compression and chunk buffers (e.g. 2GB)")
+        ->transform(CLI::AsSizeValue(false))
+        ->each([](const std::string& value) {
+            core::MemoryBudget::global().set_limit(std::stoull(value));
+        });
     
     // Register commands
     register_commands();
@@ -121,6 +150,8 @@ void Application::register_commands() {
     commands_.push_back(std::make_unique<commands::SignCommand>(*engine_));
     commands_.push_back(std::make_unique<commands::VerifyCommand>(*engine_));
     commands_.push_back(std::make_unique<commands::KeyInfoCommand>(*engine_));
+    commands_.push_back(std::make_unique<UpdateCommand>(*engine_));
+    commands_.push_back(std::make_unique<VerifyIntegrityCommand>(*engine_));
     
     // Setup each command
     for (auto& cmd : commands_) {
@@ -131,7 +162,8 @@ void Application::register_commands() {
 }
 
 void Application::setup_logging() {
-    auto console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+    // Log to stderr so stdout can carry data in pipe mode (encrypt - -)
+    auto console_sink = std::make_shared<spdlog::sinks::stderr_color_sink_mt>();
     auto logger = std::make_shared<spdlog::logger>("filevault", console_sink);
     
     spdlog::set_default_logger(logger);
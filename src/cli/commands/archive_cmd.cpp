@@ -4,6 +4,7 @@
 #include "filevault/utils/file_io.hpp"
 #include "filevault/utils/console.hpp"
 #include "filevault/utils/password.hpp"
+#include "filevault/core/algorithm_registry.hpp"
 #include "filevault/core/file_format.hpp"
 #include <fmt/core.h>
 #include <filesystem>
@@ -221,7 +222,8 @@ int ArchiveCommand::do_create() {
     // Generate salt and derive key
     auto salt = engine_.generate_salt(32);
     auto key = engine_.derive_key(password_, salt, config);
-    auto nonce = engine_.generate_nonce(12);
+    auto* algo_info = core::find_algorithm(algo_type);
+    auto nonce = engine_.generate_nonce(algo_info ? algo_info->nonce_size : 12);
     config.nonce = nonce;
     
     // Get algorithm and encrypt
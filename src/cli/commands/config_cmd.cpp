@@ -38,6 +38,7 @@ void ConfigCommand::setup(CLI::App& app) {
         "  Reset config:          filevault config reset\n"
         "\n"
         "Symmetric algorithms: aes-128-gcm, aes-192-gcm, aes-256-gcm, chacha20-poly1305,\n"
+        "  aes-{128,192,256}-ocb, aegis-128l, aegis-256,\n"
         "  serpent-256-gcm, twofish-{128,192,256}-gcm, camellia-{128,192,256}-gcm,\n"
         "  aria-{128,192,256}-gcm, sm4-gcm, aes-{128,192,256}-{cbc,ctr,cfb,ofb,ecb,xts}\n"
         "Asymmetric: rsa-{2048,3072,4096}, ecc-{p256,p384,p521}\n"
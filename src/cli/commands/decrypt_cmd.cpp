@@ -1,6 +1,8 @@
 #include "filevault/cli/commands/decrypt_cmd.hpp"
 #include "filevault/format/file_header.hpp"
 #include "filevault/core/file_format.hpp"
+#include "filevault/core/streaming.hpp"
+#include "filevault/core/streaming_reader.hpp"
 #include "filevault/utils/console.hpp"
 #include "filevault/utils/file_io.hpp"
 #include "filevault/utils/crypto_utils.hpp"
@@ -9,6 +11,7 @@
 #include "filevault/compression/compressor.hpp"
 #include <spdlog/spdlog.h>
 #include <iostream>
+#include <fstream>
 
 namespace filevault {
 namespace cli {
@@ -20,12 +23,14 @@ DecryptCommand::DecryptCommand(core::CryptoEngine& engine)
 void DecryptCommand::setup(CLI::App& app) {
     auto* cmd = app.add_subcommand(name(), description());
     
-    cmd->add_option("input", input_file_, "Input encrypted file")
+    cmd->add_option("input", input_file_, "Input encrypted file ('-' for stdin)")
         ->required()
-        ->check(CLI::ExistingFile);
+        ->check(CLI::ExistingFile | CLI::IsMember({"-"}));
     
-    cmd->add_option("output", output_file_, "Output decrypted file");
+    cmd->add_option("output", output_file_, "Output decrypted file ('-' for stdout)");
     cmd->add_option("-p,--password", password_, "Decryption password (not recommended)");
+    cmd->add_option("--range", range_, "Decrypt only OFFSET:LENGTH bytes of a streaming file");
+    cmd->add_option("-j,--threads", threads_, "Worker threads for streaming files (0 = all cores)");
     cmd->add_flag("-v,--verbose", verbose_, "Verbose output");
     cmd->add_flag("--no-progress", no_progress_, "Disable progress bars");
     
@@ -35,8 +40,10 @@ void DecryptCommand::setup(CLI::App& app) {
         "  Specify output:        filevault decrypt secret.fvlt -o output.txt\n"
         "  With password arg:     filevault decrypt file.fvlt -p mypassword\n"
         "  Verbose mode:          filevault decrypt file.fvlt -v\n"
+        "  Byte range (FVST):     filevault decrypt big.fvlt part.bin --range 1048576:4096\n"
+        "  Pipe (FVST):           filevault decrypt - - -p \"$PW\" < db.fvst | psql db\n"
         "\n"
-        "Supported formats: .fvlt (FileVault encrypted files)\n"
+        "Supported formats: .fvlt (FileVault encrypted files), streaming FVST files\n"
         "Automatically detects: algorithm, mode, KDF settings from header\n"
     );
     
@@ -49,9 +56,24 @@ void DecryptCommand::setup(CLI::App& app) {
 }
 
 int DecryptCommand::execute() {
+    // Pipe mode: stdout may carry plaintext, so all messages go to stderr
+    const bool pipe_mode = input_file_ == "-" || output_file_ == "-";
+    if (input_file_ == "-" && output_file_.empty()) {
+        output_file_ = "-";
+    }
+    if (output_file_ == "-") {
+        utils::Console::set_stream(stderr);
+    }
+    
     try {
         utils::Console::header("FileVault Decryption");
         
+        // stdin may carry the ciphertext, so no interactive prompts in pipe mode
+        if (pipe_mode && password_.empty()) {
+            utils::Console::error("Use -p/--password when streaming through stdin/stdout");
+            return 1;
+        }
+        
         // Get password securely if not provided
         if (password_.empty()) {
             password_ = utils::Password::read_secure("Enter decryption password: ", false);
@@ -78,6 +100,23 @@ int DecryptCommand::execute() {
         utils::Console::info(fmt::format("Output: {}", output_file_));
         utils::Console::separator();
         
+        if (!range_.empty()) {
+            if (pipe_mode) {
+                utils::Console::error("--range needs a seekable input and output file");
+                return 1;
+            }
+            return execute_range();
+        }
+        
+        if (pipe_mode) {
+            return execute_stream();
+        }
+        
+        // Streaming files are decrypted chunk by chunk, never loaded whole
+        if (core::StreamingCrypto::is_streaming_file(input_file_)) {
+            return execute_streaming_file();
+        }
+        
         // Read encrypted file
         auto file_result = utils::FileIO::read_file(input_file_);
         if (!file_result) {
@@ -314,5 +353,169 @@ int DecryptCommand::execute() {
     }
 }
 
+int DecryptCommand::execute_range() {
+    if (!core::StreamingCrypto::is_streaming_file(input_file_)) {
+        utils::Console::error("--range requires a streaming (FVST) encrypted file");
+        return 1;
+    }
+    
+    // Parse OFFSET:LENGTH (LENGTH omitted = to end of stream)
+    uint64_t offset = 0;
+    uint64_t length = UINT64_MAX;
+    try {
+        auto colon = range_.find(':');
+        offset = std::stoull(range_.substr(0, colon));
+        if (colon != std::string::npos && colon + 1 < range_.size()) {
+            length = std::stoull(range_.substr(colon + 1));
+        }
+    } catch (const std::exception&) {
+        utils::Console::error(fmt::format("Invalid range '{}', expected OFFSET:LENGTH", range_));
+        return 1;
+    }
+    
+    core::StreamingReader reader;
+    auto opened = reader.open(input_file_, password_);
+    if (!opened) {
+        utils::Console::error(opened.error_message);
+        return 1;
+    }
+    
+    if (offset > reader.size()) {
+        utils::Console::error(fmt::format("Range starts beyond end of stream ({} bytes)", reader.size()));
+        return 1;
+    }
+    length = (std::min)(length, reader.size() - offset);
+    
+    utils::Console::info(fmt::format("Range:  {} bytes at offset {} ({} chunk index)",
+                                     length, offset,
+                                     reader.has_index_footer() ? "footer" : "scanned"));
+    
+    std::ofstream output(output_file_, std::ios::binary);
+    if (!output) {
+        utils::Console::error("Failed to create output file: " + output_file_);
+        return 1;
+    }
+    
+    auto sought = reader.seek(offset);
+    if (!sought) {
+        utils::Console::error(sought.error_message);
+        return 1;
+    }
+    
+    // Copy in pieces so large ranges stay within a few cached chunks
+    const uint64_t piece_size = 4 * 1024 * 1024;
+    uint64_t remaining = length;
+    while (remaining > 0) {
+        auto piece = reader.read(static_cast<size_t>((std::min)(remaining, piece_size)));
+        if (!piece) {
+            utils::Console::error(piece.error_message);
+            if (piece.error_message.find("Authentication failed") != std::string::npos) {
+                utils::Console::error("Wrong password or file corrupted/tampered");
+            }
+            return 1;
+        }
+        output.write(reinterpret_cast<const char*>(piece.value.data()), piece.value.size());
+        remaining -= piece.value.size();
+    }
+    
+    if (!output) {
+        utils::Console::error("Failed to write output file: " + output_file_);
+        return 1;
+    }
+    
+    utils::Console::separator();
+    utils::Console::success("Range decryption completed!");
+    utils::Console::info(fmt::format("Output: {} ({})", output_file_,
+                                     utils::CryptoUtils::format_bytes(length)));
+    return 0;
+}
+
+int DecryptCommand::execute_streaming_file() {
+    core::StreamingConfig options;
+    options.threads = threads_;
+    
+    std::unique_ptr<utils::ProgressBar> progress;
+    if (!no_progress_) {
+        progress = std::make_unique<utils::ProgressBar>("Decrypting", 100);
+        options.progress_callback = [&progress](const core::ChunkInfo& info) {
+            if (info.total_bytes > 0) {
+                progress->set_progress(info.bytes_processed * 100 / info.total_bytes);
+            }
+            return true;
+        };
+    }
+    
+    utils::Console::info("Format: Streaming (FVST)");
+    auto result = core::StreamingCrypto::decrypt_file(input_file_, output_file_, password_, options);
+    if (!result.success) {
+        utils::Console::error(result.error_message);
+        if (result.error_message.find("Authentication failed") != std::string::npos) {
+            utils::Console::error("Wrong password or file corrupted/tampered");
+        }
+        return 1;
+    }
+    if (progress) {
+        progress->mark_as_completed();
+    }
+    
+    utils::Console::separator();
+    utils::Console::success("Decryption completed!");
+    utils::Console::info(fmt::format("Output: {} ({}, {} chunks, {:.1f} MB/s)", output_file_,
+                                     utils::CryptoUtils::format_bytes(result.bytes_processed),
+                                     result.chunks_processed, result.throughput_mbps));
+    return 0;
+}
+
+int DecryptCommand::execute_stream() {
+    std::ifstream input_file;
+    std::ofstream output_file;
+    std::istream* input = &std::cin;
+    std::ostream* output = &std::cout;
+    
+    if (input_file_ == "-") {
+        utils::FileIO::set_binary_mode(stdin);
+    } else {
+        if (!core::StreamingCrypto::is_streaming_file(input_file_)) {
+            utils::Console::error("Only streaming (FVST) files can be decrypted to stdout");
+            return 1;
+        }
+        input_file.open(input_file_, std::ios::binary);
+        if (!input_file) {
+            utils::Console::error("Cannot open file: " + input_file_);
+            return 1;
+        }
+        input = &input_file;
+    }
+    
+    if (output_file_ == "-") {
+        utils::FileIO::set_binary_mode(stdout);
+    } else {
+        output_file.open(output_file_, std::ios::binary);
+        if (!output_file) {
+            utils::Console::error("Cannot create file: " + output_file_);
+            return 1;
+        }
+        output = &output_file;
+    }
+    
+    core::StreamingConfig options;
+    options.threads = threads_;
+    auto result = core::StreamingCrypto::decrypt_stream(*input, *output, password_, options);
+    if (!result.success) {
+        utils::Console::error(result.error_message);
+        if (result.error_message.find("Authentication failed") != std::string::npos) {
+            utils::Console::error("Wrong password or file corrupted/tampered");
+        }
+        return 1;
+    }
+    
+    utils::Console::separator();
+    utils::Console::success("Decryption completed!");
+    utils::Console::info(fmt::format("Processed {} in {} chunks ({:.1f} MB/s)",
+                                     utils::CryptoUtils::format_bytes(result.bytes_processed),
+                                     result.chunks_processed, result.throughput_mbps));
+    return 0;
+}
+
 } // namespace cli
 } // namespace filevault
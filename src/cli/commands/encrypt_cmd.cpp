@@ -1,7 +1,13 @@
 #include "filevault/cli/commands/encrypt_cmd.hpp"
+#include "filevault/core/algorithm_registry.hpp"
+#include "filevault/core/cpu_features.hpp"
 #include "filevault/format/file_header.hpp"
 #include "filevault/core/file_format.hpp"
+#include "filevault/core/io_backend.hpp"
 #include "filevault/core/modes.hpp"
+#include "filevault/core/streaming.hpp"
+#include "filevault/core/system_resources.hpp"
+#include "filevault/utils/config.hpp"
 #include "filevault/utils/console.hpp"
 #include "filevault/utils/file_io.hpp"
 #include "filevault/utils/crypto_utils.hpp"
@@ -10,6 +16,8 @@
 #include "filevault/compression/compressor.hpp"
 #include <spdlog/spdlog.h>
 #include <chrono>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 
 namespace filevault {
@@ -22,25 +30,30 @@ EncryptCommand::EncryptCommand(core::CryptoEngine& engine)
 void EncryptCommand::setup(CLI::App& app) {
     auto* encrypt_cmd = app.add_subcommand(name(), description());
     
-    encrypt_cmd->add_option("input", input_file_, "Input file to encrypt")
+    encrypt_cmd->add_option("input", input_file_, "Input file to encrypt ('-' for stdin)")
         ->required()
-        ->check(CLI::ExistingFile);
+        ->check(CLI::ExistingFile | CLI::IsMember({"-"}));
     
-    encrypt_cmd->add_option("output", output_file_, "Output encrypted file");
+    encrypt_cmd->add_option("output", output_file_, "Output encrypted file ('-' for stdout)");
     
     encrypt_cmd->add_option("-m,--mode", mode_, "Mode preset (overrides other options)")
         ->check(CLI::IsMember({"basic", "standard", "advanced"}));
     
     encrypt_cmd->add_option("-a,--algorithm", algorithm_, "Encryption algorithm")
         ->check(CLI::IsMember({
+            // Fastest AEAD on this machine
+            "auto",
             // Modern AEAD algorithms
             "aes-128-gcm", "aes-192-gcm", "aes-256-gcm", 
+            "aes-128-ocb", "aes-192-ocb", "aes-256-ocb",
             "chacha20-poly1305", "serpent-256-gcm",
             "twofish-128-gcm", "twofish-192-gcm", "twofish-256-gcm",
             // International standards
             "camellia-128-gcm", "camellia-192-gcm", "camellia-256-gcm",
             "aria-128-gcm", "aria-192-gcm", "aria-256-gcm",
             "sm4-gcm",
+            // High-throughput AEAD (AES instructions)
+            "aegis-128l", "aegis-256",
             // Non-AEAD modes (CBC)
             "aes-128-cbc", "aes-192-cbc", "aes-256-cbc",
             // Non-AEAD modes (CTR)
@@ -88,6 +101,29 @@ void EncryptCommand::setup(CLI::App& app) {
     encrypt_cmd->add_flag("-y,--yes,--force", force_weak_password_, 
                          "Skip weak password prompt (accept automatically)");
     
+    encrypt_cmd->add_option("--checkpoint", checkpoint_interval_,
+                           "Stream the file and journal progress every N chunks so an interrupted run can be resumed")
+        ->check(CLI::PositiveNumber);
+    
+    encrypt_cmd->add_flag("--resume", resume_,
+                         "Continue an interrupted --checkpoint run (same input, output and password)");
+    
+    encrypt_cmd->add_flag("--append", append_,
+                         "Add the input to the end of an existing streaming output (same password)");
+    
+    encrypt_cmd->add_flag("--stream", stream_,
+                         "Always use the chunked streaming format (constant memory, parallel)");
+    
+    encrypt_cmd->add_option("--stream-threshold", stream_threshold_,
+                           "Stream inputs larger than this (e.g. 512MB; default 100MiB)")
+        ->transform(CLI::AsSizeValue(false));
+    
+    encrypt_cmd->add_option("--chunk-size", chunk_size_, "Streaming chunk size (e.g. 16MB; default sized to available memory)")
+        ->transform(CLI::AsSizeValue(false))
+        ->check(CLI::Range(size_t(4096), core::StreamingCrypto::MAX_CHUNK_SIZE));
+    
+    encrypt_cmd->add_option("-j,--threads", threads_, "Streaming worker threads (0 = all cores)");
+    
     encrypt_cmd->footer(
         "\nExamples:\n"
         "  Basic encryption:      filevault encrypt file.txt -m basic\n"
@@ -96,8 +132,14 @@ void EncryptCommand::setup(CLI::App& app) {
         "  Custom algorithm:      filevault encrypt file.txt -a aes-256-gcm\n"
         "  With compression:      filevault encrypt file.txt --compression lzma\n"
         "  Skip weak password:    filevault encrypt file.txt -m standard --yes\n"
+        "  Pipe (stdin->stdout):  pg_dump db | filevault encrypt - - -p \"$PW\" > db.fvst\n"
+        "  Resumable:             filevault encrypt big.img big.fvst --checkpoint 16\n"
+        "  After an interruption: filevault encrypt big.img big.fvst --checkpoint 16 --resume\n"
+        "  Append to a stream:    filevault encrypt today.log logs.fvst --append\n"
+        "  Large file, 8 threads: filevault encrypt disk.img --stream --chunk-size 16MB -j 8\n"
         "\n"
         "Symmetric algorithms: aes-128-gcm, aes-192-gcm, aes-256-gcm, chacha20-poly1305,\n"
+        "  aes-{128,192,256}-ocb, aegis-128l, aegis-256,\n"
         "  serpent-256-gcm, twofish-{128,192,256}-gcm, camellia-{128,192,256}-gcm,\n"
         "  aria-{128,192,256}-gcm, sm4-gcm, aes-{128,192,256}-{cbc,ctr,cfb,ofb,ecb,xts}\n"
         "Asymmetric: rsa-{2048,3072,4096}, ecc-{p256,p384,p521}\n"
@@ -105,6 +147,8 @@ void EncryptCommand::setup(CLI::App& app) {
         "Classical: caesar, vigenere, playfair, substitution, hill\n"
         "KDF options: argon2id, argon2i, pbkdf2-sha256, pbkdf2-sha512, scrypt\n"
         "Compression: none, zlib, bzip2, lzma (levels 1-9)\n"
+        "Inputs above --stream-threshold are encrypted chunk by chunk (FVST format),\n"
+        "so memory use stays bounded; streaming needs an AEAD algorithm.\n"
     );
     
     encrypt_cmd->callback([this]() { 
@@ -116,13 +160,30 @@ void EncryptCommand::setup(CLI::App& app) {
 }
 
 int EncryptCommand::execute() {
+    // Pipe mode: stdout may carry ciphertext, so all messages go to stderr
+    const bool pipe_mode = input_file_ == "-" || output_file_ == "-";
+    if (input_file_ == "-" && output_file_.empty()) {
+        output_file_ = "-";
+    }
+    if (output_file_ == "-") {
+        utils::Console::set_stream(stderr);
+    }
+    
     try {
         utils::Console::header("FileVault Encryption");
         
+        // Presets and "auto" choose from the same saved benchmark figures
+        const auto& cpu = core::CpuFeatures::current();
+        std::vector<core::AeadThroughput> measured;
+        if (!mode_.empty() || algorithm_ == "auto") {
+            measured = core::AutoAlgorithm::load_measurements(
+                utils::Config::get_benchmark_cache_path(), cpu);
+        }
+        
         // Apply mode preset if specified (only for options not explicitly set)
         if (!mode_.empty()) {
             auto user_mode = core::ModePreset::parse_mode(mode_);
-            auto preset = core::ModePreset::get_preset(user_mode);
+            auto preset = core::ModePreset::get_preset(user_mode, measured);
             
             // Only apply preset values if user didn't explicitly specify the option
             if (algorithm_.empty()) {
@@ -145,6 +206,21 @@ int EncryptCommand::execute() {
                                preset.name(), preset.description()));
         }
         
+        // Resolve "auto" from saved benchmark figures, else from the CPU probe
+        if (algorithm_ == "auto") {
+            algorithm_ = engine_.algorithm_name(core::AutoAlgorithm::choose(cpu, measured));
+            utils::Console::info(fmt::format("Auto-selected {} ({})", algorithm_,
+                measured.empty()
+                    ? (cpu.hardware_aes() ? "AES instructions available" : "no AES instructions")
+                    : "fastest in saved benchmark"));
+        }
+        
+        // stdin may carry the plaintext, so no interactive prompts in pipe mode
+        if (pipe_mode && password_.empty()) {
+            utils::Console::error("Use -p/--password when streaming through stdin/stdout");
+            return 1;
+        }
+        
         // Get password securely if not provided
         if (password_.empty()) {
             // Try up to 3 times to get a valid password
@@ -183,7 +259,10 @@ int EncryptCommand::execute() {
                                        utils::Password::get_strength_label(strength_analysis.strength),
                                        static_cast<int>(strength_analysis.score)));
                 
-                if (!force_weak_password_) {
+                if (!force_weak_password_ && pipe_mode) {
+                    utils::Console::error("Weak password rejected; pass --yes to accept it when streaming");
+                    return 1;
+                } else if (!force_weak_password_) {
                     fmt::print("Continue with weak password? (y/N): ");
                     std::string response;
                     std::getline(std::cin, response);
@@ -198,6 +277,31 @@ int EncryptCommand::execute() {
             }
         }
         
+        const bool checkpointed = checkpoint_interval_ > 0 || resume_;
+        if (checkpointed && pipe_mode) {
+            utils::Console::error("--checkpoint and --resume need a file input and output");
+            return 1;
+        }
+        if (append_ && (pipe_mode || output_file_.empty() || checkpointed)) {
+            utils::Console::error("--append needs a file input and an existing output file");
+            return 1;
+        }
+        if (pipe_mode || checkpointed || append_ || stream_) {
+            return execute_stream();
+        }
+        
+        // Large inputs would need several in-memory copies; stream them when the algorithm allows
+        bool large_input = false;
+        if (core::StreamingCrypto::should_use_streaming(input_file_, stream_threshold_)) {
+            auto algo_type = engine_.parse_algorithm(algorithm_);
+            if (algo_type && core::StreamingCrypto::supports_algorithm(*algo_type)) {
+                utils::Console::info(fmt::format("Input exceeds {}, using streaming encryption",
+                                                 utils::CryptoUtils::format_bytes(stream_threshold_)));
+                return execute_stream();
+            }
+            large_input = true;
+        }
+        
         // Set output file if not specified
         if (output_file_.empty()) {
             output_file_ = input_file_ + ".fvlt";
@@ -211,58 +315,6 @@ int EncryptCommand::execute() {
         utils::Console::info(fmt::format("KDF:       {}", kdf_));
         utils::Console::separator();
         
-        // Read input file
-        auto file_result = utils::FileIO::read_file(input_file_);
-        if (!file_result) {
-            utils::Console::error(file_result.error_message);
-            return 1;
-        }
-        
-        auto plaintext = file_result.value;
-        utils::Console::info(fmt::format("Read {} bytes", plaintext.size()));
-        
-        // Step 1: Compress if requested
-        bool compressed = false;
-        core::CompressionType comp_type = core::CompressionType::NONE;
-        size_t original_size = plaintext.size();
-        
-        if (compression_type_ != "none") {
-            utils::Console::info(fmt::format("Compressing with {}...", compression_type_));
-            
-            comp_type = compression::CompressionService::parse_algorithm(compression_type_);
-            
-            auto compressor = compression::CompressionService::create(comp_type);
-            if (!compressor) {
-                utils::Console::error("Failed to create compressor");
-                return 1;
-            }
-            
-            std::unique_ptr<utils::ProgressBar> compress_progress;
-            if (!no_progress_) {
-                compress_progress = std::make_unique<utils::ProgressBar>("Compressing", 100);
-                compress_progress->set_progress(50);  // Show activity
-            }
-            
-            auto compress_result = compressor->compress(plaintext, compression_level_);
-            
-            if (compress_progress) {
-                compress_progress->mark_as_completed();
-            }
-            
-            if (!compress_result.success) {
-                utils::Console::error(compress_result.error_message);
-                return 1;
-            }
-            
-            plaintext = std::move(compress_result.data);
-            compressed = true;
-            
-            utils::Console::info(fmt::format("Compressed: {} -> {} bytes ({:.1f}% ratio)",
-                               original_size,
-                               plaintext.size(),
-                               compress_result.compression_ratio));
-        }
-        
         spdlog::debug("Parsing configuration...");
         // Parse configuration
         auto algo_type_opt = engine_.parse_algorithm(algorithm_);
@@ -322,7 +374,13 @@ int EncryptCommand::execute() {
         config.level = sec_level;
         config.apply_security_level();
         
-        // Step 2: Generate salt and derive key
+        // More Argon2 lanes than usable CPUs only adds contention; the header records the value
+        if (kdf_type == core::KDFType::ARGON2ID || kdf_type == core::KDFType::ARGON2I) {
+            config.kdf_parallelism = static_cast<uint32_t>((std::min)(
+                size_t(config.kdf_parallelism), core::SystemResources::current().cpu_count));
+        }
+        
+        // Step 1: Generate salt and derive key
         utils::Console::info("Deriving key...");
         std::unique_ptr<utils::ProgressBar> kdf_progress;
         if (!no_progress_) {
@@ -337,10 +395,88 @@ int EncryptCommand::execute() {
             kdf_progress->mark_as_completed();
         }
         
-        // Generate nonce and add to config
-        auto nonce = engine_.generate_nonce(12); // GCM standard
+        // Generate nonce and add to config (12 bytes except for AEGIS)
+        auto* algo_info = core::find_algorithm(algo_type);
+        auto nonce = engine_.generate_nonce(algo_info ? algo_info->nonce_size : 12);
         config.nonce = nonce;
         
+        // Uncompressed input goes through an incremental session when the
+        // algorithm has one: ciphertext is written as it is produced, so memory
+        // stays at one block and the file layout is unchanged
+        if (compression_type_ == "none") {
+            auto session = algorithm->begin_encryption(key, {});
+            if (session) {
+                auto header = core::FileFormatHandler::create_header(
+                    algo_type, kdf_type, config, salt, session.value->nonce(), false);
+                auto written = encrypt_incremental(*session.value, header);
+                if (!written) {
+                    utils::Console::error(written.error_message);
+                    return 1;
+                }
+                return report_output(written.value);
+            }
+            spdlog::debug("No incremental session: {}", session.error_message);
+        }
+        if (large_input) {
+            utils::Console::warning(fmt::format("{} cannot be streamed; the whole input is loaded into memory",
+                                                algorithm_));
+        }
+        
+        // Read input file
+        auto file_result = utils::FileIO::read_file(input_file_);
+        if (!file_result) {
+            utils::Console::error(file_result.error_message);
+            return 1;
+        }
+        
+        auto plaintext = file_result.value;
+        utils::Console::info(fmt::format("Read {} bytes", plaintext.size()));
+        
+        // Step 2: Compress if requested
+        bool compressed = false;
+        core::CompressionType comp_type = core::CompressionType::NONE;
+        size_t original_size = plaintext.size();
+        
+        if (compression_type_ != "none") {
+            utils::Console::info(fmt::format("Compressing with {}...", compression_type_));
+            
+            comp_type = compression::CompressionService::parse_algorithm(compression_type_);
+            
+            auto compressor = compression::CompressionService::create(comp_type);
+            if (!compressor) {
+                utils::Console::error("Failed to create compressor");
+                return 1;
+            }
+            
+            std::unique_ptr<utils::ProgressBar> compress_progress;
+            if (!no_progress_) {
+                compress_progress = std::make_unique<utils::ProgressBar>("Compressing", 100);
+                compress_progress->set_progress(50);  // Show activity
+            }
+            
+            auto compress_result = compressor->compress(plaintext, compression_level_);
+            
+            if (compress_progress) {
+                compress_progress->mark_as_completed();
+            }
+            
+            if (!compress_result.success) {
+                utils::Console::error(compress_result.error_message);
+                return 1;
+            }
+            
+            plaintext = std::move(compress_result.data);
+            compressed = true;
+            
+            utils::Console::info(fmt::format("Compressed: {} -> {} bytes ({:.1f}% ratio)",
+                               original_size,
+                               plaintext.size(),
+                               compress_result.compression_ratio));
+        }
+        
+        // Only AEAD algorithms (GCM, OCB, ChaCha20-Poly1305, AEGIS) have authentication tags
+        bool is_aead = algo_info && algo_info->aead;
+        
         // Step 3: Encrypt
         utils::Console::info("Encrypting...");
         std::unique_ptr<utils::ProgressBar> encrypt_progress;
@@ -349,25 +485,45 @@ int EncryptCommand::execute() {
             encrypt_progress->set_progress(50);  // Show activity
         }
         
-        auto encrypt_result = algorithm->encrypt(plaintext, key, config);
+        const size_t plaintext_size = plaintext.size();
+        std::vector<uint8_t> ciphertext_only;
+        std::vector<uint8_t> auth_tag;
+        std::vector<uint8_t> nonce_to_store = nonce;
+        auto encrypt_start = std::chrono::high_resolution_clock::now();
         
-        if (encrypt_progress) {
-            encrypt_progress->mark_as_completed();
+        if (is_aead) {
+            // AEAD output is as long as the input: encrypt the buffer in place
+            auth_tag.resize(16);
+            auto written = algorithm->encrypt_into(plaintext, plaintext, auth_tag, key, config);
+            if (!written.success) {
+                utils::Console::error(written.error_message);
+                return 1;
+            }
+            plaintext.resize(written.value);
+            ciphertext_only = std::move(plaintext);
+        } else {
+            auto encrypt_result = algorithm->encrypt(plaintext, key, config);
+            if (!encrypt_result.success) {
+                utils::Console::error(encrypt_result.error_message);
+                return 1;
+            }
+            
+            // For non-AEAD algorithms (CBC, CTR), use the IV/nonce from encrypt result
+            // The algorithm generates its own IV during encryption
+            if (encrypt_result.nonce.has_value() && !encrypt_result.nonce.value().empty()) {
+                nonce_to_store = encrypt_result.nonce.value();
+            }
+            ciphertext_only = std::move(encrypt_result.data);
+            // Classical ciphers don't have tags - auth_tag remains empty
         }
         
-        if (!encrypt_result.success) {
-            utils::Console::error(encrypt_result.error_message);
-            return 1;
+        if (encrypt_progress) {
+            encrypt_progress->mark_as_completed();
         }
         
-        utils::Console::info(fmt::format("Encrypted in {:.2f}ms", encrypt_result.processing_time_ms));
-        
-        // For non-AEAD algorithms (CBC, CTR), use the IV/nonce from encrypt result
-        // The algorithm generates its own IV during encryption
-        std::vector<uint8_t> nonce_to_store = nonce;
-        if (encrypt_result.nonce.has_value() && !encrypt_result.nonce.value().empty()) {
-            nonce_to_store = encrypt_result.nonce.value();
-        }
+        auto encrypt_end = std::chrono::high_resolution_clock::now();
+        utils::Console::info(fmt::format("Encrypted in {:.2f}ms",
+            std::chrono::duration<double, std::milli>(encrypt_end - encrypt_start).count()));
         
         // Create enhanced file header
         config.compression = compressed ? comp_type : core::CompressionType::NONE;
@@ -380,38 +536,6 @@ int EncryptCommand::execute() {
             compressed
         );
         
-        // Extract ciphertext and tag from CryptoResult
-        // AES_GCM::encrypt() stores them separately in result.data and result.tag
-        std::vector<uint8_t> ciphertext_only = encrypt_result.data;  // Already without tag
-        std::vector<uint8_t> auth_tag;
-        
-        // Only AEAD algorithms (GCM, ChaCha20-Poly1305) have authentication tags
-        bool is_aead = (algo_type == core::AlgorithmType::AES_128_GCM ||
-                       algo_type == core::AlgorithmType::AES_192_GCM ||
-                       algo_type == core::AlgorithmType::AES_256_GCM ||
-                       algo_type == core::AlgorithmType::CHACHA20_POLY1305 ||
-                       algo_type == core::AlgorithmType::SERPENT_256_GCM ||
-                       algo_type == core::AlgorithmType::TWOFISH_128_GCM ||
-                       algo_type == core::AlgorithmType::TWOFISH_192_GCM ||
-                       algo_type == core::AlgorithmType::TWOFISH_256_GCM ||
-                       algo_type == core::AlgorithmType::CAMELLIA_128_GCM ||
-                       algo_type == core::AlgorithmType::CAMELLIA_192_GCM ||
-                       algo_type == core::AlgorithmType::CAMELLIA_256_GCM ||
-                       algo_type == core::AlgorithmType::ARIA_128_GCM ||
-                       algo_type == core::AlgorithmType::ARIA_192_GCM ||
-                       algo_type == core::AlgorithmType::ARIA_256_GCM ||
-                       algo_type == core::AlgorithmType::SM4_GCM);
-        
-        if (is_aead) {
-            if (encrypt_result.tag.has_value()) {
-                auth_tag = encrypt_result.tag.value();
-            } else {
-                utils::Console::error("No authentication tag generated for AEAD algorithm");
-                return 1;
-            }
-        }
-        // Classical ciphers don't have tags - auth_tag remains empty
-        
         // Write enhanced format file
         bool write_success = core::FileFormatHandler::write_file(
             output_file_,
@@ -425,25 +549,223 @@ int EncryptCommand::execute() {
             return 1;
         }
         
-        // Get final file size
-        std::ifstream check_file(output_file_, std::ios::binary | std::ios::ate);
-        size_t final_size = check_file.tellg();
-        check_file.close();
+        return report_output(plaintext_size);
         
-        utils::Console::separator();
-        utils::Console::success("Encryption completed!");
-        utils::Console::info(fmt::format("Output: {} ({})", 
-                           output_file_, 
-                           utils::CryptoUtils::format_bytes(final_size)));
-        utils::Console::info(fmt::format("Compression: {:.1f}%", 
-                           100.0 * final_size / plaintext.size()));
+    } catch (const std::exception& e) {
+        utils::Console::error(fmt::format("Encryption failed: {}", e.what()));
+        return 1;
+    }
+}
+
+core::Result<size_t> EncryptCommand::encrypt_incremental(core::ICipherSession& session,
+                                                         const core::FileHeader& header) {
+    constexpr size_t BLOCK_SIZE = 1024 * 1024;
+    
+    // Global --io, --direct-io and --cache apply, as for streaming files
+    auto io_options = core::IOBackend::default_options();
+    io_options.direct = core::IOBackend::default_direct();
+    
+    auto input = core::IOBackend::open_reader(input_file_, io_options);
+    if (!input) {
+        return core::Result<size_t>::error("Failed to open input file: " + input_file_);
+    }
+    auto output = core::IOBackend::open_writer(output_file_, io_options);
+    if (!output) {
+        return core::Result<size_t>::error("Failed to create output file: " + output_file_);
+    }
+    
+    // Drop the partial output on any failure
+    auto fail = [&](const std::string& message) {
+        try {
+            output.value.reset();
+        } catch (const std::exception&) {
+        }
+        std::error_code ec;
+        std::filesystem::remove(output_file_, ec);
+        return core::Result<size_t>::error(message);
+    };
+    
+    const uint64_t input_size = input.value->size();
+    
+    utils::Console::info("Encrypting...");
+    std::unique_ptr<utils::ProgressBar> progress;
+    if (!no_progress_) {
+        progress = std::make_unique<utils::ProgressBar>("Encrypting", 100);
+    }
+    auto encrypt_start = std::chrono::high_resolution_clock::now();
+    
+    std::vector<uint8_t> in_block(BLOCK_SIZE);
+    std::vector<uint8_t> out_block(session.output_bound(BLOCK_SIZE));
+    size_t total = 0;
+    
+    try {
+        auto header_data = header.serialize();
+        output.value->write(header_data.data(), header_data.size());
         
-        return 0;
+        while (true) {
+            const size_t got = input.value->read(in_block.data(), in_block.size());
+            if (got == 0) {
+                break;
+            }
+            auto written = session.update(std::span(in_block).first(got), out_block);
+            if (!written) {
+                return fail(written.error_message);
+            }
+            output.value->write(out_block.data(), written.value);
+            total += got;
+            
+            if (progress && input_size > 0) {
+                progress->set_progress(total * 100 / input_size);
+            }
+        }
         
+        std::vector<uint8_t> auth_tag(session.tag_size());
+        auto written = session.finish(out_block, auth_tag);
+        if (!written) {
+            return fail(written.error_message);
+        }
+        output.value->write(out_block.data(), written.value);
+        output.value->write(auth_tag.data(), auth_tag.size());
+        output.value->flush();
+        output.value.reset();
     } catch (const std::exception& e) {
-        utils::Console::error(fmt::format("Encryption failed: {}", e.what()));
+        return fail(std::string("Failed to encrypt ") + input_file_ + ": " + e.what());
+    }
+    
+    if (progress) {
+        progress->mark_as_completed();
+    }
+    auto encrypt_end = std::chrono::high_resolution_clock::now();
+    utils::Console::info(fmt::format("Encrypted {} bytes in {:.2f}ms", total,
+        std::chrono::duration<double, std::milli>(encrypt_end - encrypt_start).count()));
+    
+    return core::Result<size_t>::ok(total);
+}
+
+int EncryptCommand::report_output(size_t plaintext_size) {
+    // Get final file size
+    std::ifstream check_file(output_file_, std::ios::binary | std::ios::ate);
+    size_t final_size = check_file.tellg();
+    check_file.close();
+    
+    utils::Console::separator();
+    utils::Console::success("Encryption completed!");
+    utils::Console::info(fmt::format("Output: {} ({})", 
+                       output_file_, 
+                       utils::CryptoUtils::format_bytes(final_size)));
+    if (plaintext_size > 0) {
+        utils::Console::info(fmt::format("Compression: {:.1f}%", 
+                           100.0 * final_size / plaintext_size));
+    }
+    
+    return 0;
+}
+
+int EncryptCommand::execute_stream() {
+    auto algo_type = engine_.parse_algorithm(algorithm_);
+    auto kdf_type = engine_.parse_kdf(kdf_);
+    auto sec_level = engine_.parse_security_level(security_level_);
+    if (!algo_type || !kdf_type || !sec_level) {
+        utils::Console::error("Invalid configuration parameters");
+        return 1;
+    }
+    
+    if (!append_ && !resume_ && !core::StreamingCrypto::supports_algorithm(*algo_type)) {
+        utils::Console::error(fmt::format("Streaming needs an AEAD algorithm (GCM or ChaCha20-Poly1305), not {}",
+                                          algorithm_));
+        return 1;
+    }
+    
+    core::StreamingConfig config;
+    config.algorithm = *algo_type;
+    config.kdf = *kdf_type;
+    config.level = *sec_level;
+    config.compression = compression::CompressionService::parse_algorithm(compression_type_);
+    config.compression_level = compression_level_;
+    config.checkpoint_interval = checkpoint_interval_;
+    config.threads = threads_;
+    config.chunk_size = chunk_size_ > 0 ? chunk_size_ : core::StreamingCrypto::get_recommended_chunk_size();
+    
+    if (input_file_ != "-" && output_file_.empty()) {
+        output_file_ = input_file_ + ".fvlt";
+    }
+    
+    utils::Console::info(fmt::format("Input:     {}", input_file_ == "-" ? "<stdin>" : input_file_));
+    utils::Console::info(fmt::format("Output:    {}", output_file_ == "-" ? "<stdout>" : output_file_));
+    utils::Console::info(fmt::format("Algorithm: {} (streaming, {} chunks)",
+                                     algorithm_, utils::CryptoUtils::format_bytes(config.chunk_size)));
+    utils::Console::separator();
+    
+    // Progress needs a known total, i.e. a file input
+    std::unique_ptr<utils::ProgressBar> progress;
+    if (!no_progress_ && input_file_ != "-" && output_file_ != "-") {
+        progress = std::make_unique<utils::ProgressBar>("Encrypting", 100);
+        config.progress_callback = [&progress](const core::ChunkInfo& info) {
+            if (info.total_bytes > 0) {
+                progress->set_progress(info.bytes_processed * 100 / info.total_bytes);
+            }
+            return true;
+        };
+    }
+    
+    core::StreamingResult result;
+    if (append_) {
+        result = core::StreamingCrypto::append_file(input_file_, output_file_, password_, config);
+    } else if (resume_) {
+        utils::Console::info("Resuming from " + core::StreamingCrypto::checkpoint_path(output_file_));
+        result = core::StreamingCrypto::resume_encrypt_file(input_file_, output_file_, password_, config);
+    } else if (input_file_ != "-" && output_file_ != "-") {
+        result = core::StreamingCrypto::encrypt_file(input_file_, output_file_, password_, config);
+    } else {
+        result = encrypt_pipe(config);
+    }
+    if (progress && result.success) {
+        progress->mark_as_completed();
+    }
+    if (!result.success) {
+        utils::Console::error(result.error_message);
         return 1;
     }
+    
+    utils::Console::separator();
+    utils::Console::success("Encryption completed!");
+    utils::Console::info(fmt::format("Processed {} in {} chunks ({:.1f} MB/s)",
+                                     utils::CryptoUtils::format_bytes(result.bytes_processed),
+                                     result.chunks_processed, result.throughput_mbps));
+    return 0;
+}
+
+core::StreamingResult EncryptCommand::encrypt_pipe(const core::StreamingConfig& config) {
+    std::ifstream input_file;
+    std::ofstream output_file;
+    std::istream* input = &std::cin;
+    std::ostream* output = &std::cout;
+    
+    if (input_file_ == "-") {
+        utils::FileIO::set_binary_mode(stdin);
+    } else {
+        input_file.open(input_file_, std::ios::binary);
+        if (!input_file) {
+            core::StreamingResult result;
+            result.error_message = "Cannot open file: " + input_file_;
+            return result;
+        }
+        input = &input_file;
+    }
+    
+    if (output_file_ == "-") {
+        utils::FileIO::set_binary_mode(stdout);
+    } else {
+        output_file.open(output_file_, std::ios::binary);
+        if (!output_file) {
+            core::StreamingResult result;
+            result.error_message = "Cannot create file: " + output_file_;
+            return result;
+        }
+        output = &output_file;
+    }
+    
+    return core::StreamingCrypto::encrypt_stream(*input, *output, password_, config);
 }
 
 } // namespace cli
@@ -47,6 +47,10 @@ void HashCommand::setup(CLI::App& app) {
         ->check(CLI::IsMember({"hex", "base64", "binary"}))
         ->default_val("hex");
     
+    cmd->add_option("--cache", cache_policy_,
+                   "Page-cache policy: keep, drop (drop evicts the file from cache as it is read)")
+        ->check(CLI::IsMember({"keep", "drop"}));
+    
     cmd->add_flag("--uppercase", uppercase_, 
                  "Output hash in uppercase");
     
@@ -68,6 +72,7 @@ void HashCommand::setup(CLI::App& app) {
         "  Verify hash:           filevault hash file.txt -v <expected-hash>\n"
         "  HMAC authentication:   filevault hash file.txt --hmac secretkey\n"
         "  Save to file:          filevault hash file.txt -o checksum.txt\n"
+        "  Hash without caching:  filevault hash disk.img --cache drop\n"
         "\n"
         // Hash algorithm: md5, sha1, sha224, sha256, sha384, sha512, sha3-256, sha3-512, blake2b-512, blake2s-256
         "Algorithms: md5 (insecure), sha1 (insecure), sha224, sha256, sha384, sha512,\n"
@@ -215,6 +220,14 @@ int HashCommand::execute() {
     }
 }
 
+core::IOOptions HashCommand::io_options() const {
+    auto options = core::IOBackend::default_options();
+    if (auto policy = core::IOBackend::parse_cache_policy(cache_policy_)) {
+        options.cache = *policy;
+    }
+    return options;
+}
+
 std::string HashCommand::calculate_file_hash(
     const std::string& filepath,
     const std::string& algorithm
@@ -224,15 +237,14 @@ std::string HashCommand::calculate_file_hash(
         throw std::runtime_error("Hash algorithm not available: " + algorithm);
     }
     
-    std::ifstream file(filepath, std::ios::binary);
+    // Sequential read hints; with --cache drop pages are released behind the cursor
+    auto file = core::IOBackend::open_reader(filepath, io_options());
     if (!file) {
         throw std::runtime_error("Cannot open file: " + filepath);
     }
     
     // Get file size for progress
-    file.seekg(0, std::ios::end);
-    size_t file_size = file.tellg();
-    file.seekg(0, std::ios::beg);
+    size_t file_size = static_cast<size_t>(file.value->size());
     
     // Read and hash in chunks
     const size_t CHUNK_SIZE = 64 * 1024;  // 64KB chunks
@@ -248,18 +260,14 @@ std::string HashCommand::calculate_file_hash(
         );
     }
     
-    while (file) {
-        file.read(reinterpret_cast<char*>(buffer.data()), CHUNK_SIZE);
-        std::streamsize bytes_read = file.gcount();
+    size_t bytes_read;
+    while ((bytes_read = file.value->read(buffer.data(), CHUNK_SIZE)) > 0) {
+        hash_func->update(buffer.data(), bytes_read);
+        total_read += bytes_read;
         
-        if (bytes_read > 0) {
-            hash_func->update(buffer.data(), bytes_read);
-            total_read += bytes_read;
-            
-            if (progress) {
-                size_t percentage = (total_read * 100) / file_size;
-                progress->set_progress(percentage);
-            }
+        if (progress) {
+            size_t percentage = (total_read * 100) / file_size;
+            progress->set_progress(percentage);
         }
     }
     
@@ -296,7 +304,7 @@ std::string HashCommand::calculate_file_hmac(
     hmac->set_key(key);
     
     // Read and process file
-    std::ifstream file(filepath, std::ios::binary);
+    auto file = core::IOBackend::open_reader(filepath, io_options());
     if (!file) {
         throw std::runtime_error("Cannot open file: " + filepath);
     }
@@ -304,13 +312,9 @@ std::string HashCommand::calculate_file_hmac(
     const size_t CHUNK_SIZE = 64 * 1024;
     std::vector<uint8_t> buffer(CHUNK_SIZE);
     
-    while (file) {
-        file.read(reinterpret_cast<char*>(buffer.data()), CHUNK_SIZE);
-        std::streamsize bytes_read = file.gcount();
-        
-        if (bytes_read > 0) {
-            hmac->update(buffer.data(), bytes_read);
-        }
+    size_t bytes_read;
+    while ((bytes_read = file.value->read(buffer.data(), CHUNK_SIZE)) > 0) {
+        hmac->update(buffer.data(), bytes_read);
     }
     
     auto result = hmac->final();
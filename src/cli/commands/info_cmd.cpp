@@ -1,5 +1,8 @@
 #include "filevault/cli/commands/info_cmd.hpp"
 #include "filevault/core/file_format.hpp"
+#include "filevault/core/memory_budget.hpp"
+#include "filevault/core/streaming.hpp"
+#include "filevault/core/system_resources.hpp"
 #include "filevault/utils/console.hpp"
 #include "filevault/utils/crypto_utils.hpp"
 #include <fmt/core.h>
@@ -16,15 +19,16 @@ void InfoCommand::setup(CLI::App& app) {
     auto* cmd = app.add_subcommand(name(), description());
     
     cmd->add_option("input", input_file_, "Encrypted file to inspect")
-        ->required()
         ->check(CLI::ExistingFile);
     
     cmd->add_flag("-v,--verbose", verbose_, "Show detailed information");
+    cmd->add_flag("--system", system_, "Show detected CPUs and memory (cgroup limits, affinity)");
 
     cmd->footer(
         "\nExamples:\n"
         "  Show file info:        filevault info secret.fvlt\n"
         "  Verbose output:       filevault info secret.fvlt -v\n"
+        "  System resources:     filevault info --system\n"
         "\n"
         "Displays information about the encrypted file, including format version,\n"
         "encryption algorithm, KDF, compression, and sizes of various components.\n"
@@ -40,6 +44,16 @@ void InfoCommand::setup(CLI::App& app) {
 
 int InfoCommand::execute() {
     try {
+        if (system_) {
+            utils::Console::header("System Resources");
+            display_system();
+            return 0;
+        }
+        if (input_file_.empty()) {
+            utils::Console::error("Specify a file to inspect, or --system");
+            return 1;
+        }
+        
         utils::Console::header("File Information");
         
         auto info = parse_file(input_file_);
@@ -172,5 +186,34 @@ void InfoCommand::display_info(const FileInfo& info) {
     fmt::print("\n");
 }
 
+void InfoCommand::display_system() {
+    const auto& res = core::SystemResources::current();
+    
+    fmt::print("\n");
+    fmt::print("  🖥️  CPUs:\n");
+    fmt::print("     {:25} : {}\n", "Online", res.online_cpus);
+    fmt::print("     {:25} : {}\n", "Affinity Mask", res.affinity_cpus);
+    fmt::print("     {:25} : {}\n", "cgroup Quota",
+               res.cpu_quota ? fmt::format("{:.2f} CPUs", *res.cpu_quota) : std::string("none"));
+    fmt::print("     {:25} : {}\n", "Usable", res.cpu_count);
+    fmt::print("\n");
+    
+    fmt::print("  💾 Memory:\n");
+    fmt::print("     {:25} : {}\n", "Physical", utils::CryptoUtils::format_bytes(res.total_memory));
+    fmt::print("     {:25} : {}\n", "cgroup Limit",
+               res.memory_limit ? utils::CryptoUtils::format_bytes(*res.memory_limit) : std::string("none"));
+    fmt::print("     {:25} : {}\n", "Available", utils::CryptoUtils::format_bytes(res.available_memory));
+    fmt::print("     {:25} : {}\n", "cgroup Version", res.cgroup);
+    fmt::print("     {:25} : {}\n", "FileVault Budget",
+               utils::CryptoUtils::format_bytes(core::MemoryBudget::global().limit()));
+    fmt::print("\n");
+    
+    fmt::print("  ⚙️  Streaming Defaults:\n");
+    fmt::print("     {:25} : {}\n", "Worker Threads", core::StreamingCrypto::resolve_thread_count(0));
+    fmt::print("     {:25} : {}\n", "Chunk Size",
+               utils::CryptoUtils::format_bytes(core::StreamingCrypto::get_recommended_chunk_size()));
+    fmt::print("\n");
+}
+
 } // namespace cli
 } // namespace filevault
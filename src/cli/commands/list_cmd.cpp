@@ -1,4 +1,6 @@
 #include "filevault/cli/commands/list_cmd.hpp"
+#include "filevault/core/cpu_features.hpp"
+#include "filevault/utils/config.hpp"
 #include "filevault/utils/console.hpp"
 #include "filevault/utils/table_formatter.hpp"
 #include <fmt/core.h>
@@ -68,6 +70,8 @@ int ListCommand::execute() {
         table.add_row({"AES-128-GCM", "128-bit", "Good", "****", "Fast, NIST standard"});
         table.add_row({"AES-192-GCM", "192-bit", "Strong", "***", "Balanced"});
         table.add_row({"AES-256-GCM", "256-bit", "Maximum", "***", "Recommended"});
+        table.add_row({"AES-128-OCB", "128-bit", "Good", "****", "One pass, no GHASH"});
+        table.add_row({"AES-256-OCB", "256-bit", "Maximum", "****", "One pass, no GHASH"});
         table.add_row({"ChaCha20-Poly1305", "256-bit", "Maximum", "****", "SW-optimized"});
         table.add_row({"Serpent-256-GCM", "256-bit", "Maximum", "**", "AES finalist"});
         table.add_row({"Twofish-128-GCM", "128-bit", "Good", "***", "AES finalist"});
@@ -75,6 +79,8 @@ int ListCommand::execute() {
         table.add_row({"Camellia-256-GCM", "256-bit", "Maximum", "***", "Japan (CRYPTREC)"});
         table.add_row({"ARIA-256-GCM", "256-bit", "Maximum", "***", "Korea (KS X 1213)"});
         table.add_row({"SM4-GCM", "128-bit", "Strong", "***", "China (GB/T 32907)"});
+        table.add_row({"AEGIS-128L", "128-bit", "Good", "*****", "Fastest with AES-NI"});
+        table.add_row({"AEGIS-256", "256-bit", "Maximum", "*****", "Bulk data, 256-bit nonce"});
         
         // Highlight recommended row
         table[3].format().font_color(tabulate::Color::green);
@@ -220,12 +226,41 @@ int ListCommand::execute() {
         print_table_safe(table);
     }
     
+    // ==================== CPU Features ====================
+    print_section_title("CPU Features (this machine)", "⚙️ ");
+    {
+        const auto& cpu = core::CpuFeatures::current();
+        const std::vector<std::pair<std::string, bool>> features = {
+            {"AES-NI", cpu.aes_ni}, {"VAES", cpu.vaes}, {"PCLMULQDQ", cpu.pclmulqdq},
+            {"AVX2", cpu.avx2}, {"AVX-512", cpu.avx512}, {"SHA-NI", cpu.sha_ni},
+            {"ARMv8 AES", cpu.arm_aes}, {"ARMv8 PMULL", cpu.arm_pmull}, {"ARMv8 SHA2", cpu.arm_sha2},
+        };
+        
+        auto table = create_styled_table({"Feature", "Available"});
+        size_t row = 1;
+        for (const auto& [feature, present] : features) {
+            table.add_row({feature, present ? "yes" : "no"});
+            table[row++].format().font_color(present ? tabulate::Color::green : tabulate::Color::grey);
+        }
+        
+        fmt::print("{} {}\n", cpu.architecture, cpu.model);
+        print_table_safe(table);
+        
+        auto measured = core::AutoAlgorithm::load_measurements(
+            utils::Config::get_benchmark_cache_path(), cpu);
+        fmt::print("-a auto selects {} ({})\n",
+                   engine_.algorithm_name(core::AutoAlgorithm::choose(cpu, measured)),
+                   measured.empty() ? "from CPU features; run 'filevault benchmark --symmetric' to measure"
+                                    : "from saved benchmark");
+    }
+    
     // ==================== Usage Examples ====================
     print_section_title("Usage Examples", "💡");
     {
         auto table = create_styled_table({"Category", "Command"});
         table.add_row({"AEAD (Recommended)", "filevault encrypt input.txt -a aes-256-gcm -s medium"});
         table.add_row({"ChaCha20", "filevault encrypt data.zip -a chacha20-poly1305"});
+        table.add_row({"Fastest AEAD", "filevault encrypt data.zip -a auto"});
         table.add_row({"PQC Keygen", "filevault keygen -a kyber-1024 -o quantum-key"});
         table.add_row({"PQC Encrypt", "filevault encrypt secret.txt -a kyber-1024-hybrid"});
         table.add_row({"RSA Keygen", "filevault keygen -a rsa-4096 -o mykey"});
@@ -0,0 +1,116 @@
+#include "filevault/cli/commands/update_cmd.hpp"
+#include "filevault/core/streaming.hpp"
+#include "filevault/utils/console.hpp"
+#include "filevault/utils/crypto_utils.hpp"
+#include "filevault/utils/password.hpp"
+#include "filevault/compression/compressor.hpp"
+#include <filesystem>
+
+namespace filevault {
+namespace cli {
+
+UpdateCommand::UpdateCommand(core::CryptoEngine& engine)
+    : engine_(engine) {
+}
+
+void UpdateCommand::setup(CLI::App& app) {
+    auto* cmd = app.add_subcommand(name(), description());
+    
+    cmd->add_option("input", input_file_, "New version of the plaintext")
+        ->required()
+        ->check(CLI::ExistingFile);
+    
+    cmd->add_option("stream", stream_file_, "Streaming encrypted file to refresh (created if missing)")
+        ->required();
+    
+    cmd->add_option("-p,--password", password_, "Password (not recommended)");
+    
+    cmd->add_option("-a,--algorithm", algorithm_, "AEAD algorithm for a new stream")
+        ->check(CLI::IsMember({"aes-128-gcm", "aes-192-gcm", "aes-256-gcm", "chacha20-poly1305"}));
+    
+    cmd->add_option("-c,--compression", compression_type_, "Compression for a new stream")
+        ->check(CLI::IsMember({"none", "zlib", "bzip2", "lzma"}));
+    
+    cmd->add_flag("--content-defined", content_defined_,
+                 "Cut a new stream's chunks by content, so insertions only change nearby chunks");
+    
+    cmd->footer(
+        "\nExamples:\n"
+        "  First run (creates):   filevault update disk.img disk.fvst\n"
+        "  Nightly refresh:       filevault update disk.img disk.fvst -p \"$PW\"\n"
+        "  Edited documents:      filevault update notes.db notes.fvst --content-defined\n"
+        "\n"
+        "Chunks whose keyed digest is unchanged are copied without re-encryption;\n"
+        "changed chunks are re-encrypted under fresh nonces. Streams written without\n"
+        "digests are re-encrypted in full once.\n"
+    );
+    
+    cmd->callback([this]() {
+        int exit_code = execute();
+        if (exit_code != 0) {
+            throw CLI::RuntimeError(exit_code);
+        }
+    });
+}
+
+int UpdateCommand::execute() {
+    try {
+        utils::Console::header("FileVault Update");
+        
+        const bool create = !std::filesystem::exists(stream_file_);
+        if (!create && !core::StreamingCrypto::is_streaming_file(stream_file_)) {
+            utils::Console::error(stream_file_ + " is not a streaming encrypted file");
+            return 1;
+        }
+        
+        if (password_.empty()) {
+            password_ = utils::Password::read_secure("Enter password: ", create);
+            if (password_.empty()) {
+                utils::Console::error("Password cannot be empty");
+                return 1;
+            }
+        } else {
+            utils::Console::warning("Using password from command line is insecure!");
+        }
+        
+        utils::Console::info(fmt::format("Input:  {}", input_file_));
+        utils::Console::info(fmt::format("Stream: {}{}", stream_file_, create ? " (new)" : ""));
+        utils::Console::separator();
+        
+        core::StreamingConfig config;
+        config.chunk_digests = true;
+        core::StreamingResult result;
+        if (create) {
+            auto algo_type = engine_.parse_algorithm(algorithm_);
+            if (!algo_type) {
+                utils::Console::error("Invalid algorithm: " + algorithm_);
+                return 1;
+            }
+            config.algorithm = *algo_type;
+            config.compression = compression::CompressionService::parse_algorithm(compression_type_);
+            config.content_defined_chunks = content_defined_;
+            result = core::StreamingCrypto::encrypt_file(input_file_, stream_file_, password_, config);
+        } else {
+            result = core::StreamingCrypto::update_file(input_file_, stream_file_, password_, config);
+        }
+        if (!result.success) {
+            utils::Console::error(result.error_message);
+            return 1;
+        }
+        
+        utils::Console::separator();
+        utils::Console::success(create ? "Stream created!" : "Update completed!");
+        utils::Console::info(fmt::format("{} of {} chunks unchanged, {} re-encrypted ({:.1f} MB/s)",
+                                         result.chunks_unchanged, result.chunks_processed,
+                                         result.chunks_processed - result.chunks_unchanged,
+                                         result.throughput_mbps));
+        return 0;
+        
+    } catch (const std::exception& e) {
+        utils::Console::error(fmt::format("Update failed: {}", e.what()));
+        return 1;
+    }
+}
+
+} // namespace cli
+} // namespace filevault
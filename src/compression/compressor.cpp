@@ -3,7 +3,10 @@
 #include <libbz3.h>  // BZIP3 API
 #include <lzma.h>
 #include <algorithm>
+#include <array>
 #include <chrono>
+#include <climits>
+#include <cmath>
 #include <stdexcept>
 #include <fmt/core.h>
 
@@ -48,10 +51,106 @@ core::CompressionType CompressionService::parse_algorithm(const std::string& nam
     throw std::invalid_argument("Unknown compression algorithm: " + name);
 }
 
+double CompressionService::estimate_entropy(std::span<const uint8_t> data) {
+    if (data.empty()) {
+        return 0.0;
+    }
+    
+    // Histogram of evenly spaced windows (the whole input when it is small)
+    std::array<uint64_t, 256> counts{};
+    size_t sampled = 0;
+    const size_t windows = (std::min)(PROBE_SAMPLES, (data.size() + PROBE_WINDOW - 1) / PROBE_WINDOW);
+    const size_t stride = data.size() / windows;
+    for (size_t w = 0; w < windows; ++w) {
+        size_t begin = w * stride;
+        size_t end = (std::min)(begin + PROBE_WINDOW, data.size());
+        for (size_t i = begin; i < end; ++i) {
+            ++counts[data[i]];
+        }
+        sampled += end - begin;
+    }
+    
+    double entropy = 0.0;
+    for (uint64_t count : counts) {
+        if (count > 0) {
+            double p = static_cast<double>(count) / sampled;
+            entropy -= p * std::log2(p);
+        }
+    }
+    return entropy;
+}
+
+bool CompressionService::is_likely_incompressible(std::span<const uint8_t> data) {
+    // Small inputs give a noisy estimate and are cheap to just try
+    if (data.size() < PROBE_WINDOW) {
+        return false;
+    }
+    return estimate_entropy(data) > INCOMPRESSIBLE_ENTROPY;
+}
+
+uint64_t CompressionService::memory_usage(core::CompressionType type, int level, bool decompress) {
+    level = std::clamp(level, 1, 9);
+    switch (type) {
+        case core::CompressionType::ZLIB:
+            // Window plus hash chains (deflate), window only (inflate)
+            return decompress ? (uint64_t(1) << 15) + 8192 : (uint64_t(1) << 18) + 8192;
+        case core::CompressionType::BZIP2: {
+            // BZIP3 works on whole blocks with ~6x the block size of state
+            uint64_t block_size = level <= 3 ? 1 << 20 : level <= 6 ? 4 << 20 : 8 << 20;
+            return 6 * block_size;
+        }
+        case core::CompressionType::LZMA: {
+            uint64_t usage = decompress ? lzma_easy_decoder_memusage(static_cast<uint32_t>(level))
+                                        : lzma_easy_encoder_memusage(static_cast<uint32_t>(level));
+            return usage != UINT64_MAX ? usage : uint64_t(1) << 30;
+        }
+        default:
+            return 0;
+    }
+}
+
+// ============================================================================
+// CompressorPool
+// ============================================================================
+
+CompressorPool::Lease CompressorPool::acquire() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!idle_.empty()) {
+            auto compressor = std::move(idle_.back());
+            idle_.pop_back();
+            return Lease(*this, std::move(compressor));
+        }
+    }
+    return Lease(*this, CompressionService::create(type_));
+}
+
+void CompressorPool::release(std::unique_ptr<ICompressor> compressor) {
+    if (!compressor) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    idle_.push_back(std::move(compressor));
+}
+
 // ============================================================================
 // ZlibCompressor
 // ============================================================================
 
+struct ZlibCompressor::DeflateState {
+    z_stream stream{};
+    int level = 0;  // Level the stream was initialised with (0 = not initialised)
+};
+
+ZlibCompressor::ZlibCompressor() : deflate_(std::make_unique<DeflateState>()) {
+}
+
+ZlibCompressor::~ZlibCompressor() {
+    if (deflate_->level != 0) {
+        deflateEnd(&deflate_->stream);
+    }
+}
+
 CompressionResult ZlibCompressor::compress(
     std::span<const uint8_t> input,
     int level
@@ -63,26 +162,57 @@ CompressionResult ZlibCompressor::compress(
         // Clamp level to valid range
         level = std::clamp(level, 1, 9);
         
-        // Allocate output buffer (worst case: original size + 0.1% + 12 bytes)
-        uLongf dest_len = compressBound(input.size());
-        result.data.resize(dest_len);
+        // Reuse the deflate context; a new one is only needed when the level changes
+        z_stream& strm = deflate_->stream;
+        if (deflate_->level != level) {
+            if (deflate_->level != 0) {
+                deflateEnd(&strm);
+                deflate_->level = 0;
+            }
+            strm = z_stream{};
+            int ret = deflateInit(&strm, level);
+            if (ret != Z_OK) {
+                result.success = false;
+                result.error_message = fmt::format("zlib initialization failed: error {}", ret);
+                return result;
+            }
+            deflate_->level = level;
+        } else {
+            deflateReset(&strm);
+        }
         
-        // Compress
-        int ret = ::compress2(
-            result.data.data(),
-            &dest_len,
-            input.data(),
-            input.size(),
-            level
-        );
+        // Allocate output buffer (worst case for this stream's parameters)
+        size_t bound = deflateBound(&strm, static_cast<uLong>(input.size()));
+        result.data.resize(bound);
         
-        if (ret != Z_OK) {
+        // Compress (zlib counts in uInt, so feed very large buffers in pieces like compress2)
+        strm.next_in = const_cast<Bytef*>(input.data());
+        strm.avail_in = 0;
+        strm.next_out = result.data.data();
+        strm.avail_out = 0;
+        size_t in_left = input.size();
+        size_t out_left = bound;
+        int ret;
+        do {
+            if (strm.avail_out == 0) {
+                strm.avail_out = static_cast<uInt>((std::min)(out_left, size_t(UINT_MAX)));
+                out_left -= strm.avail_out;
+            }
+            if (strm.avail_in == 0) {
+                strm.avail_in = static_cast<uInt>((std::min)(in_left, size_t(UINT_MAX)));
+                in_left -= strm.avail_in;
+            }
+            ret = deflate(&strm, in_left > 0 ? Z_NO_FLUSH : Z_FINISH);
+        } while (ret == Z_OK);
+        
+        if (ret != Z_STREAM_END) {
             result.success = false;
             result.error_message = fmt::format("zlib compression failed: error {}", ret);
             return result;
         }
         
         // Resize to actual size
+        size_t dest_len = bound - out_left - strm.avail_out;
         result.data.resize(dest_len);
         
         result.success = true;
@@ -280,6 +410,17 @@ CompressionResult Bzip2Compressor::decompress(std::span<const uint8_t> input) {
 // LzmaCompressor
 // ============================================================================
 
+struct LzmaCompressor::EncoderState {
+    lzma_stream stream = LZMA_STREAM_INIT;
+};
+
+LzmaCompressor::LzmaCompressor() : encoder_(std::make_unique<EncoderState>()) {
+}
+
+LzmaCompressor::~LzmaCompressor() {
+    lzma_end(&encoder_->stream);
+}
+
 CompressionResult LzmaCompressor::compress(
     std::span<const uint8_t> input,
     int level
@@ -290,8 +431,8 @@ CompressionResult LzmaCompressor::compress(
     try {
         level = std::clamp(level, 1, 9);
         
-        // LZMA properties
-        lzma_stream strm = LZMA_STREAM_INIT;
+        // Re-initialising the same stream reuses the encoder's memory
+        lzma_stream& strm = encoder_->stream;
         
         // Initialize encoder
         lzma_ret ret = lzma_easy_encoder(&strm, level, LZMA_CHECK_CRC64);
@@ -315,14 +456,12 @@ CompressionResult LzmaCompressor::compress(
         ret = lzma_code(&strm, LZMA_FINISH);
         
         if (ret != LZMA_STREAM_END) {
-            lzma_end(&strm);
             result.success = false;
             result.error_message = fmt::format("LZMA compression failed: error {}", static_cast<int>(ret));
             return result;
         }
         
         size_t compressed_size = strm.total_out;
-        lzma_end(&strm);
         
         result.data.resize(compressed_size);
         
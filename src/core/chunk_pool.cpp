@@ -0,0 +1,260 @@
+/**
+ * @file chunk_pool.cpp
+ * @brief Ordered worker pool and bounded pipeline for streaming chunk transforms
+ */
+
+#include "filevault/core/chunk_pool.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <stdexcept>
+
+namespace filevault {
+namespace core {
+
+// ============================================================================
+// ChunkWorkerPool
+// ============================================================================
+
+ChunkWorkerPool::ChunkWorkerPool(size_t threads, Transform transform)
+    : transform_(std::move(transform)) {
+    workers_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        workers_.emplace_back([this]() { worker_loop(); });
+    }
+    if (threads > 0) {
+        spdlog::debug("Chunk worker pool started with {} threads", threads);
+    }
+}
+
+ChunkWorkerPool::~ChunkWorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        closed_ = true;
+        pending_.clear();
+    }
+    work_cv_.notify_all();
+    done_cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ChunkWorkerPool::run(ChunkJob& job) {
+    try {
+        transform_(job);
+    } catch (const std::exception& e) {
+        job.success = false;
+        job.error_message = e.what();
+    }
+}
+
+void ChunkWorkerPool::submit(ChunkJob job) {
+    if (workers_.empty()) {
+        // Inline mode: transform immediately on the producer thread
+        run(job);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (submitted_ == 0) {
+            next_index_ = job.index;
+        }
+        ++submitted_;
+
+        if (workers_.empty()) {
+            completed_.emplace(job.index, std::move(job));
+        } else {
+            pending_.push_back(std::move(job));
+        }
+    }
+
+    if (workers_.empty()) {
+        done_cv_.notify_all();
+    } else {
+        work_cv_.notify_one();
+    }
+}
+
+void ChunkWorkerPool::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+    }
+    done_cv_.notify_all();
+}
+
+std::optional<ChunkJob> ChunkWorkerPool::next() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this]() {
+        return completed_.count(next_index_) > 0 || (closed_ && returned_ == submitted_);
+    });
+
+    auto it = completed_.find(next_index_);
+    if (it == completed_.end()) {
+        return std::nullopt;
+    }
+
+    ChunkJob job = std::move(it->second);
+    completed_.erase(it);
+
+    ++next_index_;
+    ++returned_;
+    return job;
+}
+
+size_t ChunkWorkerPool::outstanding() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return submitted_ - returned_;
+}
+
+void ChunkWorkerPool::worker_loop() {
+    while (true) {
+        ChunkJob job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            work_cv_.wait(lock, [this]() { return stopping_ || !pending_.empty(); });
+            if (stopping_) {
+                return;
+            }
+            job = std::move(pending_.front());
+            pending_.pop_front();
+        }
+
+        run(job);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            completed_.emplace(job.index, std::move(job));
+        }
+        done_cv_.notify_all();
+    }
+}
+
+// ============================================================================
+// ChunkBufferRing
+// ============================================================================
+
+ChunkBufferRing::ChunkBufferRing(size_t slots)
+    : slots_((std::max)(slots, size_t(1))), available_(slots_) {
+    free_buffers_.reserve(slots_);
+}
+
+std::optional<std::vector<uint8_t>> ChunkBufferRing::acquire() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this]() { return cancelled_ || available_ > 0; });
+    if (cancelled_) {
+        return std::nullopt;
+    }
+
+    --available_;
+    if (free_buffers_.empty()) {
+        return std::vector<uint8_t>();
+    }
+
+    std::vector<uint8_t> buffer = std::move(free_buffers_.back());
+    free_buffers_.pop_back();
+    return buffer;
+}
+
+void ChunkBufferRing::release(std::vector<uint8_t> buffer) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (free_buffers_.size() < slots_) {
+            free_buffers_.push_back(std::move(buffer));
+        }
+        ++available_;
+    }
+    cv_.notify_one();
+}
+
+void ChunkBufferRing::cancel() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cancelled_ = true;
+    }
+    cv_.notify_all();
+}
+
+// ============================================================================
+// ChunkPipeline
+// ============================================================================
+
+ChunkPipeline::ChunkPipeline(size_t threads, size_t slots, ChunkWorkerPool::Transform transform)
+    : threads_(threads),
+      slots_((std::max)(slots, size_t(1))),
+      transform_(std::move(transform)) {
+}
+
+size_t ChunkPipeline::slots_for_budget(size_t chunk_size, size_t max_in_flight_bytes, size_t threads) {
+    // Enough slots to keep every worker busy plus one being read and one being written
+    size_t wanted = threads + 2;
+    if (max_in_flight_bytes == 0 || chunk_size == 0) {
+        return wanted;
+    }
+
+    size_t affordable = max_in_flight_bytes / chunk_size;
+    // Two slots is the minimum that still overlaps reading with writing
+    return (std::max)(size_t(2), (std::min)(wanted, affordable));
+}
+
+Result<void> ChunkPipeline::run(const Reader& reader, const Writer& writer) {
+    ChunkBufferRing ring(slots_);
+    ChunkWorkerPool pool(threads_, transform_);
+
+    std::atomic<bool> aborted{false};
+    std::string writer_error;
+    std::string reader_error;
+
+    std::thread writer_thread([&]() {
+        try {
+            while (auto job = pool.next()) {
+                if (!job->success) {
+                    throw std::runtime_error("chunk " + std::to_string(job->index) + ": " +
+                                             job->error_message);
+                }
+                writer(*job);
+                ring.release(std::move(job->data));
+            }
+        } catch (const std::exception& e) {
+            writer_error = e.what();
+            aborted = true;
+            ring.cancel();
+        }
+    });
+
+    try {
+        while (!aborted) {
+            auto buffer = ring.acquire();
+            if (!buffer) {
+                break;
+            }
+
+            ChunkJob job;
+            job.data = std::move(*buffer);
+            if (!reader(job)) {
+                ring.release(std::move(job.data));
+                break;
+            }
+            pool.submit(std::move(job));
+        }
+    } catch (const std::exception& e) {
+        reader_error = e.what();
+    }
+
+    pool.close();
+    writer_thread.join();
+
+    if (!writer_error.empty()) {
+        return Result<void>::error(writer_error);
+    }
+    if (!reader_error.empty()) {
+        return Result<void>::error(reader_error);
+    }
+    return Result<void>::ok();
+}
+
+} // namespace core
+} // namespace filevault
@@ -0,0 +1,89 @@
+/**
+ * @file content_chunker.cpp
+ * @brief Keyed Gear rolling hash chunker for content-defined FVST chunks
+ */
+
+#include "filevault/core/content_chunker.hpp"
+#include <botan/mac.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace filevault {
+namespace core {
+
+namespace {
+
+// Mask with the top `bits` bits set: after the shift in the hash update these
+// depend on the most recent 64 bytes, the window of the rolling hash
+uint64_t top_bits(int bits) {
+    bits = std::clamp(bits, 1, 63);
+    return ~uint64_t(0) << (64 - bits);
+}
+
+} // anonymous namespace
+
+ContentChunker::ContentChunker(const std::vector<uint8_t>& key, size_t min_size, size_t avg_size, size_t max_size)
+    : min_size_(min_size), avg_size_(avg_size), max_size_(max_size) {
+    if (max_size == 0 || min_size > avg_size || avg_size > max_size) {
+        throw std::invalid_argument("Content-defined chunking needs min <= avg <= max and max > 0");
+    }
+    
+    // Normalization level 2: two bits stricter before the average, two looser after it
+    int avg_bits = 0;
+    while ((size_t(2) << avg_bits) <= avg_size) {
+        ++avg_bits;
+    }
+    avg_size_ = size_t(1) << avg_bits;
+    mask_small_ = top_bits(avg_bits + 2);
+    mask_large_ = top_bits(avg_bits - 2);
+    
+    // Gear table: HMAC-SHA256(key, "FVST gear" || block) yields four entries per block
+    static constexpr char label[] = "FVST gear";
+    auto mac = Botan::MessageAuthenticationCode::create_or_throw("HMAC(SHA-256)");
+    mac->set_key(key);
+    for (uint32_t block = 0; block < gear_.size() / 4; ++block) {
+        mac->update(reinterpret_cast<const uint8_t*>(label), sizeof(label) - 1);
+        mac->update(reinterpret_cast<const uint8_t*>(&block), 4);
+        auto out = mac->final();
+        std::memcpy(&gear_[block * 4], out.data(), 32);
+    }
+}
+
+ContentChunker ContentChunker::for_stream(const std::vector<uint8_t>& key, size_t chunk_size) {
+    return ContentChunker(key, chunk_size / 16, (std::max)(chunk_size / 4, size_t(1)), chunk_size);
+}
+
+uint64_t ContentChunker::max_stream_chunks(uint64_t size, size_t chunk_size) {
+    // Every cut is at least one byte long, even when chunk_size / 16 is zero
+    const uint64_t min_size = (std::max)(chunk_size / 16, size_t(1));
+    return size / min_size + 1;
+}
+
+size_t ContentChunker::cut_point(const uint8_t* data, size_t size) const {
+    if (size <= min_size_) {
+        return size;
+    }
+    const size_t end = (std::min)(size, max_size_);
+    const size_t normal = (std::min)(end, avg_size_);
+    
+    // Bytes before min_size never end a chunk, so they are not hashed at all
+    uint64_t hash = 0;
+    size_t i = min_size_;
+    for (; i < normal; ++i) {
+        hash = (hash << 1) + gear_[data[i]];
+        if ((hash & mask_small_) == 0) {
+            return i + 1;
+        }
+    }
+    for (; i < end; ++i) {
+        hash = (hash << 1) + gear_[data[i]];
+        if ((hash & mask_large_) == 0) {
+            return i + 1;
+        }
+    }
+    return end;
+}
+
+} // namespace core
+} // namespace filevault
@@ -0,0 +1,246 @@
+/**
+ * @file cpu_features.cpp
+ * @brief CPUID / HWCAP probe and hardware-aware AEAD selection
+ */
+
+#include "filevault/core/cpu_features.hpp"
+#include "filevault/core/algorithm_registry.hpp"
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define FILEVAULT_CPU_X86 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#else
+#include <cpuid.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define FILEVAULT_CPU_ARM64 1
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+#endif
+
+namespace filevault {
+namespace core {
+
+namespace {
+
+#if defined(FILEVAULT_CPU_X86)
+
+struct CpuidRegs {
+    uint32_t eax = 0, ebx = 0, ecx = 0, edx = 0;
+};
+
+CpuidRegs cpuid(uint32_t leaf, uint32_t subleaf = 0) {
+    CpuidRegs r;
+#if defined(_MSC_VER)
+    int regs[4];
+    __cpuidex(regs, static_cast<int>(leaf), static_cast<int>(subleaf));
+    r.eax = regs[0]; r.ebx = regs[1]; r.ecx = regs[2]; r.edx = regs[3];
+#else
+    __cpuid_count(leaf, subleaf, r.eax, r.ebx, r.ecx, r.edx);
+#endif
+    return r;
+}
+
+// Register state the OS saves on context switch (XCR0)
+uint64_t xgetbv0() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    uint32_t eax = 0, edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (uint64_t(edx) << 32) | eax;
+#endif
+}
+
+constexpr bool bit(uint32_t reg, int n) {
+    return (reg >> n) & 1;
+}
+
+void probe_x86(CpuFeatures& cpu) {
+    const uint32_t max_leaf = cpuid(0).eax;
+    if (max_leaf < 1) {
+        return;
+    }
+
+    const auto leaf1 = cpuid(1);
+    cpu.aes_ni = bit(leaf1.ecx, 25);
+    cpu.pclmulqdq = bit(leaf1.ecx, 1);
+
+    // AVX state (XMM|YMM) and AVX-512 state (opmask, ZMM) must be enabled by the OS
+    const bool osxsave = bit(leaf1.ecx, 27);
+    const uint64_t xcr0 = osxsave ? xgetbv0() : 0;
+    const bool avx_state = (xcr0 & 0x6) == 0x6;
+    const bool avx512_state = (xcr0 & 0xE6) == 0xE6;
+
+    if (max_leaf >= 7) {
+        const auto leaf7 = cpuid(7, 0);
+        cpu.avx2 = avx_state && bit(leaf1.ecx, 28) && bit(leaf7.ebx, 5);
+        cpu.avx512 = avx512_state && bit(leaf7.ebx, 16);
+        cpu.sha_ni = bit(leaf7.ebx, 29);
+        cpu.vaes = avx_state && bit(leaf7.ecx, 9);
+    }
+
+    if (cpuid(0x80000000).eax >= 0x80000004) {
+        char brand[49] = {};
+        for (uint32_t i = 0; i < 3; ++i) {
+            const auto regs = cpuid(0x80000002 + i);
+            std::memcpy(brand + i * 16, &regs.eax, 4);
+            std::memcpy(brand + i * 16 + 4, &regs.ebx, 4);
+            std::memcpy(brand + i * 16 + 8, &regs.ecx, 4);
+            std::memcpy(brand + i * 16 + 12, &regs.edx, 4);
+        }
+        cpu.model = brand;
+        // Some vendors pad the brand string with leading spaces
+        cpu.model.erase(0, cpu.model.find_first_not_of(' '));
+    }
+}
+
+#elif defined(FILEVAULT_CPU_ARM64)
+
+void probe_arm64(CpuFeatures& cpu) {
+#if defined(__APPLE__)
+    // Every Apple silicon core has the ARMv8 crypto extensions
+    cpu.arm_aes = cpu.arm_pmull = cpu.arm_sha2 = true;
+#elif defined(_WIN32)
+    const bool crypto = IsProcessorFeaturePresent(PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE);
+    cpu.arm_aes = cpu.arm_pmull = cpu.arm_sha2 = crypto;
+#elif defined(__linux__)
+    const unsigned long hwcap = getauxval(AT_HWCAP);
+    cpu.arm_aes = hwcap & HWCAP_AES;
+    cpu.arm_pmull = hwcap & HWCAP_PMULL;
+    cpu.arm_sha2 = hwcap & HWCAP_SHA2;
+#else
+    (void)cpu;
+#endif
+}
+
+#endif
+
+} // anonymous namespace
+
+bool CpuFeatures::hardware_aes() const {
+    return (aes_ni && pclmulqdq) || (arm_aes && arm_pmull);
+}
+
+std::vector<std::string> CpuFeatures::names() const {
+    std::vector<std::string> result;
+    if (aes_ni) result.push_back("AES-NI");
+    if (vaes) result.push_back("VAES");
+    if (pclmulqdq) result.push_back("PCLMULQDQ");
+    if (avx2) result.push_back("AVX2");
+    if (avx512) result.push_back("AVX-512");
+    if (sha_ni) result.push_back("SHA-NI");
+    if (arm_aes) result.push_back("ARMv8 AES");
+    if (arm_pmull) result.push_back("ARMv8 PMULL");
+    if (arm_sha2) result.push_back("ARMv8 SHA2");
+    return result;
+}
+
+std::string CpuFeatures::signature() const {
+    std::string result = architecture + "|" + model;
+    for (const auto& name : names()) {
+        result += "|" + name;
+    }
+    return result;
+}
+
+const CpuFeatures& CpuFeatures::current() {
+    static const CpuFeatures features = probe();
+    return features;
+}
+
+CpuFeatures CpuFeatures::probe() {
+    CpuFeatures cpu;
+#if defined(FILEVAULT_CPU_X86)
+#if defined(__x86_64__) || defined(_M_X64)
+    cpu.architecture = "x86_64";
+#else
+    cpu.architecture = "x86";
+#endif
+    probe_x86(cpu);
+#elif defined(FILEVAULT_CPU_ARM64)
+    cpu.architecture = "aarch64";
+    probe_arm64(cpu);
+#endif
+    spdlog::debug("CPU features: {}", cpu.signature());
+    return cpu;
+}
+
+AlgorithmType AutoAlgorithm::choose(const CpuFeatures& cpu, const std::vector<AeadThroughput>& measured) {
+    // Only 256-bit AEADs: `auto` must never trade key strength for speed
+    const AeadThroughput* fastest = nullptr;
+    for (const auto& entry : measured) {
+        auto* info = find_algorithm(entry.algorithm);
+        if (!info || !info->aead || info->key_size < 32 || entry.encrypt_mbps <= 0) {
+            continue;
+        }
+        if (!fastest || entry.encrypt_mbps > fastest->encrypt_mbps) {
+            fastest = &entry;
+        }
+    }
+    if (fastest) {
+        return fastest->algorithm;
+    }
+    return cpu.hardware_aes() ? AlgorithmType::AES_256_GCM : AlgorithmType::CHACHA20_POLY1305;
+}
+
+std::vector<AeadThroughput> AutoAlgorithm::load_measurements(const std::filesystem::path& file,
+                                                             const CpuFeatures& cpu) {
+    std::vector<AeadThroughput> result;
+    try {
+        std::ifstream in(file);
+        if (!in) {
+            return result;
+        }
+        auto j = nlohmann::json::parse(in);
+        if (j.value("cpu", std::string()) != cpu.signature()) {
+            spdlog::debug("Ignoring benchmark cache {} from another CPU", file.string());
+            return result;
+        }
+        for (const auto& entry : j.at("aead")) {
+            auto* info = find_algorithm(std::string_view(entry.at("algorithm").get<std::string>()));
+            if (info) {
+                result.push_back({info->type, entry.at("encrypt_mbps").get<double>()});
+            }
+        }
+    } catch (const std::exception& e) {
+        spdlog::debug("Unreadable benchmark cache {}: {}", file.string(), e.what());
+        result.clear();
+    }
+    return result;
+}
+
+bool AutoAlgorithm::save_measurements(const std::filesystem::path& file,
+                                      const CpuFeatures& cpu,
+                                      const std::vector<AeadThroughput>& measured) {
+    nlohmann::json j;
+    j["cpu"] = cpu.signature();
+    j["aead"] = nlohmann::json::array();
+    for (const auto& entry : measured) {
+        auto* info = find_algorithm(entry.algorithm);
+        if (info) {
+            j["aead"].push_back({{"algorithm", std::string(info->name)}, {"encrypt_mbps", entry.encrypt_mbps}});
+        }
+    }
+
+    std::ofstream out(file, std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+    out << j.dump(2);
+    return static_cast<bool>(out);
+}
+
+} // namespace core
+} // namespace filevault
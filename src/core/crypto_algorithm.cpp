@@ -0,0 +1,267 @@
+/**
+ * @file crypto_algorithm.cpp
+ * @brief Default keyed context, buffer entry points and the per-worker context pool
+ */
+
+#include "filevault/core/crypto_algorithm.hpp"
+#include <botan/mem_ops.h>
+#include <algorithm>
+#include <cstdint>
+
+namespace filevault {
+namespace core {
+
+namespace {
+
+// Fallback for algorithms without a native context: keeps the key and
+// forwards each message to the one-shot interface
+class ForwardingContext : public ICipherContext {
+public:
+    ForwardingContext(ICryptoAlgorithm& algorithm, std::span<const uint8_t> key)
+        : algorithm_(algorithm), key_(key.begin(), key.end()) {}
+
+    ~ForwardingContext() override {
+        Botan::secure_scrub_memory(key_.data(), key_.size());
+    }
+
+    CryptoResult encrypt(std::span<const uint8_t> plaintext, const EncryptionConfig& config) override {
+        return algorithm_.encrypt(plaintext, key_, config);
+    }
+
+    CryptoResult decrypt(std::span<const uint8_t> ciphertext, const EncryptionConfig& config) override {
+        return algorithm_.decrypt(ciphertext, key_, config);
+    }
+
+private:
+    ICryptoAlgorithm& algorithm_;
+    std::vector<uint8_t> key_;
+};
+
+} // anonymous namespace
+
+// ============================================================================
+// BatchArena
+// ============================================================================
+
+void BatchArena::write_nonce(std::span<const uint8_t> nonce_base, size_t index, std::vector<uint8_t>& nonce) {
+    nonce.assign(nonce_base.begin(), nonce_base.end());
+    const size_t last = nonce.size() - 1;
+    for (size_t i = 0; i < 4; ++i) {
+        nonce[last - i] ^= static_cast<uint8_t>((index >> (i * 8)) & 0xFF);
+    }
+}
+
+std::vector<uint8_t> BatchArena::nonce_for(std::span<const uint8_t> nonce_base, size_t index) {
+    std::vector<uint8_t> nonce;
+    if (nonce_base.size() >= 4) {
+        write_nonce(nonce_base, index, nonce);
+    }
+    return nonce;
+}
+
+void BatchArena::clear() {
+    data_.clear();
+    items_.clear();
+    tag_size_ = 0;
+}
+
+// ============================================================================
+// ICipherContext: buffer entry points over the one-shot calls
+// ============================================================================
+
+Result<size_t> ICipherContext::encrypt_into(
+    std::span<const uint8_t> plaintext,
+    std::span<uint8_t> out,
+    std::span<uint8_t> tag_out,
+    const EncryptionConfig& config) {
+
+    if (!config.nonce.has_value() || config.nonce->empty()) {
+        return Result<size_t>::error("encrypt_into requires a nonce");
+    }
+
+    auto result = encrypt(plaintext, config);
+    if (!result.success) {
+        return Result<size_t>::error(result.error_message);
+    }
+    // The stored nonce would differ from the caller's (e.g. CBC's own 16-byte IV)
+    if (result.nonce.has_value() && result.nonce.value() != config.nonce.value()) {
+        return Result<size_t>::error("Algorithm generates its own IV; use encrypt()");
+    }
+
+    size_t tag_size = result.tag.has_value() ? result.tag->size() : 0;
+    if (tag_out.size() != tag_size) {
+        return Result<size_t>::error("Tag buffer must be " + std::to_string(tag_size) + " bytes");
+    }
+    if (out.size() < result.data.size()) {
+        return Result<size_t>::error("Output buffer too small (need " +
+                                     std::to_string(result.data.size()) + " bytes)");
+    }
+
+    std::copy(result.data.begin(), result.data.end(), out.begin());
+    if (tag_size > 0) {
+        std::copy(result.tag->begin(), result.tag->end(), tag_out.begin());
+    }
+    return Result<size_t>::ok(result.data.size());
+}
+
+Result<size_t> ICipherContext::decrypt_into(
+    std::span<const uint8_t> ciphertext,
+    std::span<uint8_t> out,
+    const EncryptionConfig& config) {
+
+    auto result = decrypt(ciphertext, config);
+    if (!result.success) {
+        return Result<size_t>::error(result.error_message);
+    }
+    if (out.size() < result.data.size()) {
+        Botan::secure_scrub_memory(result.data.data(), result.data.size());
+        return Result<size_t>::error("Output buffer too small (need " +
+                                     std::to_string(result.data.size()) + " bytes)");
+    }
+
+    std::copy(result.data.begin(), result.data.end(), out.begin());
+    Botan::secure_scrub_memory(result.data.data(), result.data.size());
+    return Result<size_t>::ok(result.data.size());
+}
+
+Result<size_t> ICipherContext::encrypt_batch(
+    std::span<const std::span<const uint8_t>> inputs,
+    std::span<const uint8_t> nonce_base,
+    BatchArena& output) {
+
+    output.clear();
+    if (nonce_base.size() < 4) {
+        return Result<size_t>::error("Batch nonce base must be at least 4 bytes");
+    }
+    if (inputs.size() > UINT32_MAX) {
+        return Result<size_t>::error("Too many messages in one batch");
+    }
+
+    const size_t tag = tag_size();
+    size_t total = 0;
+    for (const auto& input : inputs) {
+        if (input.size() > UINT32_MAX) {
+            return Result<size_t>::error("Batch messages must be smaller than 4 GiB");
+        }
+        total += input.size() + tag;
+    }
+    output.data_.resize(total);
+    output.items_.resize(inputs.size());
+    output.tag_size_ = tag;
+
+    // One nonce buffer for the whole batch, rewritten per message
+    EncryptionConfig config;
+    config.nonce.emplace();
+    config.nonce->reserve(nonce_base.size());
+
+    uint64_t offset = 0;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        const auto& input = inputs[i];
+        BatchArena::write_nonce(nonce_base, i, *config.nonce);
+
+        std::span<uint8_t> out(output.data_.data() + offset, input.size());
+        std::span<uint8_t> tag_out(output.data_.data() + offset + input.size(), tag);
+        auto written = encrypt_into(input, out, tag_out, config);
+        if (!written) {
+            output.clear();
+            return Result<size_t>::error("Message " + std::to_string(i) + ": " + written.error_message);
+        }
+        if (written.value != input.size()) {
+            output.clear();
+            return Result<size_t>::error("Batch encryption needs a length-preserving cipher");
+        }
+
+        output.items_[i] = BatchItem{offset, static_cast<uint32_t>(input.size())};
+        offset += input.size() + tag;
+    }
+    return Result<size_t>::ok(inputs.size());
+}
+
+// ============================================================================
+// ICryptoAlgorithm defaults
+// ============================================================================
+
+std::unique_ptr<ICipherContext> ICryptoAlgorithm::make_context(std::span<const uint8_t> key) {
+    return std::make_unique<ForwardingContext>(*this, key);
+}
+
+Result<size_t> ICryptoAlgorithm::encrypt_into(
+    std::span<const uint8_t> plaintext,
+    std::span<uint8_t> out,
+    std::span<uint8_t> tag_out,
+    std::span<const uint8_t> key,
+    const EncryptionConfig& config) {
+    return make_context(key)->encrypt_into(plaintext, out, tag_out, config);
+}
+
+Result<size_t> ICryptoAlgorithm::decrypt_into(
+    std::span<const uint8_t> ciphertext,
+    std::span<uint8_t> out,
+    std::span<const uint8_t> key,
+    const EncryptionConfig& config) {
+    return make_context(key)->decrypt_into(ciphertext, out, config);
+}
+
+Result<size_t> ICryptoAlgorithm::encrypt_batch(
+    std::span<const std::span<const uint8_t>> inputs,
+    std::span<const uint8_t> key,
+    std::span<const uint8_t> nonce_base,
+    BatchArena& output) {
+    return make_context(key)->encrypt_batch(inputs, nonce_base, output);
+}
+
+Result<std::unique_ptr<ICipherSession>> ICryptoAlgorithm::begin_encryption(
+    std::span<const uint8_t>,
+    std::span<const uint8_t>,
+    std::span<const uint8_t>) {
+    return Result<std::unique_ptr<ICipherSession>>::error(name() + " only processes whole messages");
+}
+
+Result<std::unique_ptr<ICipherSession>> ICryptoAlgorithm::begin_decryption(
+    std::span<const uint8_t>,
+    std::span<const uint8_t>,
+    std::span<const uint8_t>) {
+    return Result<std::unique_ptr<ICipherSession>>::error(name() + " only processes whole messages");
+}
+
+// ============================================================================
+// CipherContextPool
+// ============================================================================
+
+CipherContextPool::CipherContextPool(ICryptoAlgorithm& algorithm, std::span<const uint8_t> key)
+    : algorithm_(algorithm), key_(key.begin(), key.end()) {
+}
+
+CipherContextPool::~CipherContextPool() {
+    Botan::secure_scrub_memory(key_.data(), key_.size());
+}
+
+CipherContextPool::Lease CipherContextPool::acquire() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!idle_.empty()) {
+            auto context = std::move(idle_.back());
+            idle_.pop_back();
+            return Lease(*this, std::move(context));
+        }
+        ++created_;
+    }
+    // Keying happens outside the lock; only the first chunk of each worker pays for it
+    return Lease(*this, algorithm_.make_context(key_));
+}
+
+size_t CipherContextPool::created() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return created_;
+}
+
+void CipherContextPool::release(std::unique_ptr<ICipherContext> context) {
+    if (!context) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    idle_.push_back(std::move(context));
+}
+
+} // namespace core
+} // namespace filevault
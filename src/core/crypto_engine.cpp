@@ -1,5 +1,8 @@
 #include "filevault/core/crypto_engine.hpp"
+#include "filevault/core/algorithm_registry.hpp"
 #include "filevault/core/types.hpp"
+#include "filevault/core/memory_budget.hpp"
+#include "filevault/core/secure_random.hpp"
 #include "filevault/algorithms/symmetric/aes_gcm.hpp"
 #include "filevault/algorithms/symmetric/aes_cbc.hpp"
 #include "filevault/algorithms/symmetric/aes_ctr.hpp"
@@ -14,6 +17,8 @@
 #include "filevault/algorithms/symmetric/camellia_gcm.hpp"
 #include "filevault/algorithms/symmetric/aria_gcm.hpp"
 #include "filevault/algorithms/symmetric/sm4_gcm.hpp"
+#include "filevault/algorithms/symmetric/aegis.hpp"
+#include "filevault/algorithms/symmetric/aes_ocb.hpp"
 #include "filevault/algorithms/asymmetric/rsa.hpp"
 #include "filevault/algorithms/asymmetric/ecc.hpp"
 #include "filevault/algorithms/pqc/post_quantum.hpp"
@@ -22,16 +27,104 @@
 #include "filevault/algorithms/classical/playfair.hpp"
 #include "filevault/algorithms/classical/hill.hpp"
 #include "filevault/algorithms/classical/substitution.hpp"
-#include <botan/auto_rng.h>
 #include <botan/argon2.h>
 #include <botan/pwdhash.h>
 #include <spdlog/spdlog.h>
 #include <algorithm>
 #include <cctype>
+#include <iterator>
 
 namespace filevault {
 namespace core {
 
+namespace {
+
+namespace sym = algorithms::symmetric;
+namespace asym = algorithms::asymmetric;
+namespace classical = algorithms::classical;
+namespace pqc = algorithms::pqc;
+
+// Constructs the implementation behind a table entry (nullptr if there is none)
+std::unique_ptr<ICryptoAlgorithm> create_algorithm(AlgorithmType type) {
+    switch (type) {
+        // Modern symmetric algorithms (AEAD)
+        case AlgorithmType::AES_128_GCM: return std::make_unique<sym::AES_GCM>(128);
+        case AlgorithmType::AES_192_GCM: return std::make_unique<sym::AES_GCM>(192);
+        case AlgorithmType::AES_256_GCM: return std::make_unique<sym::AES_GCM>(256);
+        case AlgorithmType::CHACHA20_POLY1305: return std::make_unique<sym::ChaCha20Poly1305>();
+        case AlgorithmType::SERPENT_256_GCM: return std::make_unique<sym::Serpent_GCM>();
+        case AlgorithmType::TWOFISH_128_GCM: return std::make_unique<sym::Twofish_GCM>(128);
+        case AlgorithmType::TWOFISH_192_GCM: return std::make_unique<sym::Twofish_GCM>(192);
+        case AlgorithmType::TWOFISH_256_GCM: return std::make_unique<sym::Twofish_GCM>(256);
+        
+        // International standard algorithms
+        case AlgorithmType::CAMELLIA_128_GCM: return std::make_unique<sym::Camellia_GCM>(128);
+        case AlgorithmType::CAMELLIA_192_GCM: return std::make_unique<sym::Camellia_GCM>(192);
+        case AlgorithmType::CAMELLIA_256_GCM: return std::make_unique<sym::Camellia_GCM>(256);
+        case AlgorithmType::ARIA_128_GCM: return std::make_unique<sym::ARIA_GCM>(128);
+        case AlgorithmType::ARIA_192_GCM: return std::make_unique<sym::ARIA_GCM>(192);
+        case AlgorithmType::ARIA_256_GCM: return std::make_unique<sym::ARIA_GCM>(256);
+        case AlgorithmType::SM4_GCM: return std::make_unique<sym::SM4_GCM>();
+        
+        // Non-AEAD symmetric modes
+        case AlgorithmType::AES_128_CBC: return std::make_unique<sym::AES_CBC>(128);
+        case AlgorithmType::AES_192_CBC: return std::make_unique<sym::AES_CBC>(192);
+        case AlgorithmType::AES_256_CBC: return std::make_unique<sym::AES_CBC>(256);
+        case AlgorithmType::AES_128_CTR: return std::make_unique<sym::AES_CTR>(128);
+        case AlgorithmType::AES_192_CTR: return std::make_unique<sym::AES_CTR>(192);
+        case AlgorithmType::AES_256_CTR: return std::make_unique<sym::AES_CTR>(256);
+        case AlgorithmType::AES_128_CFB: return std::make_unique<sym::AES_CFB>(128);
+        case AlgorithmType::AES_192_CFB: return std::make_unique<sym::AES_CFB>(192);
+        case AlgorithmType::AES_256_CFB: return std::make_unique<sym::AES_CFB>(256);
+        case AlgorithmType::AES_128_OFB: return std::make_unique<sym::AES_OFB>(128);
+        case AlgorithmType::AES_192_OFB: return std::make_unique<sym::AES_OFB>(192);
+        case AlgorithmType::AES_256_OFB: return std::make_unique<sym::AES_OFB>(256);
+        
+        // ECB mode (INSECURE - educational only)
+        case AlgorithmType::AES_128_ECB: return std::make_unique<sym::AES_ECB>(128);
+        case AlgorithmType::AES_192_ECB: return std::make_unique<sym::AES_ECB>(192);
+        case AlgorithmType::AES_256_ECB: return std::make_unique<sym::AES_ECB>(256);
+        
+        // XTS mode (disk encryption)
+        case AlgorithmType::AES_128_XTS: return std::make_unique<sym::AES_XTS>(128);
+        case AlgorithmType::AES_256_XTS: return std::make_unique<sym::AES_XTS>(256);
+        
+        // Legacy algorithms (for compatibility only)
+        case AlgorithmType::TRIPLE_DES_CBC: return std::make_unique<sym::TripleDES>();
+        
+        // Asymmetric algorithms (RSA, ECC hybrid - ECDH + AES-GCM)
+        case AlgorithmType::RSA_2048: return std::make_unique<asym::RSA>(2048);
+        case AlgorithmType::RSA_3072: return std::make_unique<asym::RSA>(3072);
+        case AlgorithmType::RSA_4096: return std::make_unique<asym::RSA>(4096);
+        case AlgorithmType::ECC_P256: return std::make_unique<asym::ECCHybrid>(asym::ECCurve::SECP256R1);
+        case AlgorithmType::ECC_P384: return std::make_unique<asym::ECCHybrid>(asym::ECCurve::SECP384R1);
+        case AlgorithmType::ECC_P521: return std::make_unique<asym::ECCHybrid>(asym::ECCurve::SECP521R1);
+        
+        // Classical ciphers (educational only)
+        case AlgorithmType::CAESAR: return std::make_unique<classical::Caesar>();
+        case AlgorithmType::VIGENERE: return std::make_unique<classical::Vigenere>();
+        case AlgorithmType::PLAYFAIR: return std::make_unique<classical::Playfair>();
+        case AlgorithmType::HILL: return std::make_unique<classical::HillCipher>();
+        case AlgorithmType::SUBSTITUTION: return std::make_unique<classical::SubstitutionCipher>();
+        
+        // Post-Quantum hybrids (NIST FIPS 203); bare KEMs and signatures are not file ciphers
+        case AlgorithmType::KYBER_512_HYBRID: return std::make_unique<pqc::KyberHybrid>(pqc::Kyber::Variant::Kyber512);
+        case AlgorithmType::KYBER_768_HYBRID: return std::make_unique<pqc::KyberHybrid>(pqc::Kyber::Variant::Kyber768);
+        case AlgorithmType::KYBER_1024_HYBRID: return std::make_unique<pqc::KyberHybrid>(pqc::Kyber::Variant::Kyber1024);
+        
+        // High-throughput AEAD
+        case AlgorithmType::AEGIS_128L: return std::make_unique<sym::AEGIS>(128);
+        case AlgorithmType::AEGIS_256: return std::make_unique<sym::AEGIS>(256);
+        case AlgorithmType::AES_128_OCB: return std::make_unique<sym::AES_OCB>(128);
+        case AlgorithmType::AES_192_OCB: return std::make_unique<sym::AES_OCB>(192);
+        case AlgorithmType::AES_256_OCB: return std::make_unique<sym::AES_OCB>(256);
+        
+        default: return nullptr;
+    }
+}
+
+} // anonymous namespace
+
 CryptoEngine::CryptoEngine() {
     spdlog::debug("CryptoEngine created");
 }
@@ -41,94 +134,32 @@ CryptoEngine::~CryptoEngine() {
 }
 
 void CryptoEngine::initialize() {
-    spdlog::info("Initializing CryptoEngine...");
-    
-    // Register modern symmetric algorithms (AEAD)
-    register_algorithm(std::make_unique<algorithms::symmetric::AES_GCM>(128));
-    register_algorithm(std::make_unique<algorithms::symmetric::AES_GCM>(192));
-    register_algorithm(std::make_unique<algorithms::symmetric::AES_GCM>(256));
-    register_algorithm(std::make_unique<algorithms::symmetric::ChaCha20Poly1305>());
-    register_algorithm(std::make_unique<algorithms::symmetric::Serpent_GCM>());
-    register_algorithm(std::make_unique<algorithms::symmetric::Twofish_GCM>(128));
-    register_algorithm(std::make_unique<algorithms::symmetric::Twofish_GCM>(192));
-    register_algorithm(std::make_unique<algorithms::symmetric::Twofish_GCM>(256));
-    
-    // Register international standard algorithms
-    register_algorithm(std::make_unique<algorithms::symmetric::Camellia_GCM>(128));
-    register_algorithm(std::make_unique<algorithms::symmetric::Camellia_GCM>(192));
-    register_algorithm(std::make_unique<algorithms::symmetric::Camellia_GCM>(256));
-    register_algorithm(std::make_unique<algorithms::symmetric::ARIA_GCM>(128));
-    register_algorithm(std::make_unique<algorithms::symmetric::ARIA_GCM>(192));
-    register_algorithm(std::make_unique<algorithms::symmetric::ARIA_GCM>(256));
-    register_algorithm(std::make_unique<algorithms::symmetric::SM4_GCM>());
-    
-    // Register non-AEAD symmetric algorithms (CBC, CTR modes)
-    register_algorithm(std::make_unique<algorithms::symmetric::AES_CBC>(128));
-    register_algorithm(std::make_unique<algorithms::symmetric::AES_CBC>(192));
-    register_algorithm(std::make_unique<algorithms::symmetric::AES_CBC>(256));
-    register_algorithm(std::make_unique<algorithms::symmetric::AES_CTR>(128));
-    register_algorithm(std::make_unique<algorithms::symmetric::AES_CTR>(192));
-    register_algorithm(std::make_unique<algorithms::symmetric::AES_CTR>(256));
-    
-    // Register CFB mode algorithms
-    register_algorithm(std::make_unique<algorithms::symmetric::AES_CFB>(128));
-    register_algorithm(std::make_unique<algorithms::symmetric::AES_CFB>(192));
-    register_algorithm(std::make_unique<algorithms::symmetric::AES_CFB>(256));
-    
-    // Register OFB mode algorithms
-    register_algorithm(std::make_unique<algorithms::symmetric::AES_OFB>(128));
-    register_algorithm(std::make_unique<algorithms::symmetric::AES_OFB>(192));
-    register_algorithm(std::make_unique<algorithms::symmetric::AES_OFB>(256));
-    
-    // Register ECB mode algorithms (INSECURE - educational only)
-    register_algorithm(std::make_unique<algorithms::symmetric::AES_ECB>(128));
-    register_algorithm(std::make_unique<algorithms::symmetric::AES_ECB>(192));
-    register_algorithm(std::make_unique<algorithms::symmetric::AES_ECB>(256));
-    
-    // Register XTS mode algorithms (disk encryption)
-    register_algorithm(std::make_unique<algorithms::symmetric::AES_XTS>(128));
-    register_algorithm(std::make_unique<algorithms::symmetric::AES_XTS>(256));
-    
-    // Register legacy algorithms (for compatibility only)
-    register_algorithm(std::make_unique<algorithms::symmetric::TripleDES>());
-    
-    // Register asymmetric algorithms (RSA)
-    register_algorithm(std::make_unique<algorithms::asymmetric::RSA>(2048));
-    register_algorithm(std::make_unique<algorithms::asymmetric::RSA>(3072));
-    register_algorithm(std::make_unique<algorithms::asymmetric::RSA>(4096));
-    
-    // Register asymmetric algorithms (ECC hybrid - ECDH + AES-GCM)
-    register_algorithm(std::make_unique<algorithms::asymmetric::ECCHybrid>(algorithms::asymmetric::ECCurve::SECP256R1));
-    register_algorithm(std::make_unique<algorithms::asymmetric::ECCHybrid>(algorithms::asymmetric::ECCurve::SECP384R1));
-    register_algorithm(std::make_unique<algorithms::asymmetric::ECCHybrid>(algorithms::asymmetric::ECCurve::SECP521R1));
-    
-    // Register classical ciphers (educational only)
-    register_algorithm(std::make_unique<algorithms::classical::Caesar>());
-    register_algorithm(std::make_unique<algorithms::classical::Vigenere>());
-    register_algorithm(std::make_unique<algorithms::classical::Playfair>());
-    register_algorithm(std::make_unique<algorithms::classical::HillCipher>());
-    register_algorithm(std::make_unique<algorithms::classical::SubstitutionCipher>());
-    
-    // Register Post-Quantum algorithms (NIST FIPS 203/204)
-    register_algorithm(std::make_unique<algorithms::pqc::KyberHybrid>(algorithms::pqc::Kyber::Variant::Kyber512));
-    register_algorithm(std::make_unique<algorithms::pqc::KyberHybrid>(algorithms::pqc::Kyber::Variant::Kyber768));
-    register_algorithm(std::make_unique<algorithms::pqc::KyberHybrid>(algorithms::pqc::Kyber::Variant::Kyber1024));
-    
-    spdlog::info("CryptoEngine initialized with {} algorithms", algorithms_.size());
+    // Nothing is constructed here: get_algorithm() builds each algorithm on first use
+    spdlog::debug("CryptoEngine ready ({} algorithms known)", std::size(ALGORITHM_TABLE));
 }
 
 void CryptoEngine::register_algorithm(std::unique_ptr<ICryptoAlgorithm> algorithm) {
     auto type = algorithm->type();
+    std::lock_guard<std::mutex> lock(mutex_);
     algorithms_[type] = std::move(algorithm);
     spdlog::debug("Registered algorithm: {}", algorithm_name(type));
 }
 
 ICryptoAlgorithm* CryptoEngine::get_algorithm(AlgorithmType type) {
+    std::lock_guard<std::mutex> lock(mutex_);
     auto it = algorithms_.find(type);
     if (it != algorithms_.end()) {
         return it->second.get();
     }
-    return nullptr;
+    
+    auto algorithm = create_algorithm(type);
+    if (!algorithm) {
+        return nullptr;
+    }
+    spdlog::debug("Created algorithm: {}", algorithm_name(type));
+    auto* created = algorithm.get();
+    algorithms_.emplace(type, std::move(algorithm));
+    return created;
 }
 
 std::vector<uint8_t> CryptoEngine::derive_key(
@@ -139,11 +170,10 @@ std::vector<uint8_t> CryptoEngine::derive_key(
     spdlog::debug("Deriving key with {} (iterations: {}, memory: {}KB)",
                   kdf_name(config.kdf), config.kdf_iterations, config.kdf_memory_kb);
     
-    // Determine key size based on algorithm
+    // Determine key size based on algorithm; the table answers without constructing it
     size_t key_size = 32; // Default 256-bit
-    auto* algo = get_algorithm(config.algorithm);
-    if (algo) {
-        key_size = algo->key_size();
+    if (auto* info = find_algorithm(config.algorithm); info && info->key_size > 0) {
+        key_size = info->key_size;
     }
     
     std::vector<uint8_t> key(key_size);
@@ -171,6 +201,8 @@ std::vector<uint8_t> CryptoEngine::derive_key(
                     config.kdf_parallelism
                 );
                 
+                // Concurrent derivations queue rather than exceed the process memory budget
+                auto memory = MemoryBudget::global().reserve(uint64_t(config.kdf_memory_kb) * 1024);
                 argon2->hash(key, password, salt);
                 break;
             }
@@ -221,6 +253,8 @@ std::vector<uint8_t> CryptoEngine::derive_key(
                 uint32_t p = config.kdf_parallelism;
                 
                 auto scrypt = pwdhash->from_params(N, r, p);
+                // scrypt's working memory is 128 * N * r bytes
+                auto memory = MemoryBudget::global().reserve(uint64_t(128) * N * r);
                 scrypt->hash(
                     key,
                     password,
@@ -243,79 +277,20 @@ std::vector<uint8_t> CryptoEngine::derive_key(
 }
 
 std::vector<uint8_t> CryptoEngine::generate_salt(size_t length) {
-    Botan::AutoSeeded_RNG rng;
-    std::vector<uint8_t> salt(length);
-    rng.randomize(salt.data(), salt.size());
+    auto salt = SecureRandom::bytes(length);
     spdlog::debug("Generated random salt ({} bytes)", length);
     return salt;
 }
 
 std::vector<uint8_t> CryptoEngine::generate_nonce(size_t length) {
-    Botan::AutoSeeded_RNG rng;
-    std::vector<uint8_t> nonce(length);
-    rng.randomize(nonce.data(), nonce.size());
+    auto nonce = SecureRandom::bytes(length);
     spdlog::debug("Generated random nonce ({} bytes)", length);
     return nonce;
 }
 
 std::string CryptoEngine::algorithm_name(AlgorithmType type) {
-    switch (type) {
-        case AlgorithmType::AES_128_GCM: return "AES-128-GCM";
-        case AlgorithmType::AES_192_GCM: return "AES-192-GCM";
-        case AlgorithmType::AES_256_GCM: return "AES-256-GCM";
-        case AlgorithmType::AES_128_CBC: return "AES-128-CBC";
-        case AlgorithmType::AES_192_CBC: return "AES-192-CBC";
-        case AlgorithmType::AES_256_CBC: return "AES-256-CBC";
-        case AlgorithmType::AES_128_CTR: return "AES-128-CTR";
-        case AlgorithmType::AES_192_CTR: return "AES-192-CTR";
-        case AlgorithmType::AES_256_CTR: return "AES-256-CTR";
-        case AlgorithmType::AES_128_CFB: return "AES-128-CFB";
-        case AlgorithmType::AES_192_CFB: return "AES-192-CFB";
-        case AlgorithmType::AES_256_CFB: return "AES-256-CFB";
-        case AlgorithmType::AES_128_OFB: return "AES-128-OFB";
-        case AlgorithmType::AES_192_OFB: return "AES-192-OFB";
-        case AlgorithmType::AES_256_OFB: return "AES-256-OFB";
-        case AlgorithmType::AES_128_ECB: return "AES-128-ECB";
-        case AlgorithmType::AES_192_ECB: return "AES-192-ECB";
-        case AlgorithmType::AES_256_ECB: return "AES-256-ECB";
-        case AlgorithmType::AES_128_XTS: return "AES-128-XTS";
-        case AlgorithmType::AES_256_XTS: return "AES-256-XTS";
-        case AlgorithmType::TRIPLE_DES_CBC: return "3DES-CBC";
-        case AlgorithmType::RSA_2048: return "RSA-2048";
-        case AlgorithmType::RSA_3072: return "RSA-3072";
-        case AlgorithmType::RSA_4096: return "RSA-4096";
-        case AlgorithmType::ECC_P256: return "ECC-P256";
-        case AlgorithmType::ECC_P384: return "ECC-P384";
-        case AlgorithmType::ECC_P521: return "ECC-P521";
-        case AlgorithmType::CHACHA20_POLY1305: return "ChaCha20-Poly1305";
-        case AlgorithmType::SERPENT_256_GCM: return "Serpent-256-GCM";
-        case AlgorithmType::TWOFISH_128_GCM: return "Twofish-128-GCM";
-        case AlgorithmType::TWOFISH_192_GCM: return "Twofish-192-GCM";
-        case AlgorithmType::TWOFISH_256_GCM: return "Twofish-256-GCM";
-        case AlgorithmType::CAMELLIA_128_GCM: return "Camellia-128-GCM";
-        case AlgorithmType::CAMELLIA_192_GCM: return "Camellia-192-GCM";
-        case AlgorithmType::CAMELLIA_256_GCM: return "Camellia-256-GCM";
-        case AlgorithmType::ARIA_128_GCM: return "ARIA-128-GCM";
-        case AlgorithmType::ARIA_192_GCM: return "ARIA-192-GCM";
-        case AlgorithmType::ARIA_256_GCM: return "ARIA-256-GCM";
-        case AlgorithmType::SM4_GCM: return "SM4-GCM";
-        case AlgorithmType::CAESAR: return "Caesar";
-        case AlgorithmType::VIGENERE: return "Vigenère";
-        case AlgorithmType::PLAYFAIR: return "Playfair";
-        case AlgorithmType::SUBSTITUTION: return "Substitution";
-        case AlgorithmType::HILL: return "Hill";
-        // Post-Quantum algorithms
-        case AlgorithmType::KYBER_512: return "Kyber-512";
-        case AlgorithmType::KYBER_768: return "Kyber-768";
-        case AlgorithmType::KYBER_1024: return "Kyber-1024";
-        case AlgorithmType::DILITHIUM_2: return "Dilithium-2";
-        case AlgorithmType::DILITHIUM_3: return "Dilithium-3";
-        case AlgorithmType::DILITHIUM_5: return "Dilithium-5";
-        case AlgorithmType::KYBER_512_HYBRID: return "Kyber-512-Hybrid";
-        case AlgorithmType::KYBER_768_HYBRID: return "Kyber-768-Hybrid";
-        case AlgorithmType::KYBER_1024_HYBRID: return "Kyber-1024-Hybrid";
-        default: return "Unknown";
-    }
+    auto* info = find_algorithm(type);
+    return info ? std::string(info->name) : "Unknown";
 }
 
 std::string CryptoEngine::kdf_name(KDFType type) {
@@ -340,87 +315,9 @@ std::string CryptoEngine::security_level_name(SecurityLevel level) {
 }
 
 std::optional<AlgorithmType> CryptoEngine::parse_algorithm(const std::string& name) {
-    std::string lower = name;
-    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
-    
-    // AES-GCM (AEAD)
-    if (lower == "aes-128-gcm" || lower == "aes128gcm") return AlgorithmType::AES_128_GCM;
-    if (lower == "aes-192-gcm" || lower == "aes192gcm") return AlgorithmType::AES_192_GCM;
-    if (lower == "aes-256-gcm" || lower == "aes256gcm" || lower == "aes" || lower == "aes256") return AlgorithmType::AES_256_GCM;
-    
-    // AES-CBC (legacy, not authenticated)
-    if (lower == "aes-128-cbc" || lower == "aes128cbc") return AlgorithmType::AES_128_CBC;
-    if (lower == "aes-192-cbc" || lower == "aes192cbc") return AlgorithmType::AES_192_CBC;
-    if (lower == "aes-256-cbc" || lower == "aes256cbc") return AlgorithmType::AES_256_CBC;
-    
-    // AES-CTR (stream mode, not authenticated)
-    if (lower == "aes-128-ctr" || lower == "aes128ctr") return AlgorithmType::AES_128_CTR;
-    if (lower == "aes-192-ctr" || lower == "aes192ctr") return AlgorithmType::AES_192_CTR;
-    if (lower == "aes-256-ctr" || lower == "aes256ctr") return AlgorithmType::AES_256_CTR;
-    
-    // AES-CFB (self-synchronizing stream mode)
-    if (lower == "aes-128-cfb" || lower == "aes128cfb") return AlgorithmType::AES_128_CFB;
-    if (lower == "aes-192-cfb" || lower == "aes192cfb") return AlgorithmType::AES_192_CFB;
-    if (lower == "aes-256-cfb" || lower == "aes256cfb") return AlgorithmType::AES_256_CFB;
-    
-    // AES-OFB (output feedback stream mode)
-    if (lower == "aes-128-ofb" || lower == "aes128ofb") return AlgorithmType::AES_128_OFB;
-    if (lower == "aes-192-ofb" || lower == "aes192ofb") return AlgorithmType::AES_192_OFB;
-    if (lower == "aes-256-ofb" || lower == "aes256ofb") return AlgorithmType::AES_256_OFB;
-    
-    // AES-ECB (INSECURE - educational only)
-    if (lower == "aes-128-ecb" || lower == "aes128ecb") return AlgorithmType::AES_128_ECB;
-    if (lower == "aes-192-ecb" || lower == "aes192ecb") return AlgorithmType::AES_192_ECB;
-    if (lower == "aes-256-ecb" || lower == "aes256ecb") return AlgorithmType::AES_256_ECB;
-    
-    // AES-XTS (disk encryption mode)
-    if (lower == "aes-128-xts" || lower == "aes128xts") return AlgorithmType::AES_128_XTS;
-    if (lower == "aes-256-xts" || lower == "aes256xts" || lower == "xts") return AlgorithmType::AES_256_XTS;
-    
-    // Legacy algorithms
-    if (lower == "3des" || lower == "3des-cbc" || lower == "tripledes" || lower == "triple-des") return AlgorithmType::TRIPLE_DES_CBC;
-    
-    // RSA asymmetric encryption
-    if (lower == "rsa-2048" || lower == "rsa2048") return AlgorithmType::RSA_2048;
-    if (lower == "rsa-3072" || lower == "rsa3072") return AlgorithmType::RSA_3072;
-    if (lower == "rsa-4096" || lower == "rsa4096" || lower == "rsa") return AlgorithmType::RSA_4096;
-    
-    // ECC hybrid encryption (ECDH + AES-GCM)
-    if (lower == "ecc-p256" || lower == "eccp256" || lower == "p256" || lower == "secp256r1") return AlgorithmType::ECC_P256;
-    if (lower == "ecc-p384" || lower == "eccp384" || lower == "p384" || lower == "secp384r1") return AlgorithmType::ECC_P384;
-    if (lower == "ecc-p521" || lower == "eccp521" || lower == "p521" || lower == "secp521r1" || lower == "ecc") return AlgorithmType::ECC_P521;
-    
-    if (lower == "chacha20-poly1305" || lower == "chacha20" || lower == "chacha") return AlgorithmType::CHACHA20_POLY1305;
-    if (lower == "serpent-256-gcm" || lower == "serpent" || lower == "serpent256") return AlgorithmType::SERPENT_256_GCM;
-    if (lower == "twofish-128-gcm" || lower == "twofish128") return AlgorithmType::TWOFISH_128_GCM;
-    if (lower == "twofish-192-gcm" || lower == "twofish192") return AlgorithmType::TWOFISH_192_GCM;
-    if (lower == "twofish-256-gcm" || lower == "twofish" || lower == "twofish256") return AlgorithmType::TWOFISH_256_GCM;
-    if (lower == "camellia-128-gcm" || lower == "camellia128") return AlgorithmType::CAMELLIA_128_GCM;
-    if (lower == "camellia-192-gcm" || lower == "camellia192") return AlgorithmType::CAMELLIA_192_GCM;
-    if (lower == "camellia-256-gcm" || lower == "camellia" || lower == "camellia256") return AlgorithmType::CAMELLIA_256_GCM;
-    if (lower == "aria-128-gcm" || lower == "aria128") return AlgorithmType::ARIA_128_GCM;
-    if (lower == "aria-192-gcm" || lower == "aria192") return AlgorithmType::ARIA_192_GCM;
-    if (lower == "aria-256-gcm" || lower == "aria" || lower == "aria256") return AlgorithmType::ARIA_256_GCM;
-    if (lower == "sm4-gcm" || lower == "sm4") return AlgorithmType::SM4_GCM;
-    if (lower == "caesar") return AlgorithmType::CAESAR;
-    if (lower == "vigenere" || lower == "vigenère") return AlgorithmType::VIGENERE;
-    if (lower == "playfair") return AlgorithmType::PLAYFAIR;
-    if (lower == "substitution" || lower == "sub") return AlgorithmType::SUBSTITUTION;
-    if (lower == "hill") return AlgorithmType::HILL;
-    
-    // Post-Quantum algorithms (ML-KEM / Kyber)
-    if (lower == "kyber-512" || lower == "kyber512") return AlgorithmType::KYBER_512;
-    if (lower == "kyber-768" || lower == "kyber768") return AlgorithmType::KYBER_768;
-    if (lower == "kyber-1024" || lower == "kyber1024" || lower == "kyber") return AlgorithmType::KYBER_1024;
-    if (lower == "kyber-512-hybrid" || lower == "kyber512hybrid") return AlgorithmType::KYBER_512_HYBRID;
-    if (lower == "kyber-768-hybrid" || lower == "kyber768hybrid") return AlgorithmType::KYBER_768_HYBRID;
-    if (lower == "kyber-1024-hybrid" || lower == "kyber1024hybrid" || lower == "kyber-hybrid") return AlgorithmType::KYBER_1024_HYBRID;
-    
-    // Post-Quantum signatures (ML-DSA / Dilithium)
-    if (lower == "dilithium-2" || lower == "dilithium2") return AlgorithmType::DILITHIUM_2;
-    if (lower == "dilithium-3" || lower == "dilithium3") return AlgorithmType::DILITHIUM_3;
-    if (lower == "dilithium-5" || lower == "dilithium5" || lower == "dilithium") return AlgorithmType::DILITHIUM_5;
-    
+    if (auto* info = find_algorithm(std::string_view(name))) {
+        return info->type;
+    }
     return std::nullopt;
 }
 
@@ -0,0 +1,824 @@
+/**
+ * @file io_backend.cpp
+ * @brief Blocking and O_DIRECT I/O backends, backend selection and streambuf adapters
+ */
+
+#include "filevault/core/io_backend.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+namespace filevault {
+namespace core {
+
+namespace {
+
+std::atomic<IOBackendType> g_default_backend{IOBackendType::SYNC};
+std::atomic<bool> g_default_direct{false};
+std::atomic<CachePolicy> g_default_cache_policy{CachePolicy::KEEP};
+
+/**
+ * @brief Reader on top of std::ifstream (blocking path on non-Linux platforms)
+ */
+class SyncReader : public ISequentialReader {
+public:
+    SyncReader(std::ifstream&& file, uint64_t size)
+        : file_(std::move(file)), size_(size) {}
+
+    size_t read(uint8_t* dst, size_t length) override {
+        file_.read(reinterpret_cast<char*>(dst), static_cast<std::streamsize>(length));
+        size_t got = static_cast<size_t>(file_.gcount());
+        if (file_.bad()) {
+            throw std::runtime_error("Read error");
+        }
+        if (got < length) {
+            file_.clear();
+        }
+        return got;
+    }
+
+    uint64_t size() const override { return size_; }
+
+private:
+    std::ifstream file_;
+    uint64_t size_;
+};
+
+/**
+ * @brief Writer on top of std::ofstream
+ */
+class SyncWriter : public ISequentialWriter {
+public:
+    explicit SyncWriter(std::ofstream&& file) : file_(std::move(file)) {}
+
+    void write(const uint8_t* src, size_t length) override {
+        file_.write(reinterpret_cast<const char*>(src), static_cast<std::streamsize>(length));
+        if (!file_) {
+            throw std::runtime_error("Write error");
+        }
+    }
+
+    void flush() override {
+        file_.flush();
+        if (!file_) {
+            throw std::runtime_error("Write error");
+        }
+    }
+
+    void sync() override {
+        // iostreams have no portable fsync; the data has at least left our buffers
+        flush();
+    }
+
+private:
+    std::ofstream file_;
+};
+
+#ifdef __linux__
+
+constexpr size_t ALIGNMENT = IOBackend::DIRECT_IO_ALIGNMENT;
+
+size_t align_up(size_t value) {
+    return (value + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+void sync_fd(int fd) {
+    if (::fdatasync(fd) != 0) {
+        throw std::runtime_error(std::string("Sync error: ") + std::strerror(errno));
+    }
+}
+
+/**
+ * @brief Open @p path for writing: create/truncate it, or keep the first
+ * IOOptions::write_offset bytes of an existing file
+ * @return File descriptor, or -1 with errno set
+ */
+int open_for_write(const std::string& path, const IOOptions& options, int extra_flags) {
+    if (!options.write_offset) {
+        return ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC | extra_flags, 0644);
+    }
+    // O_RDWR: O_DIRECT writers read back the partial block at the offset
+    int fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC | extra_flags);
+    if (fd >= 0 && ::ftruncate(fd, static_cast<off_t>(*options.write_offset)) != 0) {
+        int saved = errno;
+        ::close(fd);
+        errno = saved;
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief Blocking reader on a file descriptor, with page-cache hints
+ */
+class PosixReader : public ISequentialReader {
+public:
+    PosixReader(int fd, uint64_t size, CachePolicy policy, uint64_t offset)
+        : fd_(fd), size_(size), offset_(offset), advisor_(fd, policy, offset) {
+        advisor_.advise_sequential(size);
+    }
+
+    ~PosixReader() override {
+        advisor_.release(false);
+        ::close(fd_);
+    }
+
+    size_t read(uint8_t* dst, size_t length) override {
+        size_t got = 0;
+        while (got < length) {
+            ssize_t n = ::read(fd_, dst + got, length - got);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                throw std::runtime_error(std::string("Read error: ") + std::strerror(errno));
+            }
+            if (n == 0) break;
+            got += static_cast<size_t>(n);
+        }
+        offset_ += got;
+        advisor_.consumed(offset_);
+        return got;
+    }
+
+    uint64_t size() const override { return size_; }
+
+private:
+    int fd_;
+    uint64_t size_;
+    uint64_t offset_ = 0;
+    detail::CacheAdvisor advisor_;
+};
+
+/**
+ * @brief Blocking writer on a file descriptor, with page-cache hints
+ *
+ * Unbuffered: callers batch small writes (WriterStreamBuf).
+ */
+class PosixWriter : public ISequentialWriter {
+public:
+    PosixWriter(int fd, CachePolicy policy, uint64_t offset)
+        : fd_(fd), offset_(offset), advisor_(fd, policy, offset) {}
+
+    ~PosixWriter() override {
+        try {
+            flush();
+        } catch (const std::exception& e) {
+            spdlog::error("Write failed on close: {}", e.what());
+        }
+        ::close(fd_);
+    }
+
+    void write(const uint8_t* src, size_t length) override {
+        size_t written = 0;
+        while (written < length) {
+            ssize_t n = ::write(fd_, src + written, length - written);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                throw std::runtime_error(std::string("Write error: ") + std::strerror(errno));
+            }
+            written += static_cast<size_t>(n);
+        }
+        offset_ += length;
+        advisor_.written(offset_);
+    }
+
+    void flush() override {
+        // Data is already in the kernel; only DROP needs to wait for writeback
+        advisor_.release(true);
+    }
+
+    void sync() override {
+        flush();
+        sync_fd(fd_);
+    }
+
+private:
+    int fd_;
+    uint64_t offset_ = 0;
+    detail::CacheAdvisor advisor_;
+};
+
+/**
+ * @brief Page-aligned heap buffer for O_DIRECT transfers
+ */
+class AlignedBuffer {
+public:
+    explicit AlignedBuffer(size_t size) : size_(size) {
+        void* buffer = nullptr;
+        if (posix_memalign(&buffer, ALIGNMENT, size) != 0) {
+            throw std::bad_alloc();
+        }
+        data_ = static_cast<uint8_t*>(buffer);
+    }
+    ~AlignedBuffer() { std::free(data_); }
+
+    AlignedBuffer(const AlignedBuffer&) = delete;
+    AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+
+    uint8_t* data() { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+/**
+ * @brief O_DIRECT reader: aligned block reads into a bounce buffer
+ */
+class DirectReader : public ISequentialReader {
+public:
+    DirectReader(int fd, uint64_t size, size_t block_size, uint64_t offset)
+        : fd_(fd), size_(size), buffer_(align_up((std::max)(block_size, ALIGNMENT))),
+          next_offset_(offset / ALIGNMENT * ALIGNMENT),
+          skip_(static_cast<size_t>(offset - next_offset_)) {}
+
+    ~DirectReader() override { ::close(fd_); }
+
+    size_t read(uint8_t* dst, size_t length) override {
+        size_t copied = 0;
+        while (copied < length) {
+            if (pos_ == filled_ && !refill()) {
+                break;
+            }
+            size_t n = (std::min)(length - copied, filled_ - pos_);
+            std::memcpy(dst + copied, buffer_.data() + pos_, n);
+            pos_ += n;
+            copied += n;
+        }
+        return copied;
+    }
+
+    uint64_t size() const override { return size_; }
+
+private:
+    bool refill() {
+        if (eof_ || next_offset_ >= size_) {
+            return false;
+        }
+        ssize_t n;
+        do {
+            n = ::pread(fd_, buffer_.data(), buffer_.size(), static_cast<off_t>(next_offset_));
+        } while (n < 0 && errno == EINTR);
+        if (n < 0) {
+            throw std::runtime_error(std::string("Read error: ") + std::strerror(errno));
+        }
+        // Short reads only happen at end of file; later offsets would be unaligned
+        if (static_cast<size_t>(n) < buffer_.size()) {
+            eof_ = true;
+        }
+        filled_ = static_cast<size_t>(n);
+        next_offset_ += filled_;
+        // The first block may start before the requested offset
+        pos_ = (std::min)(skip_, filled_);
+        skip_ = 0;
+        return filled_ > pos_;
+    }
+
+    int fd_;
+    uint64_t size_;
+    AlignedBuffer buffer_;
+    uint64_t next_offset_ = 0;
+    size_t skip_ = 0;             // Bytes of the first block before the read offset
+    size_t filled_ = 0;
+    size_t pos_ = 0;
+    bool eof_ = false;
+};
+
+/**
+ * @brief O_DIRECT writer: stages data and writes whole aligned blocks
+ *
+ * flush() writes a partial block zero-padded to the alignment and truncates
+ * the file to its logical length, but keeps the block staged so later writes
+ * rewrite it at the same aligned offset.
+ */
+class DirectWriter : public ISequentialWriter {
+public:
+    DirectWriter(int fd, size_t block_size)
+        : fd_(fd), buffer_(align_up((std::max)(block_size, ALIGNMENT))) {}
+
+    ~DirectWriter() override {
+        try {
+            flush();
+        } catch (const std::exception& e) {
+            spdlog::error("Direct write failed on close: {}", e.what());
+        }
+        ::close(fd_);
+    }
+
+    void write(const uint8_t* src, size_t length) override {
+        if (length > 0) {
+            truncated_ = false;
+        }
+        while (length > 0) {
+            size_t n = (std::min)(length, buffer_.size() - filled_);
+            std::memcpy(buffer_.data() + filled_, src, n);
+            filled_ += n;
+            src += n;
+            length -= n;
+            if (filled_ == buffer_.size()) {
+                write_block(buffer_.size());
+                block_offset_ += filled_;
+                filled_ = 0;
+            }
+        }
+    }
+
+    void flush() override {
+        if (filled_ == 0 || truncated_) {
+            return;
+        }
+        size_t padded = align_up(filled_);
+        std::memset(buffer_.data() + filled_, 0, padded - filled_);
+        write_block(padded);
+        if (padded != filled_ && ::ftruncate(fd_, static_cast<off_t>(block_offset_ + filled_)) != 0) {
+            throw std::runtime_error(std::string("Truncate error: ") + std::strerror(errno));
+        }
+        truncated_ = true;
+    }
+
+    void sync() override {
+        flush();
+        sync_fd(fd_);
+    }
+
+    /**
+     * @brief Continue after the first @p offset bytes of the file
+     *
+     * The partial block at the offset is read back and staged, so writes stay aligned.
+     */
+    bool start_at(uint64_t offset) {
+        block_offset_ = offset / ALIGNMENT * ALIGNMENT;
+        size_t partial = static_cast<size_t>(offset - block_offset_);
+        if (partial == 0) {
+            return true;
+        }
+        ssize_t n;
+        do {
+            n = ::pread(fd_, buffer_.data(), ALIGNMENT, static_cast<off_t>(block_offset_));
+        } while (n < 0 && errno == EINTR);
+        if (n < static_cast<ssize_t>(partial)) {
+            return false;
+        }
+        filled_ = partial;
+        truncated_ = true;
+        return true;
+    }
+
+private:
+    void write_block(size_t length) {
+        size_t written = 0;
+        while (written < length) {
+            ssize_t n = ::pwrite(fd_, buffer_.data() + written, length - written,
+                                 static_cast<off_t>(block_offset_ + written));
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                throw std::runtime_error(std::string("Write error: ") + std::strerror(errno));
+            }
+            written += static_cast<size_t>(n);
+        }
+    }
+
+    int fd_;
+    AlignedBuffer buffer_;
+    uint64_t block_offset_ = 0;   // Aligned file offset of the staged block
+    size_t filled_ = 0;
+    bool truncated_ = false;      // Staged block already on disk (since last flush)
+};
+
+/**
+ * @brief Open with O_DIRECT; nullptr with a warning if the filesystem refuses it
+ */
+std::unique_ptr<ISequentialReader> open_direct_reader(const std::string& path, const IOOptions& options) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC | O_DIRECT);
+    if (fd < 0) {
+        if (errno == EINVAL) {
+            spdlog::warn("O_DIRECT not supported for {}, using buffered I/O", path);
+        }
+        return nullptr;
+    }
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    return std::make_unique<DirectReader>(fd, static_cast<uint64_t>(st.st_size), options.block_size,
+                                          options.read_offset);
+}
+
+std::unique_ptr<ISequentialWriter> open_direct_writer(const std::string& path, const IOOptions& options) {
+    int fd = open_for_write(path, options, O_DIRECT);
+    if (fd < 0) {
+        if (errno == EINVAL) {
+            spdlog::warn("O_DIRECT not supported for {}, using buffered I/O", path);
+        }
+        return nullptr;
+    }
+    auto writer = std::make_unique<DirectWriter>(fd, options.block_size);
+    if (options.write_offset && !writer->start_at(*options.write_offset)) {
+        spdlog::warn("Cannot resume {} with O_DIRECT, using buffered I/O", path);
+        return nullptr;
+    }
+    return writer;
+}
+
+#endif // __linux__
+
+Result<std::unique_ptr<ISequentialReader>> open_sync_reader(const std::string& path, const IOOptions& options) {
+#ifdef __linux__
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat st {};
+    if (fd < 0 || ::fstat(fd, &st) != 0 || S_ISDIR(st.st_mode) ||
+        ::lseek(fd, static_cast<off_t>(options.read_offset), SEEK_SET) < 0) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        return Result<std::unique_ptr<ISequentialReader>>::error("Failed to open input file: " + path);
+    }
+    return Result<std::unique_ptr<ISequentialReader>>::ok(
+        std::make_unique<PosixReader>(fd, static_cast<uint64_t>(st.st_size), options.cache, options.read_offset));
+#else
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return Result<std::unique_ptr<ISequentialReader>>::error("Failed to open input file: " + path);
+    }
+    uint64_t size = static_cast<uint64_t>(file.tellg());
+    file.seekg(static_cast<std::streamoff>(options.read_offset));
+    return Result<std::unique_ptr<ISequentialReader>>::ok(
+        std::make_unique<SyncReader>(std::move(file), size));
+#endif
+}
+
+Result<std::unique_ptr<ISequentialWriter>> open_sync_writer(const std::string& path, const IOOptions& options) {
+#ifdef __linux__
+    int fd = open_for_write(path, options, 0);
+    uint64_t offset = options.write_offset.value_or(0);
+    if (fd < 0 || ::lseek(fd, static_cast<off_t>(offset), SEEK_SET) < 0) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        return Result<std::unique_ptr<ISequentialWriter>>::error("Failed to create output file: " + path);
+    }
+    return Result<std::unique_ptr<ISequentialWriter>>::ok(std::make_unique<PosixWriter>(fd, options.cache, offset));
+#else
+    std::ofstream file;
+    if (options.write_offset) {
+        std::error_code ec;
+        std::filesystem::resize_file(path, *options.write_offset, ec);
+        if (!ec) {
+            file.open(path, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(static_cast<std::streamoff>(*options.write_offset));
+        }
+    } else {
+        file.open(path, std::ios::binary | std::ios::trunc);
+    }
+    if (!file) {
+        return Result<std::unique_ptr<ISequentialWriter>>::error("Failed to create output file: " + path);
+    }
+    return Result<std::unique_ptr<ISequentialWriter>>::ok(std::make_unique<SyncWriter>(std::move(file)));
+#endif
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// CacheAdvisor
+// ============================================================================
+
+namespace detail {
+
+void CacheAdvisor::advise_sequential(uint64_t size) {
+#ifdef __linux__
+    if (fd_ < 0) {
+        return;
+    }
+    // Doubles the kernel readahead window and starts reading the first window now
+    ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+    ::posix_fadvise(fd_, 0, static_cast<off_t>((std::min)(size, DROP_WINDOW)), POSIX_FADV_WILLNEED);
+#else
+    (void)size;
+#endif
+}
+
+void CacheAdvisor::consumed(uint64_t offset) {
+#ifdef __linux__
+    if (policy_ != CachePolicy::DROP || offset < dropped_ + DROP_WINDOW) {
+        return;
+    }
+    ::posix_fadvise(fd_, static_cast<off_t>(dropped_), static_cast<off_t>(offset - dropped_),
+                    POSIX_FADV_DONTNEED);
+    dropped_ = offset;
+#else
+    (void)offset;
+#endif
+}
+
+void CacheAdvisor::written(uint64_t offset) {
+#ifdef __linux__
+    if (policy_ != CachePolicy::DROP || offset < flushed_ + DROP_WINDOW) {
+        return;
+    }
+    // Start writeback of the newest window without waiting for it
+    ::sync_file_range(fd_, static_cast<off_t>(flushed_), static_cast<off_t>(offset - flushed_),
+                      SYNC_FILE_RANGE_WRITE);
+    // The previous window had a whole window's time to reach the disk; clean pages can be dropped
+    if (flushed_ > dropped_) {
+        ::sync_file_range(fd_, static_cast<off_t>(dropped_), static_cast<off_t>(flushed_ - dropped_),
+                          SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+        ::posix_fadvise(fd_, static_cast<off_t>(dropped_), static_cast<off_t>(flushed_ - dropped_),
+                        POSIX_FADV_DONTNEED);
+        dropped_ = flushed_;
+    }
+    flushed_ = offset;
+#else
+    (void)offset;
+#endif
+}
+
+void CacheAdvisor::release(bool wrote) {
+#ifdef __linux__
+    if (policy_ != CachePolicy::DROP || fd_ < 0) {
+        return;
+    }
+    // Length 0 means "to end of file"
+    if (wrote) {
+        ::sync_file_range(fd_, static_cast<off_t>(dropped_), 0,
+                          SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+    }
+    ::posix_fadvise(fd_, static_cast<off_t>(dropped_), 0, POSIX_FADV_DONTNEED);
+#else
+    (void)wrote;
+#endif
+}
+
+} // namespace detail
+
+// ============================================================================
+// IOBackend
+// ============================================================================
+
+Result<std::unique_ptr<ISequentialReader>> IOBackend::open_reader(
+    const std::string& path, const IOOptions& options) {
+#ifdef FILEVAULT_HAVE_IO_URING
+    if (options.backend == IOBackendType::URING) {
+        std::string error;
+        auto reader = detail::make_uring_reader(path, options, error);
+        if (reader) {
+            return Result<std::unique_ptr<ISequentialReader>>::ok(std::move(reader));
+        }
+        spdlog::warn("io_uring unavailable for {} ({}), using blocking I/O", path, error);
+    }
+#else
+    if (options.backend == IOBackendType::URING) {
+        spdlog::debug("Built without io_uring support, using blocking I/O");
+    }
+#endif
+#ifdef __linux__
+    if (options.direct) {
+        if (auto reader = open_direct_reader(path, options)) {
+            return Result<std::unique_ptr<ISequentialReader>>::ok(std::move(reader));
+        }
+    }
+#endif
+    return open_sync_reader(path, options);
+}
+
+Result<std::unique_ptr<ISequentialWriter>> IOBackend::open_writer(
+    const std::string& path, const IOOptions& options) {
+#ifdef FILEVAULT_HAVE_IO_URING
+    if (options.backend == IOBackendType::URING) {
+        std::string error;
+        auto writer = detail::make_uring_writer(path, options, error);
+        if (writer) {
+            return Result<std::unique_ptr<ISequentialWriter>>::ok(std::move(writer));
+        }
+        spdlog::warn("io_uring unavailable for {} ({}), using blocking I/O", path, error);
+    }
+#else
+    if (options.backend == IOBackendType::URING) {
+        spdlog::debug("Built without io_uring support, using blocking I/O");
+    }
+#endif
+#ifdef __linux__
+    if (options.direct) {
+        if (auto writer = open_direct_writer(path, options)) {
+            return Result<std::unique_ptr<ISequentialWriter>>::ok(std::move(writer));
+        }
+    }
+#endif
+    return open_sync_writer(path, options);
+}
+
+bool IOBackend::is_available(IOBackendType type) {
+    switch (type) {
+        case IOBackendType::SYNC:
+            return true;
+        case IOBackendType::URING:
+#ifdef FILEVAULT_HAVE_IO_URING
+            return detail::uring_supported();
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+IOBackendType IOBackend::default_backend() {
+    return g_default_backend.load(std::memory_order_relaxed);
+}
+
+void IOBackend::set_default_backend(IOBackendType type) {
+    if (type == IOBackendType::URING && !is_available(type)) {
+        spdlog::warn("io_uring is not available on this system, using blocking I/O");
+        type = IOBackendType::SYNC;
+    }
+    g_default_backend.store(type, std::memory_order_relaxed);
+}
+
+bool IOBackend::default_direct() {
+    return g_default_direct.load(std::memory_order_relaxed);
+}
+
+void IOBackend::set_default_direct(bool direct) {
+    if (direct && !is_direct_supported()) {
+        spdlog::warn("O_DIRECT is not available on this platform, using buffered I/O");
+        direct = false;
+    }
+    g_default_direct.store(direct, std::memory_order_relaxed);
+}
+
+bool IOBackend::is_direct_supported() {
+#ifdef __linux__
+    return true;
+#else
+    return false;
+#endif
+}
+
+CachePolicy IOBackend::default_cache_policy() {
+    return g_default_cache_policy.load(std::memory_order_relaxed);
+}
+
+void IOBackend::set_default_cache_policy(CachePolicy policy) {
+    g_default_cache_policy.store(policy, std::memory_order_relaxed);
+}
+
+IOOptions IOBackend::default_options() {
+    IOOptions options;
+    options.backend = default_backend();
+    options.cache = default_cache_policy();
+    return options;
+}
+
+std::string IOBackend::name(IOBackendType type) {
+    switch (type) {
+        case IOBackendType::SYNC: return "sync";
+        case IOBackendType::URING: return "uring";
+    }
+    return "unknown";
+}
+
+std::optional<IOBackendType> IOBackend::parse(const std::string& name) {
+    if (name == "sync") return IOBackendType::SYNC;
+    if (name == "uring" || name == "io_uring") return IOBackendType::URING;
+    return std::nullopt;
+}
+
+std::string IOBackend::cache_policy_name(CachePolicy policy) {
+    switch (policy) {
+        case CachePolicy::KEEP: return "keep";
+        case CachePolicy::DROP: return "drop";
+    }
+    return "unknown";
+}
+
+std::optional<CachePolicy> IOBackend::parse_cache_policy(const std::string& name) {
+    if (name == "keep") return CachePolicy::KEEP;
+    if (name == "drop") return CachePolicy::DROP;
+    return std::nullopt;
+}
+
+// ============================================================================
+// ReaderStreamBuf
+// ============================================================================
+
+ReaderStreamBuf::ReaderStreamBuf(ISequentialReader& reader, size_t buffer_size)
+    : reader_(reader), buffer_(buffer_size) {
+    setg(buffer_.data(), buffer_.data(), buffer_.data());
+}
+
+ReaderStreamBuf::int_type ReaderStreamBuf::underflow() {
+    if (gptr() < egptr()) {
+        return traits_type::to_int_type(*gptr());
+    }
+    size_t got = reader_.read(reinterpret_cast<uint8_t*>(buffer_.data()), buffer_.size());
+    setg(buffer_.data(), buffer_.data(), buffer_.data() + got);
+    if (got == 0) {
+        return traits_type::eof();
+    }
+    return traits_type::to_int_type(*gptr());
+}
+
+std::streamsize ReaderStreamBuf::xsgetn(char* s, std::streamsize count) {
+    // Drain whatever underflow() buffered, then read straight into the caller's buffer
+    std::streamsize buffered = (std::min)(count, static_cast<std::streamsize>(egptr() - gptr()));
+    if (buffered > 0) {
+        std::memcpy(s, gptr(), static_cast<size_t>(buffered));
+        gbump(static_cast<int>(buffered));
+    }
+
+    std::streamsize total = buffered;
+    while (total < count) {
+        size_t got = reader_.read(reinterpret_cast<uint8_t*>(s + total), static_cast<size_t>(count - total));
+        if (got == 0) {
+            break;
+        }
+        total += static_cast<std::streamsize>(got);
+    }
+    return total;
+}
+
+// ============================================================================
+// WriterStreamBuf
+// ============================================================================
+
+WriterStreamBuf::WriterStreamBuf(ISequentialWriter& writer, size_t buffer_size)
+    : writer_(writer), buffer_(buffer_size) {
+    setp(buffer_.data(), buffer_.data() + buffer_.size());
+}
+
+WriterStreamBuf::~WriterStreamBuf() {
+    sync();
+}
+
+bool WriterStreamBuf::flush_buffer() {
+    std::ptrdiff_t pending = pptr() - pbase();
+    if (pending > 0) {
+        try {
+            writer_.write(reinterpret_cast<const uint8_t*>(pbase()), static_cast<size_t>(pending));
+        } catch (const std::exception& e) {
+            spdlog::error("Write failed: {}", e.what());
+            return false;
+        }
+    }
+    setp(buffer_.data(), buffer_.data() + buffer_.size());
+    return true;
+}
+
+WriterStreamBuf::int_type WriterStreamBuf::overflow(int_type ch) {
+    if (!flush_buffer()) {
+        return traits_type::eof();
+    }
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+    }
+    return traits_type::not_eof(ch);
+}
+
+std::streamsize WriterStreamBuf::xsputn(const char* s, std::streamsize count) {
+    // Small writes (record headers, tags) are coalesced; chunk payloads bypass the buffer
+    if (count <= epptr() - pptr()) {
+        std::memcpy(pptr(), s, static_cast<size_t>(count));
+        pbump(static_cast<int>(count));
+        return count;
+    }
+    if (!flush_buffer()) {
+        return 0;
+    }
+    try {
+        writer_.write(reinterpret_cast<const uint8_t*>(s), static_cast<size_t>(count));
+    } catch (const std::exception& e) {
+        spdlog::error("Write failed: {}", e.what());
+        return 0;
+    }
+    return count;
+}
+
+int WriterStreamBuf::sync() {
+    if (!flush_buffer()) {
+        return -1;
+    }
+    try {
+        writer_.flush();
+    } catch (const std::exception& e) {
+        spdlog::error("Flush failed: {}", e.what());
+        return -1;
+    }
+    return 0;
+}
+
+} // namespace core
+} // namespace filevault
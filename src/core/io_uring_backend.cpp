@@ -0,0 +1,550 @@
+/**
+ * @file io_uring_backend.cpp
+ * @brief Linux io_uring implementation of the sequential I/O backend
+ *
+ * Only compiled when liburing is found (FILEVAULT_HAVE_IO_URING). Each
+ * reader/writer owns a ring and queue_depth block-sized buffers that are
+ * registered with the kernel when RLIMIT_MEMLOCK allows, so the kernel can
+ * skip per-request page pinning. With IOOptions::direct the file is opened
+ * with O_DIRECT and every request is a whole number of aligned blocks.
+ * Otherwise detail::CacheAdvisor applies the page-cache policy as blocks
+ * are consumed or written.
+ */
+
+#include "filevault/core/io_backend.hpp"
+#include <liburing.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace filevault {
+namespace core {
+
+namespace {
+
+constexpr size_t BUFFER_ALIGNMENT = IOBackend::DIRECT_IO_ALIGNMENT;
+
+size_t align_up(size_t value) {
+    return (value + BUFFER_ALIGNMENT - 1) / BUFFER_ALIGNMENT * BUFFER_ALIGNMENT;
+}
+
+std::string errno_string(int err) {
+    return std::strerror(err < 0 ? -err : err);
+}
+
+/**
+ * @brief One block buffer and the request currently using it
+ */
+struct UringSlot {
+    uint8_t* buffer = nullptr;
+    int index = 0;
+    uint64_t offset = 0;      // File offset of the request
+    size_t length = 0;        // Bytes requested
+    size_t filled = 0;        // Bytes transferred (reads) or staged (writes)
+    size_t consumed = 0;      // Bytes handed to the caller (reads only)
+    bool ready = false;       // Read completed and filled is valid
+    bool in_flight = false;
+    int result = 0;
+};
+
+/**
+ * @brief Ring, file descriptor and slot buffers shared by reader and writer
+ */
+class UringFile {
+public:
+    ~UringFile() {
+        if (ring_ready_) {
+            if (registered_) {
+                io_uring_unregister_buffers(&ring_);
+            }
+            io_uring_queue_exit(&ring_);
+        }
+        for (auto& slot : slots_) {
+            std::free(slot.buffer);
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+
+    bool init(int fd, const IOOptions& options, std::string& error) {
+        fd_ = fd;
+        direct_ = options.direct;
+        // O_DIRECT transfers bypass the page cache; there is nothing to advise
+        advisor_ = detail::CacheAdvisor(fd, direct_ ? CachePolicy::KEEP : options.cache);
+        block_size_ = align_up((std::max)(options.block_size, BUFFER_ALIGNMENT));
+        const unsigned depth = static_cast<unsigned>((std::max)(options.queue_depth, size_t(2)));
+
+        int rc = io_uring_queue_init(depth, &ring_, 0);
+        if (rc < 0) {
+            error = "io_uring_queue_init: " + errno_string(rc);
+            return false;
+        }
+        ring_ready_ = true;
+
+        slots_.resize(depth);
+        std::vector<struct iovec> iovecs(depth);
+        for (unsigned i = 0; i < depth; ++i) {
+            void* buffer = nullptr;
+            if (posix_memalign(&buffer, BUFFER_ALIGNMENT, block_size_) != 0) {
+                error = "Out of memory for I/O buffers";
+                return false;
+            }
+            slots_[i].buffer = static_cast<uint8_t*>(buffer);
+            slots_[i].index = static_cast<int>(i);
+            iovecs[i].iov_base = buffer;
+            iovecs[i].iov_len = block_size_;
+        }
+
+        // Registration fails under a low RLIMIT_MEMLOCK; plain reads/writes still work
+        rc = io_uring_register_buffers(&ring_, iovecs.data(), depth);
+        registered_ = (rc == 0);
+        if (!registered_) {
+            spdlog::debug("io_uring buffer registration failed ({}), using unregistered buffers",
+                          errno_string(rc));
+        }
+        return true;
+    }
+
+    void submit_read(UringSlot& slot, uint64_t offset, size_t length) {
+        struct io_uring_sqe* sqe = get_sqe();
+        // O_DIRECT needs an aligned length; the kernel stops at end of file
+        unsigned request = static_cast<unsigned>(direct_ ? align_up(length) : length);
+        if (registered_) {
+            io_uring_prep_read_fixed(sqe, fd_, slot.buffer, request, offset, slot.index);
+        } else {
+            io_uring_prep_read(sqe, fd_, slot.buffer, request, offset);
+        }
+        start(sqe, slot, offset, length);
+    }
+
+    void submit_write(UringSlot& slot) {
+        struct io_uring_sqe* sqe = get_sqe();
+        if (registered_) {
+            io_uring_prep_write_fixed(sqe, fd_, slot.buffer, static_cast<unsigned>(slot.filled),
+                                      slot.offset, slot.index);
+        } else {
+            io_uring_prep_write(sqe, fd_, slot.buffer, static_cast<unsigned>(slot.filled), slot.offset);
+        }
+        start(sqe, slot, slot.offset, slot.filled);
+    }
+
+    /**
+     * @brief Reap one completion and mark its slot as finished
+     */
+    void wait_one() {
+        struct io_uring_cqe* cqe = nullptr;
+        int rc;
+        do {
+            rc = io_uring_wait_cqe(&ring_, &cqe);
+        } while (rc == -EINTR);
+        if (rc < 0) {
+            throw std::runtime_error("io_uring_wait_cqe: " + errno_string(rc));
+        }
+        auto* slot = static_cast<UringSlot*>(io_uring_cqe_get_data(cqe));
+        slot->result = cqe->res;
+        slot->in_flight = false;
+        --in_flight_;
+        io_uring_cqe_seen(&ring_, cqe);
+    }
+
+    void wait_for(const UringSlot& slot) {
+        while (slot.in_flight) {
+            wait_one();
+        }
+    }
+
+    void drain() {
+        while (in_flight_ > 0) {
+            wait_one();
+        }
+    }
+
+    int fd() const { return fd_; }
+    bool direct() const { return direct_; }
+    detail::CacheAdvisor& advisor() { return advisor_; }
+    size_t block_size() const { return block_size_; }
+    std::vector<UringSlot>& slots() { return slots_; }
+
+private:
+    struct io_uring_sqe* get_sqe() {
+        struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+        if (!sqe) {
+            throw std::runtime_error("io_uring submission queue full");
+        }
+        return sqe;
+    }
+
+    void start(struct io_uring_sqe* sqe, UringSlot& slot, uint64_t offset, size_t length) {
+        slot.offset = offset;
+        slot.length = length;
+        slot.in_flight = true;
+        slot.result = 0;
+        io_uring_sqe_set_data(sqe, &slot);
+        int rc = io_uring_submit(&ring_);
+        if (rc < 0) {
+            slot.in_flight = false;
+            throw std::runtime_error("io_uring_submit: " + errno_string(rc));
+        }
+        ++in_flight_;
+    }
+
+    struct io_uring ring_ {};
+    bool ring_ready_ = false;
+    bool registered_ = false;
+    bool direct_ = false;
+    int fd_ = -1;
+    detail::CacheAdvisor advisor_;
+    size_t block_size_ = 0;
+    size_t in_flight_ = 0;
+    std::vector<UringSlot> slots_;
+};
+
+/**
+ * @brief Keeps up to queue_depth block reads ahead of the consumer
+ */
+class UringReader : public ISequentialReader {
+public:
+    bool open(const std::string& path, const IOOptions& options, std::string& error) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC | (options.direct ? O_DIRECT : 0));
+        if (fd < 0) {
+            error = "open: " + errno_string(errno);
+            return false;
+        }
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) {
+            error = "fstat: " + errno_string(errno);
+            ::close(fd);
+            return false;
+        }
+        size_ = static_cast<uint64_t>(st.st_size);
+        if (!file_.init(fd, options, error)) {
+            return false;
+        }
+        if (!options.direct) {
+            file_.advisor().advise_sequential(size_);
+        }
+        // O_DIRECT reads start at the aligned block and skip up to the offset
+        next_offset_ = options.direct ? options.read_offset / BUFFER_ALIGNMENT * BUFFER_ALIGNMENT
+                                      : options.read_offset;
+        const size_t skip = static_cast<size_t>(options.read_offset - next_offset_);
+        for (auto& slot : file_.slots()) {
+            if (!queue_next(slot)) {
+                break;
+            }
+        }
+        if (!order_.empty()) {
+            order_.front()->consumed = skip;
+        }
+        return true;
+    }
+
+    size_t read(uint8_t* dst, size_t length) override {
+        size_t copied = 0;
+        while (copied < length && !order_.empty()) {
+            UringSlot& slot = *order_.front();
+            if (!slot.ready) {
+                complete(slot);
+            }
+
+            size_t n = (std::min)(length - copied, slot.filled - slot.consumed);
+            std::memcpy(dst + copied, slot.buffer + slot.consumed, n);
+            slot.consumed += n;
+            copied += n;
+
+            if (slot.consumed == slot.filled) {
+                order_.pop_front();
+                file_.advisor().consumed(slot.offset + slot.filled);
+                if (slot.filled < slot.length) {
+                    // File shrank since open: stop at the new end
+                    eof_ = true;
+                    abandon_queued();
+                } else {
+                    queue_next(slot);
+                }
+            }
+        }
+        return copied;
+    }
+
+    uint64_t size() const override { return size_; }
+
+    ~UringReader() override {
+        try {
+            file_.drain();
+        } catch (const std::exception&) {
+        }
+        file_.advisor().release(false);
+    }
+
+private:
+    bool queue_next(UringSlot& slot) {
+        if (eof_ || next_offset_ >= size_) {
+            return false;
+        }
+        size_t length = static_cast<size_t>((std::min)(uint64_t(file_.block_size()), size_ - next_offset_));
+        slot.filled = 0;
+        slot.consumed = 0;
+        slot.ready = false;
+        file_.submit_read(slot, next_offset_, length);
+        next_offset_ += length;
+        order_.push_back(&slot);
+        return true;
+    }
+
+    void complete(UringSlot& slot) {
+        file_.wait_for(slot);
+        if (slot.result < 0) {
+            throw std::runtime_error("Read error: " + errno_string(slot.result));
+        }
+        slot.filled = (std::min)(static_cast<size_t>(slot.result), slot.length);
+
+        // Short read: finish synchronously until the block is full or the file ends.
+        // O_DIRECT cannot resume at an unaligned offset; the reader then stops early.
+        while (slot.filled < slot.length && !file_.direct()) {
+            ssize_t n = ::pread(file_.fd(), slot.buffer + slot.filled, slot.length - slot.filled,
+                                static_cast<off_t>(slot.offset + slot.filled));
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                throw std::runtime_error("Read error: " + errno_string(errno));
+            }
+            if (n == 0) break;
+            slot.filled += static_cast<size_t>(n);
+        }
+        slot.consumed = (std::min)(slot.consumed, slot.filled);
+        slot.ready = true;
+    }
+
+    void abandon_queued() {
+        file_.drain();
+        order_.clear();
+    }
+
+    UringFile file_;
+    std::deque<UringSlot*> order_;   // Slots in file order, oldest first
+    uint64_t size_ = 0;
+    uint64_t next_offset_ = 0;
+    bool eof_ = false;
+};
+
+/**
+ * @brief Stages writes in block buffers and keeps full blocks in flight
+ */
+class UringWriter : public ISequentialWriter {
+public:
+    bool open(const std::string& path, const IOOptions& options, std::string& error) {
+        const int direct = options.direct ? O_DIRECT : 0;
+        int fd = options.write_offset
+            ? ::open(path.c_str(), O_RDWR | O_CLOEXEC | direct)
+            : ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC | direct, 0644);
+        if (fd < 0) {
+            error = "open: " + errno_string(errno);
+            return false;
+        }
+        if (!file_.init(fd, options, error)) {
+            return false;
+        }
+        return !options.write_offset || start_at(*options.write_offset, error);
+    }
+
+    void write(const uint8_t* src, size_t length) override {
+        while (length > 0) {
+            UringSlot& slot = current();
+            size_t n = (std::min)(length, file_.block_size() - slot.filled);
+            std::memcpy(slot.buffer + slot.filled, src, n);
+            slot.filled += n;
+            src += n;
+            length -= n;
+            if (slot.filled == file_.block_size()) {
+                submit_current();
+            }
+        }
+    }
+
+    void flush() override {
+        UringSlot& slot = file_.slots()[current_];
+        if (file_.direct()) {
+            for (auto& s : file_.slots()) {
+                finish(s);
+            }
+            flush_direct_tail(slot);
+            return;
+        }
+        if (!slot.in_flight && slot.filled > 0) {
+            submit_current();
+        }
+        for (auto& s : file_.slots()) {
+            finish(s);
+        }
+        file_.advisor().release(true);
+    }
+
+    void sync() override {
+        flush();
+        if (::fdatasync(file_.fd()) != 0) {
+            throw std::runtime_error("Sync error: " + errno_string(errno));
+        }
+    }
+
+    ~UringWriter() override {
+        try {
+            flush();
+        } catch (const std::exception& e) {
+            spdlog::error("io_uring write failed on close: {}", e.what());
+        }
+    }
+
+private:
+    /**
+     * @brief Keep the first @p offset bytes and continue writing after them
+     *
+     * With O_DIRECT the partial block at the offset is read back into the
+     * first slot, so every request stays aligned.
+     */
+    bool start_at(uint64_t offset, std::string& error) {
+        if (::ftruncate(file_.fd(), static_cast<off_t>(offset)) != 0) {
+            error = "ftruncate: " + errno_string(errno);
+            return false;
+        }
+        next_offset_ = offset;
+        if (!file_.direct()) {
+            return true;
+        }
+        next_offset_ = offset / BUFFER_ALIGNMENT * BUFFER_ALIGNMENT;
+        UringSlot& slot = file_.slots()[current_];
+        slot.filled = static_cast<size_t>(offset - next_offset_);
+        if (slot.filled == 0) {
+            return true;
+        }
+        ssize_t n;
+        do {
+            n = ::pread(file_.fd(), slot.buffer, BUFFER_ALIGNMENT, static_cast<off_t>(next_offset_));
+        } while (n < 0 && errno == EINTR);
+        if (n < static_cast<ssize_t>(slot.filled)) {
+            error = "pread: " + errno_string(n < 0 ? errno : EIO);
+            return false;
+        }
+        return true;
+    }
+
+    UringSlot& current() {
+        UringSlot& slot = file_.slots()[current_];
+        // Slots are reused round-robin, so this is the oldest write: everything before it is done
+        if (slot.in_flight) {
+            finish(slot);
+            file_.advisor().written(slot.offset + slot.length);
+        }
+        return slot;
+    }
+
+    void submit_current() {
+        UringSlot& slot = file_.slots()[current_];
+        slot.offset = next_offset_;
+        next_offset_ += slot.filled;
+        file_.submit_write(slot);
+        current_ = (current_ + 1) % file_.slots().size();
+    }
+
+    /**
+     * @brief Write a partial block zero-padded and truncate to the real length
+     *
+     * The block stays staged so later writes keep every request aligned.
+     */
+    void flush_direct_tail(UringSlot& slot) {
+        if (slot.filled == 0 || slot.filled == file_.block_size()) {
+            return;
+        }
+        size_t padded = align_up(slot.filled);
+        std::memset(slot.buffer + slot.filled, 0, padded - slot.filled);
+        size_t written = 0;
+        while (written < padded) {
+            ssize_t n = ::pwrite(file_.fd(), slot.buffer + written, padded - written,
+                                 static_cast<off_t>(next_offset_ + written));
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                throw std::runtime_error("Write error: " + errno_string(errno));
+            }
+            written += static_cast<size_t>(n);
+        }
+        if (::ftruncate(file_.fd(), static_cast<off_t>(next_offset_ + slot.filled)) != 0) {
+            throw std::runtime_error("Truncate error: " + errno_string(errno));
+        }
+    }
+
+    /**
+     * @brief Wait for a slot's write and make it reusable
+     */
+    void finish(UringSlot& slot) {
+        if (!slot.in_flight) {
+            return;
+        }
+        file_.wait_for(slot);
+        if (slot.result < 0) {
+            throw std::runtime_error("Write error: " + errno_string(slot.result));
+        }
+
+        // Short write: push the remainder synchronously
+        size_t written = static_cast<size_t>(slot.result);
+        while (written < slot.length) {
+            ssize_t n = ::pwrite(file_.fd(), slot.buffer + written, slot.length - written,
+                                 static_cast<off_t>(slot.offset + written));
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                throw std::runtime_error("Write error: " + errno_string(errno));
+            }
+            written += static_cast<size_t>(n);
+        }
+        slot.filled = 0;
+    }
+
+    UringFile file_;
+    size_t current_ = 0;
+    uint64_t next_offset_ = 0;
+};
+
+} // anonymous namespace
+
+namespace detail {
+
+std::unique_ptr<ISequentialReader> make_uring_reader(const std::string& path, const IOOptions& options,
+                                                     std::string& error) {
+    auto reader = std::make_unique<UringReader>();
+    if (!reader->open(path, options, error)) {
+        return nullptr;
+    }
+    return reader;
+}
+
+std::unique_ptr<ISequentialWriter> make_uring_writer(const std::string& path, const IOOptions& options,
+                                                     std::string& error) {
+    auto writer = std::make_unique<UringWriter>();
+    if (!writer->open(path, options, error)) {
+        return nullptr;
+    }
+    return writer;
+}
+
+bool uring_supported() {
+    // Containers and hardened kernels often disable io_uring (ENOSYS/EPERM)
+    static const bool supported = [] {
+        struct io_uring ring {};
+        if (io_uring_queue_init(2, &ring, 0) < 0) {
+            return false;
+        }
+        io_uring_queue_exit(&ring);
+        return true;
+    }();
+    return supported;
+}
+
+} // namespace detail
+
+} // namespace core
+} // namespace filevault
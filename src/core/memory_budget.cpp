@@ -0,0 +1,132 @@
+/**
+ * @file memory_budget.cpp
+ * @brief Process-wide memory reservations for KDFs, codecs and chunk buffers
+ */
+
+#include "filevault/core/memory_budget.hpp"
+#include "filevault/core/system_resources.hpp"
+#include <algorithm>
+
+namespace filevault {
+namespace core {
+
+// ============================================================================
+// MemoryBudget::Reservation
+// ============================================================================
+
+MemoryBudget::Reservation::Reservation(Reservation&& other) noexcept
+    : budget_(other.budget_), bytes_(other.bytes_) {
+    other.budget_ = nullptr;
+    other.bytes_ = 0;
+}
+
+MemoryBudget::Reservation& MemoryBudget::Reservation::operator=(Reservation&& other) noexcept {
+    if (this != &other) {
+        release();
+        budget_ = other.budget_;
+        bytes_ = other.bytes_;
+        other.budget_ = nullptr;
+        other.bytes_ = 0;
+    }
+    return *this;
+}
+
+void MemoryBudget::Reservation::release() {
+    if (budget_ && bytes_ > 0) {
+        budget_->release(bytes_);
+    }
+    budget_ = nullptr;
+    bytes_ = 0;
+}
+
+// ============================================================================
+// MemoryBudget
+// ============================================================================
+
+MemoryBudget::MemoryBudget(uint64_t limit)
+    : limit_(limit > 0 ? limit : default_limit()) {
+}
+
+MemoryBudget& MemoryBudget::global() {
+    static MemoryBudget budget;
+    return budget;
+}
+
+uint64_t MemoryBudget::default_limit() {
+    const auto& resources = SystemResources::current();
+    uint64_t memory = resources.memory_limit.value_or(resources.total_memory);
+    if (memory == 0) {
+        memory = uint64_t(1) << 30;     // Unknown platform: assume 1 GiB
+    }
+    return memory / 4 * 3;
+}
+
+void MemoryBudget::set_limit(uint64_t limit) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        limit_ = limit > 0 ? limit : default_limit();
+    }
+    cv_.notify_all();
+}
+
+uint64_t MemoryBudget::limit() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return limit_;
+}
+
+uint64_t MemoryBudget::reserved() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return reserved_;
+}
+
+bool MemoryBudget::fits(uint64_t bytes) const {
+    // Oversized requests run alone instead of never
+    return reserved_ == 0 || (reserved_ <= limit_ && bytes <= limit_ - reserved_);
+}
+
+MemoryBudget::Reservation MemoryBudget::reserve(uint64_t bytes) {
+    if (bytes == 0) {
+        return Reservation();
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [&] { return fits(bytes); });
+    reserved_ += bytes;
+    return Reservation(this, bytes);
+}
+
+std::optional<MemoryBudget::Reservation> MemoryBudget::try_reserve(uint64_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (bytes > 0 && !fits(bytes)) {
+        return std::nullopt;
+    }
+    reserved_ += bytes;
+    return Reservation(this, bytes);
+}
+
+MemoryBudget::Reservation MemoryBudget::reserve_units(uint64_t unit, size_t min_units, size_t max_units) {
+    max_units = (std::max)(max_units, min_units);
+    if (unit == 0 || max_units == 0) {
+        return Reservation();
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [&] { return fits(unit * min_units); });
+
+    uint64_t free = reserved_ < limit_ ? limit_ - reserved_ : 0;
+    size_t units = static_cast<size_t>((std::min)(uint64_t(max_units), free / unit));
+    units = (std::max)(units, min_units);
+
+    reserved_ += unit * units;
+    return Reservation(this, unit * units);
+}
+
+void MemoryBudget::release(uint64_t bytes) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        reserved_ -= (std::min)(bytes, reserved_);
+    }
+    cv_.notify_all();
+}
+
+} // namespace core
+} // namespace filevault
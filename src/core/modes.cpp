@@ -1,4 +1,5 @@
 #include "filevault/core/modes.hpp"
+#include "filevault/core/cpu_features.hpp"
 #include <algorithm>
 #include <cctype>
 
@@ -83,12 +84,22 @@ void ModePreset::apply_to(EncryptionConfig& config) const {
     config.kdf_parallelism = kdf_parallelism;
 }
 
-ModePreset ModePreset::get_preset(UserMode mode) {
+namespace {
+
+// The preset tables name AES-256-GCM; swap in the AEAD that is fast on this CPU
+ModePreset for_this_machine(ModePreset preset, const std::vector<AeadThroughput>& measured) {
+    preset.algorithm = AutoAlgorithm::choose(CpuFeatures::current(), measured);
+    return preset;
+}
+
+} // anonymous namespace
+
+ModePreset ModePreset::get_preset(UserMode mode, const std::vector<AeadThroughput>& measured) {
     switch (mode) {
-        case UserMode::STUDENT: return presets::BASIC;
-        case UserMode::PROFESSIONAL: return presets::STANDARD;
-        case UserMode::ADVANCED: return presets::ADVANCED;
-        default: return presets::STANDARD;
+        case UserMode::STUDENT: return for_this_machine(presets::BASIC, measured);
+        case UserMode::PROFESSIONAL: return for_this_machine(presets::STANDARD, measured);
+        case UserMode::ADVANCED: return for_this_machine(presets::ADVANCED, measured);
+        default: return for_this_machine(presets::STANDARD, measured);
     }
 }
 
@@ -109,11 +120,11 @@ UserMode ModePreset::parse_mode(const std::string& name) {
     return UserMode::PROFESSIONAL;  // Default
 }
 
-std::vector<ModePreset> ModePreset::get_all_presets() {
+std::vector<ModePreset> ModePreset::get_all_presets(const std::vector<AeadThroughput>& measured) {
     return {
-        presets::BASIC,
-        presets::STANDARD,
-        presets::ADVANCED
+        for_this_machine(presets::BASIC, measured),
+        for_this_machine(presets::STANDARD, measured),
+        for_this_machine(presets::ADVANCED, measured)
     };
 }
 
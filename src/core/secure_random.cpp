@@ -0,0 +1,39 @@
+/**
+ * @file secure_random.cpp
+ * @brief Thread-local HMAC_DRBG seeded from the system RNG
+ */
+
+#include "filevault/core/secure_random.hpp"
+#include <botan/hmac_drbg.h>
+#include <botan/mac.h>
+#include <botan/system_rng.h>
+#include <memory>
+
+namespace filevault {
+namespace core {
+
+Botan::RandomNumberGenerator& SecureRandom::thread_rng() {
+    // Seeding is deferred to the first request, which also covers fork
+    // detection: a child's first call sees a new pid and reseeds
+    thread_local std::unique_ptr<Botan::HMAC_DRBG> rng = std::make_unique<Botan::HMAC_DRBG>(
+        Botan::MessageAuthenticationCode::create_or_throw("HMAC(SHA-512)"),
+        Botan::system_rng(),
+        RESEED_INTERVAL);
+    return *rng;
+}
+
+void SecureRandom::randomize(std::span<uint8_t> out) {
+    if (out.empty()) {
+        return;
+    }
+    thread_rng().randomize(out.data(), out.size());
+}
+
+std::vector<uint8_t> SecureRandom::bytes(size_t length) {
+    std::vector<uint8_t> out(length);
+    randomize(out);
+    return out;
+}
+
+} // namespace core
+} // namespace filevault
@@ -4,64 +4,161 @@
  */
 
 #include "filevault/core/streaming.hpp"
+#include "filevault/core/algorithm_registry.hpp"
 #include "filevault/core/crypto_engine.hpp"
+#include "filevault/core/chunk_pool.hpp"
+#include "filevault/core/content_chunker.hpp"
+#include "filevault/core/memory_budget.hpp"
+#include "filevault/core/streaming_reader.hpp"
+#include "filevault/core/system_resources.hpp"
 #include "filevault/compression/compressor.hpp"
-#include <botan/auto_rng.h>
+#include <botan/mac.h>
+#include <botan/mem_ops.h>
 #include <spdlog/spdlog.h>
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstring>
-
-#ifdef _WIN32
-#include <windows.h>
-#elif defined(__APPLE__)
-#include <unistd.h>
-#include <sys/types.h>
-#include <sys/sysctl.h>
-#include <mach/mach.h>
-#else
-// Linux
-#include <unistd.h>
-#include <sys/sysinfo.h>
-#endif
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
 
 namespace filevault {
 namespace core {
 
 // Magic bytes for streaming format: "FVST" (FileVault STreaming)
 static constexpr uint8_t STREAM_MAGIC[4] = {'F', 'V', 'S', 'T'};
-static constexpr uint8_t STREAM_VERSION = 1;
+// Version 3 binds records and segment markers to the stream (RecordBinding)
+static constexpr uint8_t STREAM_VERSION = 3;
+
+// Chunk index footer trailer: [8 bytes index offset][4 bytes count]["FVIX"]
+static constexpr uint8_t INDEX_MAGIC[4] = {'F', 'V', 'I', 'X'};
+static constexpr size_t INDEX_TRAILER_SIZE = 16;
+static constexpr size_t INDEX_ENTRY_SIZE = 12;
+
+// Checkpoint journal: ["FVCK"][version][next chunk][record offset][input offset][nonce len][base nonce]
+// [16 bytes: kept digest] (version 2)
+static constexpr uint8_t CHECKPOINT_MAGIC[4] = {'F', 'V', 'C', 'K'};
+static constexpr uint8_t CHECKPOINT_VERSION = 2;
+
+// Append undo journal: ["FVUN"][version][stream size][tail offset][header prefix][tail bytes]
+static constexpr uint8_t UNDO_MAGIC[4] = {'F', 'V', 'U', 'N'};
+static constexpr uint8_t UNDO_VERSION = 1;
+// Header bytes an append rewrites: magic through chunk count (flags, total size, count)
+static constexpr size_t HEADER_PREFIX_SIZE = 30;
+static constexpr std::streamoff HEADER_FLAGS_OFFSET = 5;
+static constexpr std::streamoff HEADER_TOTAL_OFFSET = 18;
+
+namespace {
+
+/**
+ * @brief The in-memory bytes of @p value (file fields are stored as they are in memory)
+ */
+std::span<const uint8_t> bytes_of(const uint64_t& value) {
+    return {reinterpret_cast<const uint8_t*>(&value), sizeof(value)};
+}
+
+/**
+ * @brief Replace @p path with @p bytes so that readers see either the old or the new file
+ * (temporary file, fdatasync, rename)
+ */
+void replace_file_durably(const std::string& path, const std::string& bytes) {
+    std::string temp_path = path + ".tmp";
+    {
+        auto writer = IOBackend::open_writer(temp_path);
+        if (!writer) {
+            throw std::runtime_error(writer.error_message);
+        }
+        writer.value->write(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+        writer.value->sync();
+    }
+    std::filesystem::rename(temp_path, path);
+}
+
+/**
+ * @brief Stream buffer that serves @p prefix before the contents of another buffer
+ */
+class PrefixStreamBuf : public std::streambuf {
+public:
+    PrefixStreamBuf(std::vector<uint8_t> prefix, std::streambuf* rest)
+        : prefix_(std::move(prefix)), rest_(rest) {
+        char* begin = reinterpret_cast<char*>(prefix_.data());
+        setg(begin, begin, begin + prefix_.size());
+    }
+
+protected:
+    int_type underflow() override {
+        return gptr() < egptr() ? traits_type::to_int_type(*gptr()) : rest_->sgetc();
+    }
+
+    int_type uflow() override {
+        if (gptr() == egptr()) {
+            return rest_->sbumpc();
+        }
+        int_type c = traits_type::to_int_type(*gptr());
+        gbump(1);
+        return c;
+    }
+
+    std::streamsize xsgetn(char* s, std::streamsize count) override {
+        std::streamsize from_prefix = (std::min)(count, static_cast<std::streamsize>(egptr() - gptr()));
+        std::memcpy(s, gptr(), static_cast<size_t>(from_prefix));
+        gbump(static_cast<int>(from_prefix));
+        if (from_prefix == count) {
+            return count;
+        }
+        return from_prefix + rest_->sgetn(s + from_prefix, count - from_prefix);
+    }
+
+private:
+    std::vector<uint8_t> prefix_;
+    std::streambuf* rest_;
+};
+
+/**
+ * Reserve the pipeline's chunk buffers and codec state from the process-wide
+ * budget. When it is tight fewer chunks are kept in flight (at least two) and
+ * no more workers are started than there are chunks to work on.
+ */
+MemoryBudget::Reservation reserve_pipeline(
+    size_t chunk_size,
+    CompressionType compression,
+    int level,
+    bool decompress,
+    size_t& slots,
+    size_t& threads
+) {
+    uint64_t unit = chunk_size;
+    if (compression != CompressionType::NONE) {
+        unit += compression::CompressionService::memory_usage(compression, level, decompress);
+    }
+    
+    auto reservation = MemoryBudget::global().reserve_units(unit, 2, slots);
+    size_t granted = static_cast<size_t>(reservation.bytes() / unit);
+    if (granted < slots) {
+        spdlog::info("Memory budget allows {} of {} chunks in flight", granted, slots);
+        slots = granted;
+        threads = (std::min)(threads, slots);
+    }
+    return reservation;
+}
+
+} // anonymous namespace
 
 size_t StreamingCrypto::get_recommended_chunk_size() {
-    size_t available_memory = 0;
-    
-#ifdef _WIN32
-    MEMORYSTATUSEX status;
-    status.dwLength = sizeof(status);
-    if (GlobalMemoryStatusEx(&status)) {
-        available_memory = static_cast<size_t>(status.ullAvailPhys);
-    }
-#elif defined(__APPLE__)
-    // macOS: Use mach API to get free memory
-    mach_port_t host_port = mach_host_self();
-    vm_size_t page_size;
-    vm_statistics64_data_t vm_stats;
-    mach_msg_type_number_t count = sizeof(vm_stats) / sizeof(natural_t);
-    
-    if (host_page_size(host_port, &page_size) == KERN_SUCCESS &&
-        host_statistics64(host_port, HOST_VM_INFO64, (host_info64_t)&vm_stats, &count) == KERN_SUCCESS) {
-        available_memory = static_cast<size_t>(vm_stats.free_count) * page_size;
-    }
-#else
-    // Linux
-    struct sysinfo info;
-    if (sysinfo(&info) == 0) {
-        available_memory = info.freeram * info.mem_unit;
-    }
-#endif
-    
-    // Use 1/4 of available memory, capped between 16MB and 256MB
-    size_t chunk_size = available_memory / 4;
-    chunk_size = (std::max)(chunk_size, size_t(16 * 1024 * 1024));   // Min 16MB
+    const auto& resources = SystemResources::current();
+    
+    // A full pipeline (one chunk per worker, plus one being read and one being
+    // written) should fit in a quarter of the memory this process may use, and
+    // in the default in-flight budget
+    size_t slots = resources.cpu_count + 2;
+    uint64_t budget = (std::min)(resources.available_memory / 4,
+                                 uint64_t(StreamingConfig{}.max_in_flight_bytes));
+    size_t chunk_size = static_cast<size_t>(budget / slots);
+    chunk_size = (std::max)(chunk_size, size_t(1024 * 1024));         // Min 1MB
     chunk_size = (std::min)(chunk_size, size_t(256 * 1024 * 1024)); // Max 256MB
     
     // Round down to nearest MB
@@ -70,6 +167,28 @@ size_t StreamingCrypto::get_recommended_chunk_size() {
     return chunk_size;
 }
 
+size_t StreamingCrypto::resolve_thread_count(size_t requested) {
+    if (requested != 0) {
+        return requested;
+    }
+    // CPUs in the affinity mask, capped by the cgroup CPU quota
+    return SystemResources::current().cpu_count;
+}
+
+bool StreamingCrypto::is_streaming_file(const std::string& file_path) {
+    std::ifstream file(file_path, std::ios::binary);
+    uint8_t magic[4];
+    if (!file.read(reinterpret_cast<char*>(magic), 4)) {
+        return false;
+    }
+    return std::memcmp(magic, STREAM_MAGIC, 4) == 0;
+}
+
+bool StreamingCrypto::supports_algorithm(AlgorithmType algorithm) {
+    auto* info = find_algorithm(algorithm);
+    return info && info->aead;
+}
+
 bool StreamingCrypto::should_use_streaming(const std::string& file_path, size_t threshold) {
     std::ifstream file(file_path, std::ios::binary | std::ios::ate);
     if (!file) return false;
@@ -80,7 +199,9 @@ bool StreamingCrypto::should_use_streaming(const std::string& file_path, size_t
 
 std::vector<uint8_t> StreamingCrypto::derive_chunk_nonce(
     const std::vector<uint8_t>& base_nonce,
-    size_t chunk_index
+    size_t chunk_index,
+    bool last_chunk,
+    bool compressed
 ) {
     // XOR chunk index into last 4 bytes of nonce
     std::vector<uint8_t> chunk_nonce = base_nonce;
@@ -95,16 +216,182 @@ std::vector<uint8_t> StreamingCrypto::derive_chunk_nonce(
         chunk_nonce[8 + i] ^= static_cast<uint8_t>((chunk_index >> (i * 8)) & 0xFF);
     }
     
+    // Final chunk gets a distinct nonce so truncating the stream (or moving
+    // the end-of-stream marker) fails authentication
+    if (last_chunk) {
+        chunk_nonce[7] ^= 0x80;
+    }
+    
+    // Likewise for the per-chunk compression bit, which is outside the ciphertext
+    if (compressed) {
+        chunk_nonce[7] ^= 0x40;
+    }
+    
     return chunk_nonce;
 }
 
+std::vector<uint8_t> StreamingCrypto::derive_subkey(const std::vector<uint8_t>& key, const std::string& label) {
+    auto mac = Botan::MessageAuthenticationCode::create_or_throw("HMAC(SHA-256)");
+    mac->set_key(key);
+    mac->update(reinterpret_cast<const uint8_t*>(label.data()), label.size());
+    auto subkey = mac->final();
+    return std::vector<uint8_t>(subkey.begin(), subkey.end());
+}
+
+std::array<uint8_t, 16> StreamingCrypto::chunk_digest(
+    const std::vector<uint8_t>& digest_key,
+    uint64_t index,
+    const std::vector<uint8_t>& plaintext
+) {
+    auto mac = Botan::MessageAuthenticationCode::create_or_throw("HMAC(SHA-256)");
+    mac->set_key(digest_key);
+    mac->update(reinterpret_cast<const uint8_t*>(&index), 8);
+    mac->update(plaintext.data(), plaintext.size());
+    auto full = mac->final();
+    
+    std::array<uint8_t, 16> digest{};
+    std::memcpy(digest.data(), full.data(), digest.size());
+    return digest;
+}
+
+StreamingCrypto::RecordBinding::RecordBinding(
+    uint8_t version,
+    const std::vector<uint8_t>& key,
+    const StreamingConfig& config,
+    uint8_t flags,
+    const std::vector<uint8_t>& salt,
+    const std::vector<uint8_t>& base_nonce
+) : version_(version) {
+    first_.base_nonce = base_nonce;
+    if (version_ < 3) {
+        return;
+    }
+    tag_key_ = derive_subkey(key, "FVST segment tag v1");
+    nonce_key_ = derive_subkey(key, "FVST segment nonce v1");
+    
+    // Appends set FLAG_SEGMENTS and updates clear FLAG_SIZE_UNKNOWN; every other
+    // header field decides how records are read, so records are bound to it
+    const uint8_t fields[8] = {
+        version,
+        static_cast<uint8_t>(flags & ~(FLAG_SEGMENTS | FLAG_SIZE_UNKNOWN)),
+        static_cast<uint8_t>(config.algorithm),
+        static_cast<uint8_t>(config.kdf),
+        static_cast<uint8_t>(config.compression),
+        static_cast<uint8_t>(config.level),
+        static_cast<uint8_t>(salt.size()),
+        static_cast<uint8_t>(base_nonce.size()),
+    };
+    const uint64_t chunk_size = config.chunk_size;
+    header_ = mac(tag_key_, 'H', {fields, bytes_of(chunk_size), salt, base_nonce});
+}
+
+std::vector<uint8_t> StreamingCrypto::RecordBinding::mac(
+    const std::vector<uint8_t>& key,
+    char domain,
+    std::initializer_list<std::span<const uint8_t>> parts
+) {
+    auto hmac = Botan::MessageAuthenticationCode::create_or_throw("HMAC(SHA-256)");
+    hmac->set_key(key);
+    hmac->update(static_cast<uint8_t>(domain));
+    for (const auto& part : parts) {
+        hmac->update(part.data(), part.size());
+    }
+    auto full = hmac->final();
+    return std::vector<uint8_t>(full.begin(), full.end());
+}
+
+void StreamingCrypto::RecordBinding::seal(StreamSegment& segment, const StreamSegment& previous) const {
+    if (version_ < 3) {
+        return;
+    }
+    auto full = mac(tag_key_, 'S', {header_, previous.tag, bytes_of(segment.first_chunk),
+                                    bytes_of(segment.first_index), segment.base_nonce});
+    std::memcpy(segment.tag.data(), full.data(), segment.tag.size());
+}
+
+bool StreamingCrypto::RecordBinding::check(const StreamSegment& segment, const StreamSegment& previous) const {
+    if (version_ < 3) {
+        return true;
+    }
+    StreamSegment expected = segment;
+    seal(expected, previous);
+    return segment.base_nonce.size() == first_.base_nonce.size() &&
+           Botan::constant_time_compare(expected.tag.data(), segment.tag.data(), segment.tag.size());
+}
+
+bool StreamingCrypto::RecordBinding::check(const std::vector<StreamSegment>& segments, size_t chunk_count) const {
+    const StreamSegment* previous = &first_;
+    for (const auto& segment : segments) {
+        // Each segment starts after the previous one (a listed one may replace the first at chunk 0)
+        if (segment.first_chunk >= chunk_count ||
+            (previous != &first_ && segment.first_chunk <= previous->first_chunk) ||
+            !check(segment, *previous)) {
+            return false;
+        }
+        previous = &segment;
+    }
+    return true;
+}
+
+std::vector<uint8_t> StreamingCrypto::RecordBinding::final_id(const StreamSegment& last) const {
+    if (version_ < 3) {
+        return last.base_nonce;
+    }
+    auto id = mac(tag_key_, 'F', {header_, last.tag, last.base_nonce});
+    id.resize(last.base_nonce.size());
+    return id;
+}
+
+void StreamingCrypto::RecordBinding::apply(
+    EncryptionConfig& config,
+    const std::vector<uint8_t>& segment_id,
+    uint64_t nonce_index,
+    bool last,
+    bool compressed
+) const {
+    if (version_ < 3) {
+        config.nonce = derive_chunk_nonce(segment_id, static_cast<size_t>(nonce_index), last, compressed);
+        return;
+    }
+    // HMAC-SHA-256 covers every supported nonce length (at most 32 bytes)
+    auto base_nonce = mac(nonce_key_, 'N', {header_, segment_id});
+    base_nonce.resize(first_.base_nonce.size());
+    config.nonce = derive_chunk_nonce(base_nonce, static_cast<size_t>(nonce_index), last, compressed);
+    
+    std::vector<uint8_t> associated_data = header_;
+    associated_data.insert(associated_data.end(), segment_id.begin(), segment_id.end());
+    auto index_bytes = bytes_of(nonce_index);
+    associated_data.insert(associated_data.end(), index_bytes.begin(), index_bytes.end());
+    config.associated_data = std::move(associated_data);
+}
+
+void StreamingCrypto::RecordBinding::apply(
+    EncryptionConfig& config,
+    const std::vector<StreamSegment>& segments,
+    uint64_t index,
+    bool last,
+    bool compressed
+) const {
+    const StreamSegment& segment = segment_for(segments, first_, index);
+    apply(config, last ? final_id(segment) : segment.base_nonce,
+          segment.first_index + (index - segment.first_chunk), last, compressed);
+}
+
+size_t StreamingCrypto::record_padding(uint64_t offset, uint8_t flags) {
+    if ((flags & FLAG_ALIGNED) == 0) {
+        return 0;
+    }
+    return static_cast<size_t>((RECORD_ALIGNMENT - offset % RECORD_ALIGNMENT) % RECORD_ALIGNMENT);
+}
+
 bool StreamingCrypto::write_stream_header(
-    std::ofstream& file,
+    std::ostream& file,
     const StreamingConfig& config,
     const std::vector<uint8_t>& salt,
     const std::vector<uint8_t>& base_nonce,
     size_t total_size,
-    size_t chunk_count
+    size_t chunk_count,
+    uint8_t flags
 ) {
     // Write magic bytes
     file.write(reinterpret_cast<const char*>(STREAM_MAGIC), 4);
@@ -112,6 +399,9 @@ bool StreamingCrypto::write_stream_header(
     // Write version
     file.write(reinterpret_cast<const char*>(&STREAM_VERSION), 1);
     
+    // Write flags (1 byte)
+    file.write(reinterpret_cast<const char*>(&flags), 1);
+    
     // Write algorithm type (1 byte)
     uint8_t algo = static_cast<uint8_t>(config.algorithm);
     file.write(reinterpret_cast<const char*>(&algo), 1);
@@ -124,6 +414,10 @@ bool StreamingCrypto::write_stream_header(
     uint8_t comp = static_cast<uint8_t>(config.compression);
     file.write(reinterpret_cast<const char*>(&comp), 1);
     
+    // Write security level (1 byte) - selects the KDF parameters
+    uint8_t level = static_cast<uint8_t>(config.level);
+    file.write(reinterpret_cast<const char*>(&level), 1);
+    
     // Write chunk size (8 bytes)
     uint64_t chunk_sz = config.chunk_size;
     file.write(reinterpret_cast<const char*>(&chunk_sz), 8);
@@ -150,29 +444,40 @@ bool StreamingCrypto::write_stream_header(
 }
 
 bool StreamingCrypto::read_stream_header(
-    std::ifstream& file,
+    std::istream& file,
     StreamingConfig& config,
     std::vector<uint8_t>& salt,
     std::vector<uint8_t>& base_nonce,
     size_t& original_size,
-    size_t& chunk_count
+    size_t& chunk_count,
+    uint8_t& flags,
+    uint8_t& version
 ) {
     // Read and verify magic bytes
     uint8_t magic[4];
     file.read(reinterpret_cast<char*>(magic), 4);
-    if (std::memcmp(magic, STREAM_MAGIC, 4) != 0) {
+    if (!file || std::memcmp(magic, STREAM_MAGIC, 4) != 0) {
         spdlog::error("Invalid streaming file format");
         return false;
     }
     
     // Read version
-    uint8_t version;
     file.read(reinterpret_cast<char*>(&version), 1);
-    if (version != STREAM_VERSION) {
+    if (version < 1 || version > STREAM_VERSION) {
         spdlog::error("Unsupported streaming format version: {}", version);
         return false;
     }
     
+    // Read flags (version 1 has none)
+    flags = 0;
+    if (version >= 2) {
+        file.read(reinterpret_cast<char*>(&flags), 1);
+    }
+    if (!file) {
+        spdlog::error("Truncated stream header");
+        return false;
+    }
+    
     // Read algorithm type
     uint8_t algo;
     file.read(reinterpret_cast<char*>(&algo), 1);
@@ -188,11 +493,24 @@ bool StreamingCrypto::read_stream_header(
     file.read(reinterpret_cast<char*>(&comp), 1);
     config.compression = static_cast<CompressionType>(comp);
     
+    // Read security level (version 1 files were always written with the default)
+    if (version >= 2) {
+        uint8_t level;
+        file.read(reinterpret_cast<char*>(&level), 1);
+        config.level = static_cast<SecurityLevel>(level);
+    }
+    
     // Read chunk size
     uint64_t chunk_sz;
     file.read(reinterpret_cast<char*>(&chunk_sz), 8);
+    // Sizes every buffer and the memory reservation, so a corrupt value must
+    // not get past here
+    if (!file || chunk_sz == 0 || chunk_sz > MAX_CHUNK_SIZE) {
+        spdlog::error("Invalid chunk size in stream header");
+        return false;
+    }
     config.chunk_size = static_cast<size_t>(chunk_sz);
-    
+
     // Read total size
     uint64_t total_sz;
     file.read(reinterpret_cast<char*>(&total_sz), 8);
@@ -218,177 +536,1508 @@ bool StreamingCrypto::read_stream_header(
     return file.good();
 }
 
+bool StreamingCrypto::write_chunk_index(
+    std::ostream& file,
+    const std::vector<ChunkIndexEntry>& entries,
+    uint64_t index_offset,
+    uint8_t flags,
+    const std::vector<StreamSegment>& segments
+) {
+    for (const auto& entry : entries) {
+        file.write(reinterpret_cast<const char*>(&entry.offset), 8);
+        file.write(reinterpret_cast<const char*>(&entry.plain_size), 4);
+    }
+    
+    if (flags & FLAG_CHUNK_DIGESTS) {
+        for (const auto& entry : entries) {
+            file.write(reinterpret_cast<const char*>(entry.digest.data()), entry.digest.size());
+        }
+    }
+    
+    if (flags & FLAG_SEGMENTS) {
+        for (const auto& segment : segments) {
+            uint32_t first = static_cast<uint32_t>(segment.first_chunk);
+            file.write(reinterpret_cast<const char*>(&first), 4);
+            write_segment(file, segment);
+        }
+        uint32_t segment_count = static_cast<uint32_t>(segments.size());
+        file.write(reinterpret_cast<const char*>(&segment_count), 4);
+    }
+    
+    uint32_t count = static_cast<uint32_t>(entries.size());
+    file.write(reinterpret_cast<const char*>(&index_offset), 8);
+    file.write(reinterpret_cast<const char*>(&count), 4);
+    file.write(reinterpret_cast<const char*>(INDEX_MAGIC), 4);
+    
+    return file.good();
+}
+
+bool StreamingCrypto::read_chunk_index(
+    std::ifstream& file,
+    size_t chunk_count,
+    std::vector<ChunkIndexEntry>& entries,
+    uint8_t flags,
+    uint8_t version,
+    size_t nonce_size,
+    std::vector<StreamSegment>* segments
+) {
+    file.seekg(0, std::ios::end);
+    uint64_t file_size = static_cast<uint64_t>(file.tellg());
+    if (file_size < INDEX_TRAILER_SIZE) {
+        return false;
+    }
+    
+    // Read trailer
+    uint64_t index_offset;
+    uint32_t count;
+    uint8_t magic[4];
+    file.seekg(static_cast<std::streamoff>(file_size - INDEX_TRAILER_SIZE));
+    file.read(reinterpret_cast<char*>(&index_offset), 8);
+    file.read(reinterpret_cast<char*>(&count), 4);
+    file.read(reinterpret_cast<char*>(magic), 4);
+    
+    // Digest and segment tables between the entries and the trailer
+    uint64_t table_size = 0;
+    uint32_t segment_count = 0;
+    if (file && (flags & FLAG_SEGMENTS) && file_size >= INDEX_TRAILER_SIZE + 4) {
+        file.seekg(static_cast<std::streamoff>(file_size - INDEX_TRAILER_SIZE - 4));
+        file.read(reinterpret_cast<char*>(&segment_count), 4);
+        table_size = uint64_t(segment_count) * (4 + segment_size(version, nonce_size)) + 4;
+    }
+    if (flags & FLAG_CHUNK_DIGESTS) {
+        table_size += uint64_t(count) * sizeof(ChunkIndexEntry::digest);
+    }
+    
+    if (!file || std::memcmp(magic, INDEX_MAGIC, 4) != 0 ||
+        (chunk_count != 0 && count != chunk_count) ||
+        index_offset + uint64_t(count) * INDEX_ENTRY_SIZE + table_size != file_size - INDEX_TRAILER_SIZE) {
+        spdlog::warn("Invalid chunk index footer");
+        return false;
+    }
+    
+    // Read entries
+    entries.resize(count);
+    file.seekg(static_cast<std::streamoff>(index_offset));
+    for (auto& entry : entries) {
+        file.read(reinterpret_cast<char*>(&entry.offset), 8);
+        file.read(reinterpret_cast<char*>(&entry.plain_size), 4);
+    }
+    
+    if (flags & FLAG_CHUNK_DIGESTS) {
+        for (auto& entry : entries) {
+            file.read(reinterpret_cast<char*>(entry.digest.data()), entry.digest.size());
+        }
+    }
+    
+    if (segments) {
+        segments->assign(segment_count, {});
+        for (auto& segment : *segments) {
+            uint32_t first = 0;
+            file.read(reinterpret_cast<char*>(&first), 4);
+            segment.first_chunk = first;
+            read_segment(file, segment, version, nonce_size);
+        }
+    }
+    
+    return file.good();
+}
+
+const StreamSegment& StreamingCrypto::segment_for(
+    const std::vector<StreamSegment>& segments,
+    const StreamSegment& first,
+    uint64_t index
+) {
+    // Last segment starting at or before the chunk
+    auto it = std::upper_bound(segments.begin(), segments.end(), index,
+                               [](uint64_t value, const StreamSegment& segment) {
+                                   return value < segment.first_chunk;
+                               });
+    return it == segments.begin() ? first : *std::prev(it);
+}
+
+size_t StreamingCrypto::segment_size(uint8_t version, size_t nonce_size) {
+    return version < 3 ? nonce_size : nonce_size + 8 + sizeof(StreamSegment::tag);
+}
+
+void StreamingCrypto::write_segment(std::ostream& file, const StreamSegment& segment) {
+    file.write(reinterpret_cast<const char*>(segment.base_nonce.data()), segment.base_nonce.size());
+    file.write(reinterpret_cast<const char*>(&segment.first_index), 8);
+    file.write(reinterpret_cast<const char*>(segment.tag.data()), segment.tag.size());
+}
+
+void StreamingCrypto::read_segment(std::istream& file, StreamSegment& segment, uint8_t version, size_t nonce_size) {
+    segment.base_nonce.resize(nonce_size);
+    file.read(reinterpret_cast<char*>(segment.base_nonce.data()), nonce_size);
+    segment.first_index = segment.first_chunk;
+    if (version >= 3) {
+        file.read(reinterpret_cast<char*>(&segment.first_index), 8);
+        file.read(reinterpret_cast<char*>(segment.tag.data()), segment.tag.size());
+    }
+}
+
+std::string StreamingCrypto::checkpoint_path(const std::string& output_path) {
+    return output_path + ".fvckpt";
+}
+
+bool StreamingCrypto::write_checkpoint(
+    const std::string& path,
+    const StreamCheckpoint& checkpoint,
+    const std::vector<uint8_t>& base_nonce
+) {
+    try {
+        std::ostringstream journal;
+        uint8_t nonce_len = static_cast<uint8_t>(base_nonce.size());
+        journal.write(reinterpret_cast<const char*>(CHECKPOINT_MAGIC), 4);
+        journal.write(reinterpret_cast<const char*>(&CHECKPOINT_VERSION), 1);
+        journal.write(reinterpret_cast<const char*>(&checkpoint.next_chunk), 8);
+        journal.write(reinterpret_cast<const char*>(&checkpoint.record_offset), 8);
+        journal.write(reinterpret_cast<const char*>(&checkpoint.input_offset), 8);
+        journal.write(reinterpret_cast<const char*>(&nonce_len), 1);
+        journal.write(reinterpret_cast<const char*>(base_nonce.data()), base_nonce.size());
+        journal.write(reinterpret_cast<const char*>(checkpoint.kept_digest.data()), checkpoint.kept_digest.size());
+        replace_file_durably(path, journal.str());
+        return true;
+    } catch (const std::exception& e) {
+        spdlog::error("Failed to write checkpoint journal {}: {}", path, e.what());
+        return false;
+    }
+}
+
+bool StreamingCrypto::read_checkpoint(
+    const std::string& path,
+    StreamCheckpoint& checkpoint,
+    std::vector<uint8_t>& base_nonce
+) {
+    std::ifstream journal(path, std::ios::binary);
+    uint8_t magic[4];
+    uint8_t version = 0;
+    uint8_t nonce_len = 0;
+    journal.read(reinterpret_cast<char*>(magic), 4);
+    journal.read(reinterpret_cast<char*>(&version), 1);
+    if (!journal || std::memcmp(magic, CHECKPOINT_MAGIC, 4) != 0 || version != CHECKPOINT_VERSION) {
+        return false;
+    }
+    journal.read(reinterpret_cast<char*>(&checkpoint.next_chunk), 8);
+    journal.read(reinterpret_cast<char*>(&checkpoint.record_offset), 8);
+    journal.read(reinterpret_cast<char*>(&checkpoint.input_offset), 8);
+    journal.read(reinterpret_cast<char*>(&nonce_len), 1);
+    base_nonce.resize(nonce_len);
+    journal.read(reinterpret_cast<char*>(base_nonce.data()), nonce_len);
+    journal.read(reinterpret_cast<char*>(checkpoint.kept_digest.data()), checkpoint.kept_digest.size());
+    return journal.good();
+}
+
 StreamingResult StreamingCrypto::encrypt_file(
     const std::string& input_path,
     const std::string& output_path,
     const std::string& password,
     const StreamingConfig& config
+) {
+    IOOptions io_options;
+    io_options.backend = config.io_backend;
+    io_options.direct = config.direct_io;
+    io_options.cache = config.cache_policy;
+    
+    // A journal left by an earlier run would describe a different output
+    const std::string journal_path = checkpoint_path(output_path);
+    std::error_code ec;
+    std::filesystem::remove(journal_path, ec);
+    
+    // Open input file
+    auto reader = IOBackend::open_reader(input_path, io_options);
+    if (!reader) {
+        StreamingResult result;
+        result.error_message = reader.error_message;
+        return result;
+    }
+    
+    size_t file_size = static_cast<size_t>(reader.value->size());
+    
+    spdlog::info("Streaming encryption: {} ({} bytes, {} I/O{})", input_path, file_size,
+                 IOBackend::name(io_options.backend), io_options.direct ? ", direct" : "");
+    
+    // Open output file
+    auto writer = IOBackend::open_writer(output_path, io_options);
+    if (!writer) {
+        StreamingResult result;
+        result.error_message = writer.error_message;
+        return result;
+    }
+    
+    ReaderStreamBuf input_buf(*reader.value);
+    WriterStreamBuf output_buf(*writer.value);
+    std::istream input(&input_buf);
+    std::ostream output(&output_buf);
+    
+    if (config.checkpoint_interval == 0) {
+        return encrypt_impl(input, output, password, config, file_size);
+    }
+    if (config.content_defined_chunks) {
+        StreamingResult result;
+        result.error_message = "Checkpoints need fixed-size chunks (content-defined chunking is on)";
+        return result;
+    }
+    
+    auto on_checkpoint = [&](const StreamCheckpoint& checkpoint, const std::vector<uint8_t>& base_nonce) {
+        writer.value->sync();
+        if (!write_checkpoint(journal_path, checkpoint, base_nonce)) {
+            throw std::runtime_error("Failed to write checkpoint journal " + journal_path);
+        }
+    };
+    auto result = encrypt_impl(input, output, password, config, file_size, nullptr, on_checkpoint);
+    return finish_checkpointed(result, *writer.value, journal_path);
+}
+
+StreamingResult StreamingCrypto::resume_encrypt_file(
+    const std::string& input_path,
+    const std::string& output_path,
+    const std::string& password,
+    const StreamingConfig& options
 ) {
     StreamingResult result;
-    auto start_time = std::chrono::high_resolution_clock::now();
+    const std::string journal_path = checkpoint_path(output_path);
     
-    try {
-        // Open input file
-        std::ifstream input(input_path, std::ios::binary | std::ios::ate);
-        if (!input) {
-            result.error_message = "Failed to open input file: " + input_path;
+    ResumeState resume;
+    std::vector<uint8_t> journal_nonce;
+    if (!read_checkpoint(journal_path, resume.checkpoint, journal_nonce)) {
+        result.error_message = "No usable checkpoint journal: " + journal_path;
+        return result;
+    }
+    const StreamCheckpoint& checkpoint = resume.checkpoint;
+    
+    // Format parameters come from the partial output's header
+    StreamingConfig config;
+    size_t original_size = 0;
+    size_t chunk_count = 0;
+    uint8_t version = 0;
+    {
+        std::ifstream partial(output_path, std::ios::binary);
+        if (!partial || !read_stream_header(partial, config, resume.salt, resume.base_nonce,
+                                            original_size, chunk_count, resume.flags, version)) {
+            result.error_message = "Cannot read the header of " + output_path;
             return result;
         }
-        
-        size_t file_size = input.tellg();
-        input.seekg(0);
-        
-        spdlog::info("Streaming encryption: {} ({} bytes)", input_path, file_size);
-        
-        // Calculate chunk count
-        size_t chunk_size = config.chunk_size;
-        size_t chunk_count = (file_size + chunk_size - 1) / chunk_size;
-        
-        // Initialize crypto engine
-        CryptoEngine engine;
-        engine.initialize();
-        
-        // Generate salt and derive key
-        auto salt = CryptoEngine::generate_salt(32);
-        auto base_nonce = CryptoEngine::generate_nonce(12);
-        
-        EncryptionConfig enc_config;
-        enc_config.algorithm = config.algorithm;
-        enc_config.kdf = config.kdf;
-        enc_config.level = config.level;
-        enc_config.apply_security_level();
-        
-        auto key = engine.derive_key(password, salt, enc_config);
-        
-        // Get algorithm
-        auto* algo = engine.get_algorithm(config.algorithm);
-        if (!algo) {
-            result.error_message = "Algorithm not available";
+        if (version != STREAM_VERSION) {
+            result.error_message = output_path + " was written by an older version; encrypt it again";
             return result;
         }
-        
-        // Open output file
-        std::ofstream output(output_path, std::ios::binary);
-        if (!output) {
-            result.error_message = "Failed to create output file: " + output_path;
+        if (resume.base_nonce != journal_nonce) {
+            result.error_message = "Checkpoint journal does not belong to " + output_path;
             return result;
         }
-        
-        // Write header
-        if (!write_stream_header(output, config, salt, base_nonce, file_size, chunk_count)) {
-            result.error_message = "Failed to write stream header";
+        if ((resume.flags & (FLAG_SIZE_UNKNOWN | FLAG_CONTENT_DEFINED)) || checkpoint.next_chunk == 0 ||
+            checkpoint.next_chunk >= chunk_count ||
+            checkpoint.input_offset != checkpoint.next_chunk * config.chunk_size ||
+            checkpoint.input_offset > original_size) {
+            result.error_message = "Checkpoint journal is inconsistent with " + output_path;
             return result;
         }
         
-        // Process chunks
-        std::vector<uint8_t> chunk_buffer(chunk_size);
-        size_t bytes_processed = 0;
-        
-        for (size_t i = 0; i < chunk_count; ++i) {
-            // Read chunk
-            size_t bytes_to_read = (std::min)(chunk_size, file_size - bytes_processed);
-            input.read(reinterpret_cast<char*>(chunk_buffer.data()), bytes_to_read);
-            
-            if (!input && !input.eof()) {
-                result.error_message = "Failed to read input chunk";
-                return result;
-            }
-            
-            // Compress if enabled
-            std::vector<uint8_t> data_to_encrypt(chunk_buffer.begin(), 
-                                                  chunk_buffer.begin() + bytes_to_read);
-            
-            if (config.compression != CompressionType::NONE) {
-                auto compressor = compression::CompressionService::create(config.compression);
-                if (compressor) {
-                    auto comp_result = compressor->compress(data_to_encrypt, config.compression_level);
-                    if (comp_result.success && comp_result.data.size() < data_to_encrypt.size()) {
-                        data_to_encrypt = std::move(comp_result.data);
-                    }
-                }
+        // Rebuild the chunk index of the durable records and keep the last one for authentication.
+        // Earlier resumes started segments; their markers are checked with the last record.
+        const bool chunk_flags = (resume.flags & FLAG_CHUNK_COMPRESSION) != 0;
+        uint64_t offset = 32 + resume.salt.size() + resume.base_nonce.size();
+        offset += record_padding(offset, resume.flags);
+        resume.entries.reserve(chunk_count);
+        for (uint64_t i = 0; i < checkpoint.next_chunk; ++i) {
+            uint32_t enc_size = 0;
+            partial.seekg(static_cast<std::streamoff>(offset));
+            partial.read(reinterpret_cast<char*>(&enc_size), 4);
+            while (partial && enc_size == RECORD_SEGMENT) {
+                StreamSegment segment;
+                segment.first_chunk = i;
+                read_segment(partial, segment, version, resume.base_nonce.size());
+                resume.segments.push_back(std::move(segment));
+                offset += 4 + segment_size(version, resume.base_nonce.size());
+                offset += record_padding(offset, resume.flags);
+                partial.seekg(static_cast<std::streamoff>(offset));
+                partial.read(reinterpret_cast<char*>(&enc_size), 4);
             }
-            
-            // Generate chunk-specific nonce
-            auto chunk_nonce = derive_chunk_nonce(base_nonce, i);
-            enc_config.nonce = chunk_nonce;
-            
-            // Encrypt chunk
-            auto enc_result = algo->encrypt(data_to_encrypt, key, enc_config);
-            if (!enc_result.success) {
-                result.error_message = "Encryption failed at chunk " + std::to_string(i);
+            bool compressed = chunk_flags && (enc_size & RECORD_COMPRESSED) != 0;
+            enc_size &= ~(RECORD_LAST_CHUNK | RECORD_COMPRESSED);
+            if (!partial || enc_size > config.chunk_size + 1024) {
+                result.error_message = "Partial output is corrupted at chunk " + std::to_string(i);
                 return result;
             }
-            
-            // Write encrypted chunk: [4 bytes size][data][16 bytes tag]
-            uint32_t enc_size = static_cast<uint32_t>(enc_result.data.size());
-            output.write(reinterpret_cast<const char*>(&enc_size), 4);
-            output.write(reinterpret_cast<const char*>(enc_result.data.data()), enc_result.data.size());
-            
-            // Write tag if present
-            if (enc_result.tag.has_value()) {
-                output.write(reinterpret_cast<const char*>(enc_result.tag.value().data()), 
-                            enc_result.tag.value().size());
-            }
-            
-            bytes_processed += bytes_to_read;
-            result.chunks_processed++;
-            
-            // Progress callback
-            if (config.progress_callback) {
-                ChunkInfo info{i, bytes_to_read, chunk_count, bytes_processed, file_size};
-                if (!config.progress_callback(info)) {
-                    result.error_message = "Operation cancelled by user";
-                    return result;
-                }
+            if (i + 1 == checkpoint.next_chunk) {
+                resume.last_data.resize(enc_size);
+                resume.last_tag.resize(16);
+                resume.last_compressed = compressed;
+                partial.read(reinterpret_cast<char*>(resume.last_data.data()), enc_size);
+                partial.read(reinterpret_cast<char*>(resume.last_tag.data()), 16);
             }
+            resume.entries.push_back({offset, static_cast<uint32_t>(config.chunk_size)});
+            offset += 4 + uint64_t(enc_size) + 16;
+            offset += record_padding(offset, resume.flags);
+        }
+        if (!partial || offset != checkpoint.record_offset) {
+            result.error_message = "Partial output is shorter than its checkpoint";
+            return result;
         }
-        
-        result.bytes_processed = bytes_processed;
-        result.success = true;
-        
-    } catch (const std::exception& e) {
-        result.error_message = std::string("Streaming encryption failed: ") + e.what();
-        return result;
     }
     
-    auto end_time = std::chrono::high_resolution_clock::now();
-    result.processing_time_ms = std::chrono::duration<double, std::milli>(end_time - start_time).count();
-    result.throughput_mbps = (result.bytes_processed / 1024.0 / 1024.0) / (result.processing_time_ms / 1000.0);
+    // Runtime options from the caller
+    config.compression_level = options.compression_level;
+    config.skip_incompressible = options.skip_incompressible;
+    config.progress_callback = options.progress_callback;
+    config.threads = options.threads;
+    config.max_in_flight_bytes = options.max_in_flight_bytes;
+    config.io_backend = options.io_backend;
+    config.direct_io = options.direct_io;
+    config.cache_policy = options.cache_policy;
+    config.checkpoint_interval = options.checkpoint_interval;
     
-    spdlog::info("Streaming encryption completed: {} chunks, {:.2f} MB/s", 
-                 result.chunks_processed, result.throughput_mbps);
+    IOOptions io_options;
+    io_options.backend = config.io_backend;
+    io_options.direct = config.direct_io;
+    io_options.cache = config.cache_policy;
+    io_options.read_offset = checkpoint.input_offset;
     
-    return result;
-}
-
-StreamingResult StreamingCrypto::decrypt_file(
+    auto reader = IOBackend::open_reader(input_path, io_options);
+    if (!reader) {
+        result.error_message = reader.error_message;
+        return result;
+    }
+    if (reader.value->size() != original_size) {
+        result.error_message = "Input size differs from the interrupted run";
+        return result;
+    }
+    
+    spdlog::info("Resuming streaming encryption: {} at chunk {}/{} ({} bytes done)",
+                 input_path, checkpoint.next_chunk, chunk_count, checkpoint.input_offset);
+    
+    // Discards the records after the checkpoint (they may be torn)
+    io_options.write_offset = checkpoint.record_offset;
+    auto writer = IOBackend::open_writer(output_path, io_options);
+    if (!writer) {
+        result.error_message = writer.error_message;
+        return result;
+    }
+    
+    ReaderStreamBuf input_buf(*reader.value);
+    WriterStreamBuf output_buf(*writer.value);
+    std::istream input(&input_buf);
+    std::ostream output(&output_buf);
+    
+    CheckpointCallback on_checkpoint;
+    if (config.checkpoint_interval > 0) {
+        on_checkpoint = [&](const StreamCheckpoint& next, const std::vector<uint8_t>& base_nonce) {
+            writer.value->sync();
+            if (!write_checkpoint(journal_path, next, base_nonce)) {
+                throw std::runtime_error("Failed to write checkpoint journal " + journal_path);
+            }
+        };
+    }
+    
+    // Digests of the kept chunks are recomputed from the start of the input
+    std::ifstream kept_input;
+    if (resume.flags & FLAG_CHUNK_DIGESTS) {
+        kept_input.open(input_path, std::ios::binary);
+        resume.kept_input = &kept_input;
+    }
+    
+    // The input may have changed since the interrupted run, so this run's chunks
+    // never reuse the nonces of the records it discarded: they start a new segment
+    resume.segment_id = CryptoEngine::generate_nonce(resume.base_nonce.size());
+    resume.flags |= FLAG_SEGMENTS;
+    result = encrypt_impl(input, output, password, config, original_size, &resume, on_checkpoint);
+    if (result.success) {
+        // finish_checkpointed's fdatasync also covers the header written through this descriptor
+        std::fstream header(output_path, std::ios::binary | std::ios::in | std::ios::out);
+        header.seekp(HEADER_FLAGS_OFFSET);
+        header.write(reinterpret_cast<const char*>(&resume.flags), 1);
+        if (!header.flush()) {
+            result.success = false;
+            result.error_message = "Failed to update the header of " + output_path;
+        }
+    }
+    return finish_checkpointed(result, *writer.value, journal_path);
+}
+
+StreamingResult& StreamingCrypto::finish_checkpointed(
+    StreamingResult& result,
+    ISequentialWriter& writer,
+    const std::string& journal_path
+) {
+    if (!result.success) {
+        spdlog::info("Checkpoint journal kept for resume: {}", journal_path);
+        return result;
+    }
+    // The journal may only go once the complete output is durable
+    try {
+        writer.sync();
+    } catch (const std::exception& e) {
+        result.success = false;
+        result.error_message = std::string("Failed to sync output: ") + e.what();
+        return result;
+    }
+    std::error_code ec;
+    std::filesystem::remove(journal_path, ec);
+    return result;
+}
+
+std::string StreamingCrypto::append_journal_path(const std::string& stream_path) {
+    return stream_path + ".fvundo";
+}
+
+Result<void> StreamingCrypto::rollback_append(const std::string& stream_path) {
+    const std::string journal_path = append_journal_path(stream_path);
+    std::ifstream journal(journal_path, std::ios::binary);
+    if (!journal) {
+        return Result<void>::ok();
+    }
+    
+    uint8_t magic[4] = {};
+    uint8_t version = 0;
+    uint64_t original_size = 0;
+    uint64_t tail_offset = 0;
+    std::vector<uint8_t> header_prefix(HEADER_PREFIX_SIZE);
+    journal.read(reinterpret_cast<char*>(magic), 4);
+    journal.read(reinterpret_cast<char*>(&version), 1);
+    journal.read(reinterpret_cast<char*>(&original_size), 8);
+    journal.read(reinterpret_cast<char*>(&tail_offset), 8);
+    journal.read(reinterpret_cast<char*>(header_prefix.data()), HEADER_PREFIX_SIZE);
+    if (!journal || std::memcmp(magic, UNDO_MAGIC, 4) != 0 || version != UNDO_VERSION ||
+        tail_offset < HEADER_PREFIX_SIZE || tail_offset > original_size) {
+        return Result<void>::error("Corrupted append journal: " + journal_path);
+    }
+    std::vector<uint8_t> tail(static_cast<size_t>(original_size - tail_offset));
+    journal.read(reinterpret_cast<char*>(tail.data()), tail.size());
+    if (!journal) {
+        return Result<void>::error("Corrupted append journal: " + journal_path);
+    }
+    journal.close();
+    
+    spdlog::warn("Rolling back an interrupted append to {}", stream_path);
+    try {
+        {
+            std::fstream stream(stream_path, std::ios::binary | std::ios::in | std::ios::out);
+            stream.write(reinterpret_cast<const char*>(header_prefix.data()), HEADER_PREFIX_SIZE);
+            if (!stream.flush()) {
+                return Result<void>::error("Cannot restore the header of " + stream_path);
+            }
+        }
+        IOOptions io_options;
+        io_options.write_offset = tail_offset;
+        auto writer = IOBackend::open_writer(stream_path, io_options);
+        if (!writer) {
+            return Result<void>::error(writer.error_message);
+        }
+        writer.value->write(tail.data(), tail.size());
+        // fdatasync also covers the header written through the other descriptor
+        writer.value->sync();
+    } catch (const std::exception& e) {
+        return Result<void>::error(std::string("Rollback of ") + stream_path + " failed: " + e.what());
+    }
+    
+    std::error_code ec;
+    std::filesystem::remove(journal_path, ec);
+    return Result<void>::ok();
+}
+
+StreamingResult StreamingCrypto::append_file(
     const std::string& input_path,
-    const std::string& output_path,
+    const std::string& stream_path,
     const std::string& password,
-    StreamProgressCallback progress_callback
+    const StreamingConfig& options
+) {
+    StreamingResult result;
+    const std::string journal_path = append_journal_path(stream_path);
+    
+    // A crash during an earlier append leaves a half-written tail behind
+    auto rolled_back = rollback_append(stream_path);
+    if (!rolled_back) {
+        result.error_message = rolled_back.error_message;
+        return result;
+    }
+    
+    ResumeState resume;
+    StreamingConfig config;
+    size_t original_size = 0;
+    size_t chunk_count = 0;
+    uint8_t version = 0;
+    std::vector<uint8_t> header_prefix(HEADER_PREFIX_SIZE);
+    std::vector<uint8_t> tail;
+    uint64_t tail_offset = 0;
+    uint64_t stream_size = 0;
+    uint64_t carried_size = 0;
+    {
+        std::ifstream stream(stream_path, std::ios::binary);
+        if (!stream || !read_stream_header(stream, config, resume.salt, resume.base_nonce,
+                                           original_size, chunk_count, resume.flags, version)) {
+            result.error_message = "Cannot read the header of " + stream_path;
+            return result;
+        }
+        const uint8_t required = FLAG_CHUNK_INDEX | FLAG_END_MARKER;
+        if ((resume.flags & required) != required) {
+            result.error_message = "Only streams with a chunk index and end markers can be appended to";
+            return result;
+        }
+        // Older segments are not bound to the stream; update_file re-encrypts the stream first
+        if (version != STREAM_VERSION) {
+            result.error_message = stream_path + " was written by an older version; update it before appending";
+            return result;
+        }
+        const bool size_known = (resume.flags & FLAG_SIZE_UNKNOWN) == 0;
+        if (!read_chunk_index(stream, size_known ? chunk_count : 0, resume.entries, resume.flags,
+                              version, resume.base_nonce.size(), &resume.segments) || resume.entries.empty()) {
+            result.error_message = "Missing or corrupted chunk index in " + stream_path;
+            return result;
+        }
+        
+        // Final record: authenticated, then re-encrypted in the new segment
+        const size_t last_index = resume.entries.size() - 1;
+        const ChunkIndexEntry last_entry = resume.entries.back();
+        uint32_t enc_size = 0;
+        stream.clear();
+        stream.seekg(static_cast<std::streamoff>(last_entry.offset));
+        stream.read(reinterpret_cast<char*>(&enc_size), 4);
+        resume.last_final = (enc_size & RECORD_LAST_CHUNK) != 0;
+        resume.last_compressed = (resume.flags & FLAG_CHUNK_COMPRESSION) && (enc_size & RECORD_COMPRESSED);
+        enc_size &= ~(RECORD_LAST_CHUNK | RECORD_COMPRESSED);
+        if (!stream || !resume.last_final || enc_size > config.chunk_size + 1024) {
+            result.error_message = "Final record of " + stream_path + " is corrupted";
+            return result;
+        }
+        resume.last_data.resize(enc_size);
+        resume.last_tag.resize(16);
+        stream.read(reinterpret_cast<char*>(resume.last_data.data()), enc_size);
+        stream.read(reinterpret_cast<char*>(resume.last_tag.data()), 16);
+        resume.carry_last = true;
+        carried_size = last_entry.plain_size;
+        
+        // Save what the append overwrites: the header fields and everything from the final record on
+        stream.seekg(0, std::ios::end);
+        stream_size = static_cast<uint64_t>(stream.tellg());
+        tail_offset = last_entry.offset;
+        tail.resize(static_cast<size_t>(stream_size - tail_offset));
+        stream.seekg(0);
+        stream.read(reinterpret_cast<char*>(header_prefix.data()), HEADER_PREFIX_SIZE);
+        stream.seekg(static_cast<std::streamoff>(tail_offset));
+        stream.read(reinterpret_cast<char*>(tail.data()), tail.size());
+        if (!stream) {
+            result.error_message = "Cannot read the tail of " + stream_path;
+            return result;
+        }
+        
+        // The new segment starts at the replaced record; its marker is written in its place
+        resume.checkpoint.next_chunk = last_index;
+        resume.checkpoint.record_offset = tail_offset;
+        resume.checkpoint.input_offset = original_size - last_entry.plain_size;
+        resume.entries.pop_back();
+        if (!size_known) {
+            // Header sizes stay zero; the footer is the only record of them
+            resume.checkpoint.input_offset = 0;
+            for (const auto& entry : resume.entries) {
+                resume.checkpoint.input_offset += entry.plain_size;
+            }
+        }
+        resume.segment_id = CryptoEngine::generate_nonce(resume.base_nonce.size());
+        resume.flags |= FLAG_SEGMENTS;
+    }
+    
+    // Runtime options from the caller
+    config.compression_level = options.compression_level;
+    config.skip_incompressible = options.skip_incompressible;
+    config.progress_callback = options.progress_callback;
+    config.threads = options.threads;
+    config.max_in_flight_bytes = options.max_in_flight_bytes;
+    config.io_backend = options.io_backend;
+    config.direct_io = options.direct_io && (resume.flags & FLAG_ALIGNED);
+    config.cache_policy = options.cache_policy;
+    
+    IOOptions io_options;
+    io_options.backend = config.io_backend;
+    io_options.direct = config.direct_io;
+    io_options.cache = config.cache_policy;
+    
+    auto reader = IOBackend::open_reader(input_path, io_options);
+    if (!reader) {
+        result.error_message = reader.error_message;
+        return result;
+    }
+    const uint64_t append_size = reader.value->size();
+    if (append_size == 0) {
+        result.success = true;
+        return result;
+    }
+    // Chunk indices continue from the replaced record and must not wrap the nonces
+    // (content-defined chunks are counted at their smallest)
+    const uint64_t new_chunks = (resume.flags & FLAG_CONTENT_DEFINED) ?
+        ContentChunker::max_stream_chunks(carried_size + append_size, config.chunk_size) :
+        (carried_size + append_size + config.chunk_size - 1) / config.chunk_size;
+    if (resume.checkpoint.next_chunk + new_chunks > MAX_CHUNKS) {
+        result.error_message = "Appending would exceed " + std::to_string(MAX_CHUNKS) + " chunks in " + stream_path;
+        return result;
+    }
+    
+    // Undo journal first: from here on the stream is modified in place
+    try {
+        std::ostringstream journal;
+        journal.write(reinterpret_cast<const char*>(UNDO_MAGIC), 4);
+        journal.write(reinterpret_cast<const char*>(&UNDO_VERSION), 1);
+        journal.write(reinterpret_cast<const char*>(&stream_size), 8);
+        journal.write(reinterpret_cast<const char*>(&tail_offset), 8);
+        journal.write(reinterpret_cast<const char*>(header_prefix.data()), HEADER_PREFIX_SIZE);
+        journal.write(reinterpret_cast<const char*>(tail.data()), tail.size());
+        replace_file_durably(journal_path, journal.str());
+    } catch (const std::exception& e) {
+        result.error_message = std::string("Failed to write append journal: ") + e.what();
+        return result;
+    }
+    
+    spdlog::info("Appending {} ({} bytes) to {} at chunk {}", input_path, append_size,
+                 stream_path, resume.checkpoint.next_chunk);
+    
+    std::string error;
+    try {
+        io_options.write_offset = tail_offset;
+        auto writer = IOBackend::open_writer(stream_path, io_options);
+        if (!writer) {
+            throw std::runtime_error(writer.error_message);
+        }
+        
+        ReaderStreamBuf input_buf(*reader.value);
+        WriterStreamBuf output_buf(*writer.value);
+        std::istream input(&input_buf);
+        std::ostream output(&output_buf);
+        
+        std::optional<uint64_t> known_size;
+        if ((resume.flags & FLAG_SIZE_UNKNOWN) == 0) {
+            known_size = original_size + append_size;
+        }
+        result = encrypt_impl(input, output, password, config, known_size, &resume);
+        if (!result.success) {
+            throw std::runtime_error(result.error_message);
+        }
+        
+        // Header: segment flag, and the new totals when the stream records them
+        {
+            std::fstream header(stream_path, std::ios::binary | std::ios::in | std::ios::out);
+            header.seekp(HEADER_FLAGS_OFFSET);
+            header.write(reinterpret_cast<const char*>(&resume.flags), 1);
+            if (known_size) {
+                uint64_t total_size = *known_size;
+                uint32_t total_chunks = (resume.flags & FLAG_CONTENT_DEFINED) ? 0 :
+                    static_cast<uint32_t>(resume.checkpoint.next_chunk + result.chunks_processed);
+                header.seekp(HEADER_TOTAL_OFFSET);
+                header.write(reinterpret_cast<const char*>(&total_size), 8);
+                header.write(reinterpret_cast<const char*>(&total_chunks), 4);
+            }
+            if (!header.flush()) {
+                throw std::runtime_error("Failed to update the header of " + stream_path);
+            }
+        }
+        // fdatasync also covers the header written through the other descriptor
+        writer.value->sync();
+    } catch (const std::exception& e) {
+        error = e.what();
+    }
+    
+    // The writer is closed by now, so nothing can land after the restored tail
+    if (!error.empty()) {
+        result.success = false;
+        result.error_message = "Append failed: " + error;
+        auto undone = rollback_append(stream_path);
+        if (!undone) {
+            spdlog::error("{} (journal kept: {})", undone.error_message, journal_path);
+        }
+        return result;
+    }
+    
+    std::error_code ec;
+    std::filesystem::remove(journal_path, ec);
+    return result;
+}
+
+StreamingResult StreamingCrypto::update_file(
+    const std::string& input_path,
+    const std::string& stream_path,
+    const std::string& password,
+    const StreamingConfig& options
+) {
+    StreamingResult result;
+    
+    UpdateSource update;
+    StreamingConfig config;
+    size_t original_size = 0;
+    size_t chunk_count = 0;
+    uint8_t version = 0;
+    std::ifstream previous(stream_path, std::ios::binary);
+    if (!previous || !read_stream_header(previous, config, update.salt, update.base_nonce,
+                                         original_size, chunk_count, update.flags, version)) {
+        result.error_message = "Cannot read the header of " + stream_path;
+        return result;
+    }
+    
+    // Records of older versions are not bound to the stream, so they are not copied
+    const uint8_t required = FLAG_CHUNK_INDEX | FLAG_END_MARKER | FLAG_CHUNK_COMPRESSION | FLAG_CHUNK_DIGESTS;
+    const bool size_known = (update.flags & FLAG_SIZE_UNKNOWN) == 0;
+    bool incremental = version == STREAM_VERSION && (update.flags & required) == required &&
+                       read_chunk_index(previous, size_known ? chunk_count : 0, update.entries, update.flags,
+                                        version, update.base_nonce.size(), &update.segments) &&
+                       !update.entries.empty();
+    if (incremental) {
+        uint32_t enc_size = 0;
+        previous.clear();
+        previous.seekg(static_cast<std::streamoff>(update.entries.back().offset));
+        previous.read(reinterpret_cast<char*>(&enc_size), 4);
+        update.last_compressed = (enc_size & RECORD_COMPRESSED) != 0;
+        enc_size &= ~(RECORD_LAST_CHUNK | RECORD_COMPRESSED);
+        if (previous && enc_size <= config.chunk_size + 1024) {
+            update.last_data.resize(enc_size);
+            update.last_tag.resize(16);
+            previous.read(reinterpret_cast<char*>(update.last_data.data()), enc_size);
+            previous.read(reinterpret_cast<char*>(update.last_tag.data()), 16);
+        }
+        incremental = previous.good() && !update.last_tag.empty();
+    }
+    
+    if (!incremental) {
+        // Older layouts: check the password by decrypting the first chunk, then re-encrypt in full
+        spdlog::info("{} has no chunk digests or an older format; re-encrypting it in full", stream_path);
+        previous.close();
+        StreamingReader reader(1);
+        auto opened = reader.open(stream_path, password);
+        if (!opened || (reader.size() > 0 && !reader.read(0, 1))) {
+            result.error_message = "Existing stream does not authenticate (wrong password?)";
+            return result;
+        }
+    }
+    update.update_segment = CryptoEngine::generate_nonce(update.base_nonce.size());
+    if (incremental && (update.flags & FLAG_CONTENT_DEFINED)) {
+        for (size_t i = 0; i < update.entries.size(); ++i) {
+            update.by_digest.emplace(update.entries[i].digest, i);
+        }
+    }
+    
+    // Runtime options from the caller
+    config.compression_level = options.compression_level;
+    config.skip_incompressible = options.skip_incompressible;
+    config.progress_callback = options.progress_callback;
+    config.threads = options.threads;
+    config.max_in_flight_bytes = options.max_in_flight_bytes;
+    config.io_backend = options.io_backend;
+    config.direct_io = options.direct_io;
+    config.cache_policy = options.cache_policy;
+    config.chunk_digests = true;
+    config.content_defined_chunks = (update.flags & FLAG_CONTENT_DEFINED) != 0;
+    if (incremental) {
+        config.direct_io = options.direct_io && (update.flags & FLAG_ALIGNED);
+    }
+    
+    IOOptions io_options;
+    io_options.backend = config.io_backend;
+    io_options.direct = config.direct_io;
+    io_options.cache = config.cache_policy;
+    
+    auto reader = IOBackend::open_reader(input_path, io_options);
+    if (!reader) {
+        result.error_message = reader.error_message;
+        return result;
+    }
+    const uint64_t input_size = reader.value->size();
+    
+    spdlog::info("Updating {} from {} ({} bytes, {} chunks before)", stream_path, input_path,
+                 input_size, update.entries.size());
+    
+    // The new version replaces the old one only once it is complete and durable
+    const std::string temp_path = stream_path + ".fvupd";
+    std::string error;
+    try {
+        auto writer = IOBackend::open_writer(temp_path, io_options);
+        if (!writer) {
+            throw std::runtime_error(writer.error_message);
+        }
+        
+        ReaderStreamBuf input_buf(*reader.value);
+        WriterStreamBuf output_buf(*writer.value);
+        std::istream input(&input_buf);
+        std::ostream output(&output_buf);
+        
+        if (incremental) {
+            update.previous = &previous;
+            result = encrypt_impl(input, output, password, config, input_size, nullptr, nullptr, &update);
+        } else {
+            result = encrypt_impl(input, output, password, config, input_size);
+        }
+        if (!result.success) {
+            throw std::runtime_error(result.error_message);
+        }
+        writer.value->sync();
+    } catch (const std::exception& e) {
+        error = e.what();
+    }
+    
+    std::error_code ec;
+    if (error.empty()) {
+        std::filesystem::rename(temp_path, stream_path, ec);
+        if (ec) {
+            error = "Cannot replace " + stream_path + ": " + ec.message();
+        }
+    }
+    if (!error.empty()) {
+        std::filesystem::remove(temp_path, ec);
+        result.success = false;
+        result.error_message = "Update failed: " + error;
+        return result;
+    }
+    
+    spdlog::info("Update completed: {} of {} chunks unchanged", result.chunks_unchanged,
+                 result.chunks_processed);
+    return result;
+}
+
+StreamingResult StreamingCrypto::encrypt_stream(
+    std::istream& input,
+    std::ostream& output,
+    const std::string& password,
+    const StreamingConfig& config
+) {
+    spdlog::info("Streaming encryption from stream of unknown length");
+    return encrypt_impl(input, output, password, config, std::nullopt);
+}
+
+StreamingResult StreamingCrypto::encrypt_impl(
+    std::istream& input,
+    std::ostream& output,
+    const std::string& password,
+    const StreamingConfig& config,
+    std::optional<uint64_t> known_size,
+    const ResumeState* resume,
+    const CheckpointCallback& on_checkpoint,
+    const UpdateSource* update
 ) {
     StreamingResult result;
     auto start_time = std::chrono::high_resolution_clock::now();
     
     try {
-        // Open input file
-        std::ifstream input(input_path, std::ios::binary);
-        if (!input) {
-            result.error_message = "Failed to open input file: " + input_path;
+        size_t chunk_size = config.chunk_size;
+        if (chunk_size == 0 || chunk_size > MAX_CHUNK_SIZE) {
+            result.error_message = "Chunk size must be at least 1 byte and below 1 GiB";
+            return result;
+        }
+        
+        // Every stream has at least one (possibly empty) final chunk
+        size_t chunk_count = 0;
+        uint8_t flags = FLAG_CHUNK_INDEX | FLAG_END_MARKER | FLAG_CHUNK_COMPRESSION;
+        if (known_size) {
+            const uint64_t chunks = (std::max)(uint64_t(1), (*known_size + chunk_size - 1) / chunk_size);
+            if (chunks > MAX_CHUNKS) {
+                result.error_message = "Input needs more than " + std::to_string(MAX_CHUNKS) +
+                                       " chunks; use a larger chunk size";
+                return result;
+            }
+            chunk_count = static_cast<size_t>(chunks);
+        } else {
+            flags |= FLAG_SIZE_UNKNOWN;
+        }
+        if (config.direct_io) {
+            flags |= FLAG_ALIGNED;
+        }
+        if (config.chunk_digests) {
+            flags |= FLAG_CHUNK_DIGESTS;
+        }
+        if (config.content_defined_chunks) {
+            flags |= FLAG_CONTENT_DEFINED;
+        }
+        
+        // Initialize crypto engine
+        CryptoEngine engine;
+        engine.initialize();
+        
+        // Generate salt and derive key (a resumed or updated stream keeps its own)
+        auto* info = find_algorithm(config.algorithm);
+        const size_t nonce_size = info ? info->nonce_size : 12;
+        auto salt = resume ? resume->salt : update ? update->salt : CryptoEngine::generate_salt(32);
+        auto base_nonce = resume ? resume->base_nonce : update ? update->base_nonce : CryptoEngine::generate_nonce(nonce_size);
+        if (resume) {
+            flags = resume->flags;
+        } else if (update) {
+            // Re-encrypted chunks live in segments; the new size is known
+            flags = (update->flags | FLAG_SEGMENTS | FLAG_CHUNK_DIGESTS) & ~FLAG_SIZE_UNKNOWN;
+        }
+        
+        EncryptionConfig enc_config;
+        enc_config.algorithm = config.algorithm;
+        enc_config.kdf = config.kdf;
+        enc_config.level = config.level;
+        enc_config.apply_security_level();
+        
+        auto key = engine.derive_key(password, salt, enc_config);
+        
+        // Get algorithm
+        auto* algo = engine.get_algorithm(config.algorithm);
+        if (!algo) {
+            result.error_message = "Algorithm not available";
+            return result;
+        }
+        // Records always carry a 16-byte tag
+        if (!supports_algorithm(config.algorithm)) {
+            result.error_message = "Streaming requires an AEAD algorithm with 16-byte tags";
+            return result;
+        }
+        
+        const bool content_defined = (flags & FLAG_CONTENT_DEFINED) != 0;
+        const RecordBinding binding(STREAM_VERSION, key, config, flags, salt, base_nonce);
+        std::vector<uint8_t> digest_key;
+        if (flags & FLAG_CHUNK_DIGESTS) {
+            digest_key = derive_subkey(key, "FVST chunk digest v1");
+        }
+        std::optional<ContentChunker> chunker;
+        if (content_defined) {
+            // Sized by the shortest chunks, as the count is only known at the end (appends check their own)
+            if (!resume && known_size && ContentChunker::max_stream_chunks(*known_size, chunk_size) > MAX_CHUNKS) {
+                result.error_message = "Input may need more than " + std::to_string(MAX_CHUNKS) +
+                                       " content-defined chunks; use a larger chunk size";
+                return result;
+            }
+            chunker.emplace(ContentChunker::for_stream(derive_subkey(key, "FVST chunk boundaries v1"), chunk_size));
+        }
+        
+        // Record offsets for the chunk index footer
+        std::vector<ChunkIndexEntry> index_entries;
+        index_entries.reserve(chunk_count);
+        uint64_t record_offset = 0;
+        
+        // Plaintext of a replaced final record is encrypted ahead of the input
+        std::optional<PrefixStreamBuf> carried;
+        std::optional<std::istream> carried_input;
+        std::istream* source = &input;
+        std::vector<StreamSegment> segments;
+        
+        // Checkpoints of digest streams carry a digest chained over the chunk digests,
+        // so a resumed run can tell whether the kept chunks are still the input's
+        std::array<uint8_t, 16> kept_digest{};
+        auto chain_digest = [&](uint64_t index, const std::array<uint8_t, 16>& digest) {
+            std::vector<uint8_t> link(kept_digest.begin(), kept_digest.end());
+            link.insert(link.end(), digest.begin(), digest.end());
+            kept_digest = chunk_digest(digest_key, index, link);
+        };
+        
+        if (resume) {
+            // Refuse to extend an output this password did not produce
+            const size_t last_index = static_cast<size_t>(resume->checkpoint.next_chunk) -
+                                      (resume->carry_last ? 0 : 1);
+            if (!binding.check(resume->segments, last_index + 1)) {
+                result.error_message = "Segment table of the existing output does not authenticate";
+                return result;
+            }
+            EncryptionConfig last_config = enc_config;
+            binding.apply(last_config, resume->segments, last_index, resume->last_final, resume->last_compressed);
+            last_config.tag = resume->last_tag;
+            auto last = algo->decrypt(resume->last_data, key, last_config);
+            if (!last.success) {
+                result.error_message = "Existing output does not authenticate (wrong password?)";
+                return result;
+            }
+            if (resume->carry_last) {
+                if (resume->last_compressed) {
+                    auto decomp_result = compression::CompressionService::create(config.compression)
+                                             ->decompress(last.data);
+                    if (!decomp_result.success) {
+                        result.error_message = "Failed to decompress the final chunk: " + decomp_result.error_message;
+                        return result;
+                    }
+                    last.data = std::move(decomp_result.data);
+                }
+                carried.emplace(std::move(last.data), input.rdbuf());
+                carried_input.emplace(&*carried);
+                source = &*carried_input;
+            }
+            index_entries = resume->entries;
+            segments = resume->segments;
+            record_offset = resume->checkpoint.record_offset;
+            
+            if (resume->kept_input) {
+                std::vector<uint8_t> plaintext;
+                for (size_t i = 0; i < index_entries.size(); ++i) {
+                    plaintext.resize(index_entries[i].plain_size);
+                    resume->kept_input->read(reinterpret_cast<char*>(plaintext.data()), plaintext.size());
+                    if (!*resume->kept_input) {
+                        result.error_message = "Failed to re-read input chunk " + std::to_string(i);
+                        return result;
+                    }
+                    index_entries[i].digest = chunk_digest(digest_key, i, plaintext);
+                    chain_digest(i, index_entries[i].digest);
+                }
+                if (kept_digest != resume->checkpoint.kept_digest) {
+                    result.error_message = "Input changed since the interrupted run; encrypt it again";
+                    return result;
+                }
+            }
+        } else {
+            if (update) {
+                // Refuse to rewrite a stream this password did not produce
+                const size_t last_index = update->entries.size() - 1;
+                EncryptionConfig last_config = enc_config;
+                binding.apply(last_config, update->segments, last_index, true, update->last_compressed);
+                last_config.tag = update->last_tag;
+                if (!binding.check(update->segments, update->entries.size()) ||
+                    !algo->decrypt(update->last_data, key, last_config).success) {
+                    result.error_message = "Existing stream does not authenticate (wrong password?)";
+                    return result;
+                }
+            }
+            
+            // Write header (serialized first so record offsets are known on pipes too)
+            std::ostringstream header;
+            // Content-defined chunk counts are only known at the end (footer)
+            if (!write_stream_header(header, config, salt, base_nonce, known_size.value_or(0),
+                                     content_defined ? 0 : chunk_count, flags)) {
+                result.error_message = "Failed to write stream header";
+                return result;
+            }
+            std::string header_bytes = header.str();
+            header_bytes.resize(header_bytes.size() + record_padding(header_bytes.size(), flags), '\0');
+            output.write(header_bytes.data(), header_bytes.size());
+            if (!output) {
+                result.error_message = "Failed to write stream header";
+                return result;
+            }
+            record_offset = header_bytes.size();
+        }
+        
+        // Compressors and keyed cipher contexts are leased per chunk, so workers
+        // reuse codec state and key schedules
+        std::optional<compression::CompressorPool> compressors;
+        if (config.compression != CompressionType::NONE) {
+            compressors.emplace(config.compression);
+        }
+        CipherContextPool ciphers(*algo, key);
+        std::atomic<size_t> chunks_compressed{0};
+        std::atomic<size_t> chunks_skipped{0};
+        
+        // Segment the writer is in, and the segment new chunks are encrypted in:
+        // a fresh one for appends and updates, otherwise the stream's first
+        StreamSegment current = segments.empty() ? binding.first_segment() : segments.back();
+        const std::vector<uint8_t> chunk_segment = resume && !resume->segment_id.empty() ? resume->segment_id :
+                                                   update ? update->update_segment : current.base_nonce;
+        // Last segment of the stream being updated: its final record is still valid after it
+        const StreamSegment update_head = update && !update->segments.empty() ? update->segments.back() :
+                                          binding.first_segment();
+        
+        auto seal = [&](ChunkJob& job) {
+            EncryptionConfig chunk_config = enc_config;
+            binding.apply(chunk_config, job.segment_id, job.nonce_index, job.last, job.compressed);
+            
+            // Encrypted in place: the chunk buffer becomes the record payload
+            job.tag.resize(16);
+            auto written = ciphers.acquire()->encrypt_into(job.data, job.data, job.tag, chunk_config);
+            if (!written.success) {
+                job.success = false;
+                job.error_message = written.error_message;
+                return;
+            }
+            job.data.resize(written.value);
+        };
+        
+        // Per-chunk transform: compress (if enabled and worthwhile) then encrypt.
+        // Runs on worker threads, so it only touches its own job and
+        // thread-safe shared state (binding, cipher and compressor pools).
+        auto transform = [&](ChunkJob& job) {
+            job.compressed = false;
+            job.unchanged = false;
+            job.segment_id = chunk_segment;
+            job.nonce_index = job.index;
+            if (!digest_key.empty()) {
+                job.digest = chunk_digest(digest_key, content_defined ? 0 : job.index, job.data);
+            }
+            
+            // Delta update: a chunk with the same digest keeps its old record.
+            // Content-defined chunks may have moved; their record is found by digest.
+            // The final record is bound to the segments before it: it stays final and
+            // in place, and the writer re-encrypts it if those segments changed.
+            if (update) {
+                size_t source = job.index;
+                if (content_defined) {
+                    auto found = update->by_digest.find(job.digest);
+                    source = found != update->by_digest.end() ? found->second : update->entries.size();
+                }
+                const bool reusable = job.last ? source + 1 == update->entries.size() && source == job.index
+                                               : source + 1 < update->entries.size();
+                if (reusable) {
+                    const auto& previous = update->entries[source];
+                    if (previous.digest == job.digest && previous.plain_size == job.plain_size) {
+                        const StreamSegment& segment = segment_for(update->segments, binding.first_segment(), source);
+                        job.unchanged = true;
+                        job.source_index = source;
+                        job.segment_id = segment.base_nonce;
+                        job.nonce_index = segment.first_index + (source - segment.first_chunk);
+                        return;
+                    }
+                }
+            }
+            
+            if (compressors) {
+                if (config.skip_incompressible &&
+                    compression::CompressionService::is_likely_incompressible(job.data)) {
+                    chunks_skipped.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    auto compressor = compressors->acquire();
+                    auto comp_result = compressor->compress(job.data, config.compression_level);
+                    if (comp_result.success && comp_result.data.size() < job.data.size()) {
+                        job.data = std::move(comp_result.data);
+                        job.compressed = true;
+                        chunks_compressed.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            }
+            
+            // The writer seals the final chunk once every segment before it is known
+            if (!job.last) {
+                seal(job);
+            }
+        };
+        
+        size_t threads = resolve_thread_count(config.threads);
+        size_t slots = ChunkPipeline::slots_for_budget(chunk_size, config.max_in_flight_bytes, threads);
+        auto memory = reserve_pipeline(chunk_size, config.compression, config.compression_level,
+                                       false, slots, threads);
+        ChunkPipeline pipeline(threads, slots, transform);
+        
+        bool input_done = false;
+        size_t next_index = resume ? static_cast<size_t>(resume->checkpoint.next_chunk) : 0;
+        const uint64_t bytes_before = resume ? resume->checkpoint.input_offset : 0;
+        uint64_t bytes_read = bytes_before;
+        uint64_t bytes_processed = bytes_before;
+        size_t chunks_since_checkpoint = 0;
+        const size_t total_bytes = static_cast<size_t>(known_size.value_or(0));
+        
+        // Content-defined chunking looks up to chunk_size bytes ahead for a cut.
+        // Read-ahead lives in [window_begin, window.size()); the buffer holds two
+        // maximal chunks so the tail is moved to the front at most once per chunk_size.
+        std::vector<uint8_t> window;
+        size_t window_begin = 0;
+        bool source_done = false;
+        auto next_content_defined = [&](ChunkJob& job) {
+            if (!source_done && window.size() - window_begin < chunk_size) {
+                if (window_begin >= chunk_size) {
+                    window.erase(window.begin(), window.begin() + static_cast<std::ptrdiff_t>(window_begin));
+                    window_begin = 0;
+                }
+                size_t have = window.size();
+                size_t wanted = chunk_size - (have - window_begin);
+                window.resize(have + wanted);
+                source->read(reinterpret_cast<char*>(window.data() + have), static_cast<std::streamsize>(wanted));
+                if (source->bad()) {
+                    throw std::runtime_error("Failed to read input chunk " + std::to_string(job.index));
+                }
+                window.resize(have + static_cast<size_t>(source->gcount()));
+                source_done = static_cast<size_t>(source->gcount()) < wanted;
+            }
+            
+            size_t cut = chunker->cut_point(window.data() + window_begin, window.size() - window_begin);
+            job.data.assign(window.begin() + static_cast<std::ptrdiff_t>(window_begin),
+                            window.begin() + static_cast<std::ptrdiff_t>(window_begin + cut));
+            window_begin += cut;
+            if (window_begin == window.size() && !source_done) {
+                source_done = source->peek() == std::char_traits<char>::eof();
+            }
+            job.plain_size = cut;
+            job.last = source_done && window_begin == window.size();
+        };
+        
+        // Read stage (calling thread): fill a recycled buffer with the next chunk.
+        // The input length may be unknown, so the last chunk is found by lookahead.
+        auto read_chunk = [&](ChunkJob& job) -> bool {
+            if (input_done) {
+                return false;
+            }
+            
+            // Nonces and footer counts carry 32-bit chunk indices; inputs of unknown
+            // length are only stopped here
+            if (next_index >= MAX_CHUNKS) {
+                throw std::runtime_error("Stream exceeds " + std::to_string(MAX_CHUNKS) +
+                                         " chunks; use a larger chunk size");
+            }
+            job.index = next_index++;
+            if (chunker) {
+                next_content_defined(job);
+                input_done = job.last;
+                bytes_read += job.plain_size;
+                return true;
+            }
+            job.data.resize(chunk_size);
+            source->read(reinterpret_cast<char*>(job.data.data()), chunk_size);
+            if (source->bad()) {
+                throw std::runtime_error("Failed to read input chunk " + std::to_string(job.index));
+            }
+            
+            job.plain_size = static_cast<size_t>(source->gcount());
+            job.data.resize(job.plain_size);
+            job.last = job.plain_size < chunk_size ||
+                       source->peek() == std::char_traits<char>::eof();
+            input_done = job.last;
+            bytes_read += job.plain_size;
+            return true;
+        };
+        
+        // Write stage (writer thread): [4 bytes size|last flag][data][16 bytes tag][padding] in index order
+        static const char zero_padding[RECORD_ALIGNMENT] = {};
+        std::vector<uint8_t> copied;
+        auto write_chunk = [&](ChunkJob& job) {
+            if (job.last && job.unchanged &&
+                (job.segment_id != current.base_nonce ||
+                 job.nonce_index + current.first_chunk != current.first_index + job.index ||
+                 current.base_nonce != update_head.base_nonce || current.tag != update_head.tag)) {
+                job.unchanged = false;
+                job.segment_id = chunk_segment;
+                job.nonce_index = job.index;
+            }
+            
+            // Segment marker [RECORD_SEGMENT][segment][padding] wherever the record's
+            // segment, or the offset of its nonce index, changes
+            if (job.segment_id != current.base_nonce ||
+                job.nonce_index + current.first_chunk != current.first_index + job.index) {
+                StreamSegment segment{job.index, job.segment_id, job.nonce_index};
+                binding.seal(segment, current);
+                const uint32_t marker = RECORD_SEGMENT;
+                record_offset += 4 + segment_size(STREAM_VERSION, segment.base_nonce.size());
+                size_t padding = record_padding(record_offset, flags);
+                record_offset += padding;
+                output.write(reinterpret_cast<const char*>(&marker), 4);
+                write_segment(output, segment);
+                output.write(zero_padding, static_cast<std::streamsize>(padding));
+                segments.push_back(segment);
+                current = std::move(segment);
+            }
+            if (job.last && !job.unchanged) {
+                job.segment_id = binding.final_id(current);
+                seal(job);
+                if (!job.success) {
+                    throw std::runtime_error("Failed to encrypt chunk " + std::to_string(job.index) + ": " +
+                                             job.error_message);
+                }
+            }
+            
+            // Unchanged chunks: the previous record as-is ([size field][data][tag])
+            if (job.unchanged) {
+                uint32_t enc_size = 0;
+                update->previous->seekg(static_cast<std::streamoff>(update->entries[job.source_index].offset));
+                update->previous->read(reinterpret_cast<char*>(&enc_size), 4);
+                copied.resize(4 + (enc_size & ~(RECORD_LAST_CHUNK | RECORD_COMPRESSED)) + 16);
+                std::memcpy(copied.data(), &enc_size, 4);
+                update->previous->read(reinterpret_cast<char*>(copied.data() + 4), copied.size() - 4);
+                if (!*update->previous) {
+                    throw std::runtime_error("Failed to read previous chunk " + std::to_string(job.index));
+                }
+                result.chunks_unchanged++;
+            }
+            
+            index_entries.push_back({record_offset, static_cast<uint32_t>(job.plain_size), job.digest});
+            if (on_checkpoint && !digest_key.empty()) {
+                chain_digest(job.index, job.digest);
+            }
+            record_offset += job.unchanged ? copied.size() : 4 + job.data.size() + job.tag.size();
+            size_t padding = record_padding(record_offset, flags);
+            record_offset += padding;
+            
+            if (job.unchanged) {
+                output.write(reinterpret_cast<const char*>(copied.data()), copied.size());
+            } else {
+                uint32_t enc_size = static_cast<uint32_t>(job.data.size());
+                if (job.last) {
+                    enc_size |= RECORD_LAST_CHUNK;
+                }
+                if (job.compressed) {
+                    enc_size |= RECORD_COMPRESSED;
+                }
+                output.write(reinterpret_cast<const char*>(&enc_size), 4);
+                output.write(reinterpret_cast<const char*>(job.data.data()), job.data.size());
+                output.write(reinterpret_cast<const char*>(job.tag.data()), job.tag.size());
+            }
+            output.write(zero_padding, static_cast<std::streamsize>(padding));
+            
+            if (!output) {
+                throw std::runtime_error("Failed to write output chunk " + std::to_string(job.index));
+            }
+            
+            bytes_processed += job.plain_size;
+            result.chunks_processed++;
+            
+            // The final record is followed by the footer; completion removes the journal instead
+            if (on_checkpoint && !job.last && ++chunks_since_checkpoint >= config.checkpoint_interval) {
+                if (!output.flush()) {
+                    throw std::runtime_error("Failed to write output chunk " + std::to_string(job.index));
+                }
+                on_checkpoint({job.index + 1, record_offset, bytes_processed, kept_digest}, base_nonce);
+                chunks_since_checkpoint = 0;
+            }
+            
+            // Progress callback
+            if (config.progress_callback) {
+                ChunkInfo info{job.index, job.plain_size, chunk_count, bytes_processed, total_bytes};
+                if (!config.progress_callback(info)) {
+                    throw std::runtime_error("Operation cancelled by user");
+                }
+            }
+        };
+        
+        auto run_result = pipeline.run(read_chunk, write_chunk);
+        if (!run_result) {
+            result.error_message = "Encryption failed: " + run_result.error_message;
+            return result;
+        }
+        
+        // The header already promised a size; a file that changed underneath us is an error
+        if (known_size && bytes_read != *known_size) {
+            result.error_message = "Input changed size during encryption";
             return result;
         }
         
+        if (!write_chunk_index(output, index_entries, record_offset, flags, segments)) {
+            result.error_message = "Failed to write chunk index";
+            return result;
+        }
+        if (!output.flush()) {
+            result.error_message = "Failed to write output";
+            return result;
+        }
+        
+        if (compressors) {
+            spdlog::debug("Compression: {} chunks compressed, {} skipped by entropy probe, {} stored",
+                          chunks_compressed.load(), chunks_skipped.load(),
+                          result.chunks_processed - chunks_compressed.load() - chunks_skipped.load());
+        }
+        
+        result.bytes_processed = bytes_processed - bytes_before;
+        result.success = true;
+        
+    } catch (const std::exception& e) {
+        result.error_message = std::string("Streaming encryption failed: ") + e.what();
+        return result;
+    }
+    
+    auto end_time = std::chrono::high_resolution_clock::now();
+    result.processing_time_ms = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+    result.throughput_mbps = (result.bytes_processed / 1024.0 / 1024.0) / (result.processing_time_ms / 1000.0);
+    
+    spdlog::info("Streaming encryption completed: {} chunks, {:.2f} MB/s", 
+                 result.chunks_processed, result.throughput_mbps);
+    
+    return result;
+}
+
+StreamingResult StreamingCrypto::decrypt_file(
+    const std::string& input_path,
+    const std::string& output_path,
+    const std::string& password,
+    StreamProgressCallback progress_callback
+) {
+    StreamingConfig options;
+    options.progress_callback = std::move(progress_callback);
+    return decrypt_file(input_path, output_path, password, options);
+}
+
+StreamingResult StreamingCrypto::decrypt_file(
+    const std::string& input_path,
+    const std::string& output_path,
+    const std::string& password,
+    const StreamingConfig& options
+) {
+    IOOptions io_options;
+    io_options.backend = options.io_backend;
+    io_options.direct = options.direct_io;
+    io_options.cache = options.cache_policy;
+    
+    // Open input file
+    auto reader = IOBackend::open_reader(input_path, io_options);
+    if (!reader) {
+        StreamingResult result;
+        result.error_message = reader.error_message;
+        return result;
+    }
+    
+    // Open output file
+    auto writer = IOBackend::open_writer(output_path, io_options);
+    if (!writer) {
+        StreamingResult result;
+        result.error_message = writer.error_message;
+        return result;
+    }
+    
+    ReaderStreamBuf input_buf(*reader.value);
+    WriterStreamBuf output_buf(*writer.value);
+    std::istream input(&input_buf);
+    std::ostream output(&output_buf);
+    
+    return decrypt_stream(input, output, password, options);
+}
+
+StreamingResult StreamingCrypto::verify_file(
+    const std::string& input_path,
+    const std::string& password,
+    const StreamingConfig& options
+) {
+    IOOptions io_options;
+    io_options.backend = options.io_backend;
+    io_options.direct = options.direct_io;
+    io_options.cache = options.cache_policy;
+    
+    auto reader = IOBackend::open_reader(input_path, io_options);
+    if (!reader) {
+        StreamingResult result;
+        result.error_message = reader.error_message;
+        return result;
+    }
+    
+    ReaderStreamBuf input_buf(*reader.value);
+    std::istream input(&input_buf);
+    
+    return decrypt_impl(input, nullptr, password, options);
+}
+
+StreamingResult StreamingCrypto::decrypt_stream(
+    std::istream& input,
+    std::ostream& output,
+    const std::string& password,
+    const StreamingConfig& options
+) {
+    return decrypt_impl(input, &output, password, options);
+}
+
+StreamingResult StreamingCrypto::decrypt_impl(
+    std::istream& input,
+    std::ostream* output,
+    const std::string& password,
+    const StreamingConfig& options
+) {
+    StreamingResult result;
+    const bool verify_only = output == nullptr;
+    auto start_time = std::chrono::high_resolution_clock::now();
+    
+    try {
         // Read header
         StreamingConfig config;
         std::vector<uint8_t> salt, base_nonce;
         size_t original_size, chunk_count;
+        uint8_t flags, version;
         
-        if (!read_stream_header(input, config, salt, base_nonce, original_size, chunk_count)) {
+        if (!read_stream_header(input, config, salt, base_nonce, original_size, chunk_count, flags, version)) {
             result.error_message = "Failed to read stream header";
             return result;
         }
         
-        spdlog::info("Streaming decryption: {} chunks, {} bytes original", chunk_count, original_size);
+        const bool end_marker = (flags & FLAG_END_MARKER) != 0;
+        const bool size_known = (flags & FLAG_SIZE_UNKNOWN) == 0;
+        const bool chunk_flags = (flags & FLAG_CHUNK_COMPRESSION) != 0;
+        const bool segmented = (flags & FLAG_SEGMENTS) != 0;
+        
+        // Skip header padding of the aligned layout (magic through nonce: 32 bytes + salt + nonce)
+        uint64_t record_offset = 32 + salt.size() + base_nonce.size();
+        size_t header_padding = record_padding(record_offset, flags);
+        if (header_padding > 0 && !input.ignore(static_cast<std::streamsize>(header_padding))) {
+            result.error_message = "Failed to read stream header";
+            return result;
+        }
+        record_offset += header_padding;
+        
+        if (size_known) {
+            spdlog::info("Streaming decryption: {} chunks, {} bytes original", chunk_count, original_size);
+        } else {
+            spdlog::info("Streaming decryption: stream of unknown length");
+        }
         
         // Initialize crypto engine
         CryptoEngine engine;
@@ -410,68 +2059,198 @@ StreamingResult StreamingCrypto::decrypt_file(
             return result;
         }
         
-        // Open output file
-        std::ofstream output(output_path, std::ios::binary);
-        if (!output) {
-            result.error_message = "Failed to create output file: " + output_path;
-            return result;
+        const RecordBinding binding(version, key, config, flags, salt, base_nonce);
+        StreamSegment current = binding.first_segment();
+        
+        std::optional<compression::CompressorPool> decompressors;
+        if (config.compression != CompressionType::NONE) {
+            decompressors.emplace(config.compression);
         }
+        CipherContextPool ciphers(*algo, key);
         
-        // Process chunks
-        size_t bytes_processed = 0;
+        // Per-chunk transform: decrypt then decompress (if the record says so)
+        auto transform = [&](ChunkJob& job) {
+            EncryptionConfig chunk_config = enc_config;
+            binding.apply(chunk_config, job.segment_id, job.nonce_index, job.last, job.compressed);
+            chunk_config.tag = job.tag;
+            
+            auto read = ciphers.acquire()->decrypt_into(job.data, job.data, chunk_config);
+            if (!read.success) {
+                // Verification hands failures to the writer, which sees them in stream
+                // order and reports the first one
+                job.success = verify_only;
+                job.error_message = read.error_message.empty()
+                    ? "Authentication failed" : read.error_message;
+                return;
+            }
+            
+            job.data.resize(read.value);
+            if (verify_only) {
+                // The tag covers the stored payload; decompressing it proves nothing more
+                return;
+            }
+            if (chunk_flags ? job.compressed : decompressors.has_value()) {
+                if (!decompressors) {
+                    job.success = false;
+                    job.error_message = "Compressed chunk in an uncompressed stream";
+                    return;
+                }
+                auto decompressor = decompressors->acquire();
+                auto decomp_result = decompressor->decompress(job.data);
+                if (decomp_result.success) {
+                    job.data = std::move(decomp_result.data);
+                } else if (chunk_flags) {
+                    job.success = false;
+                    job.error_message = "Decompression failed: " + decomp_result.error_message;
+                    return;
+                }
+                // Streams without per-chunk flags kept chunks that did not shrink as-is
+            }
+            job.plain_size = job.data.size();
+        };
         
-        for (size_t i = 0; i < chunk_count; ++i) {
+        size_t threads = resolve_thread_count(options.threads);
+        size_t slots = ChunkPipeline::slots_for_budget(config.chunk_size, options.max_in_flight_bytes, threads);
+        // The header does not record the compression level; assume the largest decoder
+        auto memory = reserve_pipeline(config.chunk_size, verify_only ? CompressionType::NONE : config.compression,
+                                       9, true, slots, threads);
+        ChunkPipeline pipeline(threads, slots, transform);
+        
+        // Upper bound for a single record; guards against corrupted size fields
+        const size_t max_record_size = config.chunk_size + 1024;
+        bool input_done = false;
+        size_t next_index = 0;
+        uint64_t read_offset = record_offset;   // Record being read, reported when it is unreadable
+        uint64_t bytes_processed = 0;
+        
+        // Read stage (calling thread): read one encrypted record into a recycled buffer.
+        // Streams with end markers stop at the flagged record; older streams use the header count.
+        auto read_chunk = [&](ChunkJob& job) -> bool {
+            if (input_done || (!end_marker && next_index >= chunk_count)) {
+                return false;
+            }
+            job.index = next_index++;
+            job.offset = read_offset = record_offset;
+            
             // Read encrypted chunk size
             uint32_t enc_size;
             input.read(reinterpret_cast<char*>(&enc_size), 4);
+            if (!input) {
+                throw std::runtime_error("Truncated stream: chunk " + std::to_string(job.index) + " missing");
+            }
+            
+            // Segment markers switch the segment of the records that follow
+            while (segmented && enc_size == RECORD_SEGMENT) {
+                StreamSegment segment;
+                segment.first_chunk = job.index;
+                read_segment(input, segment, version, base_nonce.size());
+                if (input && !binding.check(segment, current)) {
+                    throw std::runtime_error("Segment marker before chunk " + std::to_string(job.index) +
+                                             " does not authenticate");
+                }
+                current = std::move(segment);
+                record_offset += 4 + segment_size(version, base_nonce.size());
+                size_t padding = record_padding(record_offset, flags);
+                record_offset += padding;
+                input.ignore(static_cast<std::streamsize>(padding));
+                input.read(reinterpret_cast<char*>(&enc_size), 4);
+                if (!input) {
+                    throw std::runtime_error("Truncated stream: chunk " + std::to_string(job.index) + " missing");
+                }
+            }
+            job.offset = read_offset = record_offset;
+            
+            if (end_marker) {
+                job.last = (enc_size & RECORD_LAST_CHUNK) != 0;
+                enc_size &= ~RECORD_LAST_CHUNK;
+                input_done = job.last;
+            }
+            // The final record's id is derived from the last segment tag
+            job.segment_id = job.last ? binding.final_id(current) : current.base_nonce;
+            job.nonce_index = current.first_index + (job.index - current.first_chunk);
+            job.compressed = false;
+            if (chunk_flags) {
+                job.compressed = (enc_size & RECORD_COMPRESSED) != 0;
+                enc_size &= ~RECORD_COMPRESSED;
+            }
+            if (enc_size > max_record_size) {
+                throw std::runtime_error("Corrupted chunk " + std::to_string(job.index));
+            }
             
             // Read encrypted data
-            std::vector<uint8_t> encrypted(enc_size);
-            input.read(reinterpret_cast<char*>(encrypted.data()), enc_size);
+            job.data.resize(enc_size);
+            input.read(reinterpret_cast<char*>(job.data.data()), enc_size);
             
             // Read tag (16 bytes for GCM)
-            std::vector<uint8_t> tag(16);
-            input.read(reinterpret_cast<char*>(tag.data()), 16);
+            job.tag.resize(16);
+            input.read(reinterpret_cast<char*>(job.tag.data()), 16);
             
-            // Generate chunk-specific nonce
-            auto chunk_nonce = derive_chunk_nonce(base_nonce, i);
-            enc_config.nonce = chunk_nonce;
-            enc_config.tag = tag;
-            
-            // Decrypt chunk
-            auto dec_result = algo->decrypt(encrypted, key, enc_config);
-            if (!dec_result.success) {
-                result.error_message = "Decryption failed at chunk " + std::to_string(i) + 
-                                       ": " + dec_result.error_message;
-                return result;
+            // Skip record padding of the aligned layout
+            record_offset += 4 + uint64_t(enc_size) + 16;
+            size_t padding = record_padding(record_offset, flags);
+            record_offset += padding;
+            if (padding > 0) {
+                input.ignore(static_cast<std::streamsize>(padding));
             }
             
-            // Decompress if needed
-            std::vector<uint8_t> plaintext = std::move(dec_result.data);
-            if (config.compression != CompressionType::NONE) {
-                auto decompressor = compression::CompressionService::create(config.compression);
-                if (decompressor) {
-                    auto decomp_result = decompressor->decompress(plaintext);
-                    if (decomp_result.success) {
-                        plaintext = std::move(decomp_result.data);
-                    }
+            if (!input) {
+                throw std::runtime_error("Truncated chunk " + std::to_string(job.index));
+            }
+            return true;
+        };
+        
+        // Write stage (writer thread): plaintext in index order
+        auto write_chunk = [&](ChunkJob& job) {
+            if (verify_only) {
+                if (!job.error_message.empty()) {
+                    result.bad_chunk = job.index;
+                    result.bad_offset = job.offset;
+                    throw std::runtime_error("chunk " + std::to_string(job.index) + ": " + job.error_message);
+                }
+            } else {
+                output->write(reinterpret_cast<const char*>(job.data.data()), job.data.size());
+                if (!*output) {
+                    throw std::runtime_error("Failed to write output chunk " + std::to_string(job.index));
                 }
             }
             
-            // Write decrypted data
-            output.write(reinterpret_cast<const char*>(plaintext.data()), plaintext.size());
-            
-            bytes_processed += plaintext.size();
+            bytes_processed += job.data.size();
             result.chunks_processed++;
             
             // Progress callback
-            if (progress_callback) {
-                ChunkInfo info{i, plaintext.size(), chunk_count, bytes_processed, original_size};
-                if (!progress_callback(info)) {
-                    result.error_message = "Operation cancelled by user";
-                    return result;
+            if (options.progress_callback) {
+                ChunkInfo info{job.index, job.data.size(), chunk_count, bytes_processed, original_size};
+                if (!options.progress_callback(info)) {
+                    throw std::runtime_error("Operation cancelled by user");
+                }
+            }
+        };
+        
+        auto run_result = pipeline.run(read_chunk, write_chunk);
+        if (!run_result) {
+            if (verify_only) {
+                if (!result.bad_chunk) {
+                    // The record after the last verified one could not be read
+                    result.bad_chunk = next_index > 0 ? next_index - 1 : 0;
+                    result.bad_offset = read_offset;
                 }
+                result.error_message = "Verification failed: " + run_result.error_message;
+                return result;
             }
+            result.error_message = "Decryption failed: " + run_result.error_message;
+            return result;
+        }
+        if (output && !output->flush()) {
+            result.error_message = "Failed to write output";
+            return result;
+        }
+        
+        // Verification counts stored (possibly compressed) bytes, so only the chunk count is checked
+        const bool count_known = size_known && (flags & FLAG_CONTENT_DEFINED) == 0;
+        if ((count_known && result.chunks_processed != chunk_count) ||
+            (!verify_only && size_known && bytes_processed != original_size)) {
+            result.error_message = "Stream length does not match header";
+            return result;
         }
         
         result.bytes_processed = bytes_processed;
@@ -0,0 +1,347 @@
+/**
+ * @file streaming_reader.cpp
+ * @brief Random-access reader for FVST streaming files
+ */
+
+#include "filevault/core/streaming_reader.hpp"
+#include "filevault/compression/compressor.hpp"
+#include <botan/mem_ops.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+
+namespace filevault {
+namespace core {
+
+StreamingReader::StreamingReader(size_t cache_chunks)
+    : cache_capacity_((std::max)(cache_chunks, size_t(1))) {
+}
+
+StreamingReader::~StreamingReader() {
+    close();
+}
+
+Result<void> StreamingReader::open(const std::string& path, const std::string& password) {
+    close();
+
+    file_.open(path, std::ios::binary);
+    if (!file_) {
+        return Result<void>::error("Failed to open input file: " + path);
+    }
+
+    StreamingConfig config;
+    std::vector<uint8_t> salt;
+    size_t original_size = 0;
+    size_t chunk_count = 0;
+    uint8_t flags = 0;
+
+    if (!StreamingCrypto::read_stream_header(file_, config, salt, base_nonce_,
+                                             original_size, chunk_count, flags, version_)) {
+        close();
+        return Result<void>::error("Failed to read stream header");
+    }
+    uint64_t data_start = static_cast<uint64_t>(file_.tellg());
+    data_start += StreamingCrypto::record_padding(data_start, flags);
+
+    chunk_size_ = config.chunk_size;
+    compression_ = config.compression;
+    total_size_ = original_size;
+    end_marker_ = (flags & StreamingCrypto::FLAG_END_MARKER) != 0;
+    flags_ = flags;
+    const bool size_known = (flags & StreamingCrypto::FLAG_SIZE_UNKNOWN) == 0;
+
+    // Locate chunk records
+    has_footer_ = (flags & StreamingCrypto::FLAG_CHUNK_INDEX) != 0 &&
+                  StreamingCrypto::read_chunk_index(file_, size_known ? chunk_count : 0, index_,
+                                                    flags, version_, base_nonce_.size(), &segments_);
+    if (!has_footer_) {
+        if (!size_known) {
+            close();
+            return Result<void>::error("Stream of unknown length has no chunk index");
+        }
+        // Chunk lengths vary, so records cannot be located without the footer
+        if (flags & StreamingCrypto::FLAG_CONTENT_DEFINED) {
+            close();
+            return Result<void>::error("Content-defined stream has no chunk index");
+        }
+        file_.clear();
+        auto scan = build_index_by_scan(data_start);
+        if (!scan) {
+            close();
+            return scan;
+        }
+    }
+
+    plain_offsets_.resize(index_.size() + 1);
+    plain_offsets_[0] = 0;
+    for (size_t i = 0; i < index_.size(); ++i) {
+        plain_offsets_[i + 1] = plain_offsets_[i] + index_[i].plain_size;
+    }
+    if (!size_known) {
+        total_size_ = plain_offsets_.back();
+    } else if (plain_offsets_.back() != total_size_) {
+        close();
+        return Result<void>::error("Chunk index does not match stream size");
+    }
+
+    // Derive key (same parameters as StreamingCrypto::decrypt_file)
+    engine_ = std::make_unique<CryptoEngine>();
+    engine_->initialize();
+
+    enc_config_.algorithm = config.algorithm;
+    enc_config_.kdf = config.kdf;
+    enc_config_.level = config.level;
+    enc_config_.apply_security_level();
+
+    algorithm_ = engine_->get_algorithm(config.algorithm);
+    if (!algorithm_) {
+        close();
+        return Result<void>::error("Algorithm not available");
+    }
+
+    // Every chunk is decrypted under the same key; key the cipher once
+    auto key = engine_->derive_key(password, salt, enc_config_);
+    cipher_ = algorithm_->make_context(key);
+    binding_.emplace(version_, key, config, flags, salt, base_nonce_);
+    Botan::secure_scrub_memory(key.data(), key.size());
+    position_ = 0;
+
+    // Chunks are only located through the segment table, so it has to be the
+    // one that was written: its entries are chained, and the final record is
+    // bound to the last of them (which also catches a truncated table)
+    if (!binding_->check(segments_, index_.size())) {
+        close();
+        return Result<void>::error("Segment table does not authenticate");
+    }
+    if (version_ >= 3 && !index_.empty()) {
+        auto last = decrypt_chunk(index_.size() - 1);
+        if (!last) {
+            auto error = last.error_message;
+            close();
+            return Result<void>::error(error);
+        }
+        Botan::secure_scrub_memory(last.value.data(), last.value.size());
+    }
+
+    spdlog::debug("Opened {} for random access: {} chunks, index {}",
+                  path, index_.size(), has_footer_ ? "from footer" : "from scan");
+    return Result<void>::ok();
+}
+
+void StreamingReader::close() {
+    for (auto& entry : cache_) {
+        Botan::secure_scrub_memory(entry.second.data(), entry.second.size());
+    }
+
+    cipher_.reset();
+    binding_.reset();
+    cache_.clear();
+    cache_map_.clear();
+    index_.clear();
+    segments_.clear();
+    plain_offsets_.clear();
+    algorithm_ = nullptr;
+    engine_.reset();
+    total_size_ = 0;
+    position_ = 0;
+    has_footer_ = false;
+    end_marker_ = false;
+    flags_ = 0;
+    version_ = 0;
+
+    if (file_.is_open()) {
+        file_.close();
+    }
+    file_.clear();
+}
+
+Result<void> StreamingReader::build_index_by_scan(uint64_t data_start) {
+    // Every chunk except the last holds exactly chunk_size plaintext bytes
+    size_t chunk_count = chunk_size_ == 0 ? 0 : (total_size_ + chunk_size_ - 1) / chunk_size_;
+    if (end_marker_) {
+        chunk_count = (std::max)(chunk_count, size_t(1));  // Empty streams have one empty chunk
+    }
+    index_.clear();
+    index_.reserve(chunk_count);
+    segments_.clear();
+
+    uint64_t offset = data_start;
+    for (size_t i = 0; i < chunk_count; ++i) {
+        uint32_t enc_size;
+        file_.seekg(static_cast<std::streamoff>(offset));
+        file_.read(reinterpret_cast<char*>(&enc_size), 4);
+        while (file_ && (flags_ & StreamingCrypto::FLAG_SEGMENTS) &&
+               enc_size == StreamingCrypto::RECORD_SEGMENT) {
+            StreamSegment segment;
+            segment.first_chunk = i;
+            StreamingCrypto::read_segment(file_, segment, version_, base_nonce_.size());
+            segments_.push_back(std::move(segment));
+            offset += 4 + StreamingCrypto::segment_size(version_, base_nonce_.size());
+            offset += StreamingCrypto::record_padding(offset, flags_);
+            file_.seekg(static_cast<std::streamoff>(offset));
+            file_.read(reinterpret_cast<char*>(&enc_size), 4);
+        }
+        if (end_marker_) {
+            enc_size &= ~StreamingCrypto::RECORD_LAST_CHUNK;
+        }
+        if (flags_ & StreamingCrypto::FLAG_CHUNK_COMPRESSION) {
+            enc_size &= ~StreamingCrypto::RECORD_COMPRESSED;
+        }
+        if (!file_ || enc_size > chunk_size_ + 1024) {
+            return Result<void>::error("Corrupted or truncated chunk " + std::to_string(i));
+        }
+
+        uint64_t plain = (std::min)(uint64_t(chunk_size_), total_size_ - uint64_t(i) * chunk_size_);
+        index_.push_back({offset, static_cast<uint32_t>(plain)});
+        offset += 4 + uint64_t(enc_size) + 16;
+        offset += StreamingCrypto::record_padding(offset, flags_);
+    }
+
+    return Result<void>::ok();
+}
+
+size_t StreamingReader::chunk_for_offset(uint64_t offset) const {
+    // First chunk whose end lies beyond offset
+    auto it = std::upper_bound(plain_offsets_.begin() + 1, plain_offsets_.end(), offset);
+    return static_cast<size_t>(it - (plain_offsets_.begin() + 1));
+}
+
+Result<const std::vector<uint8_t>*> StreamingReader::load_chunk(size_t index) {
+    auto cached = cache_map_.find(index);
+    if (cached != cache_map_.end()) {
+        ++cache_hits_;
+        cache_.splice(cache_.begin(), cache_, cached->second);
+        return Result<const std::vector<uint8_t>*>::ok(&cached->second->second);
+    }
+    ++cache_misses_;
+
+    auto plaintext = decrypt_chunk(index);
+    if (!plaintext) {
+        return Result<const std::vector<uint8_t>*>::error(plaintext.error_message);
+    }
+
+    // Insert as most recently used, evicting the least recently used chunk
+    if (cache_.size() >= cache_capacity_) {
+        auto& victim = cache_.back();
+        Botan::secure_scrub_memory(victim.second.data(), victim.second.size());
+        cache_map_.erase(victim.first);
+        cache_.pop_back();
+    }
+    cache_.emplace_front(index, std::move(plaintext.value));
+    cache_map_[index] = cache_.begin();
+
+    return Result<const std::vector<uint8_t>*>::ok(&cache_.front().second);
+}
+
+Result<std::vector<uint8_t>> StreamingReader::decrypt_chunk(size_t index) {
+    // Read record: [4 bytes size][data][16 bytes tag]
+    const auto& entry = index_[index];
+    uint32_t enc_size;
+    file_.clear();
+    file_.seekg(static_cast<std::streamoff>(entry.offset));
+    file_.read(reinterpret_cast<char*>(&enc_size), 4);
+    if (end_marker_) {
+        enc_size &= ~StreamingCrypto::RECORD_LAST_CHUNK;
+    }
+    // Streams without per-chunk flags try to decompress every chunk
+    bool compressed = compression_ != CompressionType::NONE;
+    if (flags_ & StreamingCrypto::FLAG_CHUNK_COMPRESSION) {
+        compressed = (enc_size & StreamingCrypto::RECORD_COMPRESSED) != 0;
+        enc_size &= ~StreamingCrypto::RECORD_COMPRESSED;
+    }
+    if (!file_ || enc_size > chunk_size_ + 1024) {
+        return Result<std::vector<uint8_t>>::error(
+            "Corrupted or truncated chunk " + std::to_string(index));
+    }
+
+    std::vector<uint8_t> data(enc_size);
+    std::vector<uint8_t> tag(16);
+    file_.read(reinterpret_cast<char*>(data.data()), enc_size);
+    file_.read(reinterpret_cast<char*>(tag.data()), 16);
+    if (!file_) {
+        return Result<std::vector<uint8_t>>::error("Truncated chunk " + std::to_string(index));
+    }
+
+    EncryptionConfig chunk_config = enc_config_;
+    bool last = end_marker_ && index + 1 == index_.size();
+    binding_->apply(chunk_config, segments_, index, last,
+                    compressed && (flags_ & StreamingCrypto::FLAG_CHUNK_COMPRESSION));
+    chunk_config.tag = tag;
+
+    auto read = cipher_->decrypt_into(data, data, chunk_config);
+    if (!read.success) {
+        return Result<std::vector<uint8_t>>::error(
+            "Decryption failed at chunk " + std::to_string(index) + ": " + read.error_message);
+    }
+
+    data.resize(read.value);
+    std::vector<uint8_t> plaintext = std::move(data);
+    if (compressed) {
+        if (compression_ == CompressionType::NONE) {
+            return Result<std::vector<uint8_t>>::error(
+                "Compressed chunk " + std::to_string(index) + " in an uncompressed stream");
+        }
+        auto decompressor = compression::CompressionService::create(compression_);
+        auto decomp_result = decompressor->decompress(plaintext);
+        if (decomp_result.success) {
+            plaintext = std::move(decomp_result.data);
+        } else if (flags_ & StreamingCrypto::FLAG_CHUNK_COMPRESSION) {
+            return Result<std::vector<uint8_t>>::error(
+                "Decompression failed at chunk " + std::to_string(index) + ": " + decomp_result.error_message);
+        }
+    }
+
+    if (plaintext.size() != entry.plain_size) {
+        return Result<std::vector<uint8_t>>::error(
+            "Chunk " + std::to_string(index) + " does not match the chunk index");
+    }
+
+    return Result<std::vector<uint8_t>>::ok(std::move(plaintext));
+}
+
+Result<void> StreamingReader::seek(uint64_t offset) {
+    if (!is_open()) {
+        return Result<void>::error("Reader is not open");
+    }
+    if (offset > total_size_) {
+        return Result<void>::error("Seek beyond end of stream");
+    }
+    position_ = offset;
+    return Result<void>::ok();
+}
+
+Result<std::vector<uint8_t>> StreamingReader::read(size_t length) {
+    if (!is_open()) {
+        return Result<std::vector<uint8_t>>::error("Reader is not open");
+    }
+
+    uint64_t end = position_ + (std::min)(uint64_t(length), total_size_ - position_);
+    std::vector<uint8_t> out;
+    out.reserve(static_cast<size_t>(end - position_));
+
+    while (position_ < end) {
+        size_t index = chunk_for_offset(position_);
+        auto chunk = load_chunk(index);
+        if (!chunk) {
+            return Result<std::vector<uint8_t>>::error(chunk.error_message);
+        }
+
+        const auto& plaintext = *chunk.value;
+        size_t begin = static_cast<size_t>(position_ - plain_offsets_[index]);
+        size_t count = static_cast<size_t>((std::min)(end, plain_offsets_[index + 1]) - position_);
+        out.insert(out.end(), plaintext.begin() + begin, plaintext.begin() + begin + count);
+        position_ += count;
+    }
+
+    return Result<std::vector<uint8_t>>::ok(std::move(out));
+}
+
+Result<std::vector<uint8_t>> StreamingReader::read(uint64_t offset, size_t length) {
+    auto sought = seek(offset);
+    if (!sought) {
+        return Result<std::vector<uint8_t>>::error(sought.error_message);
+    }
+    return read(length);
+}
+
+} // namespace core
+} // namespace filevault
@@ -0,0 +1,310 @@
+/**
+ * @file system_resources.cpp
+ * @brief Host, cgroup and affinity probe for chunk sizing and thread counts
+ */
+
+#include "filevault/core/system_resources.hpp"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/sysctl.h>
+#include <mach/mach.h>
+#else
+// Linux
+#include <sched.h>
+#include <unistd.h>
+#include <sys/sysinfo.h>
+#endif
+
+namespace filevault {
+namespace core {
+
+namespace {
+
+namespace fs = std::filesystem;
+
+#if defined(__linux__)
+
+// cgroup v1 reports "no limit" as a page-rounded LLONG_MAX
+constexpr uint64_t UNLIMITED_THRESHOLD = uint64_t(1) << 60;
+
+std::optional<std::string> read_first_line(const fs::path& path) {
+    std::ifstream file(path);
+    std::string line;
+    if (!file || !std::getline(file, line)) {
+        return std::nullopt;
+    }
+    return line;
+}
+
+std::optional<uint64_t> read_number(const fs::path& path) {
+    auto line = read_first_line(path);
+    if (!line) {
+        return std::nullopt;
+    }
+    try {
+        long long value = std::stoll(*line);
+        if (value < 0 || uint64_t(value) >= UNLIMITED_THRESHOLD) {
+            return std::nullopt;
+        }
+        return uint64_t(value);
+    } catch (const std::exception&) {
+        return std::nullopt;    // "max" and friends
+    }
+}
+
+void keep_min(std::optional<uint64_t>& current, std::optional<uint64_t> candidate) {
+    if (candidate && (!current || *candidate < *current)) {
+        current = candidate;
+    }
+}
+
+void keep_min(std::optional<double>& current, std::optional<double> candidate) {
+    if (candidate && (!current || *candidate < *current)) {
+        current = candidate;
+    }
+}
+
+// Directories from @p leaf up to and including @p mount
+std::vector<fs::path> hierarchy(const fs::path& mount, const std::string& cgroup_path) {
+    fs::path relative = fs::path(cgroup_path).relative_path();
+    fs::path leaf = relative.empty() ? mount : mount / relative;
+    // Without a cgroup namespace the host path is not visible inside a container,
+    // whose own cgroup is then mounted at the root
+    if (!fs::is_directory(leaf)) {
+        leaf = mount;
+    }
+
+    std::vector<fs::path> dirs;
+    for (fs::path dir = leaf; ; dir = dir.parent_path()) {
+        dirs.push_back(dir);
+        if (dir == mount || !dir.has_relative_path() || dir == dir.parent_path()) {
+            break;
+        }
+    }
+    return dirs;
+}
+
+struct CgroupLimits {
+    std::string version = "none";
+    std::optional<uint64_t> memory_limit;
+    std::optional<uint64_t> memory_headroom;    // Limit minus usage, tightest level
+    std::optional<double> cpu_quota;
+};
+
+void probe_v2(const fs::path& mount, const std::string& path, CgroupLimits& limits) {
+    for (const auto& dir : hierarchy(mount, path)) {
+        auto limit = read_number(dir / "memory.max");
+        keep_min(limits.memory_limit, limit);
+        if (limit) {
+            uint64_t used = read_number(dir / "memory.current").value_or(0);
+            keep_min(limits.memory_headroom, *limit > used ? *limit - used : 0);
+        }
+
+        // cpu.max: "<quota> <period>" or "max <period>"
+        if (auto line = read_first_line(dir / "cpu.max")) {
+            std::istringstream fields(*line);
+            std::string quota;
+            double period = 0;
+            if (fields >> quota >> period && quota != "max" && period > 0) {
+                try {
+                    keep_min(limits.cpu_quota, std::stod(quota) / period);
+                } catch (const std::exception&) {
+                }
+            }
+        }
+    }
+}
+
+void probe_v1(const fs::path& cgroup_root, const std::string& memory_path,
+              const std::string& cpu_path, CgroupLimits& limits) {
+    fs::path memory_mount = cgroup_root / "memory";
+    if (!memory_path.empty() && fs::is_directory(memory_mount)) {
+        for (const auto& dir : hierarchy(memory_mount, memory_path)) {
+            auto limit = read_number(dir / "memory.limit_in_bytes");
+            keep_min(limits.memory_limit, limit);
+            if (limit) {
+                uint64_t used = read_number(dir / "memory.usage_in_bytes").value_or(0);
+                keep_min(limits.memory_headroom, *limit > used ? *limit - used : 0);
+            }
+        }
+    }
+
+    for (const char* name : {"cpu,cpuacct", "cpu"}) {
+        fs::path cpu_mount = cgroup_root / name;
+        if (cpu_path.empty() || !fs::is_directory(cpu_mount)) {
+            continue;
+        }
+        for (const auto& dir : hierarchy(cpu_mount, cpu_path)) {
+            auto quota = read_number(dir / "cpu.cfs_quota_us");     // -1: no quota
+            auto period = read_number(dir / "cpu.cfs_period_us");
+            if (quota && period && *period > 0) {
+                keep_min(limits.cpu_quota, double(*quota) / double(*period));
+            }
+        }
+        break;
+    }
+}
+
+// /proc/self/cgroup: "0::<path>" (v2) or "<id>:<controllers>:<path>" lines (v1)
+CgroupLimits probe_cgroup(const fs::path& root) {
+    CgroupLimits limits;
+    std::ifstream file(root / "proc/self/cgroup");
+    if (!file) {
+        return limits;
+    }
+
+    std::string line, unified_path, memory_path, cpu_path;
+    bool unified = false;
+    while (std::getline(file, line)) {
+        auto first = line.find(':');
+        auto second = line.find(':', first + 1);
+        if (first == std::string::npos || second == std::string::npos) {
+            continue;
+        }
+        std::string controllers = line.substr(first + 1, second - first - 1);
+        std::string path = line.substr(second + 1);
+        if (controllers.empty()) {
+            unified = true;
+            unified_path = path;
+            continue;
+        }
+        std::istringstream names(controllers);
+        std::string name;
+        while (std::getline(names, name, ',')) {
+            if (name == "memory") memory_path = path;
+            if (name == "cpu") cpu_path = path;
+        }
+    }
+
+    fs::path cgroup_root = root / "sys/fs/cgroup";
+    if (!memory_path.empty() || !cpu_path.empty()) {
+        limits.version = "v1";
+        probe_v1(cgroup_root, memory_path, cpu_path, limits);
+    } else if (unified && fs::exists(cgroup_root / "cgroup.controllers")) {
+        limits.version = "v2";
+        probe_v2(cgroup_root, unified_path, limits);
+    }
+    return limits;
+}
+
+// MemTotal / MemAvailable in bytes; MemAvailable counts reclaimable cache, unlike freeram
+bool read_meminfo(const fs::path& root, uint64_t& total, uint64_t& available) {
+    std::ifstream file(root / "proc/meminfo");
+    std::string key;
+    uint64_t value_kb = 0;
+    std::string unit;
+    bool have_total = false, have_available = false;
+    while (file >> key >> value_kb) {
+        std::getline(file, unit);
+        if (key == "MemTotal:") {
+            total = value_kb * 1024;
+            have_total = true;
+        } else if (key == "MemAvailable:") {
+            available = value_kb * 1024;
+            have_available = true;
+        }
+    }
+    return have_total && have_available;
+}
+
+#endif // __linux__
+
+void probe_host_memory(const fs::path& root, uint64_t& total, uint64_t& available) {
+#ifdef _WIN32
+    (void)root;
+    MEMORYSTATUSEX status;
+    status.dwLength = sizeof(status);
+    if (GlobalMemoryStatusEx(&status)) {
+        total = static_cast<uint64_t>(status.ullTotalPhys);
+        available = static_cast<uint64_t>(status.ullAvailPhys);
+    }
+#elif defined(__APPLE__)
+    (void)root;
+    // macOS: Use mach API to get free memory
+    mach_port_t host_port = mach_host_self();
+    vm_size_t page_size;
+    vm_statistics64_data_t vm_stats;
+    mach_msg_type_number_t count = sizeof(vm_stats) / sizeof(natural_t);
+
+    if (host_page_size(host_port, &page_size) == KERN_SUCCESS &&
+        host_statistics64(host_port, HOST_VM_INFO64, (host_info64_t)&vm_stats, &count) == KERN_SUCCESS) {
+        available = static_cast<uint64_t>(vm_stats.free_count) * page_size;
+    }
+    uint64_t memsize = 0;
+    size_t length = sizeof(memsize);
+    if (sysctlbyname("hw.memsize", &memsize, &length, nullptr, 0) == 0) {
+        total = memsize;
+    }
+#else
+#if defined(__linux__)
+    if (read_meminfo(root, total, available)) {
+        return;
+    }
+#else
+    (void)root;
+#endif
+    struct sysinfo info;
+    if (sysinfo(&info) == 0) {
+        total = uint64_t(info.totalram) * info.mem_unit;
+        available = uint64_t(info.freeram) * info.mem_unit;
+    }
+#endif
+}
+
+} // anonymous namespace
+
+const SystemResources& SystemResources::current() {
+    static const SystemResources resources = probe();
+    return resources;
+}
+
+SystemResources SystemResources::probe(const std::string& root) {
+    SystemResources resources;
+
+    unsigned int hw = std::thread::hardware_concurrency();
+    resources.online_cpus = hw > 0 ? hw : 1;
+    resources.affinity_cpus = resources.online_cpus;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0 && CPU_COUNT(&set) > 0) {
+        resources.affinity_cpus = static_cast<size_t>(CPU_COUNT(&set));
+    }
+#endif
+
+    probe_host_memory(root, resources.total_memory, resources.available_memory);
+
+#if defined(__linux__)
+    auto limits = probe_cgroup(root);
+    resources.cgroup = limits.version;
+    resources.cpu_quota = limits.cpu_quota;
+    resources.memory_limit = limits.memory_limit;
+    if (limits.memory_headroom) {
+        resources.available_memory = resources.available_memory > 0
+            ? (std::min)(resources.available_memory, *limits.memory_headroom)
+            : *limits.memory_headroom;
+    }
+#endif
+
+    // A quota of 1.5 CPUs keeps two threads busy part of the time; round up
+    resources.cpu_count = resources.affinity_cpus;
+    if (resources.cpu_quota) {
+        size_t quota_cpus = static_cast<size_t>(std::ceil(*resources.cpu_quota));
+        resources.cpu_count = (std::min)(resources.cpu_count, (std::max)(quota_cpus, size_t(1)));
+    }
+    return resources;
+}
+
+} // namespace core
+} // namespace filevault
@@ -1,4 +1,5 @@
 #include "filevault/core/file_format.hpp"
+#include "filevault/core/algorithm_registry.hpp"
 #include <fstream>
 #include <cstring>
 #include <stdexcept>
@@ -322,21 +323,8 @@ std::tuple<FileHeader, std::vector<uint8_t>, std::vector<uint8_t>> FileFormatHan
     auto [header, header_size] = FileHeader::deserialize(file_data);
     
     // Check if algorithm uses authentication tag (AEAD)
-    bool has_tag = (header.algorithm == AlgorithmID::AES_128_GCM ||
-                    header.algorithm == AlgorithmID::AES_192_GCM ||
-                    header.algorithm == AlgorithmID::AES_256_GCM ||
-                    header.algorithm == AlgorithmID::CHACHA20_POLY1305 ||
-                    header.algorithm == AlgorithmID::SERPENT_256_GCM ||
-                    header.algorithm == AlgorithmID::TWOFISH_128_GCM ||
-                    header.algorithm == AlgorithmID::TWOFISH_192_GCM ||
-                    header.algorithm == AlgorithmID::TWOFISH_256_GCM ||
-                    header.algorithm == AlgorithmID::CAMELLIA_128_GCM ||
-                    header.algorithm == AlgorithmID::CAMELLIA_192_GCM ||
-                    header.algorithm == AlgorithmID::CAMELLIA_256_GCM ||
-                    header.algorithm == AlgorithmID::ARIA_128_GCM ||
-                    header.algorithm == AlgorithmID::ARIA_192_GCM ||
-                    header.algorithm == AlgorithmID::ARIA_256_GCM ||
-                    header.algorithm == AlgorithmID::SM4_GCM);
+    auto* info = find_algorithm(header.algorithm);
+    bool has_tag = info && info->aead;
     
     size_t tag_size = has_tag ? 16 : 0;
     
@@ -360,103 +348,13 @@ std::tuple<FileHeader, std::vector<uint8_t>, std::vector<uint8_t>> FileFormatHan
 }
 
 AlgorithmID FileFormatHandler::to_algorithm_id(AlgorithmType type) {
-    switch (type) {
-        case AlgorithmType::AES_128_GCM: return AlgorithmID::AES_128_GCM;
-        case AlgorithmType::AES_192_GCM: return AlgorithmID::AES_192_GCM;
-        case AlgorithmType::AES_256_GCM: return AlgorithmID::AES_256_GCM;
-        case AlgorithmType::AES_128_CBC: return AlgorithmID::AES_128_CBC;
-        case AlgorithmType::AES_192_CBC: return AlgorithmID::AES_192_CBC;
-        case AlgorithmType::AES_256_CBC: return AlgorithmID::AES_256_CBC;
-        case AlgorithmType::AES_128_CTR: return AlgorithmID::AES_128_CTR;
-        case AlgorithmType::AES_192_CTR: return AlgorithmID::AES_192_CTR;
-        case AlgorithmType::AES_256_CTR: return AlgorithmID::AES_256_CTR;
-        case AlgorithmType::AES_128_CFB: return AlgorithmID::AES_128_CFB;
-        case AlgorithmType::AES_192_CFB: return AlgorithmID::AES_192_CFB;
-        case AlgorithmType::AES_256_CFB: return AlgorithmID::AES_256_CFB;
-        case AlgorithmType::AES_128_OFB: return AlgorithmID::AES_128_OFB;
-        case AlgorithmType::AES_192_OFB: return AlgorithmID::AES_192_OFB;
-        case AlgorithmType::AES_256_OFB: return AlgorithmID::AES_256_OFB;
-        case AlgorithmType::AES_128_ECB: return AlgorithmID::AES_128_ECB;
-        case AlgorithmType::AES_192_ECB: return AlgorithmID::AES_192_ECB;
-        case AlgorithmType::AES_256_ECB: return AlgorithmID::AES_256_ECB;
-        case AlgorithmType::AES_128_XTS: return AlgorithmID::AES_128_XTS;
-        case AlgorithmType::AES_256_XTS: return AlgorithmID::AES_256_XTS;
-        case AlgorithmType::TRIPLE_DES_CBC: return AlgorithmID::TRIPLE_DES_CBC;
-        case AlgorithmType::RSA_2048: return AlgorithmID::RSA_2048;
-        case AlgorithmType::RSA_3072: return AlgorithmID::RSA_3072;
-        case AlgorithmType::RSA_4096: return AlgorithmID::RSA_4096;
-        case AlgorithmType::ECC_P256: return AlgorithmID::ECC_P256;
-        case AlgorithmType::ECC_P384: return AlgorithmID::ECC_P384;
-        case AlgorithmType::ECC_P521: return AlgorithmID::ECC_P521;
-        case AlgorithmType::CHACHA20_POLY1305: return AlgorithmID::CHACHA20_POLY1305;
-        case AlgorithmType::SERPENT_256_GCM: return AlgorithmID::SERPENT_256_GCM;
-        case AlgorithmType::TWOFISH_128_GCM: return AlgorithmID::TWOFISH_128_GCM;
-        case AlgorithmType::TWOFISH_192_GCM: return AlgorithmID::TWOFISH_192_GCM;
-        case AlgorithmType::TWOFISH_256_GCM: return AlgorithmID::TWOFISH_256_GCM;
-        case AlgorithmType::CAMELLIA_128_GCM: return AlgorithmID::CAMELLIA_128_GCM;
-        case AlgorithmType::CAMELLIA_192_GCM: return AlgorithmID::CAMELLIA_192_GCM;
-        case AlgorithmType::CAMELLIA_256_GCM: return AlgorithmID::CAMELLIA_256_GCM;
-        case AlgorithmType::ARIA_128_GCM: return AlgorithmID::ARIA_128_GCM;
-        case AlgorithmType::ARIA_192_GCM: return AlgorithmID::ARIA_192_GCM;
-        case AlgorithmType::ARIA_256_GCM: return AlgorithmID::ARIA_256_GCM;
-        case AlgorithmType::SM4_GCM: return AlgorithmID::SM4_GCM;
-        case AlgorithmType::CAESAR: return AlgorithmID::CAESAR;
-        case AlgorithmType::VIGENERE: return AlgorithmID::VIGENERE;
-        case AlgorithmType::PLAYFAIR: return AlgorithmID::PLAYFAIR;
-        case AlgorithmType::SUBSTITUTION: return AlgorithmID::SUBSTITUTION;
-        case AlgorithmType::HILL: return AlgorithmID::HILL;
-        default: return AlgorithmID::UNKNOWN;
-    }
+    auto* info = find_algorithm(type);
+    return info ? info->format_id : AlgorithmID::UNKNOWN;
 }
 
 AlgorithmType FileFormatHandler::from_algorithm_id(AlgorithmID id) {
-    switch (id) {
-        case AlgorithmID::AES_128_GCM: return AlgorithmType::AES_128_GCM;
-        case AlgorithmID::AES_192_GCM: return AlgorithmType::AES_192_GCM;
-        case AlgorithmID::AES_256_GCM: return AlgorithmType::AES_256_GCM;
-        case AlgorithmID::AES_128_CBC: return AlgorithmType::AES_128_CBC;
-        case AlgorithmID::AES_192_CBC: return AlgorithmType::AES_192_CBC;
-        case AlgorithmID::AES_256_CBC: return AlgorithmType::AES_256_CBC;
-        case AlgorithmID::AES_128_CTR: return AlgorithmType::AES_128_CTR;
-        case AlgorithmID::AES_192_CTR: return AlgorithmType::AES_192_CTR;
-        case AlgorithmID::AES_256_CTR: return AlgorithmType::AES_256_CTR;
-        case AlgorithmID::AES_128_CFB: return AlgorithmType::AES_128_CFB;
-        case AlgorithmID::AES_192_CFB: return AlgorithmType::AES_192_CFB;
-        case AlgorithmID::AES_256_CFB: return AlgorithmType::AES_256_CFB;
-        case AlgorithmID::AES_128_OFB: return AlgorithmType::AES_128_OFB;
-        case AlgorithmID::AES_192_OFB: return AlgorithmType::AES_192_OFB;
-        case AlgorithmID::AES_256_OFB: return AlgorithmType::AES_256_OFB;
-        case AlgorithmID::AES_128_ECB: return AlgorithmType::AES_128_ECB;
-        case AlgorithmID::AES_192_ECB: return AlgorithmType::AES_192_ECB;
-        case AlgorithmID::AES_256_ECB: return AlgorithmType::AES_256_ECB;
-        case AlgorithmID::AES_128_XTS: return AlgorithmType::AES_128_XTS;
-        case AlgorithmID::AES_256_XTS: return AlgorithmType::AES_256_XTS;
-        case AlgorithmID::TRIPLE_DES_CBC: return AlgorithmType::TRIPLE_DES_CBC;
-        case AlgorithmID::RSA_2048: return AlgorithmType::RSA_2048;
-        case AlgorithmID::RSA_3072: return AlgorithmType::RSA_3072;
-        case AlgorithmID::RSA_4096: return AlgorithmType::RSA_4096;
-        case AlgorithmID::ECC_P256: return AlgorithmType::ECC_P256;
-        case AlgorithmID::ECC_P384: return AlgorithmType::ECC_P384;
-        case AlgorithmID::ECC_P521: return AlgorithmType::ECC_P521;
-        case AlgorithmID::CHACHA20_POLY1305: return AlgorithmType::CHACHA20_POLY1305;
-        case AlgorithmID::SERPENT_256_GCM: return AlgorithmType::SERPENT_256_GCM;
-        case AlgorithmID::TWOFISH_128_GCM: return AlgorithmType::TWOFISH_128_GCM;
-        case AlgorithmID::TWOFISH_192_GCM: return AlgorithmType::TWOFISH_192_GCM;
-        case AlgorithmID::TWOFISH_256_GCM: return AlgorithmType::TWOFISH_256_GCM;
-        case AlgorithmID::CAMELLIA_128_GCM: return AlgorithmType::CAMELLIA_128_GCM;
-        case AlgorithmID::CAMELLIA_192_GCM: return AlgorithmType::CAMELLIA_192_GCM;
-        case AlgorithmID::CAMELLIA_256_GCM: return AlgorithmType::CAMELLIA_256_GCM;
-        case AlgorithmID::ARIA_128_GCM: return AlgorithmType::ARIA_128_GCM;
-        case AlgorithmID::ARIA_192_GCM: return AlgorithmType::ARIA_192_GCM;
-        case AlgorithmID::ARIA_256_GCM: return AlgorithmType::ARIA_256_GCM;
-        case AlgorithmID::SM4_GCM: return AlgorithmType::SM4_GCM;
-        case AlgorithmID::CAESAR: return AlgorithmType::CAESAR;
-        case AlgorithmID::VIGENERE: return AlgorithmType::VIGENERE;
-        case AlgorithmID::PLAYFAIR: return AlgorithmType::PLAYFAIR;
-        case AlgorithmID::SUBSTITUTION: return AlgorithmType::SUBSTITUTION;
-        case AlgorithmID::HILL: return AlgorithmType::HILL;
-        default: return AlgorithmType::AES_256_GCM;
-    }
+    auto* info = find_algorithm(id);
+    return info ? info->type : AlgorithmType::AES_256_GCM;
 }
 
 KDFID FileFormatHandler::to_kdf_id(KDFType type) {
@@ -49,6 +49,10 @@ std::filesystem::path Config::get_config_path() {
     return config_dir / "config.json";
 }
 
+std::filesystem::path Config::get_benchmark_cache_path() {
+    return get_config_path().parent_path() / "benchmark_cache.json";
+}
+
 Config Config::load() {
     auto config_path = get_config_path();
     
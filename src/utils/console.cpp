@@ -3,38 +3,46 @@
 namespace filevault {
 namespace utils {
 
+namespace {
+std::FILE* g_stream = stdout;
+}
+
+void Console::set_stream(std::FILE* stream) {
+    g_stream = stream ? stream : stdout;
+}
+
 void Console::success(const std::string& msg) {
-    fmt::print(fmt::fg(fmt::color::green), "✓ ");
-    fmt::print("{}\n", msg);
+    fmt::print(g_stream, fmt::fg(fmt::color::green), "✓ ");
+    fmt::print(g_stream, "{}\n", msg);
 }
 
 void Console::error(const std::string& msg) {
-    fmt::print(fmt::fg(fmt::color::red), "✗ ");
-    fmt::print("{}\n", msg);
+    fmt::print(g_stream, fmt::fg(fmt::color::red), "✗ ");
+    fmt::print(g_stream, "{}\n", msg);
 }
 
 void Console::warning(const std::string& msg) {
-    fmt::print(fmt::fg(fmt::color::yellow), "⚠ ");
-    fmt::print("{}\n", msg);
+    fmt::print(g_stream, fmt::fg(fmt::color::yellow), "⚠ ");
+    fmt::print(g_stream, "{}\n", msg);
 }
 
 void Console::info(const std::string& msg) {
-    fmt::print(fmt::fg(fmt::color::blue), "ℹ ");
-    fmt::print("{}\n", msg);
+    fmt::print(g_stream, fmt::fg(fmt::color::blue), "ℹ ");
+    fmt::print(g_stream, "{}\n", msg);
 }
 
 void Console::debug(const std::string& msg) {
-    fmt::print(fmt::fg(fmt::color::cyan), "🔍 ");
-    fmt::print("{}\n", msg);
+    fmt::print(g_stream, fmt::fg(fmt::color::cyan), "🔍 ");
+    fmt::print(g_stream, "{}\n", msg);
 }
 
 void Console::separator(char ch, size_t width) {
-    fmt::print("{}\n", std::string(width, ch));
+    fmt::print(g_stream, "{}\n", std::string(width, ch));
 }
 
 void Console::header(const std::string& title) {
     separator('=', 80);
-    fmt::print(fmt::emphasis::bold | fmt::fg(fmt::color::cyan), "{}\n", title);
+    fmt::print(g_stream, fmt::emphasis::bold | fmt::fg(fmt::color::cyan), "{}\n", title);
     separator('=', 80);
 }
 
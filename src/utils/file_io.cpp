@@ -1,26 +1,28 @@
 #include "filevault/utils/file_io.hpp"
-#include <fstream>
+#include "filevault/core/io_backend.hpp"
 #include <filesystem>
 #include <spdlog/spdlog.h>
 
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#endif
+
 namespace filevault {
 namespace utils {
 
 core::Result<std::vector<uint8_t>> FileIO::read_file(const std::string& path) {
     try {
-        std::ifstream file(path, std::ios::binary);
-        if (!file) {
+        auto reader = core::IOBackend::open_reader(path, core::IOBackend::default_options());
+        if (!reader) {
             return core::Result<std::vector<uint8_t>>::error("Cannot open file: " + path);
         }
         
-        file.seekg(0, std::ios::end);
-        size_t size = file.tellg();
-        file.seekg(0, std::ios::beg);
-        
+        size_t size = static_cast<size_t>(reader.value->size());
         std::vector<uint8_t> data(size);
-        file.read(reinterpret_cast<char*>(data.data()), size);
+        size_t got = reader.value->read(data.data(), size);
         
-        if (!file) {
+        if (got != size) {
             return core::Result<std::vector<uint8_t>>::error("Failed to read file: " + path);
         }
         
@@ -34,22 +36,19 @@ core::Result<std::vector<uint8_t>> FileIO::read_file(const std::string& path) {
 
 core::Result<void> FileIO::write_file(const std::string& path, std::span<const uint8_t> data) {
     try {
-        std::ofstream file(path, std::ios::binary);
-        if (!file) {
+        auto writer = core::IOBackend::open_writer(path, core::IOBackend::default_options());
+        if (!writer) {
             return core::Result<void>::error("Cannot create file: " + path);
         }
         
-        file.write(reinterpret_cast<const char*>(data.data()), data.size());
-        
-        if (!file) {
-            return core::Result<void>::error("Failed to write file: " + path);
-        }
+        writer.value->write(data.data(), data.size());
+        writer.value->flush();
         
         spdlog::debug("Wrote {} bytes to {}", data.size(), path);
         return core::Result<void>::ok();
         
     } catch (const std::exception& e) {
-        return core::Result<void>::error(std::string("Exception: ") + e.what());
+        return core::Result<void>::error(std::string("Failed to write file: ") + path + ": " + e.what());
     }
 }
 
@@ -64,5 +63,13 @@ size_t FileIO::file_size(const std::string& path) {
     return std::filesystem::file_size(path);
 }
 
+void FileIO::set_binary_mode(std::FILE* stream) {
+#ifdef _WIN32
+    _setmode(_fileno(stream), _O_BINARY);
+#else
+    (void)stream;
+#endif
+}
+
 } // namespace utils
 } // namespace filevault
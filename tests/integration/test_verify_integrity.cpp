@@ -0,0 +1,89 @@
+/**
+ * @file test_verify_integrity.cpp
+ * @brief verify-integrity command on single-shot .fvlt files
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include "filevault/cli/commands/verify_integrity_cmd.hpp"
+#include "filevault/core/crypto_engine.hpp"
+#include "filevault/core/file_format.hpp"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace filevault;
+using namespace filevault::core;
+namespace fs = std::filesystem;
+
+namespace {
+
+const std::string kPassword = "IntegrityTestPassword!7";
+
+// Encrypt @p plaintext into a .fvlt file the way the encrypt command lays it out
+void write_fvlt(CryptoEngine& engine, const fs::path& path, AlgorithmType algorithm,
+                const std::vector<uint8_t>& plaintext) {
+    EncryptionConfig config;
+    config.algorithm = algorithm;
+    config.kdf = KDFType::PBKDF2_SHA256;
+    config.level = SecurityLevel::WEAK;
+    config.apply_security_level();
+
+    auto salt = CryptoEngine::generate_salt(32);
+    auto key = engine.derive_key(kPassword, salt, config);
+    auto encrypted = engine.get_algorithm(algorithm)->encrypt(plaintext, key, config);
+    REQUIRE(encrypted.success);
+
+    std::vector<uint8_t> nonce = encrypted.nonce.value_or(std::vector<uint8_t>{});
+    std::vector<uint8_t> tag = encrypted.tag.value_or(std::vector<uint8_t>{});
+    auto header = FileFormatHandler::create_header(algorithm, config.kdf, config, salt, nonce, false);
+    REQUIRE(FileFormatHandler::write_file(path.string(), header, encrypted.data, tag));
+}
+
+// Exit status of `filevault verify-integrity <path> -p <password>`
+int verify_integrity(CryptoEngine& engine, const fs::path& path) {
+    CLI::App app;
+    cli::VerifyIntegrityCommand command(engine);
+    command.setup(app);
+    try {
+        app.parse("verify-integrity " + path.string() + " -p " + kPassword, false);
+    } catch (const CLI::RuntimeError& e) {
+        return e.get_exit_code();
+    }
+    return 0;
+}
+
+} // anonymous namespace
+
+TEST_CASE("verify-integrity checks the tag of single-shot files", "[integration][verify]") {
+    CryptoEngine engine;
+    engine.initialize();
+
+    fs::path dir = "test_verify_integrity_temp";
+    fs::create_directories(dir);
+    auto path = dir / "file.fvlt";
+    std::vector<uint8_t> plaintext(1000, 0x5A);
+
+    SECTION("An AEAD file verifies, and fails once tampered") {
+        write_fvlt(engine, path, AlgorithmType::AES_256_GCM, plaintext);
+        REQUIRE(verify_integrity(engine, path) == 0);
+
+        std::vector<uint8_t> bytes(fs::file_size(path));
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.read(reinterpret_cast<char*>(bytes.data()), bytes.size());
+        bytes[bytes.size() - 40] ^= 0x01;
+        file.seekp(0);
+        file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        file.close();
+        REQUIRE(verify_integrity(engine, path) == 1);
+    }
+
+    SECTION("Files without a tag are not reported as verified") {
+        for (auto algorithm : {AlgorithmType::AES_256_CTR, AlgorithmType::AES_256_CBC}) {
+            write_fvlt(engine, path, algorithm, plaintext);
+            REQUIRE(verify_integrity(engine, path) == 2);
+        }
+    }
+
+    fs::remove_all(dir);
+}
@@ -6,6 +6,7 @@
 #include <random>
 
 using filevault::compression::CompressionService;
+using filevault::compression::CompressorPool;
 using filevault::core::CompressionType;
 
 TEST_CASE("ZLIB compression", "[compression][zlib]") {
@@ -113,3 +114,47 @@ TEST_CASE("Large data compression", "[compression][large]") {
         REQUIRE(decompressed.data == data);
     }
 }
+
+TEST_CASE("Incompressibility probe and compressor pool", "[compression][probe]") {
+    
+    SECTION("Random data is detected, text is not") {
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<int> dist(0, 255);
+        std::vector<uint8_t> random(256 * 1024);
+        for (auto& b : random) b = static_cast<uint8_t>(dist(gen));
+        
+        std::string pattern = "2025-01-01 12:00:00 INFO request served in 12ms\n";
+        std::string text;
+        while (text.size() < random.size()) {
+            text += pattern;
+        }
+        std::vector<uint8_t> log(text.begin(), text.end());
+        
+        REQUIRE(CompressionService::estimate_entropy(random) > CompressionService::INCOMPRESSIBLE_ENTROPY);
+        REQUIRE(CompressionService::is_likely_incompressible(random));
+        REQUIRE_FALSE(CompressionService::is_likely_incompressible(log));
+        
+        // Too small to judge: always worth a try
+        std::vector<uint8_t> tiny(random.begin(), random.begin() + 100);
+        REQUIRE_FALSE(CompressionService::is_likely_incompressible(tiny));
+    }
+    
+    SECTION("Pooled compressors are reused across levels") {
+        std::string pattern = "The quick brown fox jumps over the lazy dog. ";
+        std::string text;
+        while (text.size() < 10000) {
+            text += pattern;
+        }
+        std::vector<uint8_t> data(text.begin(), text.end());
+        
+        CompressorPool pool(CompressionType::ZLIB);
+        for (int level : {1, 9, 9, 6}) {
+            auto compressor = pool.acquire();
+            auto compressed = compressor->compress(data, level);
+            REQUIRE(compressed.success);
+            auto decompressed = compressor->decompress(compressed.data);
+            REQUIRE(decompressed.success);
+            REQUIRE(decompressed.data == data);
+        }
+    }
+}
@@ -0,0 +1,100 @@
+/**
+ * @file test_algorithm_registry.cpp
+ * @brief Unit tests for the algorithm table and lazy algorithm creation
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include "filevault/core/algorithm_registry.hpp"
+#include "filevault/core/crypto_engine.hpp"
+#include "filevault/core/file_format.hpp"
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace filevault::core;
+
+TEST_CASE("Algorithm table lookups", "[registry]") {
+    SECTION("Every alias parses to its entry, in any case") {
+        for (const auto& info : ALGORITHM_TABLE) {
+            REQUIRE(find_algorithm(info.type) == &info);
+            REQUIRE(CryptoEngine::algorithm_name(info.type) == info.name);
+
+            for (auto alias : info.aliases) {
+                if (alias.empty()) {
+                    continue;
+                }
+                REQUIRE(CryptoEngine::parse_algorithm(std::string(alias)) == info.type);
+            }
+            REQUIRE(CryptoEngine::parse_algorithm(std::string(info.name)) == info.type);
+        }
+        REQUIRE(CryptoEngine::parse_algorithm("AES") == AlgorithmType::AES_256_GCM);
+        REQUIRE(CryptoEngine::parse_algorithm("Vigenère") == AlgorithmType::VIGENERE);
+    }
+
+    SECTION("Unknown names are rejected") {
+        REQUIRE_FALSE(CryptoEngine::parse_algorithm("").has_value());
+        REQUIRE_FALSE(CryptoEngine::parse_algorithm("aes-512-gcm").has_value());
+        REQUIRE_FALSE(CryptoEngine::parse_algorithm("aes-256-gcm ").has_value());
+    }
+
+    SECTION("File-format IDs are unique and round-trip") {
+        std::set<AlgorithmID> seen;
+        for (const auto& info : ALGORITHM_TABLE) {
+            REQUIRE(FileFormatHandler::to_algorithm_id(info.type) == info.format_id);
+            if (info.format_id == AlgorithmID::UNKNOWN) {
+                continue;
+            }
+            REQUIRE(seen.insert(info.format_id).second);
+            REQUIRE(FileFormatHandler::from_algorithm_id(info.format_id) == info.type);
+        }
+        REQUIRE(find_algorithm(AlgorithmID::UNKNOWN) == nullptr);
+    }
+
+    SECTION("Lookups are usable at compile time") {
+        static_assert(find_algorithm(AlgorithmType::CHACHA20_POLY1305)->aead);
+        static_assert(!find_algorithm(AlgorithmType::AES_256_CBC)->aead);
+        static_assert(find_algorithm("AES-256-XTS")->key_size == 64);
+        static_assert(find_algorithm("nonexistent") == nullptr);
+    }
+}
+
+TEST_CASE("Algorithms are created lazily", "[registry]") {
+    CryptoEngine engine;
+    engine.initialize();
+
+    SECTION("Implementations agree with their table entries") {
+        for (const auto& info : ALGORITHM_TABLE) {
+            auto* algorithm = engine.get_algorithm(info.type);
+            // Bare KEMs and signatures are not file ciphers
+            if (info.type >= AlgorithmType::KYBER_512 && info.type <= AlgorithmType::DILITHIUM_5) {
+                REQUIRE(algorithm == nullptr);
+                continue;
+            }
+            REQUIRE(algorithm != nullptr);
+            REQUIRE(algorithm->type() == info.type);
+            REQUIRE(algorithm->key_size() == info.key_size);
+        }
+    }
+
+    SECTION("The first request builds the instance, later ones reuse it") {
+        auto* first = engine.get_algorithm(AlgorithmType::AES_256_GCM);
+        REQUIRE(first != nullptr);
+        REQUIRE(engine.get_algorithm(AlgorithmType::AES_256_GCM) == first);
+    }
+
+    SECTION("Concurrent first requests get the same instance") {
+        std::vector<ICryptoAlgorithm*> results(8);
+        std::vector<std::thread> threads;
+        for (auto& out : results) {
+            threads.emplace_back([&engine, &out] { out = engine.get_algorithm(AlgorithmType::SM4_GCM); });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        REQUIRE(results[0] != nullptr);
+        for (auto* result : results) {
+            REQUIRE(result == results[0]);
+        }
+    }
+}
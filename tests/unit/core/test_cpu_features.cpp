@@ -0,0 +1,136 @@
+/**
+ * @file test_cpu_features.cpp
+ * @brief Unit tests for the CPU feature probe and the `auto` algorithm choice
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include "filevault/core/cpu_features.hpp"
+#include "filevault/core/modes.hpp"
+#include <filesystem>
+#include <fstream>
+
+using namespace filevault::core;
+
+namespace {
+
+CpuFeatures cpu_without_aes() {
+    CpuFeatures cpu;
+    cpu.architecture = "aarch64";
+    cpu.model = "edge box";
+    return cpu;
+}
+
+CpuFeatures cpu_with_aes() {
+    CpuFeatures cpu;
+    cpu.architecture = "x86_64";
+    cpu.model = "server";
+    cpu.aes_ni = true;
+    cpu.pclmulqdq = true;
+    cpu.avx2 = true;
+    return cpu;
+}
+
+} // anonymous namespace
+
+TEST_CASE("CPU feature probe", "[cpu]") {
+    const auto& cpu = CpuFeatures::current();
+
+    SECTION("The probe runs once") {
+        REQUIRE(&CpuFeatures::current() == &cpu);
+        REQUIRE(CpuFeatures::probe().signature() == cpu.signature());
+    }
+
+    SECTION("Names match the flags") {
+        auto names = cpu.names();
+        const bool any = cpu.aes_ni || cpu.vaes || cpu.pclmulqdq || cpu.avx2 || cpu.avx512 ||
+                         cpu.sha_ni || cpu.arm_aes || cpu.arm_pmull || cpu.arm_sha2;
+        REQUIRE(names.empty() == !any);
+        REQUIRE(cpu_with_aes().names() == std::vector<std::string>{"AES-NI", "PCLMULQDQ", "AVX2"});
+    }
+
+    SECTION("Hardware AES needs both AES rounds and carry-less multiply") {
+        REQUIRE(cpu_with_aes().hardware_aes());
+        REQUIRE_FALSE(cpu_without_aes().hardware_aes());
+
+        auto aes_only = cpu_without_aes();
+        aes_only.arm_aes = true;
+        REQUIRE_FALSE(aes_only.hardware_aes());
+        aes_only.arm_pmull = true;
+        REQUIRE(aes_only.hardware_aes());
+    }
+}
+
+TEST_CASE("Auto algorithm choice", "[cpu]") {
+    SECTION("Without measurements the probe decides") {
+        REQUIRE(AutoAlgorithm::choose(cpu_with_aes()) == AlgorithmType::AES_256_GCM);
+        REQUIRE(AutoAlgorithm::choose(cpu_without_aes()) == AlgorithmType::CHACHA20_POLY1305);
+    }
+
+    SECTION("The fastest measured 256-bit AEAD wins") {
+        std::vector<AeadThroughput> measured = {
+            {AlgorithmType::AES_256_GCM, 900},
+            {AlgorithmType::CHACHA20_POLY1305, 1200},
+            {AlgorithmType::AES_128_GCM, 5000},    // 128-bit key: never chosen
+            {AlgorithmType::AES_256_CTR, 8000},    // not authenticated: never chosen
+        };
+        REQUIRE(AutoAlgorithm::choose(cpu_with_aes(), measured) == AlgorithmType::CHACHA20_POLY1305);
+    }
+
+    SECTION("Unusable measurements fall back to the probe") {
+        std::vector<AeadThroughput> measured = {
+            {AlgorithmType::AES_128_GCM, 5000},
+            {AlgorithmType::CHACHA20_POLY1305, 0},
+        };
+        REQUIRE(AutoAlgorithm::choose(cpu_with_aes(), measured) == AlgorithmType::AES_256_GCM);
+    }
+
+    SECTION("Mode presets make the same choice as auto") {
+        std::vector<AeadThroughput> measured = {
+            {AlgorithmType::AES_256_GCM, 900},
+            {AlgorithmType::CHACHA20_POLY1305, 1200},
+        };
+        const auto& cpu = CpuFeatures::current();
+        REQUIRE(ModePreset::get_preset(UserMode::PROFESSIONAL).algorithm == AutoAlgorithm::choose(cpu));
+        for (const auto& preset : ModePreset::get_all_presets(measured)) {
+            REQUIRE(preset.algorithm == AlgorithmType::CHACHA20_POLY1305);
+        }
+    }
+}
+
+TEST_CASE("Benchmark cache", "[cpu]") {
+    auto dir = std::filesystem::temp_directory_path() / "filevault_test_cpu_features";
+    std::filesystem::create_directories(dir);
+    auto file = dir / "benchmark_cache.json";
+    std::filesystem::remove(file);
+
+    std::vector<AeadThroughput> measured = {
+        {AlgorithmType::AES_256_GCM, 3100.5},
+        {AlgorithmType::CHACHA20_POLY1305, 1450.25},
+    };
+
+    SECTION("Missing file yields nothing") {
+        REQUIRE(AutoAlgorithm::load_measurements(file, cpu_with_aes()).empty());
+    }
+
+    SECTION("Round trip on the same CPU") {
+        REQUIRE(AutoAlgorithm::save_measurements(file, cpu_with_aes(), measured));
+        auto loaded = AutoAlgorithm::load_measurements(file, cpu_with_aes());
+        REQUIRE(loaded.size() == 2);
+        REQUIRE(loaded[0].algorithm == AlgorithmType::AES_256_GCM);
+        REQUIRE(loaded[0].encrypt_mbps == 3100.5);
+        REQUIRE(loaded[1].algorithm == AlgorithmType::CHACHA20_POLY1305);
+        REQUIRE(AutoAlgorithm::choose(cpu_with_aes(), loaded) == AlgorithmType::AES_256_GCM);
+    }
+
+    SECTION("Figures from another CPU are ignored") {
+        REQUIRE(AutoAlgorithm::save_measurements(file, cpu_with_aes(), measured));
+        REQUIRE(AutoAlgorithm::load_measurements(file, cpu_without_aes()).empty());
+    }
+
+    SECTION("A corrupt file is ignored") {
+        std::ofstream(file) << "{ not json";
+        REQUIRE(AutoAlgorithm::load_measurements(file, cpu_with_aes()).empty());
+    }
+
+    std::filesystem::remove_all(dir);
+}
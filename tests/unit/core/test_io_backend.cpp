@@ -0,0 +1,255 @@
+/**
+ * @file test_io_backend.cpp
+ * @brief Unit tests for the pluggable file I/O backend (sync / io_uring)
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include "filevault/core/io_backend.hpp"
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+#include <string>
+
+using namespace filevault::core;
+namespace fs = std::filesystem;
+
+namespace {
+
+fs::path test_dir() {
+    static fs::path dir = fs::path("test_io_backend_temp");
+    fs::create_directories(dir);
+    return dir;
+}
+
+std::vector<uint8_t> make_data(size_t size) {
+    std::vector<uint8_t> data(size);
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(0, 255);
+    for (auto& b : data) {
+        b = static_cast<uint8_t>(dist(gen));
+    }
+    return data;
+}
+
+std::vector<uint8_t> read_back(const fs::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<uint8_t>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+void round_trip(IOBackendType type, size_t size, bool direct = false,
+                CachePolicy cache = CachePolicy::KEEP, size_t block_size = 4096) {
+    IOOptions options;
+    options.backend = type;
+    options.direct = direct;
+    options.cache = cache;
+    options.block_size = block_size;  // Small blocks so every queue slot is reused
+    options.queue_depth = 4;
+
+    auto data = make_data(size);
+    auto path = (test_dir() / ("rt_" + IOBackend::name(type) + (direct ? "_direct_" : "_") +
+                               std::to_string(size))).string();
+
+    {
+        auto writer = IOBackend::open_writer(path, options);
+        REQUIRE(writer);
+        // Uneven write sizes straddle block boundaries
+        size_t pos = 0;
+        size_t step = 1;
+        while (pos < data.size()) {
+            size_t n = std::min(step, data.size() - pos);
+            writer.value->write(data.data() + pos, n);
+            pos += n;
+            step = step * 3 + 1;
+        }
+        writer.value->flush();
+    }
+    REQUIRE(read_back(path) == data);
+
+    auto reader = IOBackend::open_reader(path, options);
+    REQUIRE(reader);
+    REQUIRE(reader.value->size() == size);
+
+    std::vector<uint8_t> out(size + 100);
+    size_t got = 0;
+    size_t step = 7;
+    while (true) {
+        size_t n = reader.value->read(out.data() + got, std::min(step, out.size() - got));
+        if (n == 0) break;
+        got += n;
+        step = step * 2 + 5;
+    }
+    REQUIRE(got == size);
+    out.resize(got);
+    REQUIRE(out == data);
+}
+
+} // anonymous namespace
+
+TEST_CASE("IOBackend names round-trip", "[io]") {
+    REQUIRE(IOBackend::parse("sync") == IOBackendType::SYNC);
+    REQUIRE(IOBackend::parse("uring") == IOBackendType::URING);
+    REQUIRE(IOBackend::parse("io_uring") == IOBackendType::URING);
+    REQUIRE_FALSE(IOBackend::parse("aio").has_value());
+    REQUIRE(IOBackend::name(IOBackendType::URING) == "uring");
+    REQUIRE(IOBackend::is_available(IOBackendType::SYNC));
+    
+    REQUIRE(IOBackend::parse_cache_policy("drop") == CachePolicy::DROP);
+    REQUIRE(IOBackend::cache_policy_name(CachePolicy::KEEP) == "keep");
+    REQUIRE_FALSE(IOBackend::parse_cache_policy("none").has_value());
+}
+
+TEST_CASE("Sync backend reads and writes files", "[io]") {
+    for (size_t size : {size_t(0), size_t(1), size_t(4096), size_t(100003)}) {
+        round_trip(IOBackendType::SYNC, size);
+    }
+}
+
+TEST_CASE("io_uring backend matches sync (or falls back)", "[io]") {
+    // Without liburing or kernel support open_* falls back to the blocking path,
+    // so the same checks hold either way
+    for (size_t size : {size_t(0), size_t(1), size_t(4096), size_t(100003)}) {
+        round_trip(IOBackendType::URING, size);
+    }
+}
+
+TEST_CASE("O_DIRECT mode matches buffered I/O (or falls back)", "[io][direct]") {
+    // Sizes around the 4 KiB alignment; unsupported filesystems fall back to buffered I/O
+    for (auto type : {IOBackendType::SYNC, IOBackendType::URING}) {
+        for (size_t size : {size_t(0), size_t(1), size_t(4095), size_t(4096), size_t(4097), size_t(100003)}) {
+            round_trip(type, size, true);
+        }
+    }
+}
+
+TEST_CASE("O_DIRECT writer keeps unaligned tails across flushes", "[io][direct]") {
+    auto data = make_data(3 * 4096 + 500);
+    auto path = (test_dir() / "direct_flush").string();
+
+    for (auto type : {IOBackendType::SYNC, IOBackendType::URING}) {
+        IOOptions options;
+        options.backend = type;
+        options.direct = true;
+        options.block_size = 8192;
+
+        auto writer = IOBackend::open_writer(path, options);
+        REQUIRE(writer);
+        writer.value->write(data.data(), 100);
+        writer.value->flush();
+        REQUIRE(fs::file_size(path) == 100);
+
+        writer.value->write(data.data() + 100, 9000);
+        writer.value->flush();
+        REQUIRE(fs::file_size(path) == 9100);
+
+        writer.value->write(data.data() + 9100, data.size() - 9100);
+        writer.value->flush();
+        writer.value.reset();
+        REQUIRE(read_back(path) == data);
+    }
+}
+
+TEST_CASE("Readers and writers start at an offset", "[io][resume]") {
+    auto data = make_data(5 * 4096 + 777);
+    auto path = (test_dir() / "offsets").string();
+
+    for (auto type : {IOBackendType::SYNC, IOBackendType::URING}) {
+        for (bool direct : {false, true}) {
+            IOOptions options;
+            options.backend = type;
+            options.direct = direct;
+            options.block_size = 8192;
+
+            // Unaligned offsets exercise the O_DIRECT read-back of the partial block
+            for (size_t offset : {size_t(0), size_t(4096), size_t(6000)}) {
+                {
+                    auto writer = IOBackend::open_writer(path, options);
+                    REQUIRE(writer);
+                    writer.value->write(data.data(), data.size());
+                    // Garbage after the offset must be discarded on reopen
+                    std::vector<uint8_t> junk(3000, 0xEE);
+                    writer.value->write(junk.data(), junk.size());
+                }
+
+                IOOptions resume = options;
+                resume.write_offset = offset;
+                auto writer = IOBackend::open_writer(path, resume);
+                REQUIRE(writer);
+                writer.value->write(data.data() + offset, data.size() - offset);
+                writer.value->sync();
+                writer.value.reset();
+                REQUIRE(read_back(path) == data);
+
+                IOOptions from = options;
+                from.read_offset = offset;
+                auto reader = IOBackend::open_reader(path, from);
+                REQUIRE(reader);
+                REQUIRE(reader.value->size() == data.size());
+                std::vector<uint8_t> rest(data.size());
+                rest.resize(reader.value->read(rest.data(), rest.size()));
+                REQUIRE(rest == std::vector<uint8_t>(data.begin() + offset, data.end()));
+            }
+        }
+    }
+}
+
+TEST_CASE("Cache drop policy does not change file contents", "[io][cache]") {
+    // Larger than the drop window so pages are released behind the cursor mid-file
+    const size_t size = 2 * detail::CacheAdvisor::DROP_WINDOW + 12345;
+    for (auto type : {IOBackendType::SYNC, IOBackendType::URING}) {
+        round_trip(type, size, false, CachePolicy::DROP, 256 * 1024);
+    }
+}
+
+TEST_CASE("Missing input is reported as an error", "[io]") {
+    for (auto type : {IOBackendType::SYNC, IOBackendType::URING}) {
+        for (bool direct : {false, true}) {
+            IOOptions options;
+            options.backend = type;
+            options.direct = direct;
+            auto reader = IOBackend::open_reader((test_dir() / "does_not_exist").string(), options);
+            REQUIRE_FALSE(reader);
+        }
+    }
+}
+
+TEST_CASE("Streambuf adapters expose backends as iostreams", "[io]") {
+    auto data = make_data(300000);
+    auto path = (test_dir() / "streambuf").string();
+
+    for (auto type : {IOBackendType::SYNC, IOBackendType::URING}) {
+        IOOptions options;
+        options.backend = type;
+        options.block_size = 8192;
+
+        {
+            auto writer = IOBackend::open_writer(path, options);
+            REQUIRE(writer);
+            WriterStreamBuf buf(*writer.value, 1000);
+            std::ostream out(&buf);
+            out.put(static_cast<char>(data[0]));
+            out.write(reinterpret_cast<const char*>(data.data() + 1), 99);       // Buffered
+            out.write(reinterpret_cast<const char*>(data.data() + 100), 150000); // Bypasses buffer
+            out.write(reinterpret_cast<const char*>(data.data() + 150100), data.size() - 150100);
+            REQUIRE(out.flush());
+        }
+        REQUIRE(read_back(path) == data);
+
+        auto reader = IOBackend::open_reader(path, options);
+        REQUIRE(reader);
+        ReaderStreamBuf buf(*reader.value, 1000);
+        std::istream in(&buf);
+
+        std::vector<uint8_t> out(data.size());
+        REQUIRE(in.peek() == data[0]);
+        in.read(reinterpret_cast<char*>(out.data()), 10);
+        in.read(reinterpret_cast<char*>(out.data() + 10), 200000);
+        REQUIRE(in.gcount() == 200000);
+        in.read(reinterpret_cast<char*>(out.data() + 200010), data.size() - 200010);
+        REQUIRE(in);
+        REQUIRE(out == data);
+        REQUIRE(in.peek() == std::char_traits<char>::eof());
+    }
+
+    fs::remove_all(test_dir());
+}
@@ -0,0 +1,104 @@
+/**
+ * @file test_memory_budget.cpp
+ * @brief Unit tests for the process-wide memory budget
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include "filevault/core/memory_budget.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace filevault::core;
+
+TEST_CASE("Memory budget reservations", "[memory]") {
+    MemoryBudget budget(1000);
+
+    SECTION("Reservations are returned when they end") {
+        {
+            auto a = budget.reserve(600);
+            REQUIRE(budget.reserved() == 600);
+            REQUIRE_FALSE(budget.try_reserve(500).has_value());
+
+            auto b = budget.try_reserve(400);
+            REQUIRE(b.has_value());
+            REQUIRE(budget.reserved() == 1000);
+
+            auto moved = std::move(*b);
+            b.reset();
+            REQUIRE(budget.reserved() == 1000);
+        }
+        REQUIRE(budget.reserved() == 0);
+    }
+
+    SECTION("Units shrink to what fits") {
+        auto held = budget.reserve(500);
+        auto units = budget.reserve_units(100, 2, 8);
+        REQUIRE(units.bytes() == 500);
+
+        units.release();
+        held.release();
+        REQUIRE(budget.reserve_units(100, 2, 8).bytes() == 800);
+    }
+
+    SECTION("Oversized requests run alone instead of failing") {
+        auto big = budget.reserve(5000);
+        REQUIRE(big.bytes() == 5000);
+        REQUIRE_FALSE(budget.try_reserve(1).has_value());
+        big.release();
+        REQUIRE(budget.try_reserve(1).has_value());
+    }
+
+    SECTION("Waiting reservations queue until memory is released") {
+        auto held = budget.reserve(800);
+        std::atomic<bool> granted{false};
+
+        std::thread waiter([&] {
+            auto r = budget.reserve(400);
+            granted = true;
+        });
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        REQUIRE_FALSE(granted);
+        held.release();
+        waiter.join();
+        REQUIRE(granted);
+        REQUIRE(budget.reserved() == 0);
+    }
+
+    SECTION("Concurrent users never exceed the limit") {
+        std::atomic<uint64_t> peak{0};
+        std::vector<std::thread> workers;
+        for (int i = 0; i < 8; ++i) {
+            workers.emplace_back([&] {
+                for (int j = 0; j < 50; ++j) {
+                    auto r = budget.reserve(300);
+                    uint64_t now = budget.reserved();
+                    uint64_t seen = peak.load();
+                    while (now > seen && !peak.compare_exchange_weak(seen, now)) {
+                    }
+                }
+            });
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+        REQUIRE(peak <= 1000);
+        REQUIRE(budget.reserved() == 0);
+    }
+
+    SECTION("Raising the limit wakes waiters") {
+        auto held = budget.reserve(1000);
+        std::thread waiter([&] { auto r = budget.reserve(500); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        budget.set_limit(2000);
+        waiter.join();
+        REQUIRE(budget.limit() == 2000);
+    }
+}
+
+TEST_CASE("Global memory budget defaults to the usable memory", "[memory]") {
+    REQUIRE(MemoryBudget::default_limit() > 0);
+    REQUIRE(MemoryBudget::global().limit() > 0);
+}
@@ -0,0 +1,88 @@
+/**
+ * @file test_secure_random.cpp
+ * @brief Unit tests for the per-thread DRBG
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include "filevault/core/secure_random.hpp"
+#include "filevault/core/crypto_engine.hpp"
+#include <set>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace filevault::core;
+
+TEST_CASE("Secure random draws", "[random]") {
+    SECTION("One generator per thread") {
+        auto* first = &SecureRandom::thread_rng();
+        REQUIRE(&SecureRandom::thread_rng() == first);
+
+        Botan::RandomNumberGenerator* other = nullptr;
+        std::thread([&] { other = &SecureRandom::thread_rng(); }).join();
+        REQUIRE(other != first);
+    }
+
+    SECTION("Outputs do not repeat across reseeds") {
+        std::set<std::vector<uint8_t>> seen;
+        const size_t draws = SecureRandom::RESEED_INTERVAL * 3;
+        for (size_t i = 0; i < draws; ++i) {
+            REQUIRE(seen.insert(SecureRandom::bytes(16)).second);
+        }
+    }
+
+    SECTION("Threads draw distinct streams") {
+        std::vector<std::vector<uint8_t>> results(4);
+        std::vector<std::thread> threads;
+        for (auto& out : results) {
+            threads.emplace_back([&out] { out = SecureRandom::bytes(32); });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        std::set<std::vector<uint8_t>> unique(results.begin(), results.end());
+        REQUIRE(unique.size() == results.size());
+    }
+
+    SECTION("Salts and nonces come from it with the requested length") {
+        REQUIRE(CryptoEngine::generate_salt(32).size() == 32);
+        REQUIRE(CryptoEngine::generate_nonce(12).size() == 12);
+        REQUIRE(CryptoEngine::generate_nonce(12) != CryptoEngine::generate_nonce(12));
+        REQUIRE(SecureRandom::bytes(0).empty());
+    }
+}
+
+#ifndef _WIN32
+TEST_CASE("Secure random reseeds in a forked child", "[random]") {
+    // Seed the parent's generator before forking so the child inherits its state
+    SecureRandom::bytes(16);
+
+    int fds[2];
+    REQUIRE(pipe(fds) == 0);
+
+    pid_t pid = fork();
+    REQUIRE(pid >= 0);
+    if (pid == 0) {
+        auto child = SecureRandom::bytes(32);
+        ssize_t written = write(fds[1], child.data(), child.size());
+        _exit(written == static_cast<ssize_t>(child.size()) ? 0 : 1);
+    }
+
+    close(fds[1]);
+    auto parent = SecureRandom::bytes(32);
+    std::vector<uint8_t> child(32);
+    ssize_t got = read(fds[0], child.data(), child.size());
+    close(fds[0]);
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    REQUIRE(WIFEXITED(status));
+    REQUIRE(WEXITSTATUS(status) == 0);
+    REQUIRE(got == 32);
+    REQUIRE(child != parent);
+}
+#endif
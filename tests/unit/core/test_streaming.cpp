@@ -0,0 +1,1157 @@
+/**
+ * @file test_streaming.cpp
+ * @brief Unit tests for chunked streaming encryption (FVST format)
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include "filevault/core/streaming.hpp"
+#include "filevault/core/chunk_pool.hpp"
+#include "filevault/core/content_chunker.hpp"
+#include "filevault/core/streaming_reader.hpp"
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+#include <string>
+
+using namespace filevault::core;
+namespace fs = std::filesystem;
+
+namespace {
+
+const std::string kPassword = "StreamingTestPassword!42";
+
+fs::path test_dir() {
+    static fs::path dir = fs::path("test_streaming_temp");
+    fs::create_directories(dir);
+    return dir;
+}
+
+std::vector<uint8_t> make_data(size_t size, bool compressible) {
+    std::vector<uint8_t> data(size);
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<int> dist(0, 255);
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = compressible ? static_cast<uint8_t>('a' + (i / 64) % 26)
+                               : static_cast<uint8_t>(dist(gen));
+    }
+    return data;
+}
+
+void write_bytes(const fs::path& path, const std::vector<uint8_t>& data) {
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+std::vector<uint8_t> read_bytes(const fs::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file),
+                                std::istreambuf_iterator<char>());
+}
+
+// Offsets of the segment markers between the header and the index footer
+std::vector<size_t> segment_markers(const std::vector<uint8_t>& bytes) {
+    auto read_u32 = [&](size_t at) {
+        uint32_t value = 0;
+        std::memcpy(&value, bytes.data() + at, 4);
+        return value;
+    };
+    uint64_t index_offset = 0;
+    std::memcpy(&index_offset, bytes.data() + bytes.size() - 16, 8);
+    const size_t salt_len = bytes[30];
+    const size_t nonce_len = bytes[31 + salt_len];
+    
+    std::vector<size_t> markers;
+    for (size_t at = 32 + salt_len + nonce_len; at < index_offset;) {
+        uint32_t size = read_u32(at);
+        if (size == StreamingCrypto::RECORD_SEGMENT) {
+            markers.push_back(at);
+            at += 4 + nonce_len + 8 + 16;
+        } else {
+            at += 4 + (size & ~(StreamingCrypto::RECORD_LAST_CHUNK | StreamingCrypto::RECORD_COMPRESSED)) + 16;
+        }
+    }
+    return markers;
+}
+
+StreamingConfig fast_config() {
+    StreamingConfig config;
+    config.chunk_size = 64 * 1024;
+    config.kdf = KDFType::PBKDF2_SHA256;  // Fast KDF for tests
+    return config;
+}
+
+} // anonymous namespace
+
+TEST_CASE("Chunk worker pool returns chunks in order", "[streaming][pool]") {
+    for (size_t threads : {size_t(0), size_t(4)}) {
+        ChunkWorkerPool pool(threads, [](ChunkJob& job) {
+            // Later chunks finish first to exercise reordering
+            if (job.index % 3 == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+            job.data.assign(1, static_cast<uint8_t>(job.index));
+        });
+
+        for (size_t i = 0; i < 16; ++i) {
+            ChunkJob job;
+            job.index = i;
+            pool.submit(std::move(job));
+        }
+
+        REQUIRE(pool.outstanding() == 16);
+        for (size_t i = 0; i < 16; ++i) {
+            auto job = pool.next();
+            REQUIRE(job.has_value());
+            REQUIRE(job->success);
+            REQUIRE(job->index == i);
+            REQUIRE(job->data[0] == static_cast<uint8_t>(i));
+        }
+        REQUIRE(pool.outstanding() == 0);
+        
+        pool.close();
+        REQUIRE_FALSE(pool.next().has_value());
+    }
+}
+
+TEST_CASE("Chunk worker pool reports transform errors", "[streaming][pool]") {
+    ChunkWorkerPool pool(2, [](ChunkJob& job) {
+        if (job.index == 1) {
+            throw std::runtime_error("boom");
+        }
+    });
+
+    for (size_t i = 0; i < 3; ++i) {
+        ChunkJob job;
+        job.index = i;
+        pool.submit(std::move(job));
+    }
+
+    REQUIRE(pool.next()->success);
+    auto failed = pool.next();
+    REQUIRE_FALSE(failed->success);
+    REQUIRE(failed->error_message == "boom");
+}
+
+TEST_CASE("Chunk pipeline bounds chunks in flight", "[streaming][pipeline]") {
+    const size_t slots = 3;
+    const size_t total = 40;
+    
+    std::atomic<size_t> in_flight{0};
+    std::atomic<size_t> peak{0};
+    size_t produced = 0;
+    std::vector<size_t> written;
+    
+    ChunkPipeline pipeline(4, slots, [](ChunkJob& job) {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        job.data.assign(8, static_cast<uint8_t>(job.index));
+    });
+    
+    auto result = pipeline.run(
+        [&](ChunkJob& job) {
+            if (produced == total) {
+                return false;
+            }
+            job.index = produced++;
+            size_t now = ++in_flight;
+            size_t prev = peak.load();
+            while (now > prev && !peak.compare_exchange_weak(prev, now)) {}
+            return true;
+        },
+        [&](ChunkJob& job) {
+            written.push_back(job.index);
+            --in_flight;
+        });
+    
+    REQUIRE(result);
+    REQUIRE(written.size() == total);
+    for (size_t i = 0; i < total; ++i) {
+        REQUIRE(written[i] == i);
+    }
+    REQUIRE(peak.load() <= slots);
+}
+
+TEST_CASE("Chunk pipeline stops on writer failure", "[streaming][pipeline]") {
+    size_t produced = 0;
+    ChunkPipeline pipeline(2, 2, [](ChunkJob&) {});
+    
+    auto result = pipeline.run(
+        [&](ChunkJob& job) {
+            job.index = produced++;
+            return true;  // Unbounded input: only the writer can stop the pipeline
+        },
+        [](ChunkJob& job) {
+            if (job.index == 5) {
+                throw std::runtime_error("disk full");
+            }
+        });
+    
+    REQUIRE_FALSE(result);
+    REQUIRE(result.error_message == "disk full");
+    REQUIRE(produced < 16);
+}
+
+TEST_CASE("Chunk pipeline slot budget", "[streaming][pipeline]") {
+    const size_t mb = 1024 * 1024;
+    REQUIRE(ChunkPipeline::slots_for_budget(64 * mb, 0, 4) == 6);
+    REQUIRE(ChunkPipeline::slots_for_budget(64 * mb, 256 * mb, 8) == 4);
+    REQUIRE(ChunkPipeline::slots_for_budget(64 * mb, 32 * mb, 8) == 2);
+}
+
+TEST_CASE("Streaming encrypt/decrypt round trip", "[streaming]") {
+    auto dir = test_dir();
+    auto input = dir / "input.bin";
+    auto encrypted = dir / "input.fvst";
+    auto decrypted = dir / "output.bin";
+
+    // Not a multiple of the chunk size so the last chunk is partial
+    auto data = make_data(5 * 64 * 1024 + 123, false);
+    write_bytes(input, data);
+
+    SECTION("Single thread") {
+        auto config = fast_config();
+        auto enc = StreamingCrypto::encrypt_file(input.string(), encrypted.string(), kPassword, config);
+        REQUIRE(enc.success);
+        REQUIRE(enc.chunks_processed == 6);
+        REQUIRE(enc.bytes_processed == data.size());
+
+        auto dec = StreamingCrypto::decrypt_file(encrypted.string(), decrypted.string(), kPassword);
+        REQUIRE(dec.success);
+        REQUIRE(read_bytes(decrypted) == data);
+    }
+
+    SECTION("Worker pool output matches and decrypts in parallel") {
+        auto config = fast_config();
+        config.threads = 4;
+
+        size_t last_index = 0;
+        bool ordered = true;
+        config.progress_callback = [&](const ChunkInfo& info) {
+            if (info.chunk_index != 0 && info.chunk_index != last_index + 1) {
+                ordered = false;
+            }
+            last_index = info.chunk_index;
+            return true;
+        };
+
+        auto enc = StreamingCrypto::encrypt_file(input.string(), encrypted.string(), kPassword, config);
+        REQUIRE(enc.success);
+        REQUIRE(ordered);
+
+        StreamingConfig options;
+        options.threads = 4;
+        auto dec = StreamingCrypto::decrypt_file(encrypted.string(), decrypted.string(), kPassword, options);
+        REQUIRE(dec.success);
+        REQUIRE(dec.chunks_processed == 6);
+        REQUIRE(read_bytes(decrypted) == data);
+    }
+
+    SECTION("Compressed chunks") {
+        auto compressible = make_data(3 * 64 * 1024, true);
+        write_bytes(input, compressible);
+
+        auto config = fast_config();
+        config.compression = CompressionType::ZLIB;
+        config.threads = 3;
+
+        auto enc = StreamingCrypto::encrypt_file(input.string(), encrypted.string(), kPassword, config);
+        REQUIRE(enc.success);
+        REQUIRE(fs::file_size(encrypted) < compressible.size());
+
+        auto dec = StreamingCrypto::decrypt_file(encrypted.string(), decrypted.string(), kPassword);
+        REQUIRE(dec.success);
+        REQUIRE(read_bytes(decrypted) == compressible);
+    }
+
+    SECTION("Tight in-flight budget") {
+        auto config = fast_config();
+        config.threads = 4;
+        config.max_in_flight_bytes = config.chunk_size;  // Clamped to two chunks
+        REQUIRE(StreamingCrypto::encrypt_file(input.string(), encrypted.string(), kPassword, config).success);
+        
+        StreamingConfig options;
+        options.threads = 4;
+        options.max_in_flight_bytes = 1;
+        auto dec = StreamingCrypto::decrypt_file(encrypted.string(), decrypted.string(), kPassword, options);
+        REQUIRE(dec.success);
+        REQUIRE(read_bytes(decrypted) == data);
+    }
+    
+    SECTION("Wrong password fails") {
+        auto config = fast_config();
+        config.threads = 2;
+        REQUIRE(StreamingCrypto::encrypt_file(input.string(), encrypted.string(), kPassword, config).success);
+
+        StreamingConfig options;
+        options.threads = 2;
+        auto dec = StreamingCrypto::decrypt_file(encrypted.string(), decrypted.string(), "wrong", options);
+        REQUIRE_FALSE(dec.success);
+    }
+
+    SECTION("Corrupt chunk size in the header is rejected") {
+        auto config = fast_config();
+        REQUIRE(StreamingCrypto::encrypt_file(input.string(), encrypted.string(), kPassword, config).success);
+        auto original = read_bytes(encrypted);
+
+        // Chunk size sits after magic, version, flags, algorithm, KDF, compression and level
+        for (uint64_t bogus : {uint64_t(0), uint64_t(StreamingCrypto::MAX_CHUNK_SIZE) + 1, ~uint64_t(0)}) {
+            auto corrupt = original;
+            std::memcpy(corrupt.data() + 10, &bogus, 8);
+            write_bytes(encrypted, corrupt);
+            REQUIRE_FALSE(StreamingCrypto::decrypt_file(encrypted.string(), decrypted.string(), kPassword).success);
+            REQUIRE_FALSE(StreamingCrypto::verify_file(encrypted.string(), kPassword).success);
+        }
+    }
+
+    SECTION("Inputs beyond the chunk count field are refused before writing") {
+        // Sparse: one byte past MAX_CHUNKS one-byte chunks
+        auto huge = dir / "huge_input.bin";
+        { std::ofstream create(huge, std::ios::binary); }
+        fs::resize_file(huge, StreamingCrypto::MAX_CHUNKS + 1);
+
+        auto config = fast_config();
+        config.chunk_size = 1;
+        auto enc = StreamingCrypto::encrypt_file(huge.string(), encrypted.string(), kPassword, config);
+        REQUIRE_FALSE(enc.success);
+        REQUIRE(enc.error_message.find("larger chunk size") != std::string::npos);
+        REQUIRE(fs::file_size(encrypted) == 0);
+    }
+
+    fs::remove_all(dir);
+}
+
+TEST_CASE("Streaming with direct I/O uses the aligned record layout", "[streaming][direct]") {
+    auto dir = test_dir();
+    auto input = dir / "direct_input.bin";
+    auto encrypted = dir / "direct_input.fvst";
+    auto decrypted = dir / "direct_output.bin";
+    
+    auto data = make_data(5 * 64 * 1024 + 123, false);
+    write_bytes(input, data);
+    
+    auto config = fast_config();
+    config.threads = 2;
+    config.direct_io = true;
+    REQUIRE(StreamingCrypto::encrypt_file(input.string(), encrypted.string(), kPassword, config).success);
+    
+    SECTION("Records start on 4 KiB boundaries") {
+        StreamingReader reader;
+        REQUIRE(reader.open(encrypted.string(), kPassword));
+        REQUIRE(reader.chunk_count() == 6);
+        
+        std::ifstream file(encrypted, std::ios::binary);
+        uint8_t header[6];
+        file.read(reinterpret_cast<char*>(header), 6);
+        REQUIRE((header[5] & StreamingCrypto::FLAG_ALIGNED) != 0);
+        
+        // Index footer starts right after the last padded record
+        uint64_t index_offset;
+        file.seekg(-16, std::ios::end);
+        file.read(reinterpret_cast<char*>(&index_offset), 8);
+        REQUIRE(index_offset % StreamingCrypto::RECORD_ALIGNMENT == 0);
+        REQUIRE(reader.read(64 * 1024 - 5, 10).value ==
+                std::vector<uint8_t>(data.begin() + 64 * 1024 - 5, data.begin() + 64 * 1024 + 5));
+    }
+    
+    SECTION("Decrypts with direct and buffered I/O") {
+        for (bool direct : {true, false}) {
+            StreamingConfig options;
+            options.direct_io = direct;
+            auto dec = StreamingCrypto::decrypt_file(encrypted.string(), decrypted.string(), kPassword, options);
+            REQUIRE(dec.success);
+            REQUIRE(read_bytes(decrypted) == data);
+        }
+        
+        std::ifstream sealed_file(encrypted, std::ios::binary);
+        std::ostringstream opened;
+        REQUIRE(StreamingCrypto::decrypt_stream(sealed_file, opened, kPassword).success);
+        REQUIRE(opened.str().size() == data.size());
+    }
+    
+    fs::remove_all(dir);
+}
+
+TEST_CASE("Streaming compresses chunks selectively", "[streaming][compression]") {
+    auto dir = test_dir();
+    auto input = dir / "mixed_input.bin";
+    auto encrypted = dir / "mixed_input.fvst";
+    auto decrypted = dir / "mixed_output.bin";
+    
+    // Alternate random (incompressible) and text-like chunks
+    const size_t chunk = 64 * 1024;
+    auto random = make_data(chunk, false);
+    auto text = make_data(chunk, true);
+    std::vector<uint8_t> data;
+    for (int i = 0; i < 4; ++i) {
+        const auto& part = (i % 2 == 0) ? random : text;
+        data.insert(data.end(), part.begin(), part.end());
+    }
+    data.insert(data.end(), text.begin(), text.begin() + 777);
+    write_bytes(input, data);
+    
+    auto config = fast_config();
+    config.compression = CompressionType::ZLIB;
+    config.threads = 3;
+    REQUIRE(StreamingCrypto::encrypt_file(input.string(), encrypted.string(), kPassword, config).success);
+    
+    SECTION("Only compressible chunks carry the compressed bit") {
+        std::ifstream file(encrypted, std::ios::binary);
+        uint8_t header[32];
+        file.read(reinterpret_cast<char*>(header), 31);
+        REQUIRE((header[5] & StreamingCrypto::FLAG_CHUNK_COMPRESSION) != 0);
+        uint8_t nonce_len = 0;
+        file.seekg(31 + header[30]);
+        file.read(reinterpret_cast<char*>(&nonce_len), 1);
+        file.seekg(nonce_len, std::ios::cur);
+        
+        std::vector<bool> compressed;
+        for (int i = 0; i < 5; ++i) {
+            uint32_t enc_size = 0;
+            file.read(reinterpret_cast<char*>(&enc_size), 4);
+            compressed.push_back((enc_size & StreamingCrypto::RECORD_COMPRESSED) != 0);
+            enc_size &= ~(StreamingCrypto::RECORD_COMPRESSED | StreamingCrypto::RECORD_LAST_CHUNK);
+            file.seekg(enc_size + 16, std::ios::cur);
+        }
+        REQUIRE(file.good());
+        REQUIRE(compressed == std::vector<bool>{false, true, false, true, true});
+        REQUIRE(fs::file_size(encrypted) < 3 * chunk);
+    }
+    
+    SECTION("Decrypts through the pipeline and the reader") {
+        StreamingConfig options;
+        options.threads = 2;
+        auto dec = StreamingCrypto::decrypt_file(encrypted.string(), decrypted.string(), kPassword, options);
+        REQUIRE(dec.success);
+        REQUIRE(read_bytes(decrypted) == data);
+        
+        StreamingReader reader;
+        REQUIRE(reader.open(encrypted.string(), kPassword));
+        REQUIRE(reader.read(chunk - 10, 20).value ==
+                std::vector<uint8_t>(data.begin() + chunk - 10, data.begin() + chunk + 10));
+    }
+    
+    SECTION("Flipping the compressed bit fails authentication") {
+        auto sealed = read_bytes(encrypted);
+        size_t first_record = 32 + sealed[30] + sealed[31 + sealed[30]];
+        sealed[first_record + 3] ^= 0x40;  // Little-endian: bit 30 lives in the fourth byte
+        write_bytes(encrypted, sealed);
+        
+        auto dec = StreamingCrypto::decrypt_file(encrypted.string(), decrypted.string(), kPassword);
+        REQUIRE_FALSE(dec.success);
+    }
+    
+    SECTION("Entropy probe can be disabled") {
+        config.skip_incompressible = false;
+        REQUIRE(StreamingCrypto::encrypt_file(input.string(), encrypted.string(), kPassword, config).success);
+        auto dec = StreamingCrypto::decrypt_file(encrypted.string(), decrypted.string(), kPassword);
+        REQUIRE(dec.success);
+        REQUIRE(read_bytes(decrypted) == data);
+    }
+    
+    fs::remove_all(dir);
+}
+
+TEST_CASE("Checkpointed streaming encryption resumes after an interruption", "[streaming][resume]") {
+    auto dir = test_dir();
+    auto input = dir / "resume_input.bin";
+    auto encrypted = dir / "resume_input.fvst";
+    auto decrypted = dir / "resume_output.bin";
+    auto journal = fs::path(StreamingCrypto::checkpoint_path(encrypted.string()));
+    
+    auto data = make_data(9 * 64 * 1024 + 4321, false);
+    write_bytes(input, data);
+    
+    auto config = fast_config();
+    config.threads = 2;
+    config.checkpoint_interval = 2;
+    
+    SECTION("Uninterrupted run leaves no journal") {
+        REQUIRE(StreamingCrypto::encrypt_file(input.string(), encrypted.string(), kPassword, config).success);
+        REQUIRE_FALSE(fs::exists(journal));
+    }
+    
+    // Simulate a crash: stop after chunk 5, leaving a torn record after the last checkpoint
+    auto interrupted = config;
+    interrupted.progress_callback = [](const ChunkInfo& info) { return info.chunk_index < 5; };
+    REQUIRE_FALSE(StreamingCrypto::encrypt_file(input.string(), encrypted.string(), kPassword, interrupted).success);
+    REQUIRE(fs::exists(journal));
+    {
+        std::ofstream torn(encrypted, std::ios::binary | std::ios::app);
+        torn << "partially written record";
+    }
+    
+    SECTION("Resume completes the file") {
+        size_t first_chunk = 0;
+        auto options = config;
+        options.progress_callback = [&](const ChunkInfo& info) {
+            if (first_chunk == 0) {
+                first_chunk = info.chunk_index;
+            }
+            return true;
+        };
+        auto resumed = StreamingCrypto::resume_encrypt_file(input.string(), encrypted.string(), kPassword, options);
+        REQUIRE(resumed.success);
+        REQUIRE(first_chunk == 6);  // Checkpoints at chunks 2, 4 and 6
+        REQUIRE(resumed.chunks_processed == 4);
+        REQUIRE(resumed.bytes_processed == data.size() - 6 * 64 * 1024);
+        REQUIRE_FALSE(fs::exists(journal));
+        
+        auto dec = StreamingCrypto::decrypt_file(encrypted.string(), decrypted.string(), kPassword);
+        REQUIRE(dec.success);
+        REQUIRE(read_bytes(decrypted) == data);
+        
+        StreamingReader reader;
+        REQUIRE(reader.open(encrypted.string(), kPassword));
+        REQUIRE(reader.read(data.size() - 10, 10).value ==
+                std::vector<uint8_t>(data.end() - 10, data.end()));
+    }
+    
+    SECTION("Resume with another password is refused") {
+        auto resumed = StreamingCrypto::resume_encrypt_file(input.string(), encrypted.string(), "wrong", config);
+        REQUIRE_FALSE(resumed.success);
+        REQUIRE(fs::exists(journal));
+    }
+    
+    SECTION("Resume refuses a changed input") {
+        data.push_back(0x42);
+        write_bytes(input, data);
+        auto resumed = StreamingCrypto::resume_encrypt_file(input.string(), encrypted.string(), kPassword, config);
+        REQUIRE_FALSE(resumed.success);
+    }
+    
+    SECTION("Each resume encrypts in a new segment") {
+        // A same-size edit after the checkpoint must not reuse the discarded records' nonces
+        data[7 * 64 * 1024 + 9] ^= 0xFF;
+        write_bytes(input, data);
+        auto again = config;
+        again.progress_callback = [](const ChunkInfo& info) { return info.chunk_index < 7; };
+        REQUIRE_FALSE(StreamingCrypto::resume_encrypt_file(input.string(), encrypted.string(), kPassword, again).success);
+        REQUIRE(fs::exists(journal));
+        
+        REQUIRE(StreamingCrypto::resume_encrypt_file(input.string(), encrypted.string(), kPassword, config).success);
+        auto bytes = read_bytes(encrypted);
+        REQUIRE((bytes[5] & StreamingCrypto::FLAG_SEGMENTS) != 0);
+        REQUIRE(segment_markers(bytes).size() == 2);
+        
+        auto dec = StreamingCrypto::decrypt_file(encrypted.string(), decrypted.string(), kPassword);
+        REQUIRE(dec.success);
+        REQUIRE(read_bytes(decrypted) == data);
+        REQUIRE(StreamingCrypto::verify_file(encrypted.string(), kPassword).success);
+    }
+    
+    SECTION("Resume refuses edits to the kept chunks of a digest stream") {
+        auto digests = interrupted;
+        digests.chunk_digests = true;
+        REQUIRE_FALSE(StreamingCrypto::encrypt_file(input.string(), encrypted.string(), kPassword, digests).success);
+        
+        data[64 * 1024 + 3] ^= 0x01;
+        write_bytes(input, data);
+        REQUIRE_FALSE(StreamingCrypto::resume_encrypt_file(input.string(), encrypted.string(), kPassword, config).success);
+        REQUIRE(fs::exists(journal));
+        
+        data[64 * 1024 + 3] ^= 0x01;
+        write_bytes(input, data);
+        REQUIRE(StreamingCrypto::resume_encrypt_file(input.string(), encrypted.string(), kPassword, config).success);
+        
+        // The digests describe the records, so an update of the same input copies them all
+        digests.progress_callback = nullptr;
+        auto updated = StreamingCrypto::update_file(input.string(), encrypted.string(), kPassword, digests);
+        REQUIRE(updated.success);
+        REQUIRE(updated.chunks_unchanged == 10);
+    }
+    
+    fs::remove_all(dir);
+}
+
+TEST_CASE("Appending to a streaming file", "[streaming][append]") {
+    auto dir = test_dir();
+    auto first = dir / "append_first.bin";
+    auto second = dir / "append_second.bin";
+    auto third = dir / "append_third.bin";
+    auto encrypted = dir / "append.fvst";
+    auto decrypted = dir / "append_output.bin";
+    auto journal = fs::path(StreamingCrypto::append_journal_path(encrypted.string()));
+    
+    const size_t chunk = 64 * 1024;
+    auto data = make_data(3 * chunk + 1000, false);
+    auto more = make_data(2 * chunk + 77, true);
+    auto tail = make_data(500, false);
+    write_bytes(first, data);
+    write_bytes(second, more);
+    write_bytes(third, tail);
+    
+    auto config = fast_config();
+    config.threads = 2;
+    config.compression = CompressionType::ZLIB;
+    REQUIRE(StreamingCrypto::encrypt_file(first.string(), encrypted.string(), kPassword, config).success);
+    
+    std::vector<uint8_t> expected = data;
+    expected.insert(expected.end(), more.begin(), more.end());
+    
+    SECTION("Only the final chunk is re-encrypted") {
+        size_t first_chunk = SIZE_MAX;
+        auto options = config;
+        options.progress_callback = [&](const ChunkInfo& info) {
+            first_chunk = (std::min)(first_chunk, info.chunk_index);
+            return true;
+        };
+        auto appended = StreamingCrypto::append_file(second.string(), encrypted.string(), kPassword, options);
+        REQUIRE(appended.success);
+        REQUIRE(first_chunk == 3);
+        REQUIRE(appended.chunks_processed == 3);
+        REQUIRE(appended.bytes_processed == 1000 + more.size());
+        REQUIRE_FALSE(fs::exists(journal));
+        
+        REQUIRE(StreamingCrypto::append_file(third.string(), encrypted.string(), kPassword, config).success);
+        expected.insert(expected.end(), tail.begin(), tail.end());
+        
+        auto header = read_bytes(encrypted);
+        REQUIRE((header[5] & StreamingCrypto::FLAG_SEGMENTS) != 0);
+        
+        auto dec = StreamingCrypto::decrypt_file(encrypted.string(), decrypted.string(), kPassword);
+        REQUIRE(dec.success);
+        REQUIRE(read_bytes(decrypted) == expected);
+        
+        StreamingReader reader;
+        REQUIRE(reader.open(encrypted.string(), kPassword));
+        REQUIRE(reader.has_index_footer());
+        REQUIRE(reader.size() == expected.size());
+        REQUIRE(reader.read(3 * chunk - 10, 2 * chunk).value ==
+                std::vector<uint8_t>(expected.begin() + 3 * chunk - 10, expected.begin() + 5 * chunk - 10));
+        REQUIRE(reader.read(expected.size() - 600, 600).value ==
+                std::vector<uint8_t>(expected.end() - 600, expected.end()));
+    }
+    
+    SECTION("Forged segment markers are rejected") {
+        REQUIRE(StreamingCrypto::append_file(second.string(), encrypted.string(), kPassword, config).success);
+        REQUIRE(StreamingCrypto::append_file(third.string(), encrypted.string(), kPassword, config).success);
+        const auto original = read_bytes(encrypted);
+        const auto markers = segment_markers(original);
+        REQUIRE(markers.size() == 2);
+        const size_t nonce_len = original[31 + original[30]];
+        const size_t marker_size = 4 + nonce_len + 8 + 16;
+        
+        auto rejected = [&](const std::vector<uint8_t>& forged) {
+            write_bytes(encrypted, forged);
+            REQUIRE_FALSE(StreamingCrypto::decrypt_file(encrypted.string(), decrypted.string(), kPassword).success);
+            REQUIRE_FALSE(StreamingCrypto::verify_file(encrypted.string(), kPassword).success);
+        };
+        
+        // Id, first nonce index and tag; the top bit of id byte 7 would turn
+        // an old-format base nonce into last-chunk nonces
+        for (size_t offset : {size_t(4 + 7), 4 + nonce_len, marker_size - 1}) {
+            auto forged = original;
+            forged[markers[1] + offset] ^= 0x80;
+            rejected(forged);
+        }
+        
+        // The first marker replayed in front of the second, or the second dropped
+        auto replayed = original;
+        replayed.insert(replayed.begin() + static_cast<std::ptrdiff_t>(markers[1]),
+                        original.begin() + static_cast<std::ptrdiff_t>(markers[0]),
+                        original.begin() + static_cast<std::ptrdiff_t>(markers[0] + marker_size));
+        rejected(replayed);
+        
+        auto dropped = original;
+        dropped.erase(dropped.begin() + static_cast<std::ptrdiff_t>(markers[1]),
+                      dropped.begin() + static_cast<std::ptrdiff_t>(markers[1] + marker_size));
+        rejected(dropped);
+        
+        // A marker from another stream spliced into one that had none
+        write_bytes(encrypted, original);
+        auto other = dir / "append_other.fvst";
+        REQUIRE(StreamingCrypto::encrypt_file(first.string(), other.string(), kPassword, config).success);
+        auto spliced = read_bytes(other);
+        spliced[5] |= StreamingCrypto::FLAG_SEGMENTS;
+        const size_t records = 32 + spliced[30] + spliced[31 + spliced[30]];
+        spliced.insert(spliced.begin() + static_cast<std::ptrdiff_t>(records),
+                       original.begin() + static_cast<std::ptrdiff_t>(markers[0]),
+                       original.begin() + static_cast<std::ptrdiff_t>(markers[0] + marker_size));
+        write_bytes(other, spliced);
+        REQUIRE_FALSE(StreamingCrypto::decrypt_file(other.string(), decrypted.string(), kPassword).success);
+    }
+    
+    SECTION("An append that would wrap the chunk counter is refused") {
+        auto small = config;
+        small.chunk_size = 1;
+        small.compression = CompressionType::NONE;
+        write_bytes(first, {1, 2, 3});
+        REQUIRE(StreamingCrypto::encrypt_file(first.string(), encrypted.string(), kPassword, small).success);
+        auto before = read_bytes(encrypted);
+        
+        // Sparse: with the three chunks already there, the counter would pass MAX_CHUNKS
+        auto huge = dir / "append_huge.bin";
+        { std::ofstream create(huge, std::ios::binary); }
+        fs::resize_file(huge, StreamingCrypto::MAX_CHUNKS - 1);
+        auto appended = StreamingCrypto::append_file(huge.string(), encrypted.string(), kPassword, small);
+        REQUIRE_FALSE(appended.success);
+        REQUIRE(appended.error_message.find("chunks") != std::string::npos);
+        REQUIRE(read_bytes(encrypted) == before);
+        REQUIRE_FALSE(fs::exists(journal));
+    }
+    
+    SECTION("Append with another password leaves the file untouched") {
+        auto before = read_bytes(encrypted);
+        auto appended = StreamingCrypto::append_file(second.string(), encrypted.string(), "wrong", config);
+        REQUIRE_FALSE(appended.success);
+        REQUIRE(read_bytes(encrypted) == before);
+        REQUIRE_FALSE(fs::exists(journal));
+    }
+    
+    SECTION("An interrupted append is rolled back") {
+        auto before = read_bytes(encrypted);
+        auto interrupted = config;
+        interrupted.progress_callback = [](const ChunkInfo& info) { return info.chunk_index < 4; };
+        REQUIRE_FALSE(StreamingCrypto::append_file(second.string(), encrypted.string(), kPassword, interrupted).success);
+        REQUIRE(read_bytes(encrypted) == before);
+        
+        REQUIRE(StreamingCrypto::append_file(second.string(), encrypted.string(), kPassword, config).success);
+        auto dec = StreamingCrypto::decrypt_file(encrypted.string(), decrypted.string(), kPassword);
+        REQUIRE(dec.success);
+        REQUIRE(read_bytes(decrypted) == expected);
+    }
+    
+    fs::remove_all(dir);
+}
+
+TEST_CASE("Delta update re-encrypts only changed chunks", "[streaming][update]") {
+    auto dir = test_dir();
+    auto input = dir / "update_input.bin";
+    auto encrypted = dir / "update.fvst";
+    auto decrypted = dir / "update_output.bin";
+    
+    const size_t chunk = 64 * 1024;
+    auto data = make_data(8 * chunk + 500, false);
+    write_bytes(input, data);
+    
+    auto config = fast_config();
+    config.threads = 2;
+    config.chunk_digests = true;
+    REQUIRE(StreamingCrypto::encrypt_file(input.string(), encrypted.string(), kPassword, config).success);
+    
+    auto decrypts_to = [&](const std::vector<uint8_t>& expected) {
+        auto dec = StreamingCrypto::decrypt_file(encrypted.string(), decrypted.string(), kPassword);
+        REQUIRE(dec.success);
+        REQUIRE(read_bytes(decrypted) == expected);
+        
+        StreamingReader reader;
+        REQUIRE(reader.open(encrypted.string(), kPassword));
+        REQUIRE(reader.size() == expected.size());
+        REQUIRE(reader.read(2 * chunk - 5, chunk + 10).value ==
+                std::vector<uint8_t>(expected.begin() + 2 * chunk - 5, expected.begin() + 3 * chunk + 5));
+    };
+    
+    SECTION("Unchanged input copies every record") {
+        auto updated = StreamingCrypto::update_file(input.string(), encrypted.string(), kPassword, config);
+        REQUIRE(updated.success);
+        REQUIRE(updated.chunks_processed == 9);
+        REQUIRE(updated.chunks_unchanged == 9);
+        decrypts_to(data);
+    }
+    
+    SECTION("Changed chunks get fresh records") {
+        data[2 * chunk + 7] ^= 0xFF;
+        data[5 * chunk] ^= 0x01;
+        write_bytes(input, data);
+        auto updated = StreamingCrypto::update_file(input.string(), encrypted.string(), kPassword, config);
+        REQUIRE(updated.success);
+        // The final record is bound to the new segments, so it is re-encrypted too
+        REQUIRE(updated.chunks_unchanged == 6);
+        decrypts_to(data);
+        
+        // A second update starts from the segmented stream
+        data[6 * chunk + 1] ^= 0x10;
+        write_bytes(input, data);
+        updated = StreamingCrypto::update_file(input.string(), encrypted.string(), kPassword, config);
+        REQUIRE(updated.success);
+        REQUIRE(updated.chunks_unchanged == 7);
+        decrypts_to(data);
+    }
+    
+    SECTION("Growing input re-encrypts the old final chunk") {
+        auto more = make_data(chunk, true);
+        data.insert(data.end(), more.begin(), more.end());
+        write_bytes(input, data);
+        auto updated = StreamingCrypto::update_file(input.string(), encrypted.string(), kPassword, config);
+        REQUIRE(updated.success);
+        REQUIRE(updated.chunks_processed == 10);
+        REQUIRE(updated.chunks_unchanged == 8);
+        decrypts_to(data);
+    }
+    
+    SECTION("Update with another password is refused") {
+        auto before = read_bytes(encrypted);
+        REQUIRE_FALSE(StreamingCrypto::update_file(input.string(), encrypted.string(), "wrong", config).success);
+        REQUIRE(read_bytes(encrypted) == before);
+    }
+    
+    SECTION("Streams without digests are rewritten once") {
+        config.chunk_digests = false;
+        REQUIRE(StreamingCrypto::encrypt_file(input.string(), encrypted.string(), kPassword, config).success);
+        auto updated = StreamingCrypto::update_file(input.string(), encrypted.string(), kPassword, config);
+        REQUIRE(updated.success);
+        REQUIRE(updated.chunks_unchanged == 0);
+        updated = StreamingCrypto::update_file(input.string(), encrypted.string(), kPassword, config);
+        REQUIRE(updated.success);
+        REQUIRE(updated.chunks_unchanged == 9);
+        decrypts_to(data);
+    }
+    
+    fs::remove_all(dir);
+}
+
+TEST_CASE("Commands switch large inputs to streaming", "[streaming][switch]") {
+    auto path = test_dir() / "switch_input.bin";
+    write_bytes(path, make_data(4096, false));
+    
+    REQUIRE(StreamingCrypto::should_use_streaming(path.string(), 1024));
+    REQUIRE_FALSE(StreamingCrypto::should_use_streaming(path.string(), 4096));
+    REQUIRE_FALSE(StreamingCrypto::should_use_streaming((test_dir() / "missing.bin").string(), 0));
+    
+    REQUIRE(StreamingCrypto::supports_algorithm(AlgorithmType::AES_256_GCM));
+    REQUIRE(StreamingCrypto::supports_algorithm(AlgorithmType::CHACHA20_POLY1305));
+    REQUIRE_FALSE(StreamingCrypto::supports_algorithm(AlgorithmType::AES_256_CBC));
+    REQUIRE_FALSE(StreamingCrypto::supports_algorithm(AlgorithmType::AES_256_XTS));
+}
+
+TEST_CASE("Verify-only integrity scan", "[streaming][verify]") {
+    auto dir = test_dir();
+    auto input = dir / "verify_input.bin";
+    auto encrypted = dir / "verify.fvst";
+    
+    const size_t chunk = 64 * 1024;
+    auto data = make_data(8 * chunk + 500, false);
+    write_bytes(input, data);
+    
+    auto config = fast_config();
+    config.threads = 4;
+    REQUIRE(StreamingCrypto::encrypt_file(input.string(), encrypted.string(), kPassword, config).success);
+    auto sealed = read_bytes(encrypted);
+    
+    // Footer: 9 index entries + trailer; records: size + payload + tag
+    const size_t footer = 9 * 12 + 16;
+    const size_t record = 4 + chunk + 16;
+    const size_t first_record = sealed.size() - footer - (4 + 500 + 16) - 8 * record;
+    
+    SECTION("An intact file verifies") {
+        auto verified = StreamingCrypto::verify_file(encrypted.string(), kPassword, config);
+        REQUIRE(verified.success);
+        REQUIRE(verified.chunks_processed == 9);
+        REQUIRE_FALSE(verified.bad_chunk.has_value());
+    }
+    
+    SECTION("The first bad chunk and its offset are reported") {
+        auto corrupted = sealed;
+        corrupted[first_record + 5 * record + 100] ^= 0x01;
+        corrupted[first_record + 7 * record + 100] ^= 0x01;
+        write_bytes(encrypted, corrupted);
+        
+        auto verified = StreamingCrypto::verify_file(encrypted.string(), kPassword, config);
+        REQUIRE_FALSE(verified.success);
+        REQUIRE(verified.bad_chunk == std::optional<size_t>(5));
+        REQUIRE(verified.bad_offset == first_record + 5 * record);
+        REQUIRE(verified.chunks_processed == 5);
+    }
+    
+    SECTION("A truncated record is reported") {
+        sealed.resize(first_record + 3 * record + 10);
+        write_bytes(encrypted, sealed);
+        
+        auto verified = StreamingCrypto::verify_file(encrypted.string(), kPassword, config);
+        REQUIRE_FALSE(verified.success);
+        REQUIRE(verified.bad_chunk == std::optional<size_t>(3));
+        REQUIRE(verified.bad_offset == first_record + 3 * record);
+    }
+    
+    SECTION("Wrong password fails on the first chunk") {
+        auto verified = StreamingCrypto::verify_file(encrypted.string(), "wrong password", config);
+        REQUIRE_FALSE(verified.success);
+        REQUIRE(verified.bad_chunk == std::optional<size_t>(0));
+        REQUIRE(verified.bad_offset == first_record);
+    }
+}
+
+TEST_CASE("Content-defined chunker boundaries follow the content", "[streaming][cdc]") {
+    const std::vector<uint8_t> key(32, 0x5A);
+    ContentChunker chunker(key, 1024, 4096, 16 * 1024);
+    REQUIRE(chunker.avg_size() == 4096);
+    
+    auto data = make_data(512 * 1024, false);
+    auto boundaries = [](const ContentChunker& c, const std::vector<uint8_t>& bytes) {
+        std::vector<size_t> ends;
+        size_t offset = 0;
+        while (offset < bytes.size()) {
+            size_t cut = c.cut_point(bytes.data() + offset, bytes.size() - offset);
+            REQUIRE(cut > 0);
+            REQUIRE(cut <= c.max_size());
+            if (offset + cut < bytes.size()) {
+                REQUIRE(cut >= c.min_size());
+            }
+            offset += cut;
+            ends.push_back(offset);
+        }
+        return ends;
+    };
+    
+    auto original = boundaries(chunker, data);
+    REQUIRE(original.back() == data.size());
+    // Normalized chunking keeps the average near the target
+    double average = double(data.size()) / original.size();
+    REQUIRE(average > 2048);
+    REQUIRE(average < 8192);
+    
+    SECTION("An insertion only moves nearby boundaries") {
+        auto edited = data;
+        edited.insert(edited.begin() + 100, 0x42);
+        auto shifted = boundaries(chunker, edited);
+        size_t kept = 0;
+        for (size_t end : shifted) {
+            if (std::binary_search(original.begin(), original.end(), end - 1)) {
+                ++kept;
+            }
+        }
+        REQUIRE(kept + 3 >= original.size());
+    }
+    
+    SECTION("Boundaries depend on the key") {
+        ContentChunker other(std::vector<uint8_t>(32, 0xA5), 1024, 4096, 16 * 1024);
+        REQUIRE(boundaries(other, data) != original);
+    }
+}
+
+TEST_CASE("Content-defined streaming", "[streaming][cdc]") {
+    auto dir = test_dir();
+    auto input = dir / "cdc_input.bin";
+    auto encrypted = dir / "cdc.fvst";
+    auto decrypted = dir / "cdc_output.bin";
+    
+    auto data = make_data(1024 * 1024 + 321, false);
+    write_bytes(input, data);
+    
+    auto config = fast_config();
+    config.threads = 2;
+    config.chunk_digests = true;
+    config.content_defined_chunks = true;
+    auto enc = StreamingCrypto::encrypt_file(input.string(), encrypted.string(), kPassword, config);
+    REQUIRE(enc.success);
+    REQUIRE(enc.chunks_processed > 16);  // Average chunk is a quarter of chunk_size
+    
+    auto header = read_bytes(encrypted);
+    REQUIRE((header[5] & StreamingCrypto::FLAG_CONTENT_DEFINED) != 0);
+    
+    auto decrypts_to = [&](const std::vector<uint8_t>& expected) {
+        auto dec = StreamingCrypto::decrypt_file(encrypted.string(), decrypted.string(), kPassword);
+        REQUIRE(dec.success);
+        REQUIRE(read_bytes(decrypted) == expected);
+        
+        StreamingReader reader;
+        REQUIRE(reader.open(encrypted.string(), kPassword));
+        REQUIRE(reader.size() == expected.size());
+        REQUIRE(reader.read(300000, 70000).value ==
+                std::vector<uint8_t>(expected.begin() + 300000, expected.begin() + 370000));
+    };
+    decrypts_to(data);
+    
+    SECTION("Update after an insertion copies the moved chunks") {
+        std::vector<uint8_t> inserted(100, 0x33);
+        data.insert(data.begin() + 50000, inserted.begin(), inserted.end());
+        write_bytes(input, data);
+        auto updated = StreamingCrypto::update_file(input.string(), encrypted.string(), kPassword, config);
+        REQUIRE(updated.success);
+        REQUIRE(updated.chunks_unchanged + 4 >= updated.chunks_processed);
+        decrypts_to(data);
+    }
+    
+    SECTION("Append keeps content-defined chunks") {
+        auto extra = dir / "cdc_extra.bin";
+        auto more = make_data(200000, true);
+        write_bytes(extra, more);
+        REQUIRE(StreamingCrypto::append_file(extra.string(), encrypted.string(), kPassword, config).success);
+        data.insert(data.end(), more.begin(), more.end());
+        decrypts_to(data);
+    }
+    
+    SECTION("Inputs that could wrap the chunk counter are refused") {
+        // 16-byte chunks are cut as short as one byte
+        REQUIRE(ContentChunker::max_stream_chunks(1000, 16) == 1001);
+        REQUIRE(ContentChunker::max_stream_chunks(1000, 64 * 1024) == 1);
+        
+        auto huge = dir / "cdc_huge.bin";
+        { std::ofstream create(huge, std::ios::binary); }
+        fs::resize_file(huge, StreamingCrypto::MAX_CHUNKS);
+        auto tiny = config;
+        tiny.chunk_size = 16;
+        auto enc = StreamingCrypto::encrypt_file(huge.string(), decrypted.string(), kPassword, tiny);
+        REQUIRE_FALSE(enc.success);
+        REQUIRE(enc.error_message.find("larger chunk size") != std::string::npos);
+        
+        auto small = dir / "cdc_small.bin";
+        write_bytes(small, make_data(100, false));
+        REQUIRE(StreamingCrypto::encrypt_file(small.string(), encrypted.string(), kPassword, tiny).success);
+        auto before = read_bytes(encrypted);
+        REQUIRE_FALSE(StreamingCrypto::append_file(huge.string(), encrypted.string(), kPassword, tiny).success);
+        REQUIRE(read_bytes(encrypted) == before);
+    }
+    
+    SECTION("Checkpointing needs fixed-size chunks") {
+        config.checkpoint_interval = 2;
+        REQUIRE_FALSE(StreamingCrypto::encrypt_file(input.string(), encrypted.string(), kPassword, config).success);
+    }
+    
+    fs::remove_all(dir);
+}
+
+TEST_CASE("Streaming reader random access", "[streaming][reader]") {
+    auto dir = test_dir();
+    auto input = dir / "reader_input.bin";
+    auto encrypted = dir / "reader_input.fvst";
+    
+    const size_t chunk = 64 * 1024;
+    auto data = make_data(7 * chunk + 999, false);
+    write_bytes(input, data);
+    
+    auto config = fast_config();
+    config.threads = 2;
+    REQUIRE(StreamingCrypto::encrypt_file(input.string(), encrypted.string(), kPassword, config).success);
+    REQUIRE(StreamingCrypto::is_streaming_file(encrypted.string()));
+    REQUIRE_FALSE(StreamingCrypto::is_streaming_file(input.string()));
+    
+    auto slice = [&](size_t offset, size_t length) {
+        return std::vector<uint8_t>(data.begin() + offset, data.begin() + offset + length);
+    };
+    
+    SECTION("Reads ranges across chunk boundaries") {
+        StreamingReader reader(2);
+        REQUIRE(reader.open(encrypted.string(), kPassword));
+        REQUIRE(reader.has_index_footer());
+        REQUIRE(reader.size() == data.size());
+        REQUIRE(reader.chunk_count() == 8);
+        
+        REQUIRE(reader.read(0, 100).value == slice(0, 100));
+        REQUIRE(reader.read(chunk - 10, 20).value == slice(chunk - 10, 20));
+        REQUIRE(reader.read(3 * chunk + 5, 2 * chunk).value == slice(3 * chunk + 5, 2 * chunk));
+        
+        // Tail of the stream is clamped at end of file
+        auto tail = reader.read(data.size() - 50, 1000);
+        REQUIRE(tail.value == slice(data.size() - 50, 50));
+        REQUIRE(reader.tell() == data.size());
+        REQUIRE_FALSE(reader.seek(data.size() + 1));
+    }
+    
+    SECTION("Sequential small reads hit the cache") {
+        StreamingReader reader(2);
+        REQUIRE(reader.open(encrypted.string(), kPassword));
+        REQUIRE(reader.seek(chunk));
+        
+        std::vector<uint8_t> collected;
+        for (int i = 0; i < 16; ++i) {
+            auto piece = reader.read(1024);
+            REQUIRE(piece);
+            collected.insert(collected.end(), piece.value.begin(), piece.value.end());
+        }
+        REQUIRE(collected == slice(chunk, 16 * 1024));
+        REQUIRE(reader.cache_misses() == 1);
+        REQUIRE(reader.cache_hits() == 15);
+    }
+    
+    SECTION("Only touched chunks are authenticated") {
+        // Flip a byte in the middle of the file, inside one of the middle chunks
+        auto bytes = read_bytes(encrypted);
+        bytes[bytes.size() / 2] ^= 0xFF;
+        write_bytes(encrypted, bytes);
+        
+        StreamingReader reader;
+        REQUIRE(reader.open(encrypted.string(), kPassword));
+        REQUIRE(reader.read(0, 10).value == slice(0, 10));
+        REQUIRE(reader.read(data.size() - 10, 10).value == slice(data.size() - 10, 10));
+        REQUIRE_FALSE(reader.read(data.size() / 2 - chunk / 2, chunk));
+    }
+    
+    SECTION("Wrong password fails on open") {
+        // Opening authenticates the final record, which is bound to the segment table
+        StreamingReader reader;
+        REQUIRE_FALSE(reader.open(encrypted.string(), "wrong"));
+        REQUIRE_FALSE(reader.read(0, 10));
+    }
+    
+    fs::remove_all(dir);
+}
+
+TEST_CASE("Streaming through iostreams of unknown length", "[streaming][pipe]") {
+    auto config = fast_config();
+    config.threads = 3;
+    
+    auto round_trip = [&](const std::vector<uint8_t>& data) {
+        std::istringstream plain(std::string(data.begin(), data.end()));
+        std::ostringstream sealed;
+        auto enc = StreamingCrypto::encrypt_stream(plain, sealed, kPassword, config);
+        REQUIRE(enc.success);
+        REQUIRE(enc.bytes_processed == data.size());
+        return sealed.str();
+    };
+    
+    SECTION("Round trip, including exact multiples of the chunk size and empty input") {
+        for (size_t size : {size_t(0), size_t(1000), size_t(3 * 64 * 1024), size_t(3 * 64 * 1024 + 7)}) {
+            auto data = make_data(size, false);
+            std::istringstream sealed(round_trip(data));
+            std::ostringstream opened;
+            
+            auto dec = StreamingCrypto::decrypt_stream(sealed, opened, kPassword);
+            REQUIRE(dec.success);
+            auto out = opened.str();
+            REQUIRE(std::vector<uint8_t>(out.begin(), out.end()) == data);
+        }
+    }
+    
+    SECTION("Unknown-length file is seekable through its index") {
+        auto data = make_data(4 * 64 * 1024 + 10, false);
+        auto sealed = round_trip(data);
+        auto path = test_dir() / "pipe.fvst";
+        write_bytes(path, std::vector<uint8_t>(sealed.begin(), sealed.end()));
+        
+        StreamingReader reader;
+        REQUIRE(reader.open(path.string(), kPassword));
+        REQUIRE(reader.has_index_footer());
+        REQUIRE(reader.size() == data.size());
+        REQUIRE(reader.read(data.size() - 100, 100).value ==
+                std::vector<uint8_t>(data.end() - 100, data.end()));
+        reader.close();
+        fs::remove_all(test_dir());
+    }
+    
+    SECTION("Truncation is detected without a chunk count") {
+        auto data = make_data(4 * 64 * 1024 + 10, false);
+        auto sealed = round_trip(data);
+        
+        // Footer: 5 index entries + trailer; final record: size + 10 bytes + tag
+        const size_t footer = 5 * 12 + 16;
+        const size_t last_record = 4 + 10 + 16;
+        size_t without_last = sealed.size() - footer - last_record;
+        
+        for (size_t keep : {without_last, sealed.size() / 2, without_last - 100}) {
+            std::istringstream truncated(sealed.substr(0, keep));
+            std::ostringstream opened;
+            auto dec = StreamingCrypto::decrypt_stream(truncated, opened, kPassword);
+            REQUIRE_FALSE(dec.success);
+        }
+        
+        // Clearing the end-of-stream bit on the final record must not authenticate
+        std::string forged = sealed;
+        uint32_t size_field;
+        std::memcpy(&size_field, forged.data() + without_last, 4);
+        REQUIRE((size_field & StreamingCrypto::RECORD_LAST_CHUNK) != 0);
+        size_field &= ~StreamingCrypto::RECORD_LAST_CHUNK;
+        std::memcpy(forged.data() + without_last, &size_field, 4);
+        
+        std::istringstream forged_in(forged);
+        std::ostringstream opened;
+        REQUIRE_FALSE(StreamingCrypto::decrypt_stream(forged_in, opened, kPassword).success);
+    }
+}
@@ -0,0 +1,137 @@
+/**
+ * @file test_system_resources.cpp
+ * @brief Unit tests for the cgroup-aware CPU/memory probe
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include "filevault/core/system_resources.hpp"
+#include "filevault/core/streaming.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+
+using namespace filevault::core;
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr uint64_t MiB = 1024 * 1024;
+
+fs::path test_dir() {
+    static fs::path dir = fs::absolute("test_system_resources_temp");
+    return dir;
+}
+
+void write_text(const fs::path& path, const std::string& text) {
+    fs::create_directories(path.parent_path());
+    std::ofstream file(path);
+    file << text;
+}
+
+// Fake root with 8 GiB of host memory, 6 GiB of it available
+fs::path fake_root(const std::string& name) {
+    fs::path root = test_dir() / name;
+    fs::remove_all(root);
+    write_text(root / "proc/meminfo",
+               "MemTotal:        8388608 kB\n"
+               "MemFree:         1048576 kB\n"
+               "MemAvailable:    6291456 kB\n");
+    return root;
+}
+
+} // anonymous namespace
+
+TEST_CASE("System resource probe reads cgroup limits", "[resources]") {
+#if defined(__linux__)
+    SECTION("Without a cgroup only host figures apply") {
+        auto root = fake_root("none");
+        auto res = SystemResources::probe(root.string());
+        REQUIRE(res.cgroup == "none");
+        REQUIRE(res.total_memory == 8192 * MiB);
+        REQUIRE(res.available_memory == 6144 * MiB);
+        REQUIRE_FALSE(res.memory_limit.has_value());
+        REQUIRE_FALSE(res.cpu_quota.has_value());
+        REQUIRE(res.cpu_count == res.affinity_cpus);
+    }
+
+    SECTION("cgroup v2: the tightest limit on the path to the root wins") {
+        auto root = fake_root("v2");
+        write_text(root / "proc/self/cgroup", "0::/kubepods/pod1/app\n");
+        auto cg = root / "sys/fs/cgroup";
+        write_text(cg / "cgroup.controllers", "cpu memory\n");
+        write_text(cg / "kubepods/memory.max", "max\n");
+        write_text(cg / "kubepods/pod1/memory.max", std::to_string(512 * MiB) + "\n");
+        write_text(cg / "kubepods/pod1/memory.current", std::to_string(128 * MiB) + "\n");
+        write_text(cg / "kubepods/pod1/app/memory.max", "max\n");
+        write_text(cg / "kubepods/pod1/app/cpu.max", "150000 100000\n");
+
+        auto res = SystemResources::probe(root.string());
+        REQUIRE(res.cgroup == "v2");
+        REQUIRE(res.memory_limit == std::optional<uint64_t>(512 * MiB));
+        REQUIRE(res.available_memory == 384 * MiB);
+        REQUIRE(res.cpu_quota == std::optional<double>(1.5));
+        REQUIRE(res.cpu_count == std::min<size_t>(2, res.affinity_cpus));
+    }
+
+    SECTION("cgroup v2 inside a namespace: the container's cgroup is the root") {
+        auto root = fake_root("v2ns");
+        write_text(root / "proc/self/cgroup", "0::/\n");
+        auto cg = root / "sys/fs/cgroup";
+        write_text(cg / "cgroup.controllers", "cpu memory\n");
+        write_text(cg / "memory.max", std::to_string(256 * MiB) + "\n");
+        write_text(cg / "cpu.max", "max 100000\n");
+
+        auto res = SystemResources::probe(root.string());
+        REQUIRE(res.memory_limit == std::optional<uint64_t>(256 * MiB));
+        REQUIRE(res.available_memory == 256 * MiB);
+        REQUIRE_FALSE(res.cpu_quota.has_value());
+    }
+
+    SECTION("cgroup v1, including unlimited sentinels") {
+        auto root = fake_root("v1");
+        write_text(root / "proc/self/cgroup",
+                   "5:memory:/docker/abc\n"
+                   "3:cpu,cpuacct:/docker/abc\n"
+                   "0::/\n");
+        auto cg = root / "sys/fs/cgroup";
+        // The host path is not visible inside the container; its cgroup is the mount root
+        write_text(cg / "memory/memory.limit_in_bytes", std::to_string(1024 * MiB) + "\n");
+        write_text(cg / "memory/memory.usage_in_bytes", std::to_string(24 * MiB) + "\n");
+        write_text(cg / "cpu,cpuacct/cpu.cfs_quota_us", "50000\n");
+        write_text(cg / "cpu,cpuacct/cpu.cfs_period_us", "100000\n");
+
+        auto res = SystemResources::probe(root.string());
+        REQUIRE(res.cgroup == "v1");
+        REQUIRE(res.memory_limit == std::optional<uint64_t>(1024 * MiB));
+        REQUIRE(res.available_memory == 1000 * MiB);
+        REQUIRE(res.cpu_quota == std::optional<double>(0.5));
+        REQUIRE(res.cpu_count == 1);
+
+        write_text(cg / "memory/memory.limit_in_bytes", "9223372036854771712\n");
+        write_text(cg / "cpu,cpuacct/cpu.cfs_quota_us", "-1\n");
+        res = SystemResources::probe(root.string());
+        REQUIRE_FALSE(res.memory_limit.has_value());
+        REQUIRE_FALSE(res.cpu_quota.has_value());
+        REQUIRE(res.available_memory == 6144 * MiB);
+    }
+
+    fs::remove_all(test_dir());
+#endif
+}
+
+TEST_CASE("Streaming sizes itself to the probed resources", "[resources]") {
+    const auto& res = SystemResources::current();
+    REQUIRE(res.cpu_count >= 1);
+    REQUIRE(res.cpu_count <= res.affinity_cpus);
+    REQUIRE(StreamingCrypto::resolve_thread_count(0) == res.cpu_count);
+    REQUIRE(StreamingCrypto::resolve_thread_count(3) == 3);
+
+    size_t chunk = StreamingCrypto::get_recommended_chunk_size();
+    REQUIRE(chunk >= MiB);
+    REQUIRE(chunk % MiB == 0);
+    // A full pipeline stays within the default in-flight budget
+    REQUIRE(chunk * (res.cpu_count + 2) <= (std::max)(StreamingConfig{}.max_in_flight_bytes,
+                                                      size_t(MiB) * (res.cpu_count + 2)));
+}
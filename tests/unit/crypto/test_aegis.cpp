@@ -0,0 +1,205 @@
+/**
+ * @file test_aegis.cpp
+ * @brief Unit tests for AEGIS-128L / AEGIS-256
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include "filevault/algorithms/symmetric/aegis.hpp"
+#include "filevault/core/algorithm_registry.hpp"
+#include "filevault/core/crypto_engine.hpp"
+#include "filevault/core/file_format.hpp"
+#include <botan/aead.h>
+#include <botan/hex.h>
+#include <algorithm>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace filevault::algorithms::symmetric;
+using namespace filevault::core;
+
+namespace {
+
+// AEGIS arrived in Botan 3.7; older builds report the algorithm as unavailable
+bool aegis_available() {
+    return Botan::AEAD_Mode::create("AEGIS-128L", Botan::Cipher_Dir::Encryption) != nullptr;
+}
+
+std::vector<uint8_t> bytes(const std::string& text) {
+    return std::vector<uint8_t>(text.begin(), text.end());
+}
+
+} // anonymous namespace
+
+TEST_CASE("AEGIS parameters and registration", "[aegis]") {
+    AEGIS aegis128(128);
+    REQUIRE(aegis128.name() == "AEGIS-128L");
+    REQUIRE(aegis128.type() == AlgorithmType::AEGIS_128L);
+    REQUIRE(aegis128.key_size() == 16);
+    REQUIRE(aegis128.nonce_size() == 16);
+
+    AEGIS aegis256(256);
+    REQUIRE(aegis256.name() == "AEGIS-256");
+    REQUIRE(aegis256.type() == AlgorithmType::AEGIS_256);
+    REQUIRE(aegis256.key_size() == 32);
+    REQUIRE(aegis256.nonce_size() == 32);
+
+    REQUIRE_THROWS_AS(AEGIS(192), std::invalid_argument);
+
+    REQUIRE(aegis128.is_suitable_for(SecurityLevel::MEDIUM));
+    REQUIRE_FALSE(aegis128.is_suitable_for(SecurityLevel::PARANOID));
+    REQUIRE(aegis256.is_suitable_for(SecurityLevel::PARANOID));
+
+    REQUIRE(CryptoEngine::parse_algorithm("aegis-128l") == AlgorithmType::AEGIS_128L);
+    REQUIRE(CryptoEngine::parse_algorithm("AEGIS-256") == AlgorithmType::AEGIS_256);
+    REQUIRE(find_algorithm(AlgorithmType::AEGIS_128L)->nonce_size == aegis128.nonce_size());
+    REQUIRE(find_algorithm(AlgorithmType::AEGIS_256)->nonce_size == aegis256.nonce_size());
+
+    REQUIRE(FileFormatHandler::to_algorithm_id(AlgorithmType::AEGIS_128L) == AlgorithmID::AEGIS_128L);
+    REQUIRE(FileFormatHandler::from_algorithm_id(AlgorithmID::AEGIS_256) == AlgorithmType::AEGIS_256);
+}
+
+TEST_CASE("AEGIS test vectors (draft-irtf-cfrg-aegis-aead)", "[aegis][kat]") {
+    if (!aegis_available()) {
+        SKIP("Botan built without AEGIS");
+    }
+
+    struct Vector {
+        size_t bits;
+        const char* key;
+        const char* nonce;
+        const char* ad;
+        const char* plaintext;
+        const char* ciphertext;
+        const char* tag;
+    };
+    const Vector vectors[] = {
+        // Test Vector 1: one zero block, no associated data
+        {128, "10010000000000000000000000000000", "10000200000000000000000000000000", "",
+         "00000000000000000000000000000000",
+         "c1c0e58bd913006feba00f4b3cc3594e", "abe0ece80c24868a226a35d16bdae37a"},
+        {256, "1001000000000000000000000000000000000000000000000000000000000000",
+         "1000020000000000000000000000000000000000000000000000000000000000", "",
+         "00000000000000000000000000000000",
+         "754fc3d8c973246dcc6d741412a4b236", "3fe91994768b332ed7f570a19ec5896e"},
+        // Test Vector 3: 32-byte message with 8 bytes of associated data
+        {128, "10010000000000000000000000000000", "10000200000000000000000000000000", "0001020304050607",
+         "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f",
+         "79d94593d8c2119d7e8fd9b8fc77845c5c077a05b2528b6ac54b563aed8efe84", "cc6f3372f6aa1bb82388d695c3962d9a"},
+        {256, "1001000000000000000000000000000000000000000000000000000000000000",
+         "1000020000000000000000000000000000000000000000000000000000000000", "0001020304050607",
+         "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f",
+         "f373079ed84b2709faee373584585d60accd191db310ef5d8b11833df9dec711", "8d86f91ee606e9ff26a01b64ccbdd91d"},
+    };
+
+    for (const auto& vector : vectors) {
+        AEGIS cipher(vector.bits);
+        EncryptionConfig config;
+        config.nonce = Botan::hex_decode(vector.nonce);
+        config.associated_data = Botan::hex_decode(vector.ad);
+
+        auto encrypted = cipher.encrypt(Botan::hex_decode(vector.plaintext), Botan::hex_decode(vector.key), config);
+        REQUIRE(encrypted.success);
+        REQUIRE(encrypted.data == Botan::hex_decode(vector.ciphertext));
+        REQUIRE(encrypted.tag.value() == Botan::hex_decode(vector.tag));
+
+        config.tag = encrypted.tag;
+        auto decrypted = cipher.decrypt(encrypted.data, Botan::hex_decode(vector.key), config);
+        REQUIRE(decrypted.success);
+        REQUIRE(decrypted.data == Botan::hex_decode(vector.plaintext));
+    }
+}
+
+TEST_CASE("AEGIS encryption/decryption", "[aegis]") {
+    if (!aegis_available()) {
+        SKIP("Botan built without AEGIS");
+    }
+
+    for (size_t bits : {size_t(128), size_t(256)}) {
+        AEGIS cipher(bits);
+        std::vector<uint8_t> key(cipher.key_size(), 0x42);
+        auto pt = bytes("Bulk backup block for " + cipher.name() + ", long enough to span several AES blocks.");
+
+        SECTION(cipher.name() + " round trip with generated nonce") {
+            EncryptionConfig config;
+            auto encrypted = cipher.encrypt(pt, key, config);
+            REQUIRE(encrypted.success);
+            REQUIRE(encrypted.data.size() == pt.size());
+            REQUIRE(encrypted.data != pt);
+            REQUIRE(encrypted.nonce->size() == cipher.nonce_size());
+            REQUIRE(encrypted.tag->size() == 16);
+
+            config.nonce = encrypted.nonce;
+            config.tag = encrypted.tag;
+            auto decrypted = cipher.decrypt(encrypted.data, key, config);
+            REQUIRE(decrypted.success);
+            REQUIRE(decrypted.data == pt);
+        }
+
+        SECTION(cipher.name() + " rejects tampering") {
+            EncryptionConfig config;
+            config.associated_data = bytes("header v1");
+            auto encrypted = cipher.encrypt(pt, key, config);
+            REQUIRE(encrypted.success);
+            config.nonce = encrypted.nonce;
+            config.tag = encrypted.tag;
+
+            auto tampered = encrypted.data;
+            tampered[3] ^= 0x01;
+            REQUIRE_FALSE(cipher.decrypt(tampered, key, config).success);
+
+            auto other_ad = config;
+            other_ad.associated_data = bytes("header v2");
+            REQUIRE_FALSE(cipher.decrypt(encrypted.data, key, other_ad).success);
+
+            std::vector<uint8_t> wrong_key(cipher.key_size(), 0x43);
+            REQUIRE_FALSE(cipher.decrypt(encrypted.data, wrong_key, config).success);
+        }
+
+        SECTION(cipher.name() + " rejects GCM-sized nonces and wrong keys") {
+            EncryptionConfig config;
+            config.nonce = std::vector<uint8_t>(12, 0x01);
+            REQUIRE_FALSE(cipher.encrypt(pt, key, config).success);
+
+            std::vector<uint8_t> short_key(cipher.key_size() - 1, 0x42);
+            REQUIRE_FALSE(cipher.encrypt(pt, short_key, EncryptionConfig{}).success);
+        }
+
+        SECTION(cipher.name() + " keyed context matches one-shot") {
+            EncryptionConfig config;
+            config.nonce = std::vector<uint8_t>(cipher.nonce_size(), 0x07);
+            auto one_shot = cipher.encrypt(pt, key, config);
+            auto context = cipher.make_context(key);
+            auto keyed = context->encrypt(pt, config);
+            REQUIRE(one_shot.success);
+            REQUIRE(keyed.success);
+            REQUIRE(keyed.data == one_shot.data);
+            REQUIRE(keyed.tag == one_shot.tag);
+        }
+
+        SECTION(cipher.name() + " incremental session matches one-shot") {
+            std::vector<uint8_t> nonce(cipher.nonce_size(), 0x09);
+            auto session = cipher.begin_encryption(key, nonce);
+            REQUIRE(session);
+
+            std::vector<uint8_t> ciphertext(session.value->output_bound(pt.size()));
+            size_t written = 0;
+            for (size_t offset = 0; offset < pt.size(); offset += 7) {
+                std::span<const uint8_t> piece(pt.data() + offset, (std::min)(size_t(7), pt.size() - offset));
+                auto n = session.value->update(piece, std::span<uint8_t>(ciphertext).subspan(written));
+                REQUIRE(n);
+                written += n.value;
+            }
+            std::vector<uint8_t> tag(16);
+            auto n = session.value->finish(std::span<uint8_t>(ciphertext).subspan(written), tag);
+            REQUIRE(n);
+            ciphertext.resize(written + n.value);
+
+            EncryptionConfig config;
+            config.nonce = nonce;
+            auto one_shot = cipher.encrypt(pt, key, config);
+            REQUIRE(ciphertext == one_shot.data);
+            REQUIRE(tag == one_shot.tag.value());
+        }
+    }
+}
@@ -127,3 +127,267 @@ TEST_CASE("AES-GCM NIST test vectors", "[aes][gcm][nist]") {
     REQUIRE(result.tag.has_value());
     REQUIRE(result.tag.value().size() == 16);
 }
+
+TEST_CASE("AES-GCM keyed context matches one-shot calls", "[aes][gcm][context]") {
+    AES_GCM cipher(256);
+    std::vector<uint8_t> key(32, 0x5C);
+    auto context = cipher.make_context(key);
+    REQUIRE(context);
+    
+    SECTION("Same ciphertext and tag for many messages") {
+        for (uint8_t i = 0; i < 16; ++i) {
+            std::vector<uint8_t> pt(100u * i, i);
+            EncryptionConfig config;
+            config.nonce = std::vector<uint8_t>(12, i);
+            
+            auto expected = cipher.encrypt(pt, key, config);
+            auto actual = context->encrypt(pt, config);
+            REQUIRE(actual.success);
+            REQUIRE(actual.data == expected.data);
+            REQUIRE(actual.tag == expected.tag);
+            REQUIRE(actual.nonce == config.nonce);
+            
+            config.tag = actual.tag;
+            auto decrypted = context->decrypt(actual.data, config);
+            REQUIRE(decrypted.success);
+            REQUIRE(decrypted.data == pt);
+        }
+    }
+    
+    SECTION("Associated data applies only to its own message") {
+        std::vector<uint8_t> pt(64, 0x11);
+        EncryptionConfig with_ad;
+        with_ad.nonce = std::vector<uint8_t>(12, 0x01);
+        with_ad.associated_data = std::vector<uint8_t>{'h', 'd', 'r'};
+        REQUIRE(context->encrypt(pt, with_ad).tag == cipher.encrypt(pt, key, with_ad).tag);
+        
+        EncryptionConfig without_ad;
+        without_ad.nonce = with_ad.nonce;
+        REQUIRE(context->encrypt(pt, without_ad).tag == cipher.encrypt(pt, key, without_ad).tag);
+    }
+    
+    SECTION("A failed tag check does not disturb later messages") {
+        std::vector<uint8_t> pt(48, 0x22);
+        EncryptionConfig config;
+        config.nonce = std::vector<uint8_t>(12, 0x03);
+        auto encrypted = context->encrypt(pt, config);
+        
+        config.tag = encrypted.tag;
+        config.tag->at(0) ^= 0x01;
+        auto rejected = context->decrypt(encrypted.data, config);
+        REQUIRE_FALSE(rejected.success);
+        REQUIRE(rejected.error_message.find("Authentication failed") != std::string::npos);
+        
+        config.tag = encrypted.tag;
+        auto decrypted = context->decrypt(encrypted.data, config);
+        REQUIRE(decrypted.success);
+        REQUIRE(decrypted.data == pt);
+    }
+    
+    SECTION("Wrong key size fails every call") {
+        auto bad = cipher.make_context(std::vector<uint8_t>(16, 0x00));
+        EncryptionConfig config;
+        auto result = bad->encrypt(std::vector<uint8_t>(8, 0x00), config);
+        REQUIRE_FALSE(result.success);
+        REQUIRE(result.error_message.find("key size") != std::string::npos);
+    }
+}
+
+TEST_CASE("AES-GCM encrypts and decrypts into caller buffers", "[aes][gcm][into]") {
+    AES_GCM cipher(256);
+    std::vector<uint8_t> key(32, 0x4D);
+    EncryptionConfig config;
+    config.nonce = std::vector<uint8_t>(12, 0x07);
+    
+    // Lengths around the cipher granularity exercise the buffered remainder
+    for (size_t length : {size_t(0), size_t(1), size_t(15), size_t(16), size_t(17), size_t(4099)}) {
+        std::vector<uint8_t> pt(length);
+        for (size_t i = 0; i < length; ++i) {
+            pt[i] = static_cast<uint8_t>(i * 31);
+        }
+        auto expected = cipher.encrypt(pt, key, config);
+        REQUIRE(expected.success);
+        
+        SECTION("Separate output buffer, length " + std::to_string(length)) {
+            std::vector<uint8_t> out(length + 8, 0xEE);
+            std::vector<uint8_t> tag(16);
+            auto written = cipher.encrypt_into(pt, out, tag, key, config);
+            REQUIRE(written.success);
+            REQUIRE(written.value == length);
+            REQUIRE(std::vector<uint8_t>(out.begin(), out.begin() + length) == expected.data);
+            REQUIRE(tag == expected.tag.value());
+            REQUIRE(out[length] == 0xEE);
+        }
+        
+        SECTION("In place, length " + std::to_string(length)) {
+            std::vector<uint8_t> buffer = pt;
+            std::vector<uint8_t> tag(16);
+            REQUIRE(cipher.encrypt_into(buffer, buffer, tag, key, config).success);
+            REQUIRE(buffer == expected.data);
+            
+            EncryptionConfig dec_config = config;
+            dec_config.tag = tag;
+            auto read = cipher.decrypt_into(buffer, buffer, key, dec_config);
+            REQUIRE(read.success);
+            REQUIRE(read.value == length);
+            REQUIRE(buffer == pt);
+        }
+    }
+    
+    SECTION("A bad tag wipes the output") {
+        std::vector<uint8_t> buffer(100, 0x61);
+        std::vector<uint8_t> tag(16);
+        REQUIRE(cipher.encrypt_into(buffer, buffer, tag, key, config).success);
+        
+        EncryptionConfig dec_config = config;
+        tag[3] ^= 0x80;
+        dec_config.tag = tag;
+        std::vector<uint8_t> out(buffer.size());
+        auto read = cipher.decrypt_into(buffer, out, key, dec_config);
+        REQUIRE_FALSE(read.success);
+        REQUIRE(read.error_message.find("Authentication failed") != std::string::npos);
+        REQUIRE(out == std::vector<uint8_t>(out.size(), 0));
+    }
+    
+    SECTION("Buffer sizes are checked") {
+        std::vector<uint8_t> pt(32, 0x01);
+        std::vector<uint8_t> small(31);
+        std::vector<uint8_t> tag(16);
+        REQUIRE_FALSE(cipher.encrypt_into(pt, small, tag, key, config).success);
+        
+        std::vector<uint8_t> out(32);
+        std::vector<uint8_t> short_tag(8);
+        REQUIRE_FALSE(cipher.encrypt_into(pt, out, short_tag, key, config).success);
+        
+        EncryptionConfig no_nonce;
+        REQUIRE_FALSE(cipher.encrypt_into(pt, out, tag, key, no_nonce).success);
+    }
+}
+
+TEST_CASE("AES-GCM batch encryption fills one arena", "[aes][gcm][batch]") {
+    AES_GCM cipher(128);
+    std::vector<uint8_t> key(16, 0x2A);
+    std::vector<uint8_t> nonce_base(12, 0x90);
+    
+    std::vector<std::vector<uint8_t>> messages;
+    for (size_t length : {size_t(0), size_t(5), size_t(16), size_t(33), size_t(300)}) {
+        messages.emplace_back(length, static_cast<uint8_t>(length));
+    }
+    std::vector<std::span<const uint8_t>> inputs(messages.begin(), messages.end());
+    
+    BatchArena arena;
+    auto count = cipher.encrypt_batch(inputs, key, nonce_base, arena);
+    REQUIRE(count.success);
+    REQUIRE(count.value == messages.size());
+    REQUIRE(arena.size() == messages.size());
+    REQUIRE(arena.tag_size() == 16);
+    
+    SECTION("Each message matches a one-shot encryption under its nonce") {
+        uint64_t offset = 0;
+        for (size_t i = 0; i < messages.size(); ++i) {
+            EncryptionConfig config;
+            config.nonce = BatchArena::nonce_for(nonce_base, i);
+            auto expected = cipher.encrypt(messages[i], key, config);
+            REQUIRE(expected.success);
+            
+            REQUIRE(arena.items()[i].offset == offset);
+            auto ct = arena.ciphertext(i);
+            auto tag = arena.tag(i);
+            REQUIRE(std::vector<uint8_t>(ct.begin(), ct.end()) == expected.data);
+            REQUIRE(std::vector<uint8_t>(tag.begin(), tag.end()) == expected.tag.value());
+            offset += messages[i].size() + 16;
+        }
+        REQUIRE(arena.bytes().size() == offset);
+    }
+    
+    SECTION("Nonces differ per message") {
+        REQUIRE(BatchArena::nonce_for(nonce_base, 0) == nonce_base);
+        REQUIRE(BatchArena::nonce_for(nonce_base, 1) != BatchArena::nonce_for(nonce_base, 2));
+        REQUIRE(BatchArena::nonce_for(nonce_base, 1).size() == 12);
+    }
+    
+    SECTION("A reused arena keeps its storage") {
+        const uint8_t* storage = arena.bytes().data();
+        auto context = cipher.make_context(key);
+        REQUIRE(context->encrypt_batch(inputs, nonce_base, arena).success);
+        REQUIRE(arena.bytes().data() == storage);
+        REQUIRE(arena.size() == messages.size());
+    }
+    
+    SECTION("Invalid batches leave the arena empty") {
+        std::vector<uint8_t> short_base(3, 0x01);
+        REQUIRE_FALSE(cipher.encrypt_batch(inputs, key, short_base, arena).success);
+        REQUIRE(arena.size() == 0);
+        
+        std::vector<uint8_t> wrong_key(8, 0x01);
+        REQUIRE_FALSE(cipher.encrypt_batch(inputs, wrong_key, nonce_base, arena).success);
+        REQUIRE(arena.bytes().empty());
+    }
+}
+
+TEST_CASE("AES-GCM encrypts incrementally like one-shot", "[aes][gcm][session]") {
+    AES_GCM cipher(256);
+    std::vector<uint8_t> key(32, 0x11);
+    std::vector<uint8_t> nonce(12, 0x22);
+    std::vector<uint8_t> ad = {'h', 'd', 'r'};
+    
+    std::vector<uint8_t> pt(777);
+    for (size_t i = 0; i < pt.size(); ++i) {
+        pt[i] = static_cast<uint8_t>(i ^ 0x5A);
+    }
+    EncryptionConfig config;
+    config.nonce = nonce;
+    config.associated_data = ad;
+    auto expected = cipher.encrypt(pt, key, config);
+    REQUIRE(expected.success);
+    
+    // Collects update() and finish() output for a message fed in 100-byte pieces
+    auto feed = [](ICipherSession& session, const std::vector<uint8_t>& input, std::vector<uint8_t>& tag) {
+        std::vector<uint8_t> output;
+        for (size_t offset = 0; offset < input.size(); offset += 100) {
+            std::span<const uint8_t> in(input.data() + offset, std::min<size_t>(100, input.size() - offset));
+            std::vector<uint8_t> out(session.output_bound(in.size()));
+            auto written = session.update(in, out);
+            REQUIRE(written.success);
+            output.insert(output.end(), out.begin(), out.begin() + written.value);
+        }
+        std::vector<uint8_t> out(session.output_bound(0));
+        auto written = session.finish(out, tag);
+        if (written.success) {
+            output.insert(output.end(), out.begin(), out.begin() + written.value);
+        }
+        return std::make_pair(written, output);
+    };
+    
+    auto enc = cipher.begin_encryption(key, nonce, ad);
+    REQUIRE(enc.success);
+    REQUIRE(enc.value->tag_size() == 16);
+    std::vector<uint8_t> tag(16);
+    auto [enc_done, ciphertext] = feed(*enc.value, pt, tag);
+    REQUIRE(enc_done.success);
+    REQUIRE(ciphertext == expected.data);
+    REQUIRE(tag == expected.tag.value());
+    
+    SECTION("Decryption verifies the tag at the end") {
+        auto dec = cipher.begin_decryption(key, nonce, ad);
+        REQUIRE(dec.success);
+        auto [done, plain] = feed(*dec.value, ciphertext, tag);
+        REQUIRE(done.success);
+        REQUIRE(plain == pt);
+    }
+    
+    SECTION("A tampered tag fails finish()") {
+        auto dec = cipher.begin_decryption(key, nonce, ad);
+        REQUIRE(dec.success);
+        tag[0] ^= 0x01;
+        auto [done, plain] = feed(*dec.value, ciphertext, tag);
+        REQUIRE_FALSE(done.success);
+        REQUIRE(done.error_message.find("Authentication failed") != std::string::npos);
+    }
+    
+    SECTION("A finished session refuses more input") {
+        std::vector<uint8_t> out(16);
+        REQUIRE_FALSE(enc.value->update(pt, out).success);
+        REQUIRE_FALSE(enc.value->finish(out, tag).success);
+    }
+}
@@ -9,6 +9,9 @@
 #include "filevault/algorithms/symmetric/aes_ofb.hpp"
 #include "filevault/algorithms/symmetric/aes_ecb.hpp"
 #include "filevault/algorithms/symmetric/aes_xts.hpp"
+#include "filevault/algorithms/symmetric/aes_cbc.hpp"
+#include "filevault/algorithms/symmetric/aes_ctr.hpp"
+#include <memory>
 #include <vector>
 #include <string>
 
@@ -134,6 +137,36 @@ TEST_CASE("AES-OFB Basic Encrypt/Decrypt", "[aes-ofb]") {
 // AES-ECB Tests (Note: ECB is INSECURE!)
 // ============================================================================
 
+TEST_CASE("AES-OFB encrypt_into copies the one-shot result", "[aes-ofb][into]") {
+    AES_OFB ofb(256);
+    auto key = generate_key(32);
+    
+    EncryptionConfig config;
+    config.nonce = std::vector<uint8_t>(16, 0x24);
+    auto expected = ofb.encrypt(TEST_DATA, key, config);
+    REQUIRE(expected.success);
+    
+    // Non-AEAD: no tag buffer
+    std::vector<uint8_t> out(TEST_DATA.size());
+    auto written = ofb.encrypt_into(TEST_DATA, out, {}, key, config);
+    REQUIRE(written.success);
+    REQUIRE(written.value == TEST_DATA.size());
+    REQUIRE(out == expected.data);
+    
+    std::vector<uint8_t> plain(out.size());
+    auto read = ofb.decrypt_into(out, plain, key, config);
+    REQUIRE(read.success);
+    REQUIRE(plain == TEST_DATA);
+    
+    SECTION("An IV the algorithm would replace is rejected") {
+        EncryptionConfig short_iv;
+        short_iv.nonce = std::vector<uint8_t>(12, 0x24);
+        auto result = ofb.encrypt_into(TEST_DATA, out, {}, key, short_iv);
+        REQUIRE_FALSE(result.success);
+        REQUIRE(result.error_message.find("IV") != std::string::npos);
+    }
+}
+
 TEST_CASE("AES-ECB Basic Encrypt/Decrypt", "[aes-ecb]") {
     SECTION("AES-128-ECB round-trip") {
         AES_ECB ecb(128);
@@ -359,3 +392,95 @@ TEST_CASE("CFB/OFB decryption requires IV", "[aes][validation]") {
         REQUIRE(result.error_message.find("Tweak") != std::string::npos);
     }
 }
+
+// ============================================================================
+// Incremental sessions
+// ============================================================================
+
+namespace {
+
+// Feeds @p input to a session in @p piece-sized updates and collects everything it writes
+std::vector<uint8_t> run_session(ICipherSession& session, const std::vector<uint8_t>& input, size_t piece) {
+    std::vector<uint8_t> output;
+    for (size_t offset = 0; offset < input.size(); offset += piece) {
+        std::span<const uint8_t> in(input.data() + offset, (std::min)(piece, input.size() - offset));
+        std::vector<uint8_t> out(session.output_bound(in.size()));
+        auto written = session.update(in, out);
+        REQUIRE(written.success);
+        output.insert(output.end(), out.begin(), out.begin() + written.value);
+    }
+    std::vector<uint8_t> out(session.output_bound(0));
+    auto written = session.finish(out, {});
+    REQUIRE(written.success);
+    output.insert(output.end(), out.begin(), out.begin() + written.value);
+    return output;
+}
+
+} // anonymous namespace
+
+TEST_CASE("AES modes encrypt incrementally like one-shot", "[aes][session]") {
+    std::vector<std::unique_ptr<ICryptoAlgorithm>> modes;
+    modes.push_back(std::make_unique<AES_CBC>(256));
+    modes.push_back(std::make_unique<AES_CTR>(128));
+    modes.push_back(std::make_unique<AES_CFB>(192));
+    modes.push_back(std::make_unique<AES_OFB>(256));
+    modes.push_back(std::make_unique<AES_XTS>(256));
+    
+    std::vector<uint8_t> data(1000);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i * 7);
+    }
+    const std::vector<uint8_t> iv(16, 0x3C);
+    
+    for (auto& mode : modes) {
+        auto key = generate_key(mode->key_size());
+        EncryptionConfig config;
+        config.nonce = iv;
+        auto expected = mode->encrypt(data, key, config);
+        REQUIRE(expected.success);
+        
+        // Pieces smaller than, equal to and larger than a block
+        for (size_t piece : {size_t(1), size_t(16), size_t(37), size_t(1000)}) {
+            SECTION(mode->name() + " in pieces of " + std::to_string(piece)) {
+                auto enc = mode->begin_encryption(key, iv);
+                REQUIRE(enc.success);
+                REQUIRE(enc.value->nonce() == iv);
+                REQUIRE(enc.value->tag_size() == 0);
+                REQUIRE(run_session(*enc.value, data, piece) == expected.data);
+                
+                auto dec = mode->begin_decryption(key, iv);
+                REQUIRE(dec.success);
+                REQUIRE(run_session(*dec.value, expected.data, piece) == data);
+            }
+        }
+    }
+    
+    SECTION("A missing IV is generated") {
+        AES_CBC cbc(128);
+        auto key = generate_key(16);
+        auto session = cbc.begin_encryption(key, {});
+        REQUIRE(session.success);
+        REQUIRE(session.value->nonce().size() == 16);
+        
+        EncryptionConfig config;
+        config.nonce = session.value->nonce();
+        auto ciphertext = run_session(*session.value, TEST_DATA, 10);
+        auto plain = cbc.decrypt(ciphertext, key, config);
+        REQUIRE(plain.success);
+        REQUIRE(plain.data == TEST_DATA);
+    }
+    
+    SECTION("Invalid starts are reported") {
+        AES_CTR ctr(256);
+        REQUIRE_FALSE(ctr.begin_encryption(generate_key(16), iv).success);
+        REQUIRE_FALSE(ctr.begin_encryption(generate_key(32), std::vector<uint8_t>(12)).success);
+        
+        std::vector<uint8_t> ad(4, 0x01);
+        auto with_ad = ctr.begin_encryption(generate_key(32), iv, ad);
+        REQUIRE_FALSE(with_ad.success);
+        REQUIRE_THAT(with_ad.error_message, Catch::Matchers::ContainsSubstring("AEAD"));
+        
+        AES_ECB ecb(128);
+        REQUIRE_FALSE(ecb.begin_encryption(generate_key(16), {}).success);
+    }
+}
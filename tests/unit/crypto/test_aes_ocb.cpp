@@ -0,0 +1,135 @@
+/**
+ * @file test_aes_ocb.cpp
+ * @brief Unit tests for AES-OCB3 (RFC 7253)
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include "filevault/algorithms/symmetric/aes_ocb.hpp"
+#include "filevault/core/algorithm_registry.hpp"
+#include "filevault/core/crypto_engine.hpp"
+#include "filevault/core/file_format.hpp"
+#include <botan/hex.h>
+#include <string>
+#include <vector>
+
+using namespace filevault::algorithms::symmetric;
+using namespace filevault::core;
+
+namespace {
+
+std::vector<uint8_t> hex(const std::string& text) {
+    return Botan::hex_decode(text);
+}
+
+} // anonymous namespace
+
+TEST_CASE("AES-OCB parameters and registration", "[aes][ocb]") {
+    const std::vector<std::pair<size_t, AlgorithmType>> variants = {
+        {128, AlgorithmType::AES_128_OCB},
+        {192, AlgorithmType::AES_192_OCB},
+        {256, AlgorithmType::AES_256_OCB},
+    };
+    for (const auto& [bits, type] : variants) {
+        AES_OCB cipher(bits);
+        REQUIRE(cipher.type() == type);
+        REQUIRE(cipher.key_size() == bits / 8);
+        REQUIRE(cipher.nonce_size() == 12);
+        REQUIRE(find_algorithm(type)->key_size == cipher.key_size());
+        REQUIRE(find_algorithm(type)->aead);
+    }
+    REQUIRE(AES_OCB(256).name() == "AES-256/OCB");
+    REQUIRE_THROWS_AS(AES_OCB(512), std::invalid_argument);
+
+    REQUIRE(CryptoEngine::parse_algorithm("aes-128-ocb") == AlgorithmType::AES_128_OCB);
+    REQUIRE(CryptoEngine::parse_algorithm("AES-256-OCB") == AlgorithmType::AES_256_OCB);
+    REQUIRE(FileFormatHandler::to_algorithm_id(AlgorithmType::AES_192_OCB) == AlgorithmID::AES_192_OCB);
+    REQUIRE(FileFormatHandler::from_algorithm_id(AlgorithmID::AES_256_OCB) == AlgorithmType::AES_256_OCB);
+}
+
+TEST_CASE("AES-OCB RFC 7253 test vectors", "[aes][ocb][kat]") {
+    AES_OCB cipher(128);
+    auto key = hex("000102030405060708090A0B0C0D0E0F");
+
+    SECTION("Empty message, empty associated data") {
+        EncryptionConfig config;
+        config.nonce = hex("BBAA99887766554433221100");
+        auto encrypted = cipher.encrypt({}, key, config);
+        REQUIRE(encrypted.success);
+        REQUIRE(encrypted.data.empty());
+        REQUIRE(encrypted.tag.value() == hex("785407BFFFC8AD9EDCC5520AC9111EE6"));
+    }
+
+    SECTION("8-byte message with 8 bytes of associated data") {
+        EncryptionConfig config;
+        config.nonce = hex("BBAA99887766554433221101");
+        config.associated_data = hex("0001020304050607");
+        auto encrypted = cipher.encrypt(hex("0001020304050607"), key, config);
+        REQUIRE(encrypted.success);
+        REQUIRE(encrypted.data == hex("6820B3657B6F615A"));
+        REQUIRE(encrypted.tag.value() == hex("5725BDA0D3B4EB3A257C9AF1F8F03009"));
+    }
+}
+
+TEST_CASE("AES-OCB encryption/decryption", "[aes][ocb]") {
+    AES_OCB cipher(256);
+    std::vector<uint8_t> key(32, 0x5A);
+    std::string text = "Several AES blocks of file content, plus a partial final block.";
+    std::vector<uint8_t> pt(text.begin(), text.end());
+
+    SECTION("Round trip with generated nonce") {
+        EncryptionConfig config;
+        auto encrypted = cipher.encrypt(pt, key, config);
+        REQUIRE(encrypted.success);
+        REQUIRE(encrypted.data.size() == pt.size());
+        REQUIRE(encrypted.nonce->size() == 12);
+        REQUIRE(encrypted.tag->size() == 16);
+
+        config.nonce = encrypted.nonce;
+        config.tag = encrypted.tag;
+        auto decrypted = cipher.decrypt(encrypted.data, key, config);
+        REQUIRE(decrypted.success);
+        REQUIRE(decrypted.data == pt);
+    }
+
+    SECTION("Tampering and wrong associated data are rejected") {
+        EncryptionConfig config;
+        config.associated_data = std::vector<uint8_t>{1, 2, 3};
+        auto encrypted = cipher.encrypt(pt, key, config);
+        REQUIRE(encrypted.success);
+        config.nonce = encrypted.nonce;
+        config.tag = encrypted.tag;
+
+        auto tampered = encrypted.data;
+        tampered[0] ^= 0x80;
+        REQUIRE_FALSE(cipher.decrypt(tampered, key, config).success);
+
+        auto other_ad = config;
+        other_ad.associated_data = std::vector<uint8_t>{1, 2, 4};
+        REQUIRE_FALSE(cipher.decrypt(encrypted.data, key, other_ad).success);
+    }
+
+    SECTION("Keyed context and incremental session match one-shot") {
+        EncryptionConfig config;
+        config.nonce = std::vector<uint8_t>(12, 0x03);
+        auto one_shot = cipher.encrypt(pt, key, config);
+        REQUIRE(one_shot.success);
+
+        auto context = cipher.make_context(key);
+        auto keyed = context->encrypt(pt, config);
+        REQUIRE(keyed.success);
+        REQUIRE(keyed.data == one_shot.data);
+        REQUIRE(keyed.tag == one_shot.tag);
+
+        auto session = cipher.begin_encryption(key, config.nonce.value());
+        REQUIRE(session);
+        std::vector<uint8_t> ciphertext(session.value->output_bound(pt.size()));
+        auto written = session.value->update(pt, ciphertext);
+        REQUIRE(written);
+        std::vector<uint8_t> tag(16);
+        auto rest = session.value->finish(std::span<uint8_t>(ciphertext).subspan(written.value), tag);
+        REQUIRE(rest);
+        ciphertext.resize(written.value + rest.value);
+        REQUIRE(ciphertext == one_shot.data);
+        REQUIRE(tag == one_shot.tag.value());
+    }
+}
@@ -5,6 +5,7 @@
 
 #include <catch2/catch_test_macros.hpp>
 #include "filevault/algorithms/asymmetric/ecc.hpp"
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -267,3 +268,80 @@ TEST_CASE("ECCHybrid Encryption", "[ecc][hybrid]") {
         REQUIRE(p521.key_size() == 66);
     }
 }
+
+TEST_CASE("ECCHybrid incremental sessions", "[ecc][hybrid]") {
+    ECCHybrid hybrid(ECCurve::SECP256R1);
+    auto recipient_keys = hybrid.generate_key_pair();
+    EncryptionConfig config;
+
+    std::vector<uint8_t> data(10000);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i * 7);
+    }
+
+    // Feeds input in pieces; the tag goes last, as in the one-shot layout
+    auto encrypt_in_pieces = [&](size_t piece) {
+        auto started = hybrid.begin_encryption(recipient_keys.public_key, {});
+        REQUIRE(started);
+        auto& session = *started.value;
+
+        std::vector<uint8_t> out;
+        for (size_t pos = 0; pos < data.size(); pos += piece) {
+            size_t n = std::min(piece, data.size() - pos);
+            std::vector<uint8_t> buffer(session.output_bound(n));
+            auto written = session.update(std::span(data).subspan(pos, n), buffer);
+            REQUIRE(written);
+            out.insert(out.end(), buffer.begin(), buffer.begin() + written.value);
+        }
+        std::vector<uint8_t> buffer(session.output_bound(0));
+        std::vector<uint8_t> tag(session.tag_size());
+        auto written = session.finish(buffer, tag);
+        REQUIRE(written);
+        out.insert(out.end(), buffer.begin(), buffer.begin() + written.value);
+        out.insert(out.end(), tag.begin(), tag.end());
+        return out;
+    };
+
+    SECTION("Session output decrypts in one shot") {
+        for (size_t piece : {size_t(1), size_t(100), size_t(4096)}) {
+            auto encrypted = encrypt_in_pieces(piece);
+            auto decrypted = hybrid.decrypt(encrypted, recipient_keys.private_key, config);
+            REQUIRE(decrypted.success);
+            REQUIRE(decrypted.data == data);
+        }
+    }
+
+    SECTION("One-shot output decrypts in pieces") {
+        auto encrypted = hybrid.encrypt(data, recipient_keys.public_key, config);
+        REQUIRE(encrypted.success);
+
+        auto started = hybrid.begin_decryption(recipient_keys.private_key, {});
+        REQUIRE(started);
+        auto& session = *started.value;
+
+        const size_t body = encrypted.data.size() - session.tag_size();
+        std::vector<uint8_t> out;
+        for (size_t pos = 0; pos < body; pos += 37) {
+            size_t n = std::min(size_t(37), body - pos);
+            std::vector<uint8_t> buffer(session.output_bound(n));
+            auto written = session.update(std::span(encrypted.data).subspan(pos, n), buffer);
+            REQUIRE(written);
+            out.insert(out.end(), buffer.begin(), buffer.begin() + written.value);
+        }
+        std::vector<uint8_t> tag(encrypted.data.begin() + body, encrypted.data.end());
+        std::vector<uint8_t> buffer(session.output_bound(0));
+        auto written = session.finish(buffer, tag);
+        REQUIRE(written);
+        out.insert(out.end(), buffer.begin(), buffer.begin() + written.value);
+        REQUIRE(out == data);
+    }
+
+    SECTION("Truncated input fails") {
+        auto started = hybrid.begin_decryption(recipient_keys.private_key, {});
+        REQUIRE(started);
+        std::vector<uint8_t> buffer(16), tag(16);
+        auto written = started.value->finish(buffer, tag);
+        REQUIRE_FALSE(written);
+        REQUIRE(written.error_message == "Ciphertext too short");
+    }
+}
@@ -353,3 +353,26 @@ TEST_CASE("Twofish Auto-generates Unique Nonces", "[twofish][nonce]") {
     // Ciphertexts should also be different
     REQUIRE(encrypted1.data != encrypted2.data);
 }
+
+TEST_CASE("Twofish keyed context keeps one-shot output", "[twofish][context]") {
+    Twofish_GCM twofish(256);
+    std::vector<uint8_t> key(32, 0x7E);
+    auto context = twofish.make_context(key);
+    
+    std::vector<uint8_t> pt(1000, 0x33);
+    EncryptionConfig config;
+    config.nonce = std::vector<uint8_t>(12, 0x09);
+    // One-shot Twofish never authenticated associated data; the context must agree
+    config.associated_data = std::vector<uint8_t>{0x01, 0x02};
+    
+    auto expected = twofish.encrypt(pt, key, config);
+    auto actual = context->encrypt(pt, config);
+    REQUIRE(actual.success);
+    REQUIRE(actual.data == expected.data);
+    REQUIRE(actual.tag == expected.tag);
+    
+    config.tag = actual.tag;
+    auto decrypted = twofish.decrypt(actual.data, key, config);
+    REQUIRE(decrypted.success);
+    REQUIRE(decrypted.data == pt);
+}